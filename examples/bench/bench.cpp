@@ -0,0 +1,737 @@
+/*
+ * fdk_aac_bench: frames per second and ns per frame of the encoder, of the
+ * decoder and of the main decoder stages.
+ *
+ * The encoder runs for each audio object type and bitrate mode on a generated
+ * test signal. The decoder runs on the constant bitrate streams of the encoder
+ * and on the ADTS (.aac, .adts), LOAS (.loas, .latm) and MP4 (.m4a, .mp4)
+ * files of an optional corpus directory. All times are the best of several passes.
+ *
+ * The huffman, imdct, sbr (qmf) and limiter numbers are microbenchmarks: each
+ * kernel runs alone on synthetic input sized like the stream, not inside a
+ * decode. The stage times of a real decode are the traced stages of a build
+ * with -DFDK_AAC_TRACE=ON.
+ *
+ * usage: fdk_aac_bench [-n frames] [-r repeats] [-k cpu features] [corpus dir]
+ *
+ *   -n  frames of the generated test signal (default 500)
+ *   -r  passes per measurement, the fastest one is reported (default 3)
+ *   -k  mask of the FDK_CPU_* flags to use, e.g. 0 for the generic code
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "libAACdec/aacdecoder.h"
+#include "libAACdec/aacdecoder_lib.h"
+#include "libAACdec/aac_rom.h"
+#include "libAACdec/block.h"
+#include "libAACdec/overlapadd.h"
+#include "libAACenc/aacenc_lib.h"
+#include "libFDK/FDK_dispatch.h"
+#include "libFDK/mdct.h"
+#include "libFDK/qmf.h"
+#include "libMpegTPDec/tpdec_lib.h"
+#include "libMpegTPDec/tpdec_mp4.h"
+#include "libPCMutils/limiter.h"
+#include "libSYS/FDK_cpu.h"
+
+#define BENCH_SAMPLE_RATE (48000)
+#define BENCH_CHANNELS (2)
+#define BENCH_MAX_PCM (8 * 4096) /* decoder output buffer in samples */
+
+/* one encoder configuration, all for 48 kHz stereo input */
+struct EncConfig {
+  const char *name;
+  AUDIO_OBJECT_TYPE aot;
+  INT sbr; /* AACENC_SBR_MODE, only for ELD */
+  INT bitrate;
+  TRANSPORT_TYPE tt;
+};
+
+static const EncConfig encConfigs[] = {
+    {"LC", AOT_AAC_LC, 0, 128000, TT_MP4_ADTS},
+    {"HE", AOT_SBR, 0, 64000, TT_MP4_ADTS},
+    {"HEv2", AOT_PS, 0, 32000, TT_MP4_ADTS},
+    {"LD", AOT_ER_AAC_LD, 0, 128000, TT_MP4_LOAS},
+    {"ELD", AOT_ER_AAC_ELD, 0, 96000, TT_MP4_LOAS},
+    {"ELD-SBR", AOT_ER_AAC_ELD, 1, 64000, TT_MP4_LOAS},
+};
+
+/* bitstream to decode */
+struct Stream {
+  std::string name;
+  TRANSPORT_TYPE tt;
+  std::vector<UCHAR> data;
+};
+
+/* properties of a decoded stream, from CStreamInfo */
+struct StreamProps {
+  INT frames;
+  AUDIO_OBJECT_TYPE aot;
+  INT coreChannels;
+  INT outChannels;
+  INT coreFrameLength;
+  INT frameSize;
+  INT sampleRate;
+  UINT flags;
+  INT traceFrames; /* frames of aacDecoder_GetTrace() */
+  double traceNs[FDK_TRACE_NUM_STAGES]; /* average per frame */
+};
+
+static INT numFrames = 500;
+static INT numRepeats = 3;
+
+/* results of the microbenchmarks are stored here so they are not optimized
+ * away */
+static volatile UINT benchSink;
+
+static double now(void) {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/* linear congruential generator, the test signals must not change between
+ * runs */
+static UINT rndState = 1;
+
+static INT rnd(void) {
+  rndState = rndState * 1103515245u + 12345u;
+  return (INT)rndState;
+}
+
+static void printResult(const char *what, const char *name, const char *mode,
+                        const INT frames, const double seconds,
+                        const double audioSeconds) {
+  printf("%-4s %-24s %-5s %6d frames %10.0f ns/frame %9.1f fps %7.1fx\n",
+         what, name, mode, frames, seconds * 1e9 / frames, frames / seconds,
+         audioSeconds / seconds);
+}
+
+/*
+ * Test signal: a slow sine sweep, two fixed tones, noise and a pulse train,
+ * with different content on both channels and a changing level. It excites
+ * long and short blocks, SBR and the stereo tools.
+ */
+static std::vector<INT_PCM> makeSignal(const INT samples) {
+  std::vector<INT_PCM> pcm((size_t)samples * BENCH_CHANNELS);
+  double phase = 0.0;
+
+  rndState = 1;
+  for (INT i = 0; i < samples; i++) {
+    double t = (double)i / BENCH_SAMPLE_RATE;
+    double level = 0.5 + 0.45 * sin(2.0 * M_PI * 0.25 * t);
+
+    phase += 2.0 * M_PI * (100.0 + 7900.0 * fmod(t / 8.0, 1.0)) /
+             BENCH_SAMPLE_RATE;
+    for (INT ch = 0; ch < BENCH_CHANNELS; ch++) {
+      double x = 0.3 * sin(phase + ch) +
+                 0.15 * sin(2.0 * M_PI * (440.0 * (ch + 1)) * t) +
+                 0.05 * (rnd() >> 16) / 32768.0;
+      if ((i % 12000) < 48) x += 0.3 * (((i >> 2) & 1) ? 1.0 : -1.0);
+      pcm[(size_t)i * BENCH_CHANNELS + ch] = (INT_PCM)(32767.0 * level * x);
+    }
+  }
+  return pcm;
+}
+
+/*
+ * Encode the test signal. Returns the duration of the fastest pass, or a
+ * negative value if the encoder does not support the configuration.
+ */
+static double encodePass(const EncConfig &c, const INT bitrateMode,
+                         const std::vector<INT_PCM> &pcm, Stream *pStream,
+                         INT *pFrames, INT *pFrameLength) {
+  HANDLE_AACENCODER hEnc = NULL;
+  AACENC_InfoStruct info;
+  static UCHAR outBuf[8192];
+  double seconds;
+
+  if (aacEncOpen(&hEnc, 0, BENCH_CHANNELS) != AACENC_OK) return -1.0;
+  aacEncoder_SetParam(hEnc, AACENC_AOT, c.aot);
+  aacEncoder_SetParam(hEnc, AACENC_SAMPLERATE, BENCH_SAMPLE_RATE);
+  aacEncoder_SetParam(hEnc, AACENC_CHANNELMODE, MODE_2);
+  aacEncoder_SetParam(hEnc, AACENC_BITRATEMODE, bitrateMode);
+  aacEncoder_SetParam(hEnc, AACENC_BITRATE, c.bitrate);
+  aacEncoder_SetParam(hEnc, AACENC_TRANSMUX, c.tt);
+  if (c.aot == AOT_ER_AAC_ELD) {
+    aacEncoder_SetParam(hEnc, AACENC_SBR_MODE, c.sbr);
+  }
+  if ((aacEncEncode(hEnc, NULL, NULL, NULL, NULL) != AACENC_OK) ||
+      (aacEncInfo(hEnc, &info) != AACENC_OK)) {
+    aacEncClose(&hEnc);
+    return -1.0;
+  }
+
+  INT inSamples = info.frameLength * BENCH_CHANNELS;
+  INT frames = 0;
+  pStream->data.clear();
+
+  seconds = now();
+  for (size_t pos = 0; (frames < numFrames) && (pos + inSamples <= pcm.size());
+       pos += inSamples) {
+    AACENC_BufDesc inDesc = {}, outDesc = {};
+    AACENC_InArgs inArgs = {};
+    AACENC_OutArgs outArgs = {};
+    void *inPtr = (void *)&pcm[pos], *outPtr = outBuf;
+    INT inId = IN_AUDIO_DATA, inSize = inSamples * sizeof(INT_PCM),
+        inElSize = sizeof(INT_PCM);
+    INT outId = OUT_BITSTREAM_DATA, outSize = sizeof(outBuf), outElSize = 1;
+
+    inDesc.numBufs = 1;
+    inDesc.bufs = &inPtr;
+    inDesc.bufferIdentifiers = &inId;
+    inDesc.bufSizes = &inSize;
+    inDesc.bufElSizes = &inElSize;
+    outDesc.numBufs = 1;
+    outDesc.bufs = &outPtr;
+    outDesc.bufferIdentifiers = &outId;
+    outDesc.bufSizes = &outSize;
+    outDesc.bufElSizes = &outElSize;
+    inArgs.numInSamples = inSamples;
+
+    if (aacEncEncode(hEnc, &inDesc, &outDesc, &inArgs, &outArgs) !=
+        AACENC_OK) {
+      break;
+    }
+    if (outArgs.numOutBytes > 0) {
+      pStream->data.insert(pStream->data.end(), outBuf,
+                           outBuf + outArgs.numOutBytes);
+    }
+    frames++;
+  }
+  seconds = now() - seconds;
+
+  aacEncClose(&hEnc);
+  pStream->tt = c.tt;
+  *pFrames = frames;
+  *pFrameLength = info.frameLength;
+  return seconds;
+}
+
+/*
+ * Decode the samples of the first AAC track of an MP4 file, returns the number
+ * of frames.
+ */
+static INT decodeMp4(HANDLE_AACDECODER hDec, const Stream &s, INT_PCM *pcm) {
+  HANDLE_MP4_DEMUX hDemux = CMp4Demux_Open();
+  MP4_TRACK_INFO track;
+  MP4_SAMPLE sample;
+  INT frames = 0;
+
+  if (hDemux == NULL) return 0;
+  if ((CMp4Demux_SetInput(hDemux, s.data.data(), s.data.size()) ==
+       TRANSPORTDEC_OK) &&
+      (CMp4Demux_GetTrackInfo(hDemux, &track) == TRANSPORTDEC_OK) &&
+      (aacDecoder_ConfigRaw(hDec, &track.pAsc, &track.ascLength) ==
+       AAC_DEC_OK)) {
+    if (track.pLoudness != NULL) {
+      aacDecoder_RawISOBMFFData(hDec, track.pLoudness, track.loudnessLength);
+    }
+    while (CMp4Demux_ReadSample(hDemux, &sample) == TRANSPORTDEC_OK) {
+      UINT valid = sample.size;
+
+      aacDecoder_Fill(hDec, &sample.pData, &sample.size, &valid);
+      if (!IS_OUTPUT_VALID(
+              aacDecoder_DecodeFrame(hDec, pcm, BENCH_MAX_PCM, 0))) {
+        break;
+      }
+      frames++;
+    }
+  }
+  CMp4Demux_Close(&hDemux);
+
+  return frames;
+}
+
+/*
+ * Decode a whole stream, with aacDecoder_Fill() or read in place. MP4 files
+ * are always read in place by the demultiplexer and have no separate in place
+ * pass. Returns the
+ * duration of the pass, or a negative value if the stream cannot be decoded.
+ */
+static double decodePass(const Stream &s, const INT maxOutChannels,
+                         const INT inPlace, StreamProps *pProps) {
+  static INT_PCM pcm[BENCH_MAX_PCM];
+  HANDLE_AACDECODER hDec = aacDecoder_Open(s.tt, 1);
+  size_t pos = 0;
+  INT frames = 0;
+  double seconds;
+
+  if (hDec == NULL) return -1.0;
+  if (maxOutChannels > 0) {
+    aacDecoder_SetParam(hDec, AAC_PCM_MAX_OUTPUT_CHANNELS, maxOutChannels);
+  }
+
+  seconds = now();
+  if (s.tt == TT_MP4_RAW) {
+    frames = inPlace ? 0 : decodeMp4(hDec, s, pcm);
+  } else {
+    if (inPlace) {
+      aacDecoder_SetInputBuffer(hDec, s.data.data(), s.data.size());
+      pos = s.data.size();
+    }
+    for (;;) {
+      AAC_DECODER_ERROR err;
+
+      if (pos < s.data.size()) {
+        UCHAR *pBuf = (UCHAR *)&s.data[pos];
+        UINT size = (UINT)(s.data.size() - pos), valid = size;
+
+        aacDecoder_Fill(hDec, &pBuf, &size, &valid);
+        pos += size - valid;
+      }
+      err = aacDecoder_DecodeFrame(hDec, pcm, BENCH_MAX_PCM, 0);
+      if (err == AAC_DEC_NOT_ENOUGH_BITS) {
+        if (pos < s.data.size()) continue;
+        break;
+      }
+      if (!IS_OUTPUT_VALID(err)) break;
+      frames++;
+    }
+  }
+  seconds = now() - seconds;
+
+  CStreamInfo *pInfo = aacDecoder_GetStreamInfo(hDec);
+  pProps->frames = frames;
+  pProps->aot = pInfo->aot;
+  pProps->coreChannels = pInfo->aacNumChannels;
+  pProps->outChannels = pInfo->numChannels;
+  pProps->coreFrameLength = pInfo->aacSamplesPerFrame;
+  pProps->frameSize = pInfo->frameSize;
+  pProps->sampleRate = pInfo->sampleRate;
+  pProps->flags = pInfo->flags;
+
+  /* stage times measured inside the decoder, needs a FDK_TRACE=1 build */
+  FDK_TRACE_FRAME trace[64];
+  pProps->traceFrames = (INT)aacDecoder_GetTrace(hDec, trace, 64);
+  for (INT i = 0; i < FDK_TRACE_NUM_STAGES; i++) {
+    double sum = 0.0;
+    for (INT f = 0; f < pProps->traceFrames; f++) sum += trace[f].stageNs[i];
+    pProps->traceNs[i] =
+        (pProps->traceFrames > 0) ? sum / pProps->traceFrames : 0.0;
+  }
+  aacDecoder_Close(hDec);
+
+  return (frames > 0) ? seconds : -1.0;
+}
+
+/* Transport stage of an MP4 file: find the samples with the demultiplexer */
+static double demuxPass(const Stream &s, INT *pFrames) {
+  HANDLE_MP4_DEMUX hDemux = CMp4Demux_Open();
+  MP4_SAMPLE sample;
+  INT frames = 0;
+  double seconds;
+
+  if (hDemux == NULL) return -1.0;
+
+  seconds = now();
+  if (CMp4Demux_SetInput(hDemux, s.data.data(), s.data.size()) ==
+      TRANSPORTDEC_OK) {
+    while (CMp4Demux_ReadSample(hDemux, &sample) == TRANSPORTDEC_OK) {
+      frames++;
+    }
+  }
+  seconds = now() - seconds;
+
+  CMp4Demux_Close(&hDemux);
+  *pFrames = frames;
+  return (frames > 0) ? seconds : -1.0;
+}
+
+/*
+ * Transport stage: sync and read every access unit with the transport decoder
+ * of a decoder instance and skip the payload. The instance registers the
+ * configuration callbacks the transport decoder needs.
+ */
+static double transportPass(const Stream &s, INT *pFrames) {
+  HANDLE_AACDECODER hDec;
+  HANDLE_TRANSPORTDEC hTp;
+  size_t pos = 0;
+  INT frames = 0;
+  double seconds;
+
+  if (s.tt == TT_MP4_RAW) return demuxPass(s, pFrames);
+  hDec = aacDecoder_Open(s.tt, 1);
+  if (hDec == NULL) return -1.0;
+  hTp = hDec->hInput;
+
+  seconds = now();
+  for (;;) {
+    TRANSPORTDEC_ERROR err;
+
+    if (pos < s.data.size()) {
+      UCHAR *pBuf = (UCHAR *)&s.data[pos];
+      UINT valid = (UINT)(s.data.size() - pos);
+
+      transportDec_FillData(hTp, pBuf, valid, &valid, 0);
+      pos = s.data.size() - valid;
+    }
+    err = transportDec_ReadAccessUnit(hTp, 0);
+    if (err == TRANSPORTDEC_NOT_ENOUGH_BITS) {
+      if (pos < s.data.size()) continue;
+      break;
+    }
+    if (err != TRANSPORTDEC_OK) break;
+    FDKpushFor(transportDec_GetBitstream(hTp, 0),
+               fMax(0, transportDec_GetAuBitsRemaining(hTp, 0)));
+    transportDec_EndAccessUnit(hTp);
+    frames++;
+  }
+  seconds = now() - seconds;
+
+  aacDecoder_Close(hDec);
+  *pFrames = frames;
+  return (frames > 0) ? seconds : -1.0;
+}
+
+/*
+ * Huffman microbenchmark: decode the codewords of frameLength spectral lines per
+ * channel from random bits, cycling through the spectral codebooks in bands
+ * of 32 lines. Sign and escape bits are not read.
+ */
+static double huffmanPass(const StreamProps &p) {
+  static UCHAR bits[1 << 16];
+  FDK_BITSTREAM bs;
+  UINT sum = 0;
+  double seconds;
+
+  rndState = 2;
+  for (UINT i = 0; i < sizeof(bits); i++) bits[i] = (UCHAR)(rnd() >> 24);
+  FDKinitBitStream(&bs, bits, sizeof(bits), sizeof(bits) * 8);
+
+  seconds = now();
+  for (INT f = 0; f < p.frames; f++) {
+    for (INT ch = 0; ch < p.coreChannels; ch++) {
+      for (INT band = 0; band < p.coreFrameLength / 32; band++) {
+        INT cb = 1 + (band + ch) % 11;
+        const CodeBookDescription *hcb = &AACcodeBookDescriptionTable[cb];
+
+        for (INT line = 0; line < 32; line += hcb->Dimension) {
+          sum += CBlock_DecodeHuffmanWord(&bs, hcb);
+        }
+      }
+    }
+  }
+  seconds = now() - seconds;
+
+  benchSink = sum;
+  return seconds;
+}
+
+/*
+ * IMDCT microbenchmark: one long block with sine window slopes of the core frame
+ * length per channel, including the copy of the spectrum which the IMDCT
+ * overwrites.
+ */
+static double imdctPass(const StreamProps &p) {
+  INT tl = p.coreFrameLength;
+  std::vector<FIXP_DBL> overlap(OverlapBufferSize * p.coreChannels);
+  std::vector<FIXP_DBL> spec(tl * p.coreChannels), work(tl), out(tl);
+  std::vector<mdct_t> mdct(p.coreChannels);
+  const FIXP_WTP *pWindow = FDKgetWindowSlope(tl, 0);
+  SHORT specScale[8] = {};
+  double seconds;
+
+  if (pWindow == NULL) return -1.0;
+  rndState = 3;
+  for (INT ch = 0; ch < p.coreChannels; ch++) {
+    mdct_init(&mdct[ch], &overlap[ch * OverlapBufferSize], OverlapBufferSize);
+  }
+  for (size_t i = 0; i < spec.size(); i++) spec[i] = (FIXP_DBL)(rnd() >> 6);
+
+  seconds = now();
+  for (INT f = 0; f < p.frames; f++) {
+    for (INT ch = 0; ch < p.coreChannels; ch++) {
+      FDKmemcpy(work.data(), &spec[ch * tl], tl * sizeof(FIXP_DBL));
+      imlt_block(&mdct[ch], out.data(), work.data(), specScale, 1, tl, tl,
+                 pWindow, tl, pWindow, tl, (FIXP_DBL)0, 0);
+    }
+  }
+  seconds = now() - seconds;
+
+  return seconds;
+}
+
+/*
+ * SBR microbenchmark: the QMF analysis of the core signal with 32 bands and the QMF
+ * synthesis of the output with 64 bands per channel, the bulk of the SBR
+ * work. ELD uses the complex low delay filter bank.
+ */
+static double sbrQmfPass(const StreamProps &p) {
+  INT cols = p.coreFrameLength / 32;
+  INT flags = (p.aot == AOT_ER_AAC_ELD) ? QMF_FLAG_CLDFB : 0;
+  std::vector<QMF_FILTER_BANK> ana(p.coreChannels), syn(p.coreChannels);
+  std::vector<FIXP_DBL> anaStates(20 * 64 * p.coreChannels);
+  std::vector<FIXP_QSS> synStates(20 * 64 * p.coreChannels);
+  std::vector<LONG> timeIn(p.coreFrameLength), timeOut(2 * p.coreFrameLength);
+  std::vector<FIXP_DBL> re(cols * 64), im(cols * 64);
+  std::vector<FIXP_DBL *> pRe(cols), pIm(cols);
+  alignas(16) FIXP_DBL work[2 * 64];
+  double seconds;
+
+  for (INT ch = 0; ch < p.coreChannels; ch++) {
+    if (qmfInitAnalysisFilterBank(&ana[ch], &anaStates[ch * 20 * 64], cols,
+                                  32, 32, 32, flags) ||
+        qmfInitSynthesisFilterBank(&syn[ch], &synStates[ch * 20 * 64], cols,
+                                   64, 64, 64, flags)) {
+      return -1.0;
+    }
+  }
+  for (INT i = 0; i < cols; i++) {
+    pRe[i] = &re[i * 64];
+    pIm[i] = &im[i * 64];
+  }
+  rndState = 4;
+  for (size_t i = 0; i < timeIn.size(); i++) timeIn[i] = rnd() >> 4;
+
+  seconds = now();
+  for (INT f = 0; f < p.frames; f++) {
+    for (INT ch = 0; ch < p.coreChannels; ch++) {
+      QMF_SCALE_FACTOR scale = {};
+
+      qmfAnalysisFiltering(&ana[ch], pRe.data(), pIm.data(), &scale,
+                           timeIn.data(), 0, 1, work);
+      scale.ov_lb_scale = scale.lb_scale;
+      scale.hb_scale = scale.lb_scale;
+      qmfSynthesisFiltering(&syn[ch], pRe.data(), pIm.data(), &scale, 0,
+                            timeOut.data(), 1, work);
+    }
+  }
+  seconds = now() - seconds;
+
+  return seconds;
+}
+
+/* Limiter microbenchmark: pcmLimiter_Apply() on random samples which need
+ * limiting */
+static double limiterPass(const StreamProps &p) {
+  TDLimiterPtr hLimiter =
+      pcmLimiter_Create(TDL_ATTACK_DEFAULT_MS, TDL_RELEASE_DEFAULT_MS,
+                        (FIXP_DBL)MAXVAL_DBL, p.outChannels, p.sampleRate);
+  std::vector<PCM_LIM> in((size_t)p.frameSize * p.outChannels);
+  std::vector<INT_PCM> out(in.size());
+  double seconds;
+
+  if (hLimiter == NULL) return -1.0;
+  rndState = 5;
+  for (size_t i = 0; i < in.size(); i++) in[i] = rnd();
+
+  seconds = now();
+  for (INT f = 0; f < p.frames; f++) {
+    pcmLimiter_Apply(hLimiter, in.data(), out.data(), NULL, 1, p.frameSize);
+  }
+  seconds = now() - seconds;
+
+  pcmLimiter_Destroy(hLimiter);
+  return seconds;
+}
+
+template <class F>
+static double best(F pass) {
+  double t = -1.0;
+
+  for (INT r = 0; r < numRepeats; r++) {
+    double s = pass();
+    if (s < 0.0) return s;
+    t = (t < 0.0) ? s : std::min(t, s);
+  }
+  return t;
+}
+
+/* Stage time per frame, with the share of the decoder time if total > 0 */
+static void printStage(const char *stage, const StreamProps &p,
+                       const double seconds, const double total) {
+  if (seconds < 0.0) {
+    printf("       %-10s %10s\n", stage, "-");
+    return;
+  }
+  if (total > 0.0) {
+    printf("       %-10s %10.0f ns/frame %5.1f%%\n", stage,
+           seconds * 1e9 / p.frames, 100.0 * seconds / total);
+  } else {
+    printf("       %-10s %10.0f ns/frame\n", stage, seconds * 1e9 / p.frames);
+  }
+}
+
+/* Decoder and per stage numbers of one stream */
+static void benchDecoder(const Stream &s) {
+  StreamProps p, mono, inPlace;
+  double total, t;
+  INT tpFrames = 0;
+
+  total = best([&] { return decodePass(s, 0, 0, &p); });
+  if (total < 0.0) {
+    printf("dec  %-24s cannot be decoded\n", s.name.c_str());
+    return;
+  }
+  printResult("dec", s.name.c_str(), "", p.frames, total,
+              (double)p.frames * p.frameSize / p.sampleRate);
+
+  /* same stream read in place with aacDecoder_SetInputBuffer() */
+  t = best([&] { return decodePass(s, 0, 1, &inPlace); });
+  if ((t >= 0.0) && (inPlace.frames == p.frames)) {
+    printResult("dec", s.name.c_str(), "zcopy", p.frames, t,
+                (double)p.frames * p.frameSize / p.sampleRate);
+  }
+
+  t = best([&] { return transportPass(s, &tpFrames); });
+  printStage("transport", p, (tpFrames == p.frames) ? t : -1.0, total);
+
+  /* PS: difference to the mono output, which skips the PS processing */
+  t = -1.0;
+  if ((p.flags & AC_PS_PRESENT) && (p.coreChannels == 1) &&
+      (p.outChannels == 2)) {
+    double m = best([&] { return decodePass(s, 1, 0, &mono); });
+    if ((m >= 0.0) && (mono.frames == p.frames)) t = std::max(0.0, total - m);
+  }
+  printStage("ps", p, t, total);
+
+  /* isolated kernels on synthetic input, no share of the decoder time */
+  printf("       microbenchmarks, synthetic input:\n");
+  printStage("huffman", p,
+             (p.flags & AC_USAC) ? -1.0 : best([&] { return huffmanPass(p); }),
+             0.0);
+  printStage("imdct", p, best([&] { return imdctPass(p); }), 0.0);
+  printStage("sbr (qmf)", p,
+             (p.flags & AC_SBR_PRESENT) ? best([&] { return sbrQmfPass(p); })
+                                        : -1.0,
+             0.0);
+  printStage("limiter", p, best([&] { return limiterPass(p); }), 0.0);
+
+  if (p.traceFrames > 0) {
+    static const char *traceStages[FDK_TRACE_NUM_STAGES] = {
+        "transport", "read", "decode", "render", "sbr",
+        "mps",       "drc",  "limiter", "psy",   "qc"};
+    double frameNs = total * 1e9 / p.frames;
+
+    printf("       traced stages, last %d frames:\n", p.traceFrames);
+    for (INT i = 0; i < FDK_TRACE_NUM_STAGES; i++) {
+      if (p.traceNs[i] == 0.0) continue;
+      printf("       %-10s %10.0f ns/frame %5.1f%%\n", traceStages[i],
+             p.traceNs[i], 100.0 * p.traceNs[i] / frameNs);
+    }
+  }
+}
+
+static const char *bitrateModeName(const INT mode) {
+  static const char *names[] = {"CBR", "VBR1", "VBR2", "VBR3", "VBR4",
+                                "VBR5"};
+  return names[mode];
+}
+
+static TRANSPORT_TYPE corpusTransport(const std::filesystem::path &path) {
+  std::string ext = path.extension().string();
+
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  if (ext == ".aac" || ext == ".adts") return TT_MP4_ADTS;
+  if (ext == ".loas" || ext == ".latm") return TT_MP4_LOAS;
+  if (ext == ".m4a" || ext == ".mp4") return TT_MP4_RAW;
+  return TT_UNKNOWN;
+}
+
+static void benchCorpus(const char *dir) {
+  std::vector<std::filesystem::path> files;
+  std::error_code ec;
+
+  for (const auto &entry : std::filesystem::directory_iterator(dir, ec)) {
+    if (entry.is_regular_file() &&
+        corpusTransport(entry.path()) != TT_UNKNOWN) {
+      files.push_back(entry.path());
+    }
+  }
+  if (ec) {
+    fprintf(stderr, "cannot read corpus directory %s\n", dir);
+    return;
+  }
+  std::sort(files.begin(), files.end());
+
+  printf("\ncorpus %s: %d files\n", dir, (INT)files.size());
+  for (const auto &path : files) {
+    Stream s;
+    FILE *f = fopen(path.string().c_str(), "rb");
+
+    if (f == NULL) continue;
+    s.name = path.filename().string();
+    s.tt = corpusTransport(path);
+    fseek(f, 0, SEEK_END);
+    s.data.resize((size_t)std::max(0L, ftell(f)));
+    fseek(f, 0, SEEK_SET);
+    if (fread(s.data.data(), 1, s.data.size(), f) == s.data.size()) {
+      benchDecoder(s);
+    }
+    fclose(f);
+  }
+}
+
+int main(int argc, char **argv) {
+  const char *corpus = NULL;
+  INT cpuFeatures;
+
+  FDKinitKernels();
+  cpuFeatures = FDKgetCpuFeatures();
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      numFrames = std::max(1, atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+      numRepeats = std::max(1, atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "-k") && i + 1 < argc) {
+      cpuFeatures &= (INT)strtol(argv[++i], NULL, 0);
+      FDKselectKernels(cpuFeatures);
+    } else if (argv[i][0] != '-' && corpus == NULL) {
+      corpus = argv[i];
+    } else {
+      fprintf(stderr,
+              "usage: %s [-n frames] [-r repeats] [-k cpu features] "
+              "[corpus dir]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+
+  printf("fdk_aac_bench: %d frames, best of %d, cpu features 0x%x\n",
+         numFrames, numRepeats, cpuFeatures);
+
+  /* enough input for numFrames of the longest (dual rate SBR) frames */
+  std::vector<INT_PCM> pcm = makeSignal(numFrames * 2048);
+  std::vector<Stream> streams;
+
+  printf("\n");
+  for (const EncConfig &c : encConfigs) {
+    for (INT mode = 0; mode <= 5; mode++) {
+      Stream s;
+      INT frames = 0, frameLength = 0;
+      double t = best([&] {
+        return encodePass(c, mode, pcm, &s, &frames, &frameLength);
+      });
+
+      if (t < 0.0) {
+        printf("enc  %-24s %-5s not supported\n", c.name,
+               bitrateModeName(mode));
+        continue;
+      }
+      printResult("enc", c.name, bitrateModeName(mode), frames, t,
+                  (double)frames * frameLength / BENCH_SAMPLE_RATE);
+      if (mode == 0) {
+        s.name = c.name;
+        streams.push_back(s);
+      }
+    }
+  }
+
+  printf("\n");
+  for (const Stream &s : streams) benchDecoder(s);
+
+  if (corpus != NULL) benchCorpus(corpus);
+
+  return 0;
+}
@@ -4,6 +4,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include "fdk_log.h"
+#include "PCMRingBufferFDK.h"
 #include "libAACdec/aacdecoder_lib.h"
 
 #define FDK_OUT_BUFFER_DEFAULT_SIZE 1024*4
@@ -62,6 +63,18 @@ class AACDecoderFDK  {
 		}
 
 #endif
+
+		/**
+		 * @brief Defines a caller owned ring buffer as output: the frames are decoded
+		 * directly into the reserved slots, so no internal output buffer is needed and
+		 * the callbacks are not called. Decoding stops while the ring buffer is full.
+		 * 
+		 * @param ring 
+		 */
+		void setOutput(PCMRingBufferFDK &ring){
+			this->ring = &ring;
+		}
+
         virtual ~AACDecoderFDK(){
             end();
         }
@@ -107,9 +120,73 @@ class AACDecoderFDK  {
 			decoder_flags = flags;
 		}
 
+		/**
+		 * @brief Activates the frame synchronous decoding: the whole input of a write
+		 * is filled with one aacDecoder_Fill and then all complete access units are
+		 * decoded. If not active (default) the input is fed in chunks of 256 bytes.
+		 * 
+		 * @param active 
+		 */
+		void setFrameSync(bool active){
+			frame_sync = active;
+		}
+
+		/**
+		 * @brief Defines the sample format of the output: PCM_FMT_INT24 provides 24 bit
+		 * samples in 32 bit words and PCM_FMT_FLOAT 32 bit float samples, the pcm
+		 * pointers of the callback and of readFrame() are then cast pointers to INT or
+		 * float samples. The sizes stay in samples. A ring buffer output needs
+		 * PCM_FMT_INT16 (default): call before begin()
+		 * 
+		 * @param format 
+		 */
+		void setOutputFormat(PCM_FORMAT format){
+			if (is_open){
+				LOG_FDK(FDKError,"setOutputFormat must be called before begin()");
+				return;
+			}
+			output_format = format;
+		}
+
+		/**
+		 * @brief Defines the allocator (e.g. of a FDK_ARENA) which is used for all
+		 * memory of this decoder instance: call before begin()
+		 * 
+		 * @param allocator nullptr for the system heap
+		 */
+		void setAllocator(const FDK_ALLOCATOR *allocator){
+			this->allocator = allocator;
+		}
+
+		/**
+		 * @brief Shares the work buffers with all other decoders which are using
+		 * the same FDK_SHARED_SCRATCH. All these decoders must be used by the same
+		 * thread: call before begin()
+		 * 
+		 * @param scratch nullptr for private work buffers
+		 */
+		void setSharedScratch(FDK_SHARED_SCRATCH *scratch){
+			this->shared_scratch = scratch;
+		}
+
+		/**
+		 * @brief Renders the channel elements of multichannel streams in parallel
+		 * (see FDKworkerPoolOpen()). Not used together with a shared scratch.
+		 * 
+		 * @param pool nullptr to decode in the calling thread only
+		 */
+		void setWorkerPool(HANDLE_FDK_WORKER_POOL pool){
+			this->worker_pool = pool;
+			if (aacDecoderInfo != nullptr){
+				aacDecoder_SetWorkerPool(aacDecoderInfo, pool);
+			}
+		}
+
         // opens the decoder
         bool begin(TRANSPORT_TYPE transportType=TT_UNKNOWN, UINT nrOfLayers=1){
 			LOG_FDK(FDKDebug,__FUNCTION__);
+			FDK_ALLOCATOR_SCOPE scope(allocator);
+			FDK_SHARED_SCRATCH_SCOPE scratch_scope(shared_scratch);
 
 			// call aacDecoder_Open only once
 			if (aacDecoderInfo == nullptr){ 
@@ -122,10 +199,20 @@ class AACDecoderFDK  {
 				}
 			}
 
-			// allocate buffer only once
-			if (output_buffer == nullptr){
+			// the slots of the ring buffer hold INT_PCM samples
+			if (ring != nullptr && output_format != PCM_FMT_INT16){
+				LOG_FDK(FDKError,"ring buffer output needs PCM_FMT_INT16");
+				return false;
+			}
+			if (aacDecoder_SetParam(aacDecoderInfo, AAC_PCM_OUTPUT_FORMAT, output_format) != AAC_DEC_OK){
+				LOG_FDK(FDKError,"Unsupported output format: %d", output_format);
+				return false;
+			}
+
+			// allocate buffer only once: not needed if we decode into a ring buffer
+			if (output_buffer == nullptr && ring == nullptr){
 				LOG_FDK(FDKDebug,__FUNCTION__);
-				output_buffer = (INT_PCM*) FDKcalloc(output_buffer_size, sizeof(INT_PCM));
+				output_buffer = (INT_PCM*) FDKcalloc(output_buffer_size, sampleSize());
 				assert(output_buffer != nullptr);
 				if (output_buffer == nullptr){
 					LOG_FDK(FDKError,"aacDecoder_Open -> Error");
@@ -135,6 +222,7 @@ class AACDecoderFDK  {
 
 			// if we decode 1 channel aac files we return output to 2 channels
 			aacDecoder_SetParam(aacDecoderInfo, AAC_PCM_MIN_OUTPUT_CHANNELS, 2);
+			aacDecoder_SetWorkerPool(aacDecoderInfo, worker_pool);
 			is_open = true;
             return true;
         }
@@ -154,6 +242,9 @@ class AACDecoderFDK  {
       	virtual size_t write(const void *in_ptr, size_t in_size) {
 			if (aacDecoderInfo==nullptr) return 0;
 			LOG_FDK(FDKDebug,"write %zu bytes", in_size);
+			if (frame_sync){
+				return decodeFrames(in_ptr, in_size);
+			}
 			uint8_t *byte_ptr = (uint8_t *)in_ptr;
 			size_t open = in_size;
 			int pos = 0;
@@ -161,12 +252,131 @@ class AACDecoderFDK  {
 				// a frame is between 1 and 768 bytes => so we feed the decoder with small chunks
 				size_t len = std::min<int>(open, 256);
 				int decoded = decode(byte_ptr+pos, len);
+				// the decoder can not take any more data (e.g. ring buffer is full)
+				if (decoded==0) break;
 				pos+=decoded;
 				open-=decoded;
 			}
             return pos;
         }
 
+		/// decodes a complete stream which stays in memory (e.g. a const array or a memory mapped file) without copying it into the decoder:
+		/// the memory must stay valid until decodeBuffered() returns no more frames
+		virtual size_t decodeInPlace(const void *in_ptr, size_t in_size) {
+			if (aacDecoderInfo==nullptr) return 0;
+			LOG_FDK(FDKDebug,"decodeInPlace %zu bytes", in_size);
+			AAC_DECODER_ERROR error = aacDecoder_SetInputBuffer(aacDecoderInfo, (const UCHAR *)in_ptr, in_size);
+			if (error != AAC_DEC_OK){
+				LOG_FDK(FDKError,"aacDecoder_SetInputBuffer error: 0x%x",error);
+				return 0;
+			}
+			decodeBuffered();
+			return in_size;
+		}
+
+		/**
+		 * @brief Decodes the complete frames which are still buffered in the decoder
+		 * (e.g. after the ring buffer was full) without providing any new input.
+		 * 
+		 * @return number of decoded frames
+		 */
+		int decodeBuffered() {
+			if (aacDecoderInfo==nullptr) return 0;
+			int frames = 0;
+			AAC_DECODER_ERROR error = decodeFrame();
+			// decode errors still provide concealed output
+			while (IS_OUTPUT_VALID(error)) {
+				frames++;
+				error = decodeFrame();
+			}
+			if (isError(error)){
+				LOG_FDK(FDKError,"Decoding error: 0x%x",error);
+			}
+			return frames;
+		}
+
+		/**
+		 * @brief Pull mode: provides AAC data to the decoder without decoding it.
+		 * Use needBytes() to determine how much data should be provided and
+		 * available() / readFrame() to get the decoded frames.
+		 * 
+		 * @return number of bytes which were accepted
+		 */
+		size_t fill(const void *in_ptr, size_t in_size) {
+			if (aacDecoderInfo==nullptr) return 0;
+			UCHAR *start = (UCHAR *)in_ptr;
+			UINT inSize = in_size;
+			UINT bytesValid = in_size;
+			LOG_FDK(FDKDebug,"aacDecoder_Fill %u bytes", inSize);
+			AAC_DECODER_ERROR error = aacDecoder_Fill(aacDecoderInfo, &start, &inSize, &bytesValid);
+			if (error != AAC_DEC_OK){
+				LOG_FDK(FDKError,"aacDecoder_Fill error: 0x%x",error);
+			}
+			if (bytesValid < inSize){
+				is_starved = false;
+			}
+			return inSize - bytesValid;
+		}
+
+		/**
+		 * @brief Pull mode: number of bytes which should be provided with fill():
+		 * 0 while decoded samples are pending, otherwise the free space of the
+		 * input buffer of the decoder. Does not decode.
+		 */
+		size_t needBytes() {
+			if (aacDecoderInfo==nullptr || pending_samples > 0) return 0;
+			UINT free_bytes = 0;
+			aacDecoder_GetFreeBytes(aacDecoderInfo, &free_bytes);
+			return free_bytes;
+		}
+
+		/**
+		 * @brief Pull mode: number of samples (over all channels) which can be read
+		 * with readFrame(). If no samples are pending, the next frame is decoded
+		 * from the buffered input into the internal output buffer. After the input
+		 * ran out no decoding is attempted again before new data was provided with
+		 * fill(). Not available
+		 * together with a ring buffer output.
+		 */
+		size_t available() {
+			if (aacDecoderInfo==nullptr || output_buffer==nullptr) return 0;
+			if (pending_samples > 0 || is_starved) return pending_samples;
+			UINT valid_bytes = 0;
+			aacDecoder_GetValidBytes(aacDecoderInfo, &valid_bytes);
+			if (valid_bytes == 0){
+				is_starved = true;
+				return 0;
+			}
+			pending_samples = pullFrame(output_buffer, output_buffer_size);
+			pending_pos = 0;
+			return pending_samples;
+		}
+
+		/**
+		 * @brief Pull mode: provides the samples (over all channels) of the next
+		 * frame. If the frame does not fit, the remaining samples are returned by
+		 * the following calls. A complete frame is decoded directly into pcm if
+		 * max is at least the output buffer size.
+		 * 
+		 * @param pcm caller owned buffer
+		 * @param max max number of samples
+		 * @return number of samples: 0 if more input is needed
+		 */
+		size_t readFrame(INT_PCM *pcm, size_t max) {
+			if (aacDecoderInfo==nullptr || output_buffer==nullptr) return 0;
+			if (pending_samples == 0 && !is_starved && max >= (size_t)output_buffer_size){
+				return pullFrame(pcm, max);
+			}
+			size_t len = available();
+			if (len > max) len = max;
+			if (len > 0){
+				memcpy(pcm, (uint8_t*)output_buffer + pending_pos * sampleSize(), len * sampleSize());
+				pending_pos += len;
+				pending_samples -= len;
+			}
+			return len;
+		}
+
         // provides detailed information about the stream
         CStreamInfo audioInfo(){
             return *aacDecoder_GetStreamInfo(aacDecoderInfo);
@@ -183,6 +393,9 @@ class AACDecoderFDK  {
                 FDKfree(output_buffer);
                 output_buffer = nullptr;
             }
+			pending_samples = 0;
+			pending_pos = 0;
+			is_starved = false;
 			is_open = false;
         }
 
@@ -201,6 +414,16 @@ class AACDecoderFDK  {
         AACDataCallbackFDK pwmCallback = nullptr;
         AACInfoCallbackFDK infoCallback = nullptr;
 		int decoder_flags = AACDEC_INTR;
+		bool frame_sync = false;
+		PCMRingBufferFDK *ring = nullptr;
+		bool is_ring_full = false;
+		size_t pending_samples = 0;
+		size_t pending_pos = 0;
+		bool is_starved = false;
+		const FDK_ALLOCATOR *allocator = nullptr;
+		FDK_SHARED_SCRATCH *shared_scratch = nullptr;
+		HANDLE_FDK_WORKER_POOL worker_pool = nullptr;
+		PCM_FORMAT output_format = PCM_FMT_INT16;
 
 #ifdef ARDUINO
         Print *out = nullptr;
@@ -219,14 +442,9 @@ class AACDecoderFDK  {
 				LOG_FDK(FDKDebug,"aacDecoder_Fill %u bytes", inSize);
 				error = aacDecoder_Fill(aacDecoderInfo, (UCHAR **)&start, &inSize, &bytesValid); 
 				while (error == AAC_DEC_OK) {
-					LOG_FDK(FDKDebug,"aacDecoder_DecodeFrame");
-					error = aacDecoder_DecodeFrame(aacDecoderInfo, output_buffer, output_buffer_size, decoder_flags); 
-					// write pcm to output stream
-					if (error == AAC_DEC_OK){
-						LOG_FDK(FDKDebug,"provideResult %d", output_buffer_size);
-						provideResult(output_buffer, output_buffer_size);
-					} else {
-						if (error != AAC_DEC_NOT_ENOUGH_BITS){
+					error = decodeFrame();
+					if (error != AAC_DEC_OK){
+						if (isError(error)){
 							LOG_FDK(FDKError,"Decoding error: 0x%x",error);
 						}
 					}
@@ -236,6 +454,92 @@ class AACDecoderFDK  {
             return result;
         }
 
+		/// fills the complete input in one step and decodes all available frames
+		virtual size_t decodeFrames(const void *in_ptr, size_t in_size) {
+			LOG_FDK(FDKDebug,"decodeFrames %zu bytes", in_size);
+			UCHAR *start = (UCHAR *)in_ptr;
+			UINT inSize = in_size;
+			UINT bytesValid = in_size;
+
+			while (bytesValid > 0) {
+				UINT before = bytesValid;
+				LOG_FDK(FDKDebug,"aacDecoder_Fill %u bytes", bytesValid);
+				AAC_DECODER_ERROR error = aacDecoder_Fill(aacDecoderInfo, &start, &inSize, &bytesValid);
+				if (error != AAC_DEC_OK){
+					LOG_FDK(FDKError,"aacDecoder_Fill error: 0x%x",error);
+					break;
+				}
+				// drain all complete access units
+				int frames = decodeBuffered();
+				// internal buffer is full and nothing could be decoded
+				if (bytesValid == before && frames == 0){
+					break;
+				}
+			}
+			return inSize - bytesValid;
+		}
+
+		/// decodes one frame into the output buffer or directly into the next ring buffer slot
+		AAC_DECODER_ERROR decodeFrame() {
+			INT_PCM *buffer = output_buffer;
+			size_t size = output_buffer_size;
+			if (ring != nullptr){
+				buffer = ring->reserve();
+				size = ring->slotSize();
+				is_ring_full = buffer == nullptr;
+				if (is_ring_full){
+					LOG_FDK(FDKDebug,"ring buffer is full");
+					return AAC_DEC_OUTPUT_BUFFER_TOO_SMALL;
+				}
+			}
+			LOG_FDK(FDKDebug,"aacDecoder_DecodeFrame");
+			AAC_DECODER_ERROR error = aacDecoder_DecodeFrame(aacDecoderInfo, buffer, size, decoder_flags);
+			if (IS_OUTPUT_VALID(error)){
+				if (ring != nullptr){
+					ring->commit(decodedSamples(size));
+				} else {
+					provideResult(buffer, decodedSamples(size));
+				}
+			}
+			return error;
+		}
+
+		/// pull mode: decodes one frame from the buffered input and returns the number of samples
+		size_t pullFrame(INT_PCM *buffer, size_t size) {
+			AAC_DECODER_ERROR error;
+			// resynchronize after a transport sync error
+			do {
+				LOG_FDK(FDKDebug,"aacDecoder_DecodeFrame");
+				error = aacDecoder_DecodeFrame(aacDecoderInfo, buffer, size, decoder_flags);
+				if (IS_OUTPUT_VALID(error)){
+					return decodedSamples(size);
+				}
+				LOG_FDK(isError(error) ? FDKError : FDKDebug,"Decoding error: 0x%x",error);
+			} while (error == AAC_DEC_TRANSPORT_SYNC_ERROR);
+			// only wait for fill() if the input ran out: other errors are retried
+			is_starved = error == AAC_DEC_NOT_ENOUGH_BITS;
+			return 0;
+		}
+
+		/// we do not report missing input data or a full ring buffer as error
+		bool isError(AAC_DECODER_ERROR error) {
+			if (error == AAC_DEC_NOT_ENOUGH_BITS) return false;
+			if (is_ring_full) return false;
+			return true;
+		}
+
+		/// size of one output sample in bytes
+		size_t sampleSize() {
+			return output_format == PCM_FMT_INT16 ? sizeof(INT_PCM) : 4;
+		}
+
+		/// number of samples (over all channels) of the last decoded frame
+		size_t decodedSamples(size_t max) {
+			CStreamInfo *info = aacDecoder_GetStreamInfo(aacDecoderInfo);
+			if (info == nullptr) return 0;
+			size_t len = info->frameSize * info->numChannels;
+			return len < max ? len : max;
+		}
 
         /// return the result PWM data
         void provideResult(INT_PCM *data, size_t len){
@@ -252,7 +556,7 @@ class AACDecoderFDK  {
                         infoCallback(info);
                     }
 #ifdef ARDUINO
-                    out->write((uint8_t*) data, len*sizeof(INT_PCM));
+                    out->write((uint8_t*) data, len*sampleSize());
 #endif
                 }
                 aacFrameInfo = info;
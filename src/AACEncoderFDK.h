@@ -58,6 +58,11 @@ public:
 		this->aacCallback = cb;
 	}
 
+	/// Input of 32 bit float samples instead of integers (integers must have 16, 24 or 32 bits_per_sample, 24 bits_per_sample are passed in 32 bit words)
+	void setFloatInput(bool active){
+		this->float_input = active;
+	}
+
 	/** 
 	 * @brief Total encoder bitrate. This parameter is	
 				mandatory and interacts with ::AACENC_BITRATEMODE.
@@ -158,6 +163,32 @@ public:
 	}
 
 
+	/**
+	 * @brief Defines the allocator (e.g. of a FDK_ARENA) which is used for all
+	 * memory of this encoder instance: call before begin()
+	 * 
+	 * @param allocator nullptr for the system heap
+	 */
+	void setAllocator(const FDK_ALLOCATOR *allocator){
+		this->allocator = allocator;
+	}
+
+	/**
+	 * @brief Processes the psychoacoustic model of the channel elements of
+	 * multichannel audio in parallel (see FDKworkerPoolOpen())
+	 * 
+	 * @param pool nullptr to encode in the calling thread only
+	 */
+	void setWorkerPool(HANDLE_FDK_WORKER_POOL pool){
+		this->worker_pool = pool;
+		if (active){
+			FDK_ALLOCATOR_SCOPE scope(allocator);
+			if (aacEncSetWorkerPool(handle, pool) != AACENC_OK) {
+				LOG_FDK(FDKError,"Unable to set the worker pool\n");
+			}
+		}
+	}
+
 	/**
 	 * @brief Defines/Updates the Audio Info 
 	 * @param from 
@@ -211,9 +242,22 @@ public:
 	/// write PCM data to be converted to AAC - The size is in bytes
 	int32_t write(uint8_t *in_ptr, int in_size){
 		LOG_FDK(FDKDebug,"write %d bytes", in_size);
-		in_elem_size = this->bits_per_sample <= 16 ? 2 : 4;
+		if (float_input){
+			in_elem_size = 4;
+			in_identifier = IN_AUDIO_DATA_FLOAT;
+		} else if (this->bits_per_sample == 24){
+			in_elem_size = 4;
+			in_identifier = IN_AUDIO_DATA_INT24;
+		} else if (this->bits_per_sample == 32){
+			// IN_AUDIO_DATA with 4 byte elements is read as full scale 32 bit integers
+			in_elem_size = 4;
+			in_identifier = IN_AUDIO_DATA;
+		} else {
+			in_elem_size = 2;
+			in_identifier = IN_AUDIO_DATA;
+		}
 
-		in_args.numInSamples = in_size <= 0 ? -1 : in_size / 2;
+		in_args.numInSamples = in_size <= 0 ? -1 : in_size / in_elem_size;
 		in_buf.numBufs = 1;
 		in_buf.bufs = (void**) &in_ptr;
 		in_buf.bufferIdentifiers = &in_identifier;
@@ -273,7 +317,7 @@ protected:
 	int vbr = 1; // variable bitrate mode
 	int bitrate = 0; // automatic determination
 	int ch = 0;
-	int format, sample_rate, channels=2, bits_per_sample;
+	int format, sample_rate, channels=2, bits_per_sample=16;
 	int aot = 2;
 	bool afterburner = false;
 	int eld_sbr = 0;
@@ -285,6 +329,7 @@ protected:
 	AACENC_InArgs in_args = { 0 };
 	AACENC_OutArgs out_args = { 0 };
 	int in_identifier = IN_AUDIO_DATA;
+	bool float_input = false;
 	int in_elem_size;
 	int out_identifier = OUT_BITSTREAM_DATA;
 	int out_elem_size=1;
@@ -297,6 +342,8 @@ protected:
 	UINT openEncModules = 0; 
 	int openChannels = 0;
 	int sce=0, cpe=0; // for bitrate determination
+	const FDK_ALLOCATOR *allocator = nullptr;
+	HANDLE_FDK_WORKER_POOL worker_pool = nullptr;
 
 #ifdef ARDUINO
 	Print *out;
@@ -306,6 +353,7 @@ protected:
 	bool setup() {
 		LOG_FDK(FDKDebug,__FUNCTION__);
 		AACENC_ERROR rc = AACENC_OK;
+		FDK_ALLOCATOR_SCOPE scope(allocator);
 
 		// determine mode
 		switch (channels) {
@@ -320,6 +368,12 @@ protected:
 			return false;
 		}
 
+		// integer input must be 16, 24 (in 32 bit words) or 32 bits
+		if (!float_input && bits_per_sample != 16 && bits_per_sample != 24 && bits_per_sample != 32){
+			LOG_FDK(FDKError,"Unsupported bits_per_sample: %d\n", bits_per_sample);
+			return false;
+		}
+
 		// reopen encoder if modules or channels have changed
 		if (active && (channels>openChannels || openEncModules!=encModules)){
 			LOG_FDK(FDKWarning,"Basic Info has changed: we reopen the encoder\n");
@@ -343,6 +397,11 @@ protected:
 			openChannels = channels;
 			openEncModules = encModules;
 
+			if (worker_pool != nullptr && aacEncSetWorkerPool(handle, worker_pool) != AACENC_OK) {
+				LOG_FDK(FDKError,"Unable to set the worker pool\n");
+				return false;
+			}
+
 			if (updateParams()<0) {
 				LOG_FDK(FDKError,"Unable to update parameters\n");
 				return false;
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "fdk_log.h"
+#include "libSYS/machine_type.h"
+
+#if defined(__has_include)
+#  if !__has_include(<atomic>)
+#    error "PCMRingBufferFDK needs <atomic>"
+#  endif
+#endif
+#include <atomic>
+
+namespace aac_fdk {
+
+/**
+ * @brief Lock free single producer / single consumer ring buffer of PCM frames
+ * which is using memory that is owned by the caller: the PCM data and the
+ * number of samples of each slot. The decoder reserves a slot,
+ * decodes directly into it and commits the number of samples. The consumer
+ * (e.g. an I2S task) reads the slot and releases it after use, so that the PCM
+ * data is written and read only once.
+ *
+ */
+class PCMRingBufferFDK {
+    public:
+        /**
+         * @brief Construct a new PCMRingBufferFDK object
+         *
+         * @param memory caller owned buffer with slotSamples*slotCount samples
+         * @param lengths caller owned array of slotCount entries for the number of samples of each slot
+         * @param slotSamples max number of samples (over all channels) of one frame
+         * @param slotCount number of frames which can be buffered
+         */
+        PCMRingBufferFDK(INT_PCM *memory, size_t *lengths, size_t slotSamples, size_t slotCount){
+            LOG_FDK(FDKDebug,__FUNCTION__);
+            this->memory = memory;
+            this->lengths = lengths;
+            this->slot_samples = slotSamples;
+            this->slot_count = slotCount;
+        }
+
+        PCMRingBufferFDK(const PCMRingBufferFDK&) = delete;
+        PCMRingBufferFDK& operator=(const PCMRingBufferFDK&) = delete;
+
+        /// Producer: provides the next free slot or nullptr if the buffer is full
+        INT_PCM* reserve() {
+            size_t head = load(write_count);
+            if (head - load(read_count) >= slot_count) return nullptr;
+            return slot(head);
+        }
+
+        /// Producer: publishes the reserved slot with the indicated number of samples
+        void commit(size_t samples) {
+            size_t head = load(write_count);
+            lengths[head % slot_count] = samples < slot_samples ? samples : slot_samples;
+            store(write_count, head + 1);
+        }
+
+        /// Consumer: provides the oldest frame and its number of samples or nullptr if empty
+        INT_PCM* peek(size_t &samples) {
+            size_t tail = load(read_count);
+            if (tail == load(write_count)) {
+                samples = 0;
+                return nullptr;
+            }
+            samples = lengths[tail % slot_count];
+            return slot(tail);
+        }
+
+        /// Consumer: marks the frame provided by peek() as processed
+        void release() {
+            size_t tail = load(read_count);
+            if (tail != load(write_count)) {
+                store(read_count, tail + 1);
+            }
+        }
+
+        /// number of frames which are ready to be consumed
+        size_t available() {
+            return load(write_count) - load(read_count);
+        }
+
+        /// number of free slots
+        size_t availableForWrite() {
+            return slot_count - available();
+        }
+
+        /// max number of samples of a slot
+        size_t slotSize() {
+            return slot_samples;
+        }
+
+        /// removes all frames: only call when producer and consumer are idle
+        void reset() {
+            store(read_count, 0);
+            store(write_count, 0);
+        }
+
+    protected:
+        INT_PCM *memory = nullptr;
+        size_t *lengths = nullptr;
+        size_t slot_samples = 0;
+        size_t slot_count = 0;
+        std::atomic<size_t> write_count{0};
+        std::atomic<size_t> read_count{0};
+
+        static size_t load(std::atomic<size_t> &value) {
+            return value.load(std::memory_order_acquire);
+        }
+
+        static void store(std::atomic<size_t> &value, size_t newValue) {
+            value.store(newValue, std::memory_order_release);
+        }
+
+        INT_PCM* slot(size_t count) {
+            return memory + (count % slot_count) * slot_samples;
+        }
+};
+
+}
@@ -177,6 +177,9 @@ amm-info@iis.fraunhofer.de
 #include "libAACdec/conceal.h"
 
 #include "libFDK/FDK_crc.h"
+
+#include "libPCMutils/pcm_utils.h"
+
 #define PS_IS_EXPLICITLY_DISABLED(aot, flags) \
   (((aot) == AOT_DRM_AAC) && !(flags & AC_PS_PRESENT))
 
@@ -556,10 +559,44 @@ static int CProgramConfigElement_Read(HANDLE_FDK_BITSTREAM bs,
   return pceStatus;
 }
 
+/* Sample i of an output buffer of the given format as FIXP_DBL */
+static FIXP_DBL pcmLoadDbl(const void *pTimeData, const PCM_FORMAT format,
+                           const INT i) {
+  switch (format) {
+    case PCM_FMT_INT24:
+      return (FIXP_DBL)(((const LONG *)pTimeData)[i] << 8);
+    case PCM_FMT_FLOAT: {
+      float t = ((const float *)pTimeData)[i] * 2147483648.0f;
+      t = (t > -2147483648.0f) ? t : -2147483648.0f;
+      t = (t < 2147483520.0f) ? t : 2147483520.0f;
+      return (FIXP_DBL)t;
+    }
+    default:
+      return FX_PCM2FX_DBL(((const INT_PCM *)pTimeData)[i]);
+  }
+}
+
+/* Store x as sample i of an output buffer of the given format */
+static void pcmStoreDbl(void *pTimeData, const PCM_FORMAT format, const INT i,
+                        const FIXP_DBL x) {
+  switch (format) {
+    case PCM_FMT_INT24:
+      ((LONG *)pTimeData)[i] = (LONG)(x >> 8);
+      break;
+    case PCM_FMT_FLOAT:
+      ((float *)pTimeData)[i] = (float)x * FDK_pow2f(-(DFRACT_BITS - 1));
+      break;
+    default:
+      ((INT_PCM *)pTimeData)[i] = (INT_PCM)(FIXP_PCM)FX_DBL2FX_PCM(x);
+      break;
+  }
+}
+
 /*!
   \brief Prepares crossfade for USAC DASH IPF config change
 
   \pTimeData             Pointer to time data
+  \format                Sample format of the time data
   \pTimeDataFlush        Pointer to flushed time data
   \numChannels           Number of channels
   \frameSize             Size of frame
@@ -568,8 +605,8 @@ static int CProgramConfigElement_Read(HANDLE_FDK_BITSTREAM bs,
   \return  Error code
 */
 LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_PrepareCrossFade(
-    const INT_PCM *pTimeData, INT_PCM **pTimeDataFlush, const INT numChannels,
-    const INT frameSize, const INT interleaved) {
+    const void *pTimeData, const PCM_FORMAT format, INT_PCM **pTimeDataFlush,
+    const INT numChannels, const INT frameSize, const INT interleaved) {
   int i, ch, s1, s2;
   AAC_DECODER_ERROR ErrorStatus;
 
@@ -584,10 +621,11 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_PrepareCrossFade(
   }
 
   for (ch = 0; ch < numChannels; ch++) {
-    const INT_PCM *pIn = &pTimeData[ch * s1];
+    INT idx = ch * s1;
     for (i = 0; i < TIME_DATA_FLUSH_SIZE; i++) {
-      pTimeDataFlush[ch][i] = *pIn;
-      pIn += s2;
+      pTimeDataFlush[ch][i] =
+          (INT_PCM)FX_DBL2FX_PCM(pcmLoadDbl(pTimeData, format, idx));
+      idx += s2;
     }
   }
 
@@ -598,6 +636,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_PrepareCrossFade(
   \brief Applies crossfade for USAC DASH IPF config change
 
   \pTimeData             Pointer to time data
+  \format                Sample format of the time data
   \pTimeDataFlush        Pointer to flushed time data
   \numChannels           Number of channels
   \frameSize             Size of frame
@@ -606,8 +645,8 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_PrepareCrossFade(
   \return  Error code
 */
 LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_ApplyCrossFade(
-    INT_PCM *pTimeData, INT_PCM **pTimeDataFlush, const INT numChannels,
-    const INT frameSize, const INT interleaved) {
+    void *pTimeData, const PCM_FORMAT format, INT_PCM **pTimeDataFlush,
+    const INT numChannels, const INT frameSize, const INT interleaved) {
   int i, ch, s1, s2;
   AAC_DECODER_ERROR ErrorStatus;
 
@@ -622,16 +661,16 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_ApplyCrossFade(
   }
 
   for (ch = 0; ch < numChannels; ch++) {
-    INT_PCM *pIn = &pTimeData[ch * s1];
+    INT idx = ch * s1;
     for (i = 0; i < TIME_DATA_FLUSH_SIZE; i++) {
       FIXP_SGL alpha = (FIXP_SGL)i
                        << (FRACT_BITS - 1 - TIME_DATA_FLUSH_SIZE_SF);
-      FIXP_DBL time = FX_PCM2FX_DBL(*pIn);
+      FIXP_DBL time = pcmLoadDbl(pTimeData, format, idx);
       FIXP_DBL timeFlush = FX_PCM2FX_DBL(pTimeDataFlush[ch][i]);
 
-      *pIn = (INT_PCM)(FIXP_PCM)FX_DBL2FX_PCM(
-          timeFlush - fMult(timeFlush, alpha) + fMult(time, alpha));
-      pIn += s2;
+      pcmStoreDbl(pTimeData, format, idx,
+                  timeFlush - fMult(timeFlush, alpha) + fMult(time, alpha));
+      idx += s2;
     }
   }
 
@@ -2400,6 +2439,91 @@ bail:
   return AAC_DEC_OUT_OF_MEMORY;
 }
 
+/* Time signal rendering of one channel */
+typedef struct {
+  CAacDecoderStaticChannelInfo *pAacDecoderStaticChannelInfo;
+  CAacDecoderChannelInfo *pAacDecoderChannelInfo;
+  PCM_DEC *pTimeData;
+  FIXP_DBL *pWorkBuffer; /* mdctOutTemp */
+  int frameOk;
+  UINT elFlags;
+  int elCh;
+} CAacDecoderRenderJob;
+
+/* Channels of one frame which are rendered per element by a worker pool */
+typedef struct {
+  HANDLE_AACDECODER self;
+  UINT flags;
+  int streamIndex;
+  CAacDecoderRenderJob job[(8)];
+  int numJobs;
+  int elementStart[(8) + 1]; /* first job of each element */
+  int numElements;
+} CAacDecoderRenderJobs;
+
+static void CAacDecoder_RenderChannel(HANDLE_AACDECODER self,
+                                      const CAacDecoderRenderJob *job,
+                                      const UINT flags, const int streamIndex) {
+  CAacDecoderChannelInfo *pAacDecoderChannelInfo = job->pAacDecoderChannelInfo;
+
+  switch (pAacDecoderChannelInfo->renderMode) {
+    case AACDEC_RENDER_IMDCT:
+      CBlock_FrequencyToTime(
+          job->pAacDecoderStaticChannelInfo, pAacDecoderChannelInfo,
+          job->pTimeData, self->streamInfo.aacSamplesPerFrame, job->frameOk,
+          job->pWorkBuffer, self->aacOutDataHeadroom, job->elFlags,
+          job->elCh);
+      break;
+    case AACDEC_RENDER_ELDFB:
+      CBlock_FrequencyToTimeLowDelay(job->pAacDecoderStaticChannelInfo,
+                                     pAacDecoderChannelInfo, job->pTimeData,
+                                     self->streamInfo.aacSamplesPerFrame);
+      break;
+    case AACDEC_RENDER_LPD:
+      CLpd_RenderTimeSignal(
+          job->pAacDecoderStaticChannelInfo, pAacDecoderChannelInfo,
+          job->pTimeData, self->streamInfo.aacSamplesPerFrame,
+          &self->samplingRateInfo[streamIndex], job->frameOk,
+          self->aacOutDataHeadroom, flags, self->flags[streamIndex]);
+      break;
+    default:
+      break;
+  }
+}
+
+/* FDK_WORKER_ITEM: renders the channels of one element. All elements share
+   the same WorkBufferCore1, so each one gets its own mdctOutTemp. */
+static void CAacDecoder_RenderElement(void *ctx, const INT index) {
+  CAacDecoderRenderJobs *jobs = (CAacDecoderRenderJobs *)ctx;
+  C_AALLOC_SCRATCH_START(mdctOutTemp, FIXP_DBL, 1024);
+
+  for (int i = jobs->elementStart[index]; i < jobs->elementStart[index + 1];
+       i++) {
+    jobs->job[i].pWorkBuffer = mdctOutTemp;
+    CAacDecoder_RenderChannel(jobs->self, &jobs->job[i], jobs->flags,
+                              jobs->streamIndex);
+  }
+
+  C_AALLOC_SCRATCH_END(mdctOutTemp, FIXP_DBL, 1024);
+}
+
+static void CAacDecoder_TDFading(HANDLE_AACDECODER self,
+                                 INT CConceal_TDFading_Applied[], const int c,
+                                 const INT aacChannels, PCM_DEC *pTimeData) {
+  if (!CConceal_TDFading_Applied[c]) {
+    CConceal_TDFading_Applied[c] = CConcealment_TDFading(
+        self->streamInfo.aacSamplesPerFrame,
+        &self->pAacDecoderStaticChannelInfo[c], self->aacOutDataHeadroom,
+        pTimeData, 0);
+    if (c + 1 < (8) && c < aacChannels - 1) {
+      /* update next TDNoise Seed to avoid muting in case of Parametric
+       * Stereo */
+      self->pAacDecoderStaticChannelInfo[c + 1]->concealmentInfo.TDNoiseSeed =
+          self->pAacDecoderStaticChannelInfo[c]->concealmentInfo.TDNoiseSeed;
+    }
+  }
+}
+
 LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(
     HANDLE_AACDECODER self, const UINT flags, PCM_DEC *pTimeData,
     const INT timeDataSize, const int timeDataChannelOffset) {
@@ -2508,6 +2632,8 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(
         /* Clear overlap-add buffers to avoid clicks. */
         FDKmemclear(self->pAacDecoderStaticChannelInfo[ch]->pOverlapBuffer,
                     OverlapBufferSize * sizeof(FIXP_DBL));
+        /* Restart the noise substitution like a new decoder */
+        self->pAacDecoderStaticChannelInfo[ch]->pnsCurrentSeed = 0;
       }
       if (self->streamInfo.channelConfig > 0) {
         /* Declare the possibly adopted old PCE (with outdated metadata)
@@ -2628,6 +2754,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(
         }
 
         if (self->frameOK) {
+          FDK_TRACE_START(self->hTrace, FDK_TRACE_ELEMENT_READ);
           ErrorStatus = CChannelElement_Read(
               bs, &self->pAacDecoderChannelInfo[aacChannels],
               &self->pAacDecoderStaticChannelInfo[aacChannels],
@@ -2635,6 +2762,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(
               self->flags[streamIndex], self->elFlags[element_count],
               self->streamInfo.aacSamplesPerFrame, el_channels,
               self->streamInfo.epConfig, self->hInput);
+          FDK_TRACE_STOP(self->hTrace, FDK_TRACE_ELEMENT_READ);
           if (ErrorStatus != AAC_DEC_OK) {
             self->frameOK = 0;
           }
@@ -2734,11 +2862,13 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(
               &tmpAacDecoderChannelInfo.pComData->pnsInterChannelData);
           pTmpAacDecoderChannelInfo = &tmpAacDecoderChannelInfo;
           /* do CCE parsing */
+          FDK_TRACE_START(self->hTrace, FDK_TRACE_ELEMENT_READ);
           ErrorStatus = CChannelElement_Read(
               bs, &pTmpAacDecoderChannelInfo, NULL, self->streamInfo.aot,
               &self->samplingRateInfo[streamIndex], self->flags[streamIndex],
               AC_EL_GA_CCE, self->streamInfo.aacSamplesPerFrame, 1,
               self->streamInfo.epConfig, self->hInput);
+          FDK_TRACE_STOP(self->hTrace, FDK_TRACE_ELEMENT_READ);
 
           C_AALLOC_SCRATCH_END(mdctSpec, FIXP_DBL, 1024);
 
@@ -3027,11 +3157,13 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(
                   ->pCpeStaticData->jointStereoPersistentData.scratchBuffer =
                   (FIXP_DBL *)pTimeData;
             }
+            FDK_TRACE_START(self->hTrace, FDK_TRACE_ELEMENT_DECODE);
             CChannelElement_Decode(
                 &self->pAacDecoderChannelInfo[aacChannels],
                 &self->pAacDecoderStaticChannelInfo[aacChannels],
                 &self->samplingRateInfo[streamIndex], self->flags[streamIndex],
                 self->elFlags[element_count], el_channels);
+            FDK_TRACE_STOP(self->hTrace, FDK_TRACE_ELEMENT_DECODE);
           }
           aacChannels += el_channels;
           break;
@@ -3214,6 +3346,24 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(
 
     int el;
     int el_channels;
+    CAacDecoderRenderJobs renderJobs;
+    CAacDecoderRenderJobs *pRenderJobs = NULL;
+    PCM_DEC *pFadingTimeData[(8)];
+    int numFadingChannels = 0;
+    int renderJobEl = -1;
+
+    /* The elements of AAC, HE-AAC and (E)LD only share the mdctOutTemp of
+     * WorkBufferCore1 (if there is no shared scratch). */
+    if ((self->hWorkerPool != NULL) && (self->sharedScratch == NULL) &&
+        !(self->flags[streamIndex] & (AC_USAC | AC_RSV603DA))) {
+      pRenderJobs = &renderJobs;
+      pRenderJobs->self = self;
+      pRenderJobs->flags = flags;
+      pRenderJobs->streamIndex = streamIndex;
+      pRenderJobs->numJobs = 0;
+      pRenderJobs->numElements = 0;
+    }
+
     c = 0;
     cIdx = 0;
     el_channels = 0;
@@ -3348,61 +3498,72 @@ LINKSPEC_CPP AAC_DECODER_ERROR CAacDecoder_DecodeFrame(
             !(flags & AACDEC_CONCEAL)) {
           FDKmemclear(pTimeData + offset,
                       sizeof(PCM_DEC) * self->streamInfo.aacSamplesPerFrame);
-        } else
+        } else {
+          CAacDecoderRenderJob job;
+
+          job.pAacDecoderStaticChannelInfo = pAacDecoderStaticChannelInfo;
+          job.pAacDecoderChannelInfo = pAacDecoderChannelInfo;
+          job.pTimeData = pTimeData + offset;
+          job.pWorkBuffer = pAacDecoderChannelInfo->pComStaticData
+                                ->pWorkBufferCore1->mdctOutTemp;
+          job.frameOk = (self->frameOK && !(flags & AACDEC_CONCEAL) &&
+                         !frameOk_butConceal);
+          job.elFlags = self->elFlags[el];
+          job.elCh = elCh;
+
           switch (pAacDecoderChannelInfo->renderMode) {
             case AACDEC_RENDER_IMDCT:
-
-              CBlock_FrequencyToTime(
-                  pAacDecoderStaticChannelInfo, pAacDecoderChannelInfo,
-                  pTimeData + offset, self->streamInfo.aacSamplesPerFrame,
-                  (self->frameOK && !(flags & AACDEC_CONCEAL) &&
-                   !frameOk_butConceal),
-                  pAacDecoderChannelInfo->pComStaticData->pWorkBufferCore1
-                      ->mdctOutTemp,
-                  self->aacOutDataHeadroom, self->elFlags[el], elCh);
-
+            case AACDEC_RENDER_LPD:
               self->extGainDelay = self->streamInfo.aacSamplesPerFrame;
               break;
-            case AACDEC_RENDER_ELDFB: {
-              CBlock_FrequencyToTimeLowDelay(
-                  pAacDecoderStaticChannelInfo, pAacDecoderChannelInfo,
-                  pTimeData + offset, self->streamInfo.aacSamplesPerFrame);
+            case AACDEC_RENDER_ELDFB:
               self->extGainDelay =
                   (self->streamInfo.aacSamplesPerFrame * 2 -
                    self->streamInfo.aacSamplesPerFrame / 2 - 1) /
                   2;
-            } break;
-            case AACDEC_RENDER_LPD:
-
-              CLpd_RenderTimeSignal(
-                  pAacDecoderStaticChannelInfo, pAacDecoderChannelInfo,
-                  pTimeData + offset, self->streamInfo.aacSamplesPerFrame,
-                  &self->samplingRateInfo[streamIndex],
-                  (self->frameOK && !(flags & AACDEC_CONCEAL) &&
-                   !frameOk_butConceal),
-                  self->aacOutDataHeadroom, flags, self->flags[streamIndex]);
-
-              self->extGainDelay = self->streamInfo.aacSamplesPerFrame;
               break;
             default:
               ErrorStatus = AAC_DEC_UNKNOWN;
               break;
           }
-        /* TimeDomainFading */
-        if (!CConceal_TDFading_Applied[c]) {
-          CConceal_TDFading_Applied[c] = CConcealment_TDFading(
-              self->streamInfo.aacSamplesPerFrame,
-              &self->pAacDecoderStaticChannelInfo[c], self->aacOutDataHeadroom,
-              pTimeData + offset, 0);
-          if (c + 1 < (8) && c < aacChannels - 1) {
-            /* update next TDNoise Seed to avoid muting in case of Parametric
-             * Stereo */
-            self->pAacDecoderStaticChannelInfo[c + 1]
-                ->concealmentInfo.TDNoiseSeed =
-                self->pAacDecoderStaticChannelInfo[c]
-                    ->concealmentInfo.TDNoiseSeed;
+
+          if (pRenderJobs != NULL) {
+            /* collect the channels of each element, see below */
+            if ((pRenderJobs->numElements == 0) || (renderJobEl != el)) {
+              pRenderJobs->elementStart[pRenderJobs->numElements++] =
+                  pRenderJobs->numJobs;
+              renderJobEl = el;
+            }
+            pRenderJobs->job[pRenderJobs->numJobs++] = job;
+          } else {
+            FDK_TRACE_START(self->hTrace, FDK_TRACE_RENDER);
+            CAacDecoder_RenderChannel(self, &job, flags, streamIndex);
+            FDK_TRACE_STOP(self->hTrace, FDK_TRACE_RENDER);
           }
         }
+        /* TimeDomainFading */
+        if (pRenderJobs != NULL) {
+          pFadingTimeData[c] = pTimeData + offset;
+          numFadingChannels = c + 1;
+        } else {
+          CAacDecoder_TDFading(self, CConceal_TDFading_Applied, c, aacChannels,
+                               pTimeData + offset);
+        }
+      }
+    }
+
+    if (pRenderJobs != NULL) {
+      /* The bit stream has been parsed serially: render the elements in
+       * parallel and apply the time domain fading in channel order. */
+      pRenderJobs->elementStart[pRenderJobs->numElements] =
+          pRenderJobs->numJobs;
+      FDK_TRACE_START(self->hTrace, FDK_TRACE_RENDER);
+      FDKworkerPoolRun(self->hWorkerPool, CAacDecoder_RenderElement,
+                       pRenderJobs, pRenderJobs->numElements);
+      FDK_TRACE_STOP(self->hTrace, FDK_TRACE_RENDER);
+      for (c = 0; c < numFadingChannels; c++) {
+        CAacDecoder_TDFading(self, CConceal_TDFading_Applied, c, aacChannels,
+                             pFadingTimeData[c]);
       }
     }
 
@@ -115,6 +115,8 @@ amm-info@iis.fraunhofer.de
 #include "libAACdec/block.h"
 
 #include "libSYS/genericStds.h"
+#include "libSYS/FDK_workerPool.h"
+#include "libSYS/FDK_trace.h"
 
 #include "libFDK/FDK_qmf_domain.h"
 
@@ -315,6 +317,7 @@ This structure is allocated once for each CPE. */
   UCHAR limiterEnableUser; /*!< The limiter configuration requested by the
                               library user */
   UCHAR limiterEnableCurr; /*!< The current limiter configuration.         */
+  PCM_FORMAT outputFormat; /*!< Sample format of the output buffer.        */
 
   FIXP_DBL extGain[1]; /*!< Gain that must be applied to the output signal. */
   UINT extGainDelay;   /*!< Delay that must be accounted for extGain. */
@@ -347,6 +350,18 @@ This structure is allocated once for each CPE. */
   FDK_SignalDelay usacResidualDelay; /*!< Delay residual signal to compensate
                                         for eSBR delay of DMX signal in case of
                                         stereoConfigIndex==2. */
+
+  const FDK_ALLOCATOR *allocator; /*!< Allocator which was active at
+                                     aacDecoder_Open(). */
+  FDK_SHARED_SCRATCH *sharedScratch; /*!< Shared scratch which was active at
+                                        aacDecoder_Open(). */
+  HANDLE_FDK_WORKER_POOL hWorkerPool; /*!< Optional pool which renders the
+                                         channel elements in parallel. */
+  HANDLE_FDK_TRACE hTrace; /*!< Stage timing, NULL unless built with
+                              FDK_TRACE. */
+  INT framePosition; /*!< Position of the next access unit in frames since the
+                        start of the stream, or -1 if unknown. Set by
+                        aacDecoder_SeekToFrame(). */
 };
 
 #define AAC_DEBUG_EXTHLP \
@@ -439,13 +454,13 @@ LINKSPEC_H AAC_DECODER_ERROR CAacDecoder_FreeMem(HANDLE_AACDECODER self,
 
 /* Prepare crossfade for USAC DASH IPF config change */
 LINKSPEC_H AAC_DECODER_ERROR CAacDecoder_PrepareCrossFade(
-    const INT_PCM *pTimeData, INT_PCM **pTimeDataFlush, const INT numChannels,
-    const INT frameSize, const INT interleaved);
+    const void *pTimeData, const PCM_FORMAT format, INT_PCM **pTimeDataFlush,
+    const INT numChannels, const INT frameSize, const INT interleaved);
 
 /* Apply crossfade for USAC DASH IPF config change */
 LINKSPEC_H AAC_DECODER_ERROR CAacDecoder_ApplyCrossFade(
-    INT_PCM *pTimeData, INT_PCM **pTimeDataFlush, const INT numChannels,
-    const INT frameSize, const INT interleaved);
+    void *pTimeData, const PCM_FORMAT format, INT_PCM **pTimeDataFlush,
+    const INT numChannels, const INT frameSize, const INT interleaved);
 
 /* Set flush and build up mode */
 LINKSPEC_H AAC_DECODER_ERROR CAacDecoder_CtrlCFGChange(HANDLE_AACDECODER self,
@@ -106,6 +106,7 @@ amm-info@iis.fraunhofer.de
 #include "libAACdec/aacdecoder.h"
 #include "libMpegTPDec/tpdec_lib.h"
 #include "libFDK/FDK_core.h"
+#include "libFDK/FDK_dispatch.h"
 
 #include "libSBRdec/sbrdecoder.h"
 
@@ -171,6 +172,22 @@ aacDecoder_GetFreeBytes(const HANDLE_AACDECODER self, UINT *pFreeBytes) {
   return AAC_DEC_OK;
 }
 
+LINKSPEC_CPP AAC_DECODER_ERROR
+aacDecoder_GetValidBytes(const HANDLE_AACDECODER self, UINT *pValidBytes) {
+  /* reset valid bytes */
+  *pValidBytes = 0;
+
+  /* check handle */
+  if (!self) return AAC_DEC_INVALID_HANDLE;
+
+  /* return nr of buffered bytes which are not decoded yet */
+  HANDLE_FDK_BITSTREAM hBs = transportDec_GetBitstream(self->hInput, 0);
+  *pValidBytes = FDKgetValidBits(hBs) >> 3;
+
+  /* success */
+  return AAC_DEC_OK;
+}
+
 /**
  * Config Decoder using a CSAudioSpecificConfig struct.
  */
@@ -195,6 +212,8 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_ConfigRaw(HANDLE_AACDECODER self,
   AAC_DECODER_ERROR err = AAC_DEC_OK;
   TRANSPORTDEC_ERROR errTp;
   UINT layer, nrOfLayers = self->nrOfLayers;
+  FDK_ALLOCATOR_SCOPE allocatorScope(self->allocator);
+  FDK_SHARED_SCRATCH_SCOPE scratchScope(self->sharedScratch);
 
   for (layer = 0; layer < nrOfLayers; layer++) {
     if (length[layer] > 0) {
@@ -231,6 +250,8 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_RawISOBMFFData(HANDLE_AACDECODER self,
   FDK_BITSTREAM bs;
   HANDLE_FDK_BITSTREAM hBs = &bs;
   AAC_DECODER_ERROR err = AAC_DEC_OK;
+  FDK_ALLOCATOR_SCOPE allocatorScope(self->allocator);
+  FDK_SHARED_SCRATCH_SCOPE scratchScope(self->sharedScratch);
 
   if (length < 8) return AAC_DEC_UNKNOWN;
 
@@ -674,6 +695,10 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_SetParam(
   PCMDMX_ERROR dmxErr = PCMDMX_OK;
   TDLimiterPtr hPcmTdl = NULL;
   DRC_DEC_ERROR uniDrcErr = DRC_DEC_OK;
+  FDK_ALLOCATOR_SCOPE allocatorScope((self != NULL) ? self->allocator
+                                                    : FDKgetAllocator());
+  FDK_SHARED_SCRATCH_SCOPE scratchScope(
+      (self != NULL) ? self->sharedScratch : FDKgetSharedScratch());
 
   /* check decoder handle */
   if (self != NULL) {
@@ -724,6 +749,13 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_SetParam(
       self->limiterEnableUser = value;
       break;
 
+    case AAC_PCM_OUTPUT_FORMAT:
+      if (value < PCM_FMT_INT16 || value > PCM_FMT_FLOAT) {
+        return AAC_DEC_SET_PARAM_FAIL;
+      }
+      self->outputFormat = (PCM_FORMAT)value;
+      break;
+
     case AAC_PCM_LIMITER_ATTACK_TIME:
       if (value <= 0) { /* module function converts value to unsigned */
         return AAC_DEC_SET_PARAM_FAIL;
@@ -885,6 +917,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_SetParam(
       self->streamInfo.numLostAccessUnits = 0;
       self->streamInfo.numBadBytes = 0;
       self->streamInfo.numTotalBytes = 0;
+      self->framePosition = -1;
       /* aacDecoder_SignalInterruption(self); */
       break;
     case AAC_CONCEAL_METHOD:
@@ -938,6 +971,16 @@ bail:
 
   return (errorStatus);
 }
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_SetWorkerPool(
+    const HANDLE_AACDECODER self, HANDLE_FDK_WORKER_POOL hPool) {
+  if (self == NULL) {
+    return AAC_DEC_INVALID_HANDLE;
+  }
+  self->hWorkerPool = hPool;
+
+  return AAC_DEC_OK;
+}
+
 LINKSPEC_CPP HANDLE_AACDECODER aacDecoder_Open(TRANSPORT_TYPE transportFmt,
                                                UINT nrOfLayers) {
   AAC_DECODER_INSTANCE *aacDec = NULL;
@@ -947,6 +990,9 @@ LINKSPEC_CPP HANDLE_AACDECODER aacDecoder_Open(TRANSPORT_TYPE transportFmt,
 
   UINT nrOfLayers_min = fMin(nrOfLayers, (UINT)1);
 
+  /* SIMD kernels for the host CPU */
+  FDKinitKernels();
+
   /* Allocate transport layer struct. */
   pIn = transportDec_Open(transportFmt, TP_FLAG_MPEG4, nrOfLayers_min);
   if (pIn == NULL) {
@@ -963,6 +1009,8 @@ LINKSPEC_CPP HANDLE_AACDECODER aacDecoder_Open(TRANSPORT_TYPE transportFmt,
     goto bail;
   }
   aacDec->hInput = pIn;
+  aacDec->allocator = FDKgetAllocator();
+  aacDec->sharedScratch = FDKgetSharedScratch();
 
   aacDec->nrOfLayers = nrOfLayers_min;
 
@@ -1031,6 +1079,11 @@ LINKSPEC_CPP HANDLE_AACDECODER aacDecoder_Open(TRANSPORT_TYPE transportFmt,
   }
   aacDec->limiterEnableUser = (UCHAR)-1;
   aacDec->limiterEnableCurr = 0;
+  aacDec->outputFormat = PCM_FMT_INT16;
+  aacDec->framePosition = -1;
+
+  /* Optional stage timing, decoding works without it. */
+  aacDec->hTrace = FDKtraceOpen();
 
   /* Assure that all modules have same delay */
   if (setConcealMethod(aacDec,
@@ -1047,6 +1100,114 @@ bail:
   return aacDec;
 }
 
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_GetRequiredMemory(
+    TRANSPORT_TYPE transportFmt, UINT flags, UINT *pPersistent,
+    UINT *pScratch) {
+  AAC_DECODER_ERROR err = AAC_DEC_OK;
+  HANDLE_AACDECODER self = NULL;
+  FDK_MEM_COUNTER counter;
+  FDK_BITSTREAM bs;
+  UCHAR asc[4] = {0};
+  UCHAR *pAsc = asc;
+  UINT ascLength;
+  UINT channelConfig = AACDEC_MEM_CHANNEL_CONFIG(flags);
+
+  if ((pPersistent == NULL) || (pScratch == NULL)) {
+    return AAC_DEC_INVALID_HANDLE;
+  }
+  *pPersistent = 0;
+  *pScratch = 0;
+  if (channelConfig == 0) {
+    channelConfig = 2;
+  }
+  if (channelConfig > 7) {
+    return AAC_DEC_UNSUPPORTED_CHANNELCONFIG;
+  }
+
+  /* AudioSpecificConfig of the requested configuration: 48 kHz output */
+  FDKinitBitStream(&bs, asc, sizeof(asc), 0, BS_WRITER);
+  if (flags & AACDEC_MEM_SBR) {
+    FDKwriteBits(&bs, (channelConfig == 1) ? AOT_PS : AOT_SBR, 5);
+    FDKwriteBits(&bs, 6, 4); /* 24 kHz core */
+    FDKwriteBits(&bs, channelConfig, 4);
+    FDKwriteBits(&bs, 3, 4); /* 48 kHz extension */
+    FDKwriteBits(&bs, AOT_AAC_LC, 5);
+  } else {
+    FDKwriteBits(&bs, AOT_AAC_LC, 5);
+    FDKwriteBits(&bs, 3, 4); /* 48 kHz */
+    FDKwriteBits(&bs, channelConfig, 4);
+  }
+  FDKwriteBits(&bs, 0, 3); /* GASpecificConfig */
+  FDKbyteAlign(&bs, 0);
+  ascLength = FDKgetValidBits(&bs) >> 3;
+
+  {
+    FDK_ALLOCATOR_SCOPE allocatorScope(FDKmemCounterInit(&counter));
+    /* count the overlays even if they would be shared */
+    FDK_SHARED_SCRATCH_SCOPE scratchScope(NULL);
+
+    /* The transport memory does not depend on the format, but LATM expects a
+       StreamMuxConfig instead of an ASC. */
+    switch (transportFmt) {
+      case TT_MP4_LATM_MCP0:
+      case TT_MP4_LATM_MCP1:
+      case TT_MP4_LOAS:
+        transportFmt = TT_MP4_RAW;
+        break;
+      default:
+        break;
+    }
+
+    self = aacDecoder_Open(transportFmt, 1);
+    if (self == NULL) {
+      return AAC_DEC_UNSUPPORTED_FORMAT;
+    }
+
+    err = aacDecoder_ConfigRaw(self, &pAsc, &ascLength);
+
+    /* SBR elements and the QMF domain are set up with the first frame: do the
+       same as CAacDecoder_DecodeFrame() and aacDecoder_DecodeFrame(). */
+    if ((err == AAC_DEC_OK) && (flags & AACDEC_MEM_SBR)) {
+      for (int el = 0; el < (((8)) + (8)); el++) {
+        MP4_ELEMENT_ID type = self->elements[el];
+        UCHAR configChanged = 0;
+
+        if ((type == ID_NONE) || (type == ID_END)) {
+          break;
+        }
+        if ((type != ID_SCE) && (type != ID_CPE) && (type != ID_LFE)) {
+          continue;
+        }
+        if (sbrDecoder_InitElement(
+                self->hSbrDecoder, self->streamInfo.aacSampleRate,
+                self->streamInfo.extSamplingRate,
+                self->streamInfo.aacSamplesPerFrame, self->streamInfo.aot,
+                type, el, 2, 0, AC_CM_ALLOC_MEM, &configChanged,
+                self->downscaleFactor) != SBRDEC_OK) {
+          err = AAC_DEC_INVALID_SBR_CONFIG;
+          break;
+        }
+      }
+      if (err == AAC_DEC_OK) {
+        self->sbrEnabled = 1;
+        CAacDecoder_SyncQmfMode(self);
+        if (FDK_QmfDomain_Configure(&self->qmfDomain) != QMF_DOMAIN_OK) {
+          err = AAC_DEC_OUT_OF_MEMORY;
+        }
+      }
+    }
+
+    aacDecoder_Close(self);
+  }
+
+  if (err == AAC_DEC_OK) {
+    *pPersistent = counter.peak[FDK_MEM_PERSISTENT];
+    *pScratch = counter.peak[FDK_MEM_SCRATCH];
+  }
+
+  return err;
+}
+
 LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER self,
                                                UCHAR *pBuffer[],
                                                const UINT bufferSize[],
@@ -1073,6 +1234,25 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER self,
   return AAC_DEC_OK;
 }
 
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_SetInputBuffer(
+    HANDLE_AACDECODER self, const UCHAR *pBuffer, const UINT64 bufferSize) {
+  TRANSPORTDEC_ERROR tpErr;
+
+  if (self == NULL) {
+    return AAC_DEC_INVALID_HANDLE;
+  }
+
+  tpErr = transportDec_SetInputBuffer(self->hInput, pBuffer, bufferSize);
+  switch (tpErr) {
+    case TRANSPORTDEC_OK:
+      return AAC_DEC_OK;
+    case TRANSPORTDEC_UNSUPPORTED_FORMAT:
+      return AAC_DEC_UNSUPPORTED_FORMAT;
+    default:
+      return AAC_DEC_UNKNOWN;
+  }
+}
+
 static void aacDecoder_SignalInterruption(HANDLE_AACDECODER self) {
   CAacDecoder_SignalInterruption(self);
 
@@ -1133,6 +1313,51 @@ static INT aacDecoder_EstimateNumberOfLostFrames(HANDLE_AACDECODER self) {
   return n;
 }
 
+/* Scale, saturate and interleave the output signal into the sample format of
+   pTimeData. Already interleaved signals are passed as one channel. */
+static void aacDecoder_StoreOutput(const PCM_FORMAT format, PCM_DEC *pIn,
+                                   void *pTimeData, const INT channels,
+                                   const INT frameSize, const INT scale) {
+  switch (format) {
+    case PCM_FMT_INT24:
+      FDK_interleaveSaturateInt24(pIn, (LONG *)pTimeData, channels, frameSize,
+                                  frameSize, scale);
+      break;
+    case PCM_FMT_FLOAT:
+      FDK_interleaveFloat(pIn, (float *)pTimeData, channels, frameSize,
+                          frameSize, scale);
+      break;
+    default:
+      if (channels == 1) {
+        scaleValuesSaturate((INT_PCM *)pTimeData, pIn, frameSize, scale);
+      } else {
+        FDK_interleaveSaturate(pIn, (INT_PCM *)pTimeData, channels, frameSize,
+                               frameSize, scale);
+      }
+      break;
+  }
+}
+
+/* pcmLimiter_Apply() into the sample format of pTimeData */
+static void aacDecoder_LimiterApply(HANDLE_AACDECODER self, PCM_LIM *pIn,
+                                    void *pTimeData, FIXP_DBL *pGainPerSample,
+                                    const INT scale) {
+  switch (self->outputFormat) {
+    case PCM_FMT_INT24:
+      pcmLimiter_Apply(self->hLimiter, pIn, (LONG *)pTimeData, pGainPerSample,
+                       scale, self->streamInfo.frameSize);
+      break;
+    case PCM_FMT_FLOAT:
+      pcmLimiter_Apply(self->hLimiter, pIn, (float *)pTimeData,
+                       pGainPerSample, scale, self->streamInfo.frameSize);
+      break;
+    default:
+      pcmLimiter_Apply(self->hLimiter, pIn, (INT_PCM *)pTimeData,
+                       pGainPerSample, scale, self->streamInfo.frameSize);
+      break;
+  }
+}
+
 LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
                                                       INT_PCM *pTimeData,
                                                       const INT timeDataSize,
@@ -1157,12 +1382,18 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
   if (self == NULL) {
     return AAC_DEC_INVALID_HANDLE;
   }
+  FDK_ALLOCATOR_SCOPE allocatorScope(self->allocator);
+  FDK_SHARED_SCRATCH_SCOPE scratchScope(self->sharedScratch);
+  FDK_TRACE_FRAME_START(self->hTrace);
 
   if (flags & AACDEC_INTR) {
     self->streamInfo.numLostAccessUnits = 0;
   }
   hBs = transportDec_GetBitstream(self->hInput, 0);
 
+  /* Follow an input buffer which is read in place. */
+  transportDec_AdvanceInput(self->hInput);
+
   /* Get current bits position for bitrate calculation. */
   nBits = FDKgetValidBits(hBs);
 
@@ -1187,7 +1418,9 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
     TRANSPORTDEC_ERROR err;
 
     for (layer = 0; layer < self->nrOfLayers; layer++) {
+      FDK_TRACE_START(self->hTrace, FDK_TRACE_TRANSPORT);
       err = transportDec_ReadAccessUnit(self->hInput, layer);
+      FDK_TRACE_STOP(self->hTrace, FDK_TRACE_TRANSPORT);
       if (err != TRANSPORTDEC_OK) {
         switch (err) {
           case TRANSPORTDEC_NOT_ENOUGH_BITS:
@@ -1473,6 +1706,8 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
 
         sbrDecoder_SetParam(self->hSbrDecoder, SBR_SKIP_QMF,
                             (self->mpsEnableCurr) ? 2 : 0);
+        sbrDecoder_SetParam(self->hSbrDecoder, SBR_FRAME_POSITION,
+                            self->framePosition);
 
         PCM_AAC *input;
         input = (PCM_AAC *)self->workBufferCore2;
@@ -1481,11 +1716,13 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
                       (self->streamInfo.frameSize));
 
         /* apply SBR processing */
+        FDK_TRACE_START(self->hTrace, FDK_TRACE_SBR);
         sbrError = sbrDecoder_Apply(
             self->hSbrDecoder, input, pTimeData3, timeData3Size,
             &self->streamInfo.numChannels, &self->streamInfo.sampleRate,
             &self->mapDescr, self->chMapIndex, self->frameOK, &self->psPossible,
             self->aacOutDataHeadroom, &timeDataHeadroom);
+        FDK_TRACE_STOP(self->hTrace, FDK_TRACE_SBR);
 
         if (sbrError == SBRDEC_OK) {
           /* Update data in streaminfo structure. Assume that the SBR upsampling
@@ -1562,6 +1799,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
             SACDEC_INTERFACE, sac_interface);
 
         if (err == 0) {
+          FDK_TRACE_START(self->hTrace, FDK_TRACE_MPS);
           err = mpegSurroundDecoder_Apply(
               (CMpegSurroundDecoder *)self->pMpegSurroundDecoder,
               (PCM_AAC *)self->workBufferCore2, pTimeData3, timeData3Size,
@@ -1569,6 +1807,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
               self->streamInfo.sampleRate, self->streamInfo.aot,
               self->channelType, self->channelIndices, &self->mapDescr,
               self->aacOutDataHeadroom, &timeDataHeadroom);
+          FDK_TRACE_STOP(self->hTrace, FDK_TRACE_MPS);
         }
 
         if (err == MPS_OUTPUT_BUFFER_TOO_SMALL) {
@@ -1613,11 +1852,13 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
         sbrDecoder_SetParam(self->hSbrDecoder, SBR_SKIP_QMF, 1);
 
         /* apply SBR processing */
+        FDK_TRACE_START(self->hTrace, FDK_TRACE_SBR);
         sbrError = sbrDecoder_Apply(
             self->hSbrDecoder, pTimeData3, pTimeData3, timeData3Size,
             &self->streamInfo.numChannels, &self->streamInfo.sampleRate,
             &self->mapDescr, self->chMapIndex, self->frameOK, &self->psPossible,
             self->aacOutDataHeadroom, &timeDataHeadroom);
+        FDK_TRACE_STOP(self->hTrace, FDK_TRACE_SBR);
 
         if (sbrError == SBRDEC_OK) {
           /* Update data in streaminfo structure. Assume that the SBR upsampling
@@ -1726,6 +1967,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
           }
 
           /* prepare Loudness Normalisation gain */
+          FDK_TRACE_START(self->hTrace, FDK_TRACE_DRC);
           FDK_drcDec_SetParam(self->hUniDrcDecoder, DRC_DEC_TARGET_LOUDNESS,
                               (INT)-self->defaultTargetLoudness *
                                   FL2FXCONST_DBL(1.0f / (float)(1 << 9)));
@@ -1760,6 +2002,7 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
                 drcWorkBuffer, pTimeData2, self->streamInfo.numChannels,
                 self->streamInfo.frameSize, self->streamInfo.frameSize);
           }
+          FDK_TRACE_STOP(self->hTrace, FDK_TRACE_DRC);
         }
       }
       if (FDK_drcDec_GetParam(self->hUniDrcDecoder, DRC_DEC_IS_ACTIVE)) {
@@ -1897,9 +2140,10 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
                 self->streamInfo.frameSize, self->streamInfo.numChannels, 1, 1);
           }
 
-          pcmLimiter_Apply(self->hLimiter, pInterleaveBuffer, pTimeData,
-                           pGainPerSample, pcmLimiterScale,
-                           self->streamInfo.frameSize);
+          FDK_TRACE_START(self->hTrace, FDK_TRACE_LIMITER);
+          aacDecoder_LimiterApply(self, pInterleaveBuffer, pTimeData,
+                                  pGainPerSample, pcmLimiterScale);
+          FDK_TRACE_STOP(self->hTrace, FDK_TRACE_LIMITER);
 
           {
             /* Announce the additional limiter output delay */
@@ -1922,21 +2166,16 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
           (resampled or not) */
           if ((self->streamInfo.numChannels == 1) || (self->sbrEnabled) ||
               (self->mpsEnableCurr)) {
-            scaleValuesSaturate(
-                pTimeData, pTimeData2,
+            aacDecoder_StoreOutput(
+                self->outputFormat, pTimeData2, pTimeData, 1,
                 self->streamInfo.frameSize * self->streamInfo.numChannels,
                 pcmLimiterScale);
 
           } else {
-            scaleValuesSaturate(
-                (INT_PCM *)self->workBufferCore2, pTimeData2,
-                self->streamInfo.frameSize * self->streamInfo.numChannels,
-                pcmLimiterScale);
             /* Interleave ouput buffer */
-            FDK_interleave((INT_PCM *)self->workBufferCore2, pTimeData,
-                           self->streamInfo.numChannels,
-                           self->streamInfo.frameSize,
-                           self->streamInfo.frameSize);
+            aacDecoder_StoreOutput(self->outputFormat, pTimeData2, pTimeData,
+                                   self->streamInfo.numChannels,
+                                   self->streamInfo.frameSize, pcmLimiterScale);
           }
         }
       } /* if (self->streamInfo.extAot != AOT_AAC_SLS)*/
@@ -1944,7 +2183,8 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
       if (self->flags[0] & AC_USAC) {
         if (self->flushStatus == AACDEC_USAC_DASH_IPF_FLUSH_ON &&
             !(flags & AACDEC_CONCEAL)) {
-          CAacDecoder_PrepareCrossFade(pTimeData, self->pTimeDataFlush,
+          CAacDecoder_PrepareCrossFade(pTimeData, self->outputFormat,
+                                       self->pTimeDataFlush,
                                        self->streamInfo.numChannels,
                                        self->streamInfo.frameSize, 1);
         }
@@ -1963,7 +2203,8 @@ LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER self,
         if (applyCrossfade && self->applyCrossfade &&
             !(accessUnit < numPrerollAU) &&
             (self->buildUpStatus == AACDEC_USAC_BUILD_UP_ON)) {
-          CAacDecoder_ApplyCrossFade(pTimeData, self->pTimeDataFlush,
+          CAacDecoder_ApplyCrossFade(pTimeData, self->outputFormat,
+                                     self->pTimeDataFlush,
                                      self->streamInfo.numChannels,
                                      self->streamInfo.frameSize, 1);
           self->applyCrossfade = 0;
@@ -2019,6 +2260,9 @@ bail:
   /* Update Statistics */
   aacDecoder_UpdateBitStreamCounters(&self->streamInfo, hBs, nBits,
                                      ErrorStatus);
+  if ((self->framePosition >= 0) && IS_OUTPUT_VALID(ErrorStatus)) {
+    self->framePosition++;
+  }
   if (((self->streamInfo.numChannels <= 0) ||
        (self->streamInfo.frameSize <= 0) ||
        (self->streamInfo.sampleRate <= 0)) &&
@@ -2028,8 +2272,10 @@ bail:
   }
 
   if (!IS_OUTPUT_VALID(ErrorStatus)) {
-    FDKmemclear(pTimeData, timeDataSize * sizeof(*pTimeData));
+    FDKmemclear(pTimeData,
+                timeDataSize * FDK_pcmSampleSize(self->outputFormat));
   }
+  FDK_TRACE_FRAME_END(self->hTrace, IS_OUTPUT_VALID(ErrorStatus));
 
   return ErrorStatus;
 }
@@ -2037,6 +2283,8 @@ bail:
 LINKSPEC_CPP void aacDecoder_Close(HANDLE_AACDECODER self) {
   if (self == NULL) return;
 
+  FDKtraceClose(&self->hTrace);
+
   if (self->hLimiter != NULL) {
     pcmLimiter_Destroy(self->hLimiter);
   }
@@ -2067,6 +2315,124 @@ LINKSPEC_CPP CStreamInfo *aacDecoder_GetStreamInfo(HANDLE_AACDECODER self) {
   return CAacDecoder_GetStreamInfo(self);
 }
 
+LINKSPEC_CPP UINT aacDecoder_GetTrace(HANDLE_AACDECODER self,
+                                      FDK_TRACE_FRAME *pFrames,
+                                      const UINT maxFrames) {
+  if (self == NULL) {
+    return 0;
+  }
+  return FDKtraceRead(self->hTrace, pFrames, maxFrames);
+}
+
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_BuildFrameIndex(
+    const TRANSPORT_TYPE transportFmt, const UCHAR *pBuffer,
+    const UINT64 bufferSize, FDK_FRAME_INDEX *pIndex, UINT *pNumEntries) {
+  HANDLE_AACDECODER hIndexer;
+  TRANSPORTDEC_ERROR errTp;
+
+  if ((transportFmt != TT_MP4_ADTS) && (transportFmt != TT_MP4_LOAS)) {
+    return AAC_DEC_UNSUPPORTED_FORMAT;
+  }
+
+  /* The transport decoder needs the configuration callbacks of an instance */
+  hIndexer = aacDecoder_Open(transportFmt, 1);
+  if (hIndexer == NULL) {
+    return AAC_DEC_OUT_OF_MEMORY;
+  }
+  errTp = transportDec_BuildFrameIndex(hIndexer->hInput, pBuffer, bufferSize,
+                                       pIndex, pNumEntries);
+  aacDecoder_Close(hIndexer);
+
+  switch (errTp) {
+    case TRANSPORTDEC_OK:
+      return AAC_DEC_OK;
+    case TRANSPORTDEC_INVALID_PARAMETER:
+      return AAC_DEC_SET_PARAM_FAIL;
+    case TRANSPORTDEC_UNSUPPORTED_FORMAT:
+      return AAC_DEC_UNSUPPORTED_FORMAT;
+    case TRANSPORTDEC_NOT_ENOUGH_BITS:
+      return AAC_DEC_NOT_ENOUGH_BITS;
+    case TRANSPORTDEC_SYNC_ERROR:
+      return AAC_DEC_TRANSPORT_SYNC_ERROR;
+    default:
+      return AAC_DEC_UNKNOWN;
+  }
+}
+
+LINKSPEC_CPP AAC_DECODER_ERROR aacDecoder_SeekToFrame(
+    HANDLE_AACDECODER self, const FDK_FRAME_INDEX *pIndex,
+    const UINT numEntries, const UINT frame, UINT64 *pOffset,
+    UINT *pDiscardFrames) {
+  CSAudioSpecificConfig asc;
+  UINT preRoll, start, lo, hi;
+  INT resyncFrames = -1;
+  int configured, sbrPossible;
+
+  if (self == NULL) {
+    return AAC_DEC_INVALID_HANDLE;
+  }
+  /* the last entry marks the end of the stream */
+  if ((pIndex == NULL) || (numEntries < 2) || (pOffset == NULL) ||
+      (pDiscardFrames == NULL) || (frame < pIndex[0].frame) ||
+      (frame >= pIndex[numEntries - 1].frame)) {
+    return AAC_DEC_SET_PARAM_FAIL;
+  }
+
+  /* Take the tools from the configuration. Before it is known assume the
+   * worst, and SBR may be signaled implicitly until a frame was decoded. */
+  transportDec_GetAsc(self->hInput, 0, &asc);
+  configured = (asc.m_aot > AOT_NULL_OBJECT);
+  sbrPossible = !configured || self->sbrEnabled || asc.m_sbrPresentFlag ||
+                ((asc.m_aot == AOT_AAC_LC) && (self->streamInfo.frameSize == 0));
+
+  /* the IMDCT overlap and window shape need two frames, the AAC-ELD low delay
+   * window spans four. The concealment delays the output and the QMF bank and
+   * SBR envelopes need one more */
+  preRoll = ((!configured || (asc.m_aot == AOT_ER_AAC_ELD)) ? 4 : 2) +
+            CConcealment_GetDelay(&self->concealCommonData);
+  if (sbrPossible) {
+    /* SBR and PS need a header and a frame without time differential
+     * coding. Until their distances were seen in the stream allow one second
+     * for each. */
+    if (self->hSbrDecoder != NULL) {
+      resyncFrames = sbrDecoder_GetResyncFrames(self->hSbrDecoder);
+    }
+    if (resyncFrames < 0) {
+      resyncFrames =
+          2 * ((configured && (asc.m_samplesPerFrame > 0))
+                   ? (INT)((asc.m_samplingFrequency + asc.m_samplesPerFrame -
+                            1) /
+                           asc.m_samplesPerFrame)
+                   : 96000 / 480);
+    }
+    preRoll += 1 + (UINT)resyncFrames;
+  }
+  start = (frame - pIndex[0].frame > preRoll) ? (frame - preRoll)
+                                               : pIndex[0].frame;
+
+  /* last transport frame which starts at or before the first decoded one */
+  lo = 0;
+  hi = numEntries - 2;
+  while (lo < hi) {
+    UINT mid = (lo + hi + 1) >> 1;
+    if (pIndex[mid].frame <= start) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+
+  transportDec_SetParam(self->hInput, TPDEC_PARAM_RESET, 1);
+  self->streamInfo.numLostAccessUnits = 0;
+  aacDecoder_SignalInterruption(self);
+  self->framePosition = (INT)pIndex[lo].frame;
+
+  *pOffset = pIndex[lo].offset;
+  *pDiscardFrames = frame - pIndex[lo].frame;
+
+  return AAC_DEC_OK;
+}
+
 LINKSPEC_CPP INT aacDecoder_GetLibInfo(LIB_INFO *info) {
   int i;
 
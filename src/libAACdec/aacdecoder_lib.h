@@ -432,6 +432,7 @@ Where N equals to CStreamInfo::frameSize .
 #include "libSYS/FDK_audio.h"
 
 #include "libSYS/genericStds.h"
+#include "libSYS/FDK_workerPool.h"
 
 #define AACDECODER_LIB_VL0 3
 #define AACDECODER_LIB_VL1 2
@@ -641,6 +642,14 @@ typedef enum {
                                            in ms. Default configuration is 50
                                            ms. Adjustable time must be larger
                                            than 0 ms. */
+  AAC_PCM_OUTPUT_FORMAT = 0x0007, /*!< Sample format of the buffer passed to
+                                     aacDecoder_DecodeFrame(), see
+                                     ::PCM_FORMAT. \n
+                                     0: INT_PCM (default). \n
+                                     1: 24 bit samples in 32 bit integers. \n
+                                     2: 32 bit float samples. These are not
+                                     clipped, with the limiter disabled they
+                                     may exceed the range -1.0 .. +1.0. */
   AAC_PCM_MIN_OUTPUT_CHANNELS =
       0x0011, /*!< Minimum number of PCM output channels. If higher than the
                  number of encoded audio channels, a simple channel extension is
@@ -933,6 +942,21 @@ LINKSPEC_H AAC_DECODER_ERROR aacDecoder_SetParam(const HANDLE_AACDECODER self,
                                                  const AACDEC_PARAM param,
                                                  const INT value);
 
+/**
+ * \brief Render the channel elements (SCE, CPE, LFE) of each frame in parallel
+ * with a worker pool. The bit stream is still parsed serially and the output
+ * is bit-exact. This is only done for AAC, HE-AAC and (E)LD streams of
+ * instances without a shared scratch, because otherwise the elements use the
+ * same work buffers.
+ *
+ * \param self   AAC decoder handle.
+ * \param hPool  Worker pool (see FDKworkerPoolOpen()) or NULL to render all
+ * elements in the calling thread. The pool can be used by several instances.
+ * \return       Error code.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_SetWorkerPool(
+    const HANDLE_AACDECODER self, HANDLE_FDK_WORKER_POOL hPool);
+
 /**
  * \brief              Get free bytes inside decoder internal buffer.
  * \param self         Handle of AAC decoder instance.
@@ -943,8 +967,48 @@ LINKSPEC_H AAC_DECODER_ERROR aacDecoder_SetParam(const HANDLE_AACDECODER self,
 LINKSPEC_H AAC_DECODER_ERROR
 aacDecoder_GetFreeBytes(const HANDLE_AACDECODER self, UINT *pFreeBytes);
 
+/**
+ * \brief              Get the number of bytes inside the decoder internal buffer
+ * which have been filled but not yet decoded.
+ * \param self         Handle of AAC decoder instance.
+ * \param pValidBytes  Pointer to variable receiving amount of valid bytes inside
+ * decoder internal buffer.
+ * \return             Error code.
+ */
+LINKSPEC_H AAC_DECODER_ERROR
+aacDecoder_GetValidBytes(const HANDLE_AACDECODER self, UINT *pValidBytes);
+
+/** Flags for aacDecoder_GetRequiredMemory(): MPEG-4 channel configuration
+ * (1..7) to be decoded. 0 selects stereo. */
+#define AACDEC_MEM_CHANNEL_CONFIG(cfg) ((UINT)(cfg)&0xF)
+/** Flag for aacDecoder_GetRequiredMemory(): Account for SBR (HE-AAC) and, with
+ * channel configuration 1, parametric stereo (HE-AAC v2). */
+#define AACDEC_MEM_SBR 0x10
+
+/**
+ * \brief               Get the exact memory which an AAC decoder instance needs
+ * for a configuration. The function opens and configures a temporary instance
+ * and accounts all its allocations as an FDK_ARENA would do. So the sum of both
+ * values can be used to size the arena of one instance.
+ * \param transportFmt  The transport type to be used.
+ * \param flags         Configuration: AACDEC_MEM_CHANNEL_CONFIG() | AACDEC_MEM_SBR.
+ * \param pPersistent   Pointer to variable receiving the persistent bytes.
+ * \param pScratch      Pointer to variable receiving the scratch (overlay)
+ * bytes.
+ * \return              Error code.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_GetRequiredMemory(
+    TRANSPORT_TYPE transportFmt, UINT flags, UINT *pPersistent, UINT *pScratch);
+
 /**
  * \brief               Open an AAC decoder instance.
+ *
+ * The instance keeps the allocator (FDKsetAllocator()) and the shared scratch
+ * (FDKsetSharedScratch()) which are active for the calling thread. With a
+ * shared scratch, all instances which are opened and decoded on the same
+ * thread use one set of work buffers, so the scratch bytes reported by
+ * aacDecoder_GetRequiredMemory() are only needed once per thread.
+ *
  * \param transportFmt  The transport type to be used.
  * \param nrOfLayers    Number of transport layers.
  * \return              AAC decoder handle.
@@ -1012,6 +1076,27 @@ LINKSPEC_H AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER self,
                                              const UINT bufferSize[],
                                              UINT *bytesValid);
 
+/**
+ * \brief Decode from a caller owned buffer which holds the complete stream,
+ * e.g. a memory mapped file, instead of copying it with aacDecoder_Fill().
+ * aacDecoder_DecodeFrame() reads the access units in place until it returns
+ * ::AAC_DEC_NOT_ENOUGH_BITS at the end of the buffer. Only the last 32 kB
+ * are copied into the internal input buffer; afterwards the buffer is not
+ * referenced anymore and further data can be appended with aacDecoder_Fill().
+ * Until then aacDecoder_Fill() fails and the buffer must stay valid and
+ * unchanged. Data in the internal input buffer is discarded. Only for
+ * streaming formats like ADTS and LOAS.
+ *
+ * \param self        AAC decoder handle.
+ * \param pBuffer     Stream starting at a transport frame, e.g. at an offset of
+ * aacDecoder_SeekToFrame(). NULL switches back to the internal input buffer.
+ * \param bufferSize  Size of pBuffer in bytes.
+ * \return            Error code.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_SetInputBuffer(HANDLE_AACDECODER self,
+                                                       const UCHAR *pBuffer,
+                                                       const UINT64 bufferSize);
+
 /** Flag for aacDecoder_DecodeFrame(): Trigger the built-in error concealment
  * module to generate a substitute signal for one lost frame. New input data
  * will not be considered.
@@ -1036,8 +1121,9 @@ LINKSPEC_H AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER self,
  *
  * \param self          AAC decoder handle.
  * \param pTimeData     Pointer to external output buffer where the decoded PCM
- * samples will be stored into.
- * \param timeDataSize  Size of external output buffer.
+ * samples will be stored into. With ::AAC_PCM_OUTPUT_FORMAT other than
+ * ::PCM_FMT_INT16 this is a cast pointer to a buffer of INT or float samples.
+ * \param timeDataSize  Size of external output buffer in samples.
  * \param flags         Bit field with flags for the decoder: \n
  *                      (flags & AACDEC_CONCEAL) == 1: Do concealment. \n
  *                      (flags & AACDEC_FLUSH) == 2: Discard input data. Flush
@@ -1068,6 +1154,85 @@ LINKSPEC_H void aacDecoder_Close(HANDLE_AACDECODER self);
  */
 LINKSPEC_H CStreamInfo *aacDecoder_GetStreamInfo(HANDLE_AACDECODER self);
 
+/**
+ * \brief Get the timing of the most recent decoded frames (at most 64), oldest
+ * first. The time of each decoder stage is only measured if the library was
+ * built with FDK_TRACE=1 (cmake -DFDK_AAC_TRACE=ON), otherwise no frames are
+ * returned. Frames without valid output are not recorded. The function may be
+ * called from another thread while aacDecoder_DecodeFrame() is running.
+ *
+ * \param self       AAC decoder handle.
+ * \param pFrames    Pointer to an array of maxFrames FDK_TRACE_FRAME.
+ * \param maxFrames  Size of the pFrames array.
+ * \return           Number of frames written to pFrames.
+ */
+LINKSPEC_H UINT aacDecoder_GetTrace(HANDLE_AACDECODER self,
+                                    FDK_TRACE_FRAME *pFrames,
+                                    const UINT maxFrames);
+
+/**
+ * \brief Build the frame index of an ADTS or LOAS stream for
+ * aacDecoder_SeekToFrame(). The whole stream is scanned once: only the
+ * transport headers and configurations are parsed, no access unit is decoded.
+ * The function uses its own decoder instance.
+ *
+ * \param transportFmt  TT_MP4_ADTS or TT_MP4_LOAS.
+ * \param pBuffer       Stream, e.g. a memory mapped file.
+ * \param bufferSize    Size of the stream in bytes.
+ * \param pIndex        Array of *pNumEntries entries, or NULL to get the number
+ * of entries.
+ * \param pNumEntries   In: size of pIndex. Out: number of entries, of which at
+ * most the input value were written. There is one entry for each ADTS frame,
+ * which can contain several access units, and for each LOAS frame which
+ * carries a StreamMuxConfig. A last entry marks the end of the stream.
+ * \return              Error code: AAC_DEC_UNSUPPORTED_FORMAT for other
+ * transport formats, AAC_DEC_SET_PARAM_FAIL for invalid arguments,
+ * AAC_DEC_NOT_ENOUGH_BITS or AAC_DEC_TRANSPORT_SYNC_ERROR for a damaged
+ * stream.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_BuildFrameIndex(
+    const TRANSPORT_TYPE transportFmt, const UCHAR *pBuffer,
+    const UINT64 bufferSize, FDK_FRAME_INDEX *pIndex, UINT *pNumEntries);
+
+/**
+ * \brief Prepare the decoder to continue at an access unit of the frame index
+ * of aacDecoder_BuildFrameIndex(). The input buffer and the bit stream
+ * history of the decoder are cleared, a buffer of aacDecoder_SetInputBuffer()
+ * is released; the configuration of the stream is kept. Afterwards the stream
+ * must be provided from *pOffset on with aacDecoder_Fill() or
+ * aacDecoder_SetInputBuffer(), the first frame must be decoded with the
+ * AACDEC_CLRHIST flag and the output of the first *pDiscardFrames decoded
+ * frames must be dropped. They prime the filter banks and the concealment
+ * delay line, and for LOAS cover the distance to the preceding
+ * StreamMuxConfig. With SBR and PS they also cover the distance of the SBR
+ * and PS headers and the longest run of time differentially coded SBR
+ * envelopes and PS parameters, as observed in the stream decoded so far;
+ * until these were observed, one second is allowed for each. The noise and
+ * harmonic generators of SBR are aligned with the stream position of the
+ * entry. The output then equals a continuous decode of the stream, provided
+ * that the stream does not exceed the observed distances after the seek
+ * position, with two exceptions: the smoothing of the SBR inverse filtering
+ * levels may keep a rounding difference of about one LSB, and the noise of
+ * perceptual noise substitution is generated anew, with the same energy but
+ * other samples, unless the seek goes to the first frame. Before the first
+ * frame was decoded the configuration may be unknown and a longer pre-roll for
+ * AAC-ELD, SBR and PS is assumed.
+ *
+ * \param self            AAC decoder handle.
+ * \param pIndex          Frame index of the stream.
+ * \param numEntries      Number of entries of pIndex.
+ * \param frame           Number of the access unit to continue with.
+ * \param pOffset         Returns the byte offset to fill the stream from.
+ * \param pDiscardFrames  Returns the number of frames to drop.
+ * \return                Error code, AAC_DEC_SET_PARAM_FAIL if the frame is
+ * before the first entry of the index or not before its last entry, the end of
+ * the stream.
+ */
+LINKSPEC_H AAC_DECODER_ERROR aacDecoder_SeekToFrame(
+    HANDLE_AACDECODER self, const FDK_FRAME_INDEX *pIndex,
+    const UINT numEntries, const UINT frame, UINT64 *pOffset,
+    UINT *pDiscardFrames);
+
 /**
  * \brief       Get decoder library info.
  *
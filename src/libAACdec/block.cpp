@@ -1219,8 +1219,7 @@ void CBlock_FrequencyToTime(
 
     } else /* last_core_mode was not LPD */
     {
-      FIXP_DBL *tmp =
-          pAacDecoderChannelInfo->pComStaticData->pWorkBufferCore1->mdctOutTemp;
+      FIXP_DBL *tmp = pWorkBuffer1; /* mdctOutTemp */
 #if defined(FDK_ASSERT_ENABLE)
       nSamples =
 #endif
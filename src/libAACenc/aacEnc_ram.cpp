@@ -148,6 +148,13 @@ PSY_DYNAMIC *GetRam_aacEnc_PsyDynamic(int n, UCHAR *dynamic_RAM) {
       dynamic_RAM + P_BUF_1 + n * sizeof(PSY_DYNAMIC)));
 }
 
+/*
+   Private PsyDynamic of the elements 1..nElements-1 which are processed in
+   parallel to element 0 (see FDKaacEnc_PsySetParallel()). Element 0 keeps
+   using the dynamic RAM.
+*/
+C_ALLOC_MEM2(Ram_aacEnc_PsyDynamicElement, PSY_DYNAMIC, 1, ((8)))
+
 /*
    The structure PSY_OUT holds all psychoaccoustic data needed
    in quantization module
@@ -119,6 +119,9 @@ amm-info@iis.fraunhofer.de
 #include "libAACenc/bit_cnt.h"
 #include "libAACenc/psy_const.h"
 
+#include "libSYS/FDK_workerPool.h"
+#include "libSYS/FDK_trace.h"
+
 #define OUTPUTBUFFER_SIZE                                                 \
   (8192) /*!< Output buffer size has to be at least 6144 bits per channel \
             (768 bytes). FDK bitbuffer implementation expects buffer of   \
@@ -164,6 +167,18 @@ struct AAC_ENC {
   INT maxFrames;
 
   AUDIO_OBJECT_TYPE aot; /* AOT to be used while encoding.  */
+
+  HANDLE_FDK_WORKER_POOL hWorkerPool; /* psych of the elements in parallel */
+
+  /* frame pipeline: psych of the next frame while the current one is
+   * quantized, see FDKaacEnc_SetPipeline() */
+  PSY_OUT *psyOutNext;
+  QC_OUT *qcOutNext;
+  FIXP_DBL *dynamic_RAM_next; /* QC_OUT_CH and adjust thresholds of qcOutNext */
+  PSY_DYNAMIC *psyDynamicNext;
+  INT pipelineSwapped; /* psyOut[0] and psyOutNext are swapped */
+
+  HANDLE_FDK_TRACE hTrace; /* stage timing, NULL unless built with FDK_TRACE */
 };
 
 #define maxSize(a, b) (((a) > (b)) ? (a) : (b))
@@ -226,6 +241,7 @@ H_ALLOC_MEM(Ram_aacEnc_PsyStatic, PSY_STATIC)
 H_ALLOC_MEM(Ram_aacEnc_PsyInputBuffer, INT_PCM)
 
 PSY_DYNAMIC *GetRam_aacEnc_PsyDynamic(int n, UCHAR *dynamic_RAM);
+H_ALLOC_MEM(Ram_aacEnc_PsyDynamicElement, PSY_DYNAMIC)
 
 H_ALLOC_MEM(Ram_aacEnc_PsyOutChannel, PSY_OUT_CHANNEL)
 
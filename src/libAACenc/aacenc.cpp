@@ -420,11 +420,38 @@ AAC_ENCODER_ERROR FDKaacEnc_Open(HANDLE_AAC_ENC *phAacEnc, const INT nElements,
   hAacEnc->maxElements = nElements;
   hAacEnc->maxFrames = nSubFrames;
 
+  /* optional stage timing, encoding works without it */
+  hAacEnc->hTrace = FDKtraceOpen();
+
 bail:
   *phAacEnc = hAacEnc;
   return ErrorStatus;
 }
 
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_SetWorkerPool
+    description:  process the psychoacoustics of the channel elements in
+                  parallel with the given pool, NULL: in the calling thread
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_SetWorkerPool(HANDLE_AAC_ENC hAacEnc,
+                                          HANDLE_FDK_WORKER_POOL hPool) {
+  AAC_ENCODER_ERROR ErrorStatus;
+
+  if (hAacEnc == NULL) {
+    return AAC_ENC_INVALID_HANDLE;
+  }
+
+  /* each element needs its own psyDynamic */
+  ErrorStatus = FDKaacEnc_PsySetParallel(
+      hAacEnc->psyKernel, (hPool != NULL) ? hAacEnc->maxElements : 0);
+  hAacEnc->hWorkerPool = (ErrorStatus == AAC_ENC_OK) ? hPool : NULL;
+
+  return ErrorStatus;
+}
+
 AAC_ENCODER_ERROR FDKaacEnc_Initialize(
     HANDLE_AAC_ENC hAacEnc,
     AACENC_CONFIG *config, /* pre-initialized config struct */
@@ -576,6 +603,12 @@ AAC_ENCODER_ERROR FDKaacEnc_Initialize(
   ErrorStatus = FDKaacEnc_QCOutInit(hAacEnc->qcOut, hAacEnc->maxFrames, cm);
   if (ErrorStatus != AAC_ENC_OK) goto bail;
 
+  if (hAacEnc->qcOutNext != NULL) {
+    FDKaacEnc_PsyOutInit(&hAacEnc->psyOutNext, 1, cm);
+    ErrorStatus = FDKaacEnc_QCOutInit(&hAacEnc->qcOutNext, 1, cm);
+    if (ErrorStatus != AAC_ENC_OK) goto bail;
+  }
+
   qcInit.channelMapping = &hAacEnc->channelMapping;
   qcInit.sceCpe = 0;
 
@@ -759,18 +792,130 @@ bail:
   return ErrorStatus;
 }
 
+/* psychoacoustics of the channel elements of one frame */
+typedef struct {
+  HANDLE_AAC_ENC hAacEnc;
+  PSY_OUT *psyOut;
+  QC_OUT *qcOut;
+  PSY_DYNAMIC *psyDynamic; /* NULL: psyDynamicElement[] of the element */
+  INT prepare;             /* also run FDKaacEnc_QCMainPrepare() */
+  INT_PCM *inputBuffer;
+  UINT inputBufferBufSize;
+  INT numElements;
+  INT element[((8))]; /* index into channelMapping.elInfo */
+  AAC_ENCODER_ERROR ErrorStatus[((8))];
+} AAC_ENC_PSY_JOBS;
+
 /*---------------------------------------------------------------------------
 
-    functionname: FDKaacEnc_EncodeFrame
-    description:  encodes one frame
+    functionname: FDKaacEnc_PsyElementJob
+    description:  psychoacoustics, form factor, pe and static bit demand of
+                  one channel element (worker item of FDKaacEnc_PsyFrame)
+
+  ---------------------------------------------------------------------------*/
+static void FDKaacEnc_PsyElementJob(void *ctx, const INT index) {
+  AAC_ENC_PSY_JOBS *psyJobs = (AAC_ENC_PSY_JOBS *)ctx;
+  HANDLE_AAC_ENC hAacEnc = psyJobs->hAacEnc;
+  CHANNEL_MAPPING *cm = &hAacEnc->channelMapping;
+  const INT el = psyJobs->element[index];
+  ELEMENT_INFO elInfo = cm->elInfo[el];
+  PSY_OUT *psyOut = psyJobs->psyOut;
+  QC_OUT *qcOut = psyJobs->qcOut;
+  PSY_DYNAMIC *psyDynamic = psyJobs->psyDynamic;
+  AAC_ENCODER_ERROR ErrorStatus;
+  int ch;
+
+  if (psyDynamic == NULL) {
+    psyDynamic = hAacEnc->psyKernel->psyDynamicElement[index];
+  }
+
+  /* update pointer!*/
+  for (ch = 0; ch < elInfo.nChannelsInEl; ch++) {
+    PSY_OUT_CHANNEL *psyOutChan = psyOut->psyOutElement[el]->psyOutChannel[ch];
+    QC_OUT_CHANNEL *qcOutChan = qcOut->qcElement[el]->qcOutChannel[ch];
+
+    psyOutChan->mdctSpectrum = qcOutChan->mdctSpectrum;
+    psyOutChan->sfbSpreadEnergy = qcOutChan->sfbSpreadEnergy;
+    psyOutChan->sfbEnergy = qcOutChan->sfbEnergy;
+    psyOutChan->sfbEnergyLdData = qcOutChan->sfbEnergyLdData;
+    psyOutChan->sfbMinSnrLdData = qcOutChan->sfbMinSnrLdData;
+    psyOutChan->sfbThresholdLdData = qcOutChan->sfbThresholdLdData;
+  }
+
+  ErrorStatus = FDKaacEnc_psyMain(
+      elInfo.nChannelsInEl, hAacEnc->psyKernel->psyElement[el], psyDynamic,
+      hAacEnc->psyKernel->psyConf, psyOut->psyOutElement[el],
+      psyJobs->inputBuffer, psyJobs->inputBufferBufSize,
+      cm->elInfo[el].ChannelIndex, cm->nChannels);
+
+  if ((ErrorStatus == AAC_ENC_OK) && psyJobs->prepare) {
+    /* FormFactor, Pe and staticBitDemand calculation */
+    ErrorStatus = FDKaacEnc_QCMainPrepare(
+        &elInfo, hAacEnc->qcKernel->hAdjThr->adjThrStateElem[el],
+        psyOut->psyOutElement[el], qcOut->qcElement[el], hAacEnc->aot,
+        hAacEnc->config->syntaxFlags, hAacEnc->config->epConfig);
+  }
+
+  psyJobs->ErrorStatus[index] = ErrorStatus;
+}
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_PsyFrame
+    description:  psychoacoustics of all channel elements of one frame
     returns:      error code
 
   ---------------------------------------------------------------------------*/
-AAC_ENCODER_ERROR FDKaacEnc_EncodeFrame(
-    HANDLE_AAC_ENC hAacEnc, /* encoder handle */
-    HANDLE_TRANSPORTENC hTpEnc, INT_PCM *RESTRICT inputBuffer,
-    const UINT inputBufferBufSize, INT *nOutBytes,
-    AACENC_EXT_PAYLOAD extPayload[MAX_TOTAL_EXT_PAYLOADS]) {
+static AAC_ENCODER_ERROR FDKaacEnc_PsyFrame(
+    HANDLE_AAC_ENC hAacEnc, PSY_OUT *psyOut, QC_OUT *qcOut,
+    PSY_DYNAMIC *psyDynamic, HANDLE_FDK_WORKER_POOL hPool, const INT prepare,
+    INT_PCM *inputBuffer, const UINT inputBufferBufSize) {
+  CHANNEL_MAPPING *cm = &hAacEnc->channelMapping;
+  AAC_ENC_PSY_JOBS psyJobs;
+  int el, n;
+
+  /* the elements are independent of each other up to the bit distribution, so
+   * they are processed by the worker pool if there is one */
+  psyJobs.hAacEnc = hAacEnc;
+  psyJobs.psyOut = psyOut;
+  psyJobs.qcOut = qcOut;
+  psyJobs.psyDynamic = psyDynamic;
+  psyJobs.prepare = prepare;
+  psyJobs.inputBuffer = inputBuffer;
+  psyJobs.inputBufferBufSize = inputBufferBufSize;
+  psyJobs.numElements = 0;
+  for (el = 0; el < cm->nElements; el++) {
+    ELEMENT_INFO *elInfo = &cm->elInfo[el];
+
+    if ((elInfo->elType == ID_SCE) || (elInfo->elType == ID_CPE) ||
+        (elInfo->elType == ID_LFE)) {
+      psyJobs.element[psyJobs.numElements] = el;
+      psyJobs.ErrorStatus[psyJobs.numElements++] = AAC_ENC_OK;
+    }
+  }
+  FDK_TRACE_START(hAacEnc->hTrace, FDK_TRACE_PSY);
+  FDKworkerPoolRun(hPool, FDKaacEnc_PsyElementJob, &psyJobs,
+                   psyJobs.numElements);
+  FDK_TRACE_STOP(hAacEnc->hTrace, FDK_TRACE_PSY);
+
+  for (n = 0; n < psyJobs.numElements; n++) {
+    if (psyJobs.ErrorStatus[n] != AAC_ENC_OK) return psyJobs.ErrorStatus[n];
+  }
+
+  return AAC_ENC_OK;
+}
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_QCFrame
+    description:  bit distribution, quantization and bitstream of the frame
+                  in psyOut[0]/qcOut[0]
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+static AAC_ENCODER_ERROR FDKaacEnc_QCFrame(
+    HANDLE_AAC_ENC hAacEnc, HANDLE_TRANSPORTENC hTpEnc, const INT prepare,
+    INT *nOutBytes, AACENC_EXT_PAYLOAD extPayload[MAX_TOTAL_EXT_PAYLOADS]) {
   AAC_ENCODER_ERROR ErrorStatus;
   int el, n, c = 0;
   UCHAR extPayloadUsed[MAX_TOTAL_EXT_PAYLOADS];
@@ -786,44 +931,21 @@ AAC_ENCODER_ERROR FDKaacEnc_EncodeFrame(
   qcOut->staticBits = 0;     /* sum up side info bits of each element */
   qcOut->totalNoRedPe = 0;   /* sum up PE */
 
-  /* advance psychoacoustics */
   for (el = 0; el < cm->nElements; el++) {
     ELEMENT_INFO elInfo = cm->elInfo[el];
 
     if ((elInfo.elType == ID_SCE) || (elInfo.elType == ID_CPE) ||
         (elInfo.elType == ID_LFE)) {
-      int ch;
-
-      /* update pointer!*/
-      for (ch = 0; ch < elInfo.nChannelsInEl; ch++) {
-        PSY_OUT_CHANNEL *psyOutChan =
-            psyOut->psyOutElement[el]->psyOutChannel[ch];
-        QC_OUT_CHANNEL *qcOutChan = qcOut->qcElement[el]->qcOutChannel[ch];
-
-        psyOutChan->mdctSpectrum = qcOutChan->mdctSpectrum;
-        psyOutChan->sfbSpreadEnergy = qcOutChan->sfbSpreadEnergy;
-        psyOutChan->sfbEnergy = qcOutChan->sfbEnergy;
-        psyOutChan->sfbEnergyLdData = qcOutChan->sfbEnergyLdData;
-        psyOutChan->sfbMinSnrLdData = qcOutChan->sfbMinSnrLdData;
-        psyOutChan->sfbThresholdLdData = qcOutChan->sfbThresholdLdData;
+      if (prepare) {
+        /* FormFactor, Pe and staticBitDemand calculation */
+        ErrorStatus = FDKaacEnc_QCMainPrepare(
+            &elInfo, hAacEnc->qcKernel->hAdjThr->adjThrStateElem[el],
+            psyOut->psyOutElement[el], qcOut->qcElement[el], hAacEnc->aot,
+            hAacEnc->config->syntaxFlags, hAacEnc->config->epConfig);
+
+        if (ErrorStatus != AAC_ENC_OK) return ErrorStatus;
       }
 
-      ErrorStatus = FDKaacEnc_psyMain(
-          elInfo.nChannelsInEl, hAacEnc->psyKernel->psyElement[el],
-          hAacEnc->psyKernel->psyDynamic, hAacEnc->psyKernel->psyConf,
-          psyOut->psyOutElement[el], inputBuffer, inputBufferBufSize,
-          cm->elInfo[el].ChannelIndex, cm->nChannels);
-
-      if (ErrorStatus != AAC_ENC_OK) return ErrorStatus;
-
-      /* FormFactor, Pe and staticBitDemand calculation */
-      ErrorStatus = FDKaacEnc_QCMainPrepare(
-          &elInfo, hAacEnc->qcKernel->hAdjThr->adjThrStateElem[el],
-          psyOut->psyOutElement[el], qcOut->qcElement[el], hAacEnc->aot,
-          hAacEnc->config->syntaxFlags, hAacEnc->config->epConfig);
-
-      if (ErrorStatus != AAC_ENC_OK) return ErrorStatus;
-
       /*-------------------------------------------- */
 
       qcOut->qcElement[el]->extBitsUsed = 0;
@@ -944,9 +1066,11 @@ AAC_ENCODER_ERROR FDKaacEnc_EncodeFrame(
     /*-------------------------------------------- */
     /*-------------------------------------------- */
 
+    FDK_TRACE_START(hAacEnc->hTrace, FDK_TRACE_QC);
     ErrorStatus = FDKaacEnc_QCMain(
         hAacEnc->qcKernel, hAacEnc->psyOut, hAacEnc->qcOut, avgTotalBits, cm,
         hAacEnc->aot, hAacEnc->config->syntaxFlags, hAacEnc->config->epConfig);
+    FDK_TRACE_STOP(hAacEnc->hTrace, FDK_TRACE_QC);
 
     if (ErrorStatus != AAC_ENC_OK) return ErrorStatus;
     /*-------------------------------------------- */
@@ -997,6 +1121,146 @@ AAC_ENCODER_ERROR FDKaacEnc_EncodeFrame(
   return AAC_ENC_OK;
 }
 
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_EncodeFrame
+    description:  encodes one frame
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_EncodeFrame(
+    HANDLE_AAC_ENC hAacEnc, /* encoder handle */
+    HANDLE_TRANSPORTENC hTpEnc, INT_PCM *RESTRICT inputBuffer,
+    const UINT inputBufferBufSize, INT *nOutBytes,
+    AACENC_EXT_PAYLOAD extPayload[MAX_TOTAL_EXT_PAYLOADS]) {
+  AAC_ENCODER_ERROR ErrorStatus;
+
+  /* advance psychoacoustics */
+  ErrorStatus = FDKaacEnc_PsyFrame(
+      hAacEnc, hAacEnc->psyOut[0], hAacEnc->qcOut[0],
+      (hAacEnc->hWorkerPool != NULL) ? NULL : hAacEnc->psyKernel->psyDynamic,
+      hAacEnc->hWorkerPool, 1, inputBuffer, inputBufferBufSize);
+  if (ErrorStatus != AAC_ENC_OK) return ErrorStatus;
+
+  return FDKaacEnc_QCFrame(hAacEnc, hTpEnc, 0, nOutBytes, extPayload);
+}
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_SetPipeline
+    description:  allocates (enable) or releases the memory of the next frame
+                  of the frame pipeline
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_SetPipeline(HANDLE_AAC_ENC hAacEnc,
+                                        const INT enable) {
+  AAC_ENCODER_ERROR ErrorStatus = AAC_ENC_OK;
+  UCHAR *dynamicRAM;
+
+  if (hAacEnc == NULL) {
+    return AAC_ENC_INVALID_HANDLE;
+  }
+
+  /* the memory of the current frame has to be the one of FDKaacEnc_Open() */
+  if (hAacEnc->pipelineSwapped) {
+    FDKaacEnc_PipelineNext(hAacEnc);
+  }
+
+  if (enable) {
+    if (hAacEnc->psyDynamicNext != NULL) {
+      return AAC_ENC_OK;
+    }
+    if (NULL == (hAacEnc->dynamic_RAM_next = GetAACdynamic_RAM())) {
+      ErrorStatus = AAC_ENC_NO_MEMORY;
+      goto bail;
+    }
+    dynamicRAM = (UCHAR *)hAacEnc->dynamic_RAM_next;
+
+    ErrorStatus =
+        FDKaacEnc_PsyOutNew(&hAacEnc->psyOutNext, hAacEnc->maxElements,
+                            hAacEnc->maxChannels, 1, dynamicRAM);
+    if (ErrorStatus != AAC_ENC_OK) goto bail;
+
+    ErrorStatus =
+        FDKaacEnc_QCOutNew(&hAacEnc->qcOutNext, hAacEnc->maxElements,
+                           hAacEnc->maxChannels, 1, dynamicRAM);
+    if (ErrorStatus != AAC_ENC_OK) goto bail;
+
+    /* the psychoacoustics of the next frame must not use the dynamic RAM of
+     * the current frame */
+    hAacEnc->psyDynamicNext = GetRam_aacEnc_PsyDynamicElement(0);
+    if (hAacEnc->psyDynamicNext == NULL) {
+      ErrorStatus = AAC_ENC_NO_MEMORY;
+      goto bail;
+    }
+
+    FDKaacEnc_PsyOutInit(&hAacEnc->psyOutNext, 1, &hAacEnc->channelMapping);
+    FDKaacEnc_QCOutInit(&hAacEnc->qcOutNext, 1, &hAacEnc->channelMapping);
+
+    return AAC_ENC_OK;
+  }
+
+bail:
+  FDKaacEnc_PsyClose(NULL, &hAacEnc->psyOutNext);
+  FDKaacEnc_QCClose(NULL, &hAacEnc->qcOutNext);
+  if (hAacEnc->dynamic_RAM_next != NULL)
+    FreeAACdynamic_RAM(&hAacEnc->dynamic_RAM_next);
+  if (hAacEnc->psyDynamicNext != NULL)
+    FreeRam_aacEnc_PsyDynamicElement(&hAacEnc->psyDynamicNext);
+
+  return ErrorStatus;
+}
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_PipelinePsy
+    description:  psychoacoustics of the next frame, can run in parallel to
+                  FDKaacEnc_PipelineQC() of the current frame
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_PipelinePsy(HANDLE_AAC_ENC hAacEnc,
+                                        INT_PCM *inputBuffer,
+                                        const UINT inputBufferBufSize) {
+  /* the elements are processed in the calling thread which might already be a
+   * worker of the pool */
+  return FDKaacEnc_PsyFrame(hAacEnc, hAacEnc->psyOutNext, hAacEnc->qcOutNext,
+                            hAacEnc->psyDynamicNext, NULL, 0, inputBuffer,
+                            inputBufferBufSize);
+}
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_PipelineQC
+    description:  bit distribution, quantization and bitstream of the current
+                  frame
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_PipelineQC(
+    HANDLE_AAC_ENC hAacEnc, HANDLE_TRANSPORTENC hTpEnc, INT *nOutBytes,
+    AACENC_EXT_PAYLOAD extPayload[MAX_TOTAL_EXT_PAYLOADS]) {
+  return FDKaacEnc_QCFrame(hAacEnc, hTpEnc, 1, nOutBytes, extPayload);
+}
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_PipelineNext
+    description:  the next frame becomes the current frame
+
+  ---------------------------------------------------------------------------*/
+void FDKaacEnc_PipelineNext(HANDLE_AAC_ENC hAacEnc) {
+  PSY_OUT *psyOut = hAacEnc->psyOut[0];
+  QC_OUT *qcOut = hAacEnc->qcOut[0];
+
+  hAacEnc->psyOut[0] = hAacEnc->psyOutNext;
+  hAacEnc->qcOut[0] = hAacEnc->qcOutNext;
+  hAacEnc->psyOutNext = psyOut;
+  hAacEnc->qcOutNext = qcOut;
+  hAacEnc->pipelineSwapped = !hAacEnc->pipelineSwapped;
+}
+
 /*---------------------------------------------------------------------------
 
     functionname:FDKaacEnc_Close
@@ -1012,6 +1276,10 @@ void FDKaacEnc_Close(HANDLE_AAC_ENC *phAacEnc) /* encoder handle */
   }
   AAC_ENC *hAacEnc = (AAC_ENC *)*phAacEnc;
 
+  FDKaacEnc_SetPipeline(hAacEnc, 0);
+
+  FDKtraceClose(&hAacEnc->hTrace);
+
   if (hAacEnc->dynamic_RAM != NULL) FreeAACdynamic_RAM(&hAacEnc->dynamic_RAM);
 
   FDKaacEnc_PsyClose(&hAacEnc->psyKernel, hAacEnc->psyOut);
@@ -390,6 +390,60 @@ AAC_ENCODER_ERROR FDKaacEnc_EncodeFrame(
     const UINT inputBufferBufSize, INT *numOutBytes,
     AACENC_EXT_PAYLOAD extPayload[MAX_TOTAL_EXT_PAYLOADS]);
 
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_SetWorkerPool
+    description:  process the psychoacoustics of the channel elements in
+                  parallel with the given pool, NULL: in the calling thread
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_SetWorkerPool(HANDLE_AAC_ENC hAacEnc,
+                                          struct FDK_WORKER_POOL *hPool);
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_SetPipeline
+    description:  allocates (enable) or releases the memory of the next frame
+                  of the frame pipeline
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_SetPipeline(HANDLE_AAC_ENC hAacEnc,
+                                        const INT enable);
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_PipelinePsy
+    description:  psychoacoustics of the next frame, can run in parallel to
+                  FDKaacEnc_PipelineQC() of the current frame
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_PipelinePsy(HANDLE_AAC_ENC hAacEnc,
+                                        INT_PCM *inputBuffer,
+                                        const UINT inputBufferBufSize);
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_PipelineQC
+    description:  bit distribution, quantization and bitstream of the current
+                  frame
+    returns:      error code
+
+  ---------------------------------------------------------------------------*/
+AAC_ENCODER_ERROR FDKaacEnc_PipelineQC(
+    HANDLE_AAC_ENC hAacEnc, HANDLE_TRANSPORTENC hTpEnc, INT *nOutBytes,
+    AACENC_EXT_PAYLOAD extPayload[MAX_TOTAL_EXT_PAYLOADS]);
+
+/*---------------------------------------------------------------------------
+
+    functionname: FDKaacEnc_PipelineNext
+    description:  the next frame becomes the current frame
+
+  ---------------------------------------------------------------------------*/
+void FDKaacEnc_PipelineNext(HANDLE_AAC_ENC hAacEnc);
+
 /*---------------------------------------------------------------------------
 
     functionname:FDKaacEnc_Close
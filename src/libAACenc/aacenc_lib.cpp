@@ -106,6 +106,7 @@ amm-info@iis.fraunhofer.de
 
 #include "libAACenc/aacEnc_ram.h"
 #include "libFDK/FDK_core.h"
+#include "libFDK/FDK_dispatch.h"
 
 /* Encoder library info */
 #define AACENCODER_LIB_VL0 4
@@ -146,6 +147,9 @@ amm-info@iis.fraunhofer.de
   ((fl) / 2) /*!< ELD FB delay (no framing delay included) */
 
 #define MAX_DS_DELAY (100) /*!< Maximum downsampler delay in SBR. */
+#define PIPELINE_META_DATA_BYTES                                          \
+  (16) /*!< Maximum size of one meta data payload (DRC: 12 bytes, ETSI \
+          ancillary data: 8 bytes) of the frame pipeline. */
 #define INPUTBUFFER_SIZE                                                    \
   (2 * (1024) + MAX_DS_DELAY + 1537) /*!< Audio input samples + downsampler \
                                         delay + sbr/aac delay compensation */
@@ -277,6 +281,20 @@ struct AACENCODER {
 
   /* Capability flags */
   UINT CAPF_tpEnc;
+
+  /* Allocator which was active at aacEncOpen() */
+  const FDK_ALLOCATOR *allocator;
+
+  /* Frame pipeline, see aacEncSetPipeline() */
+  INT pipeline;        /* enabled */
+  INT pipelinePending; /* quantization of the last analyzed frame is pending */
+  UINT pipelineFrames; /* number of analyzed frames */
+  AACENC_EXT_PAYLOAD
+  pipelineExtPayload[MAX_TOTAL_EXT_PAYLOADS]; /* of the pending frame */
+  SBRENC_EXT_PAYLOAD *pPipelineSbrPayload; /* of the pending frame, swapped
+                                              with pSbrPayload */
+  UCHAR pipelineMetaData[2][2][PIPELINE_META_DATA_BYTES]; /* meta data payload
+                                            copies of the last two frames */
 };
 
 typedef struct {
@@ -649,6 +667,27 @@ static INT getBufDescIdx(const AACENC_BufDesc *pBufDesc,
   return idx;
 }
 
+/*
+ * Examine buffer descriptor regarding the audio input buffer of any of the
+ * supported sample formats.
+ *
+ * \param pBufDesc              Pointer to buffer descriptor
+
+ * \return - Buffer descriptor index.
+ *         -1, if there is no entry available.
+ */
+static INT getAudioBufDescIdx(const AACENC_BufDesc *pBufDesc) {
+  INT idx = getBufDescIdx(pBufDesc, IN_AUDIO_DATA);
+
+  if (idx == -1) {
+    idx = getBufDescIdx(pBufDesc, IN_AUDIO_DATA_FLOAT);
+  }
+  if (idx == -1) {
+    idx = getBufDescIdx(pBufDesc, IN_AUDIO_DATA_INT24);
+  }
+  return idx;
+}
+
 /****************************************************************************
                           Function Declarations
 ****************************************************************************/
@@ -1474,6 +1513,38 @@ static AACENC_ERROR aacEncInit(HANDLE_AACENCODER hAacEncoder, ULONG InitFlags,
   return AACENC_OK;
 }
 
+AACENC_ERROR aacEncGetRequiredMemory(const UINT encModules,
+                                     const UINT maxChannels, UINT *pPersistent,
+                                     UINT *pScratch) {
+  AACENC_ERROR err = AACENC_OK;
+  HANDLE_AACENCODER hAacEncoder = NULL;
+  FDK_MEM_COUNTER counter;
+
+  if ((pPersistent == NULL) || (pScratch == NULL)) {
+    return AACENC_INVALID_HANDLE;
+  }
+  *pPersistent = 0;
+  *pScratch = 0;
+
+  {
+    FDK_ALLOCATOR_SCOPE allocatorScope(FDKmemCounterInit(&counter));
+
+    /* all buffers are allocated in aacEncOpen() depending on the modules and
+     * channels */
+    err = aacEncOpen(&hAacEncoder, encModules, maxChannels);
+    if (err == AACENC_OK) {
+      aacEncClose(&hAacEncoder);
+    }
+  }
+
+  if (err == AACENC_OK) {
+    *pPersistent = counter.peak[FDK_MEM_PERSISTENT];
+    *pScratch = counter.peak[FDK_MEM_SCRATCH];
+  }
+
+  return err;
+}
+
 AACENC_ERROR aacEncOpen(HANDLE_AACENCODER *phAacEncoder, const UINT encModules,
                         const UINT maxChannels) {
   AACENC_ERROR err = AACENC_OK;
@@ -1484,6 +1555,9 @@ AACENC_ERROR aacEncOpen(HANDLE_AACENCODER *phAacEncoder, const UINT encModules,
     goto bail;
   }
 
+  /* SIMD kernels for the host CPU */
+  FDKinitKernels();
+
   /* allocate memory */
   hAacEncoder = Get_AacEncoder();
 
@@ -1493,6 +1567,7 @@ AACENC_ERROR aacEncOpen(HANDLE_AACENCODER *phAacEncoder, const UINT encModules,
   }
 
   FDKmemclear(hAacEncoder, sizeof(AACENCODER));
+  hAacEncoder->allocator = FDKgetAllocator();
 
   /* Specify encoder modules to be allocated. */
   if (encModules == 0) {
@@ -1687,6 +1762,10 @@ AACENC_ERROR aacEncClose(HANDLE_AACENCODER *phAacEncoder) {
       FDKfree(hAacEncoder->pSbrPayload);
       hAacEncoder->pSbrPayload = NULL;
     }
+    if (hAacEncoder->pPipelineSbrPayload != NULL) {
+      FDKfree(hAacEncoder->pPipelineSbrPayload);
+      hAacEncoder->pPipelineSbrPayload = NULL;
+    }
     if (hAacEncoder->hAacEnc) {
       FDKaacEnc_Close(&hAacEncoder->hAacEnc);
     }
@@ -1707,6 +1786,201 @@ bail:
   return err;
 }
 
+AACENC_ERROR aacEncSetWorkerPool(const HANDLE_AACENCODER hAacEncoder,
+                                 HANDLE_FDK_WORKER_POOL hPool) {
+  if ((hAacEncoder == NULL) || (hAacEncoder->hAacEnc == NULL)) {
+    return AACENC_INVALID_HANDLE;
+  }
+  FDK_ALLOCATOR_SCOPE allocatorScope(hAacEncoder->allocator);
+
+  if (FDKaacEnc_SetWorkerPool(hAacEncoder->hAacEnc, hPool) != AAC_ENC_OK) {
+    return AACENC_MEMORY_ERROR;
+  }
+
+  return AACENC_OK;
+}
+
+/*
+ * Encode SBR data and add the SBR extension payload.
+ */
+static AACENC_ERROR aacEncEncodeSbr(HANDLE_AACENCODER hAacEncoder,
+                                    int *pnExtensions) {
+  int i, nExtensions = *pnExtensions;
+
+  if ((NULL != hAacEncoder->hEnvEnc) && (NULL != hAacEncoder->pSbrPayload) &&
+      isSbrActive(&hAacEncoder->aacConfig)) {
+    INT nPayload = 0;
+
+    /*
+     * Encode SBR data.
+     */
+    if (sbrEncoder_EncodeFrame(hAacEncoder->hEnvEnc, hAacEncoder->inputBuffer,
+                               hAacEncoder->inputBufferSizePerChannel,
+                               hAacEncoder->pSbrPayload->dataSize[nPayload],
+                               hAacEncoder->pSbrPayload->data[nPayload])) {
+      return AACENC_ENCODE_ERROR;
+    } else {
+      /* Add SBR extension payload */
+      for (i = 0; i < (8); i++) {
+        if (hAacEncoder->pSbrPayload->dataSize[nPayload][i] > 0) {
+          hAacEncoder->extPayload[nExtensions].pData =
+              hAacEncoder->pSbrPayload->data[nPayload][i];
+          {
+            hAacEncoder->extPayload[nExtensions].dataSize =
+                hAacEncoder->pSbrPayload->dataSize[nPayload][i];
+            hAacEncoder->extPayload[nExtensions].associatedChElement =
+                getAssociatedChElement(
+                    &hAacEncoder->hEnvEnc->sbrElement[i]->elInfo,
+                    &hAacEncoder->hAacEnc->channelMapping);
+            if (hAacEncoder->extPayload[nExtensions].associatedChElement ==
+                -1) {
+              return AACENC_ENCODE_ERROR;
+            }
+          }
+          hAacEncoder->extPayload[nExtensions].dataType =
+              EXT_SBR_DATA; /* Once SBR Encoder supports SBR CRC set
+                               EXT_SBR_DATA_CRC */
+          nExtensions++;    /* or EXT_SBR_DATA according to configuration. */
+          FDK_ASSERT(nExtensions <= MAX_TOTAL_EXT_PAYLOADS);
+        }
+      }
+      nPayload++;
+    }
+  } /* sbrEnabled */
+
+  *pnExtensions = nExtensions;
+
+  return AACENC_OK;
+}
+
+/* Frame pipeline: quantization of the pending frame and analysis of the new
+ * frame */
+typedef struct {
+  HANDLE_AACENCODER hAacEncoder;
+  INT first; /* 0: quantize the pending frame, 1: only analyze */
+  int nExtensions;
+  INT outBytes[(1)];
+  AACENC_ERROR err[2];
+} AACENC_PIPELINE_JOBS;
+
+static void aacEncPipelineJob(void *ctx, const INT index) {
+  AACENC_PIPELINE_JOBS *jobs = (AACENC_PIPELINE_JOBS *)ctx;
+  HANDLE_AACENCODER hAacEncoder = jobs->hAacEncoder;
+
+  if (jobs->first + index == 0) {
+    /* bit distribution, quantization and bitstream of the pending frame */
+    if (FDKaacEnc_PipelineQC(hAacEncoder->hAacEnc, hAacEncoder->hTpEnc,
+                             jobs->outBytes, hAacEncoder->pipelineExtPayload) !=
+        AAC_ENC_OK) {
+      jobs->err[0] = AACENC_ENCODE_ERROR;
+    }
+  } else {
+    /* SBR and psychoacoustics of the new frame */
+    jobs->err[1] = aacEncEncodeSbr(hAacEncoder, &jobs->nExtensions);
+    if (jobs->err[1] != AACENC_OK) return;
+
+    if (FDKaacEnc_PipelinePsy(hAacEncoder->hAacEnc, hAacEncoder->inputBuffer,
+                              hAacEncoder->inputBufferSizePerChannel) !=
+        AAC_ENC_OK) {
+      jobs->err[1] = AACENC_ENCODE_ERROR;
+      return;
+    }
+
+    /* the input buffer is not needed anymore for this frame */
+    if (isSbrActive(&hAacEncoder->aacConfig)) {
+      sbrEncoder_UpdateBuffers(hAacEncoder->hEnvEnc, hAacEncoder->inputBuffer,
+                               hAacEncoder->inputBufferSizePerChannel);
+    }
+  }
+}
+
+/*
+ * Quantize the pending frame (if any) in parallel to the analysis of the new
+ * frame (if analyze). The new frame is pending afterwards.
+ */
+static AACENC_ERROR aacEncPipelineRun(HANDLE_AACENCODER hAacEncoder,
+                                      INT *outBytes, const int nExtensions,
+                                      const INT analyze) {
+  AACENC_PIPELINE_JOBS jobs;
+  SBRENC_EXT_PAYLOAD *pSbrPayload;
+
+  jobs.hAacEncoder = hAacEncoder;
+  jobs.first = (hAacEncoder->pipelinePending) ? 0 : 1;
+  jobs.nExtensions = nExtensions;
+  jobs.outBytes[0] = 0;
+  jobs.err[0] = jobs.err[1] = AACENC_OK;
+
+  FDKworkerPoolRun(hAacEncoder->hAacEnc->hWorkerPool, aacEncPipelineJob, &jobs,
+                   ((analyze) ? 2 : 1) - jobs.first);
+  hAacEncoder->pipelinePending = 0;
+
+  if ((jobs.err[0] != AACENC_OK) || (jobs.err[1] != AACENC_OK)) {
+    return AACENC_ENCODE_ERROR;
+  }
+  outBytes[0] = jobs.outBytes[0];
+
+  if (analyze) {
+    FDKaacEnc_PipelineNext(hAacEncoder->hAacEnc);
+
+    /* keep the payload of the new frame until it is quantized */
+    FDKmemcpy(hAacEncoder->pipelineExtPayload, hAacEncoder->extPayload,
+              sizeof(AACENC_EXT_PAYLOAD) * MAX_TOTAL_EXT_PAYLOADS);
+    pSbrPayload = hAacEncoder->pSbrPayload;
+    hAacEncoder->pSbrPayload = hAacEncoder->pPipelineSbrPayload;
+    hAacEncoder->pPipelineSbrPayload = pSbrPayload;
+
+    hAacEncoder->pipelineFrames++;
+    hAacEncoder->pipelinePending = 1;
+  }
+
+  return AACENC_OK;
+}
+
+AACENC_ERROR aacEncSetPipeline(const HANDLE_AACENCODER hAacEncoder,
+                               const UINT enable) {
+  if ((hAacEncoder == NULL) || (hAacEncoder->hAacEnc == NULL)) {
+    return AACENC_INVALID_HANDLE;
+  }
+  if (hAacEncoder->pipelinePending) {
+    /* the last frame has not been flushed */
+    return AACENC_UNSUPPORTED_PARAMETER;
+  }
+  FDK_ALLOCATOR_SCOPE allocatorScope(hAacEncoder->allocator);
+
+  hAacEncoder->pipeline = 0;
+
+  if (enable) {
+    if ((hAacEncoder->pSbrPayload != NULL) &&
+        (hAacEncoder->pPipelineSbrPayload == NULL)) {
+      hAacEncoder->pPipelineSbrPayload =
+          (SBRENC_EXT_PAYLOAD *)FDKcalloc(1, sizeof(SBRENC_EXT_PAYLOAD));
+      if (hAacEncoder->pPipelineSbrPayload == NULL) {
+        return AACENC_MEMORY_ERROR;
+      }
+    }
+    if (FDKaacEnc_SetPipeline(hAacEncoder->hAacEnc, 1) != AAC_ENC_OK) {
+      return AACENC_MEMORY_ERROR;
+    }
+    hAacEncoder->pipeline = 1;
+  } else {
+    if (hAacEncoder->pPipelineSbrPayload != NULL) {
+      FDKfree(hAacEncoder->pPipelineSbrPayload);
+      hAacEncoder->pPipelineSbrPayload = NULL;
+    }
+    FDKaacEnc_SetPipeline(hAacEncoder->hAacEnc, 0);
+  }
+
+  return AACENC_OK;
+}
+
+UINT aacEncGetTrace(const HANDLE_AACENCODER hAacEncoder,
+                    FDK_TRACE_FRAME *pFrames, const UINT maxFrames) {
+  if ((hAacEncoder == NULL) || (hAacEncoder->hAacEnc == NULL)) {
+    return 0;
+  }
+  return FDKtraceRead(hAacEncoder->hAacEnc->hTrace, pFrames, maxFrames);
+}
+
 AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
                           const AACENC_BufDesc *inBufDesc,
                           const AACENC_BufDesc *outBufDesc,
@@ -1717,6 +1991,9 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
   INT outBytes[(1)];
   int nExtensions = 0;
   int ancDataExtIdx = -1;
+  INT pipelined = 0;
+  FDK_ALLOCATOR_SCOPE allocatorScope(
+      (hAacEncoder != NULL) ? hAacEncoder->allocator : FDKgetAllocator());
 
   /* deal with valid encoder handle */
   if (hAacEncoder == NULL) {
@@ -1725,9 +2002,10 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
   }
 
   /*
-   * Adjust user settings and trigger reinitialization.
+   * Adjust user settings and trigger reinitialization. A pending frame of the
+   * pipeline is finished with the old settings first.
    */
-  if (hAacEncoder->InitFlags != 0) {
+  if ((hAacEncoder->InitFlags != 0) && !hAacEncoder->pipelinePending) {
     err =
         aacEncInit(hAacEncoder, hAacEncoder->InitFlags, &hAacEncoder->extParam);
 
@@ -1771,14 +2049,28 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
   /* reset buffer wich signals number of valid bytes in output bitstream buffer
    */
   FDKmemclear(outBytes, hAacEncoder->aacConfig.nSubFrames * sizeof(INT));
+  FDK_TRACE_FRAME_START(hAacEncoder->hAacEnc->hTrace);
+
+  if (hAacEncoder->pipeline && (inargs->numAncBytes > 0)) {
+    /* ancillary data is owned by the caller and can't be delayed */
+    err = AACENC_UNSUPPORTED_PARAMETER;
+    goto bail;
+  }
+
+  if (hAacEncoder->pipelinePending && (hAacEncoder->InitFlags != 0)) {
+    /* input samples are fetched after the reinitialization in the next call */
+    err = aacEncPipelineRun(hAacEncoder, outBytes, 0, 0);
+    if (err != AACENC_OK) goto bail;
+    goto bitstream;
+  }
 
   /*
    * Manage incoming audio samples.
    */
   if ((inBufDesc != NULL) && (inargs->numInSamples > 0) &&
-      (getBufDescIdx(inBufDesc, IN_AUDIO_DATA) != -1)) {
+      (getAudioBufDescIdx(inBufDesc) != -1)) {
     /* Fetch data until nSamplesToRead reached */
-    INT idx = getBufDescIdx(inBufDesc, IN_AUDIO_DATA);
+    INT idx = getAudioBufDescIdx(inBufDesc);
     INT newSamples =
         fixMax(0, fixMin(inargs->numInSamples, hAacEncoder->nSamplesToRead -
                                                    hAacEncoder->nSamplesRead));
@@ -1792,7 +2084,17 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
              .nChannels); /* process multiple samples of input channels */
 
     /* Copy new input samples to internal buffer */
-    if (inBufDesc->bufElSizes[idx] == (INT)sizeof(INT_PCM)) {
+    if (inBufDesc->bufferIdentifiers[idx] == IN_AUDIO_DATA_FLOAT) {
+      FDK_deinterleave((const float *)inBufDesc->bufs[idx], pIn,
+                       hAacEncoder->extParam.nChannels,
+                       newSamples / hAacEncoder->extParam.nChannels,
+                       hAacEncoder->inputBufferSizePerChannel);
+    } else if (inBufDesc->bufferIdentifiers[idx] == IN_AUDIO_DATA_INT24) {
+      FDK_deinterleaveInt24((const LONG *)inBufDesc->bufs[idx], pIn,
+                            hAacEncoder->extParam.nChannels,
+                            newSamples / hAacEncoder->extParam.nChannels,
+                            hAacEncoder->inputBufferSizePerChannel);
+    } else if (inBufDesc->bufElSizes[idx] == (INT)sizeof(INT_PCM)) {
       FDK_deinterleave((INT_PCM *)inBufDesc->bufs[idx], pIn,
                        hAacEncoder->extParam.nChannels,
                        newSamples / hAacEncoder->extParam.nChannels,
@@ -1838,7 +2140,13 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
           hAacEncoder->nZerosAppended += nZeros;
           hAacEncoder->nSamplesRead = hAacEncoder->nSamplesToRead;
         }
-      } else {                   /* flushing completed */
+      } else { /* flushing completed */
+        if (hAacEncoder->pipelinePending) {
+          /* last frame of the pipeline */
+          err = aacEncPipelineRun(hAacEncoder, outBytes, 0, 0);
+          if (err != AACENC_OK) goto bail;
+          goto bitstream;
+        }
         err = AACENC_ENCODE_EOF; /* eof reached */
         goto bail;
       }
@@ -1848,6 +2156,11 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
     }
   }
 
+  /* The frame pipeline doesn't support MPS */
+  pipelined = hAacEncoder->pipeline &&
+              !((hAacEncoder->hMpsEnc != NULL) &&
+                (hAacEncoder->aacConfig.syntaxFlags & AC_LD_MPS));
+
   /* init payload */
   FDKmemclear(hAacEncoder->extPayload,
               sizeof(AACENC_EXT_PAYLOAD) * MAX_TOTAL_EXT_PAYLOADS);
@@ -1885,7 +2198,23 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
 
     for (i = 0; i < (INT)nMetaDataExtensions;
          i++) { /* Get meta data extension payload. */
-      hAacEncoder->extPayload[nExtensions++] = pMetaDataExtPayload[i];
+      hAacEncoder->extPayload[nExtensions] = pMetaDataExtPayload[i];
+
+      if (pipelined) {
+        /* the meta data encoder overwrites the payload in the next frame */
+        UCHAR *pData =
+            hAacEncoder->pipelineMetaData[hAacEncoder->pipelineFrames & 1][i];
+
+        if ((i >= 2) || (pMetaDataExtPayload[i].dataSize >
+                         PIPELINE_META_DATA_BYTES * 8)) {
+          err = AACENC_ENCODE_ERROR;
+          goto bail;
+        }
+        FDKmemcpy(pData, pMetaDataExtPayload[i].pData,
+                  (pMetaDataExtPayload[i].dataSize + 7) >> 3);
+        hAacEncoder->extPayload[nExtensions].pData = pData;
+      }
+      nExtensions++;
     }
 
     if ((matrix_mixdown_idx != -1) &&
@@ -1924,48 +2253,10 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
     }
   }
 
-  if ((NULL != hAacEncoder->hEnvEnc) && (NULL != hAacEncoder->pSbrPayload) &&
-      isSbrActive(&hAacEncoder->aacConfig)) {
-    INT nPayload = 0;
-
-    /*
-     * Encode SBR data.
-     */
-    if (sbrEncoder_EncodeFrame(hAacEncoder->hEnvEnc, hAacEncoder->inputBuffer,
-                               hAacEncoder->inputBufferSizePerChannel,
-                               hAacEncoder->pSbrPayload->dataSize[nPayload],
-                               hAacEncoder->pSbrPayload->data[nPayload])) {
-      err = AACENC_ENCODE_ERROR;
-      goto bail;
-    } else {
-      /* Add SBR extension payload */
-      for (i = 0; i < (8); i++) {
-        if (hAacEncoder->pSbrPayload->dataSize[nPayload][i] > 0) {
-          hAacEncoder->extPayload[nExtensions].pData =
-              hAacEncoder->pSbrPayload->data[nPayload][i];
-          {
-            hAacEncoder->extPayload[nExtensions].dataSize =
-                hAacEncoder->pSbrPayload->dataSize[nPayload][i];
-            hAacEncoder->extPayload[nExtensions].associatedChElement =
-                getAssociatedChElement(
-                    &hAacEncoder->hEnvEnc->sbrElement[i]->elInfo,
-                    &hAacEncoder->hAacEnc->channelMapping);
-            if (hAacEncoder->extPayload[nExtensions].associatedChElement ==
-                -1) {
-              err = AACENC_ENCODE_ERROR;
-              goto bail;
-            }
-          }
-          hAacEncoder->extPayload[nExtensions].dataType =
-              EXT_SBR_DATA; /* Once SBR Encoder supports SBR CRC set
-                               EXT_SBR_DATA_CRC */
-          nExtensions++;    /* or EXT_SBR_DATA according to configuration. */
-          FDK_ASSERT(nExtensions <= MAX_TOTAL_EXT_PAYLOADS);
-        }
-      }
-      nPayload++;
-    }
-  } /* sbrEnabled */
+  if (!pipelined) {
+    err = aacEncEncodeSbr(hAacEncoder, &nExtensions);
+    if (err != AACENC_OK) goto bail;
+  }
 
   if ((inargs->numAncBytes > 0) &&
       (getBufDescIdx(inBufDesc, IN_ANCILLRY_DATA) != -1)) {
@@ -1981,10 +2272,16 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
   /*
    * Encode AAC - Core.
    */
-  if (FDKaacEnc_EncodeFrame(hAacEncoder->hAacEnc, hAacEncoder->hTpEnc,
-                            hAacEncoder->inputBuffer,
-                            hAacEncoder->inputBufferSizePerChannel, outBytes,
-                            hAacEncoder->extPayload) != AAC_ENC_OK) {
+  if (pipelined) {
+    /* SBR and psychoacoustics of this frame in parallel to the quantization of
+     * the previous one */
+    err = aacEncPipelineRun(hAacEncoder, outBytes, nExtensions, 1);
+    if (err != AACENC_OK) goto bail;
+  } else if (FDKaacEnc_EncodeFrame(hAacEncoder->hAacEnc, hAacEncoder->hTpEnc,
+                                   hAacEncoder->inputBuffer,
+                                   hAacEncoder->inputBufferSizePerChannel,
+                                   outBytes,
+                                   hAacEncoder->extPayload) != AAC_ENC_OK) {
     err = AACENC_ENCODE_ERROR;
     goto bail;
   }
@@ -2001,11 +2298,12 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
   /*
    * Delay balancing buffer handling
    */
-  if (isSbrActive(&hAacEncoder->aacConfig)) {
+  if (isSbrActive(&hAacEncoder->aacConfig) && !pipelined) {
     sbrEncoder_UpdateBuffers(hAacEncoder->hEnvEnc, hAacEncoder->inputBuffer,
                              hAacEncoder->inputBufferSizePerChannel);
   }
 
+bitstream:
   /*
    * Make bitstream public
    */
@@ -2033,11 +2331,13 @@ AACENC_ERROR aacEncEncode(const HANDLE_AACENCODER hAacEncoder,
       goto bail;
     }
   }
+  FDK_TRACE_FRAME_END(hAacEncoder->hAacEnc->hTrace, nBsBytes > 0);
 
 bail:
   if (err == AACENC_ENCODE_ERROR) {
     /* All encoder modules have to be initialized */
     hAacEncoder->InitFlags = AACENC_INIT_ALL;
+    hAacEncoder->pipelinePending = 0;
   }
 
   return err;
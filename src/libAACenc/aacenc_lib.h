@@ -1004,6 +1004,7 @@ internally.
 
 #include "libSYS/machine_type.h"
 #include "libSYS/FDK_audio.h"
+#include "libSYS/FDK_workerPool.h"
 
 #define AACENCODER_LIB_VL0 4
 #define AACENCODER_LIB_VL1 0
@@ -1046,6 +1047,12 @@ typedef enum {
   IN_AUDIO_DATA = 0,    /*!< Audio input buffer, interleaved INT_PCM samples. */
   IN_ANCILLRY_DATA = 1, /*!< Ancillary data to be embedded into bitstream. */
   IN_METADATA_SETUP = 2, /*!< Setup structure for embedding meta data. */
+  IN_AUDIO_DATA_FLOAT = 5, /*!< Audio input buffer, interleaved 32 bit float
+                                samples with full scale at -1.0 .. +1.0. Used
+                                instead of ::IN_AUDIO_DATA. */
+  IN_AUDIO_DATA_INT24 = 6, /*!< Audio input buffer, interleaved 24 bit samples
+                                sign extended to 32 bit. Used instead of
+                                ::IN_AUDIO_DATA. */
 
   /* Output buffer identifier. */
   OUT_BITSTREAM_DATA = 3, /*!< Buffer holds bitstream output data. */
@@ -1526,6 +1533,27 @@ typedef enum {
 extern "C" {
 #endif
 
+/**
+ * \brief  Get the exact memory which an encoder instance needs. The function
+ * opens and initializes a temporary instance and accounts all its allocations
+ * as an FDK_ARENA would do. So the sum of both values can be used to size the
+ * arena of one instance.
+ *
+ * \param encModules    Encoder modules, see aacEncOpen().
+ * \param maxChannels   Number of channels to be allocated, see aacEncOpen().
+ * \param pPersistent   Pointer to variable receiving the persistent bytes.
+ * \param pScratch      Pointer to variable receiving the scratch (overlay)
+ * bytes.
+ *
+ * \return
+ *          - AACENC_OK, on succes.
+ *          - AACENC_INVALID_HANDLE, AACENC_MEMORY_ERROR, AACENC_INVALID_CONFIG,
+ * on failure.
+ */
+AACENC_ERROR aacEncGetRequiredMemory(const UINT encModules,
+                                     const UINT maxChannels, UINT *pPersistent,
+                                     UINT *pScratch);
+
 /**
  * \brief  Open an instance of the encoder.
  *
@@ -1577,6 +1605,74 @@ AACENC_ERROR aacEncOpen(HANDLE_AACENCODER *phAacEncoder, const UINT encModules,
  */
 AACENC_ERROR aacEncClose(HANDLE_AACENCODER *phAacEncoder);
 
+/**
+ * \brief Process the psychoacoustic model of the channel elements (SCE, CPE,
+ * LFE) of each frame in parallel with a worker pool. The bit distribution,
+ * quantization and bitstream writing stay in the calling thread, so the
+ * output is bit-exact. Each channel element gets a private psychoacoustic work
+ * buffer which is allocated with the allocator of aacEncOpen().
+ *
+ * \param hAacEncoder  Encoder handle.
+ * \param hPool        Worker pool (see FDKworkerPoolOpen()) or NULL to process
+ * all elements in the calling thread and to release the work buffers. The pool
+ * can be used by several instances.
+ *
+ * \return
+ *          - AACENC_OK, on success.
+ *          - AACENC_INVALID_HANDLE, AACENC_MEMORY_ERROR, on failure.
+ */
+AACENC_ERROR aacEncSetWorkerPool(const HANDLE_AACENCODER hAacEncoder,
+                                 HANDLE_FDK_WORKER_POOL hPool);
+
+/**
+ * \brief Pipeline the frames: the SBR encoder and the psychoacoustic model of
+ * frame N+1 run in parallel to the quantization and bitstream writing of frame
+ * N. Both stages are processed by the worker pool of aacEncSetWorkerPool() or
+ * in the calling thread if no pool is set. The bitstream is bit-exact, but
+ * aacEncEncode() returns each access unit one call later:
+ *   - The first call after enabling returns no output.
+ *   - The pending frame is returned by the flushing call (numInSamples=-1)
+ *     before AACENC_ENCODE_EOF is signaled.
+ *   - After a parameter change the pending frame is finished with the old
+ *     configuration. This call doesn't consume input samples.
+ *   .
+ * Ancillary data input is not supported in pipeline mode
+ * (AACENC_UNSUPPORTED_PARAMETER) and the MPS encoder (AAC-ELD v2) processes its
+ * frames without the pipeline. The second set of work buffers is allocated with
+ * the allocator of aacEncOpen().
+ *
+ * \param hAacEncoder  Encoder handle.
+ * \param enable       1 to enable the pipeline, 0 to disable it and to release
+ * the work buffers. Changes are not possible while a frame is pending.
+ *
+ * \return
+ *          - AACENC_OK, on success.
+ *          - AACENC_INVALID_HANDLE, AACENC_MEMORY_ERROR,
+ * AACENC_UNSUPPORTED_PARAMETER, on failure.
+ */
+AACENC_ERROR aacEncSetPipeline(const HANDLE_AACENCODER hAacEncoder,
+                               const UINT enable);
+
+/**
+ * \brief Get the timing of the most recent encoded frames (at most 64), oldest
+ * first.
+ *
+ * The time of the psychoacoustics (FDK_TRACE_PSY) and of the quantization and
+ * coding (FDK_TRACE_QC) is only measured if the library was built with
+ * FDK_TRACE=1 (cmake -DFDK_AAC_TRACE=ON), otherwise no frames are returned.
+ * Only aacEncEncode() calls which return an access unit are recorded. In
+ * pipeline mode FDK_TRACE_PSY is the time of the next frame. The function may
+ * be called from another thread while aacEncEncode() is running.
+ *
+ * \param hAacEncoder  Encoder handle.
+ * \param pFrames      Pointer to an array of maxFrames FDK_TRACE_FRAME.
+ * \param maxFrames    Size of the pFrames array.
+ *
+ * \return Number of frames written to pFrames.
+ */
+UINT aacEncGetTrace(const HANDLE_AACENCODER hAacEncoder,
+                    FDK_TRACE_FRAME *pFrames, const UINT maxFrames);
+
 /**
  * \brief Encode audio data.
  *
@@ -182,6 +182,40 @@ bail:
   return ErrorStatus;
 }
 
+/*****************************************************************************
+
+    functionname: FDKaacEnc_PsySetParallel
+    description:  allocates a private psyDynamic for each element, so that
+                  the elements can be processed in parallel; nElements 0
+                  releases them again
+    returns:      an error code
+    input:        pointer to a psych handle, number of elements
+
+*****************************************************************************/
+AAC_ENCODER_ERROR FDKaacEnc_PsySetParallel(PSY_INTERNAL *hPsy,
+                                           const INT nElements) {
+  INT i;
+
+  for (i = fMax(nElements, 1); i < ((8)); i++) {
+    if (hPsy->psyDynamicElement[i] != NULL) {
+      FreeRam_aacEnc_PsyDynamicElement(&hPsy->psyDynamicElement[i]);
+    }
+  }
+  hPsy->psyDynamicElement[0] = (nElements > 0) ? hPsy->psyDynamic : NULL;
+
+  for (i = 1; i < nElements; i++) {
+    if (hPsy->psyDynamicElement[i] == NULL) {
+      hPsy->psyDynamicElement[i] = GetRam_aacEnc_PsyDynamicElement(i);
+      if (hPsy->psyDynamicElement[i] == NULL) {
+        FDKaacEnc_PsySetParallel(hPsy, 0);
+        return AAC_ENC_NO_MEMORY;
+      }
+    }
+  }
+
+  return AAC_ENC_OK;
+}
+
 /*****************************************************************************
 
     functionname: FDKaacEnc_PsyOutNew
@@ -248,7 +282,7 @@ AAC_ENCODER_ERROR FDKaacEnc_psyInit(PSY_INTERNAL *hPsy, PSY_OUT **phpsyOut,
                                     const AUDIO_OBJECT_TYPE audioObjectType,
                                     CHANNEL_MAPPING *cm) {
   AAC_ENCODER_ERROR ErrorStatus = AAC_ENC_OK;
-  int i, ch, n, chInc = 0, resetChannels = 3;
+  int i, ch, chInc = 0, resetChannels = 3;
 
   if ((nMaxChannels > 2) && (cm->nChannels == 2)) {
     chInc = 1;
@@ -276,6 +310,22 @@ AAC_ENCODER_ERROR FDKaacEnc_psyInit(PSY_INTERNAL *hPsy, PSY_OUT **phpsyOut,
     }
   }
 
+  FDKaacEnc_PsyOutInit(phpsyOut, nSubFrames, cm);
+
+  return ErrorStatus;
+}
+
+/*****************************************************************************
+
+    functionname: FDKaacEnc_PsyOutInit
+    description:  assigns the channels of psyOut to the channel elements
+    input:        psyOut, number of sub frames, channel mapping
+
+*****************************************************************************/
+void FDKaacEnc_PsyOutInit(PSY_OUT **phpsyOut, const INT nSubFrames,
+                          const CHANNEL_MAPPING *cm) {
+  int i, ch, n, chInc;
+
   for (n = 0; n < nSubFrames; n++) {
     chInc = 0;
     for (i = 0; i < cm->nElements; i++) {
@@ -285,8 +335,6 @@ AAC_ENCODER_ERROR FDKaacEnc_psyInit(PSY_INTERNAL *hPsy, PSY_OUT **phpsyOut,
       }
     }
   }
-
-  return ErrorStatus;
 }
 
 /*****************************************************************************
@@ -1322,6 +1370,8 @@ void FDKaacEnc_PsyClose(PSY_INTERNAL **phPsyInternal, PSY_OUT **phPsyOut) {
               &hPsyInternal->psyElement[i]); /* PSY_ELEMENT */
       }
 
+      FDKaacEnc_PsySetParallel(hPsyInternal, 0); /* PSY_DYNAMIC */
+
       FreeRam_aacEnc_PsyInternal(phPsyInternal);
     }
   }
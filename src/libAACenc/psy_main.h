@@ -127,6 +127,9 @@ typedef struct {
   PSY_ELEMENT *psyElement[((8))];
   PSY_STATIC *pStaticChannels[(8)];
   PSY_DYNAMIC *psyDynamic;
+  PSY_DYNAMIC *psyDynamicElement[((8))]; /* psyDynamic of each element when
+                                            the elements are processed in
+                                            parallel, [0] is psyDynamic */
   INT granuleLength;
 
 } PSY_INTERNAL;
@@ -134,6 +137,9 @@ typedef struct {
 AAC_ENCODER_ERROR FDKaacEnc_PsyNew(PSY_INTERNAL **phpsy, const INT nElements,
                                    const INT nChannels, UCHAR *dynamic_RAM);
 
+AAC_ENCODER_ERROR FDKaacEnc_PsySetParallel(PSY_INTERNAL *hPsy,
+                                           const INT nElements);
+
 AAC_ENCODER_ERROR FDKaacEnc_PsyOutNew(PSY_OUT **phpsyOut, const INT nElements,
                                       const INT nChannels, const INT nSubFrames,
                                       UCHAR *dynamic_RAM);
@@ -144,6 +150,9 @@ AAC_ENCODER_ERROR FDKaacEnc_psyInit(PSY_INTERNAL *hPsy, PSY_OUT **phpsyOut,
                                     const AUDIO_OBJECT_TYPE audioObjectType,
                                     CHANNEL_MAPPING *cm);
 
+void FDKaacEnc_PsyOutInit(PSY_OUT **phpsyOut, const INT nSubFrames,
+                          const CHANNEL_MAPPING *cm);
+
 AAC_ENCODER_ERROR FDKaacEnc_psyMainInit(
     PSY_INTERNAL *hPsy, AUDIO_OBJECT_TYPE audioObjectType, CHANNEL_MAPPING *cm,
     INT sampleRate, INT granuleLength, INT bitRate, INT tnsMask, INT bandwidth,
@@ -0,0 +1,222 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/******************* Library for basic calculation routines ********************
+
+   Author(s):   arduino-fdk-aac contributors
+
+   Description: Runtime selection of the SIMD kernels
+
+*******************************************************************************/
+
+/** \file   FDK_dispatch.h
+    \brief  Table of the kernels which have SIMD versions for instruction set
+   extensions that the build cannot assume, e.g. AVX2 on x86-64. The entries
+   are NULL for the generic code and are filled once by FDKinitKernels(), which
+   aacDecoder_Open() and aacEncOpen() call. All entries are bit exact to the
+   generic code.
+ */
+
+#if !defined(FDK_DISPATCH_H)
+#define FDK_DISPATCH_H
+
+#include "libFDK/common_fix.h"
+#include "libFDK/FDK_tools_rom.h"
+#include "libSYS/FDK_cpu.h"
+
+typedef struct {
+  /* fft_rad2.cpp */
+  void (*dit_fft)(FIXP_DBL *x, const INT ldn, const FIXP_STP *trigdata,
+                  const INT trigDataSize);
+
+  /* fft.cpp */
+  void (*fft_apply_rot_vector)(FIXP_DBL *pData, const int cl, const int l,
+                               const FIXP_STB *pVecRe, const FIXP_STB *pVecIm);
+
+  /* scale.cpp */
+  void (*scaleValues_SGL)(FIXP_SGL *vector, INT len, INT scalefactor);
+  void (*scaleValues_DBL)(FIXP_DBL *vector, INT len, INT scalefactor);
+  void (*scaleValues_DBLDBL)(FIXP_DBL *dst, const FIXP_DBL *src, INT len,
+                             INT scalefactor);
+  void (*scaleValuesSaturate_DBL)(FIXP_DBL *vector, INT len, INT scalefactor);
+  void (*scaleValuesSaturate_DBL_DBL)(FIXP_DBL *dst, const FIXP_DBL *src,
+                                      INT len, INT scalefactor);
+  void (*scaleValuesSaturate_SGL_DBL)(FIXP_SGL *dst, const FIXP_DBL *src,
+                                      INT len, INT scalefactor);
+  void (*scaleValuesSaturate_SGL)(FIXP_SGL *vector, INT len, INT scalefactor);
+  void (*scaleValuesSaturate_SGL_SGL)(FIXP_SGL *dst, const FIXP_SGL *src,
+                                      INT len, INT scalefactor);
+  INT (*getScalefactor_DBL)(const FIXP_DBL *vector, INT len);
+  INT (*getScalefactor_SGL)(const FIXP_SGL *vector, INT len);
+
+  /* qmf.cpp */
+  void (*qmfSynPrototypeFir)(FIXP_DBL *states, FIXP_DBL *realSlot,
+                             const FIXP_DBL *imagSlot, const FIXP_PFT *p_flt,
+                             const FIXP_PFT *p_fltm, const INT pfltStep,
+                             const INT no_channels);
+  void (*qmfAnaPrototypeFirSlot)(FIXP_DBL *analysisBuffer, INT no_channels,
+                                 const FIXP_PFT *p_filter, INT p_stride,
+                                 FIXP_DBL *pFilterStates); /* 32 bit states */
+  void (*qmfForwardRotation)(FIXP_DBL *rSubband, FIXP_DBL *iSubband,
+                             const FIXP_QTW *t_cos, const FIXP_QTW *t_sin,
+                             const int len);
+
+  /* dct.cpp */
+  void (*dct_IV_preTwiddle)(FIXP_DBL *pDat, const int L,
+                            const FIXP_WTP *twiddle);
+  void (*dct_IV_postTwiddle)(FIXP_DBL *pDat, const int L,
+                             const FIXP_STP *sin_twiddle, const int sin_step);
+  void (*dst_IV_preTwiddle)(FIXP_DBL *pDat, const int L,
+                            const FIXP_WTP *twiddle);
+  void (*dst_IV_postTwiddle)(FIXP_DBL *pDat, const int L,
+                             const FIXP_STP *sin_twiddle, const int sin_step);
+
+  /* mdct.cpp */
+  void (*imdct_window_overlap)(FIXP_DBL *pOut0, FIXP_DBL *pOut1,
+                               const FIXP_DBL *pCurr, const FIXP_DBL *pOvl,
+                               const FIXP_WTP *pWindow, const int n,
+                               const int prevPrevAliasSymmetry,
+                               const int prevAliasSymmetry);
+
+  /* libPCMutils/pcm_utils.cpp, 1, 2, 6 or 8 channels */
+  void (*interleave_DBL)(const FIXP_DBL *pIn, LONG *pOut, const UINT channels,
+                         const UINT frameSize, const UINT length);
+  void (*interleave_SGL)(const FIXP_SGL *pIn, SHORT *pOut, const UINT channels,
+                         const UINT frameSize, const UINT length);
+  void (*deinterleave_DBL)(const LONG *pIn, LONG *pOut, const UINT channels,
+                           const UINT frameSize, const UINT length);
+  void (*deinterleave_SGL)(const SHORT *pIn, SHORT *pOut, const UINT channels,
+                           const UINT frameSize, const UINT length);
+  void (*interleaveSaturate)(const FIXP_DBL *pIn, SHORT *pOut,
+                             const UINT channels, const UINT frameSize,
+                             const UINT length, INT scalefactor);
+  void (*interleaveSaturateInt24)(const FIXP_DBL *pIn, LONG *pOut,
+                                  const UINT channels, const UINT frameSize,
+                                  const UINT length, INT scalefactor);
+  void (*interleaveFloat)(const FIXP_DBL *pIn, float *pOut,
+                          const UINT channels, const UINT frameSize,
+                          const UINT length, INT scalefactor);
+  void (*deinterleaveFloat)(const float *pIn, SHORT *pOut, const UINT channels,
+                            const UINT frameSize, const UINT length);
+  void (*deinterleaveInt24)(const LONG *pIn, SHORT *pOut, const UINT channels,
+                            const UINT frameSize, const UINT length);
+} FDK_KERNELS;
+
+extern FDK_KERNELS FDK_kernels;
+
+/**
+ *  Select the kernels for the features of the host CPU. Only the first call
+ * changes the table, further calls return immediately.
+ */
+void FDKinitKernels(void);
+
+/**
+ *  Select the kernels for the given CPU features. The generic code is used
+ * for all kernels with cpuFeatures = 0. Must not be called while other threads
+ * use the library.
+ *
+ * \param cpuFeatures  Combination of the FDK_CPU_* flags of FDK_cpu.h.
+ */
+void FDKselectKernels(const UINT cpuFeatures);
+
+/* Kernels of the modules, called by FDKselectKernels() */
+void ditFftSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures);
+void fftSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures);
+void scaleSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures);
+void qmfSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures);
+void dctSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures);
+void mdctSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures);
+void pcmUtilsSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures);
+
+#endif /* FDK_DISPATCH_H */
@@ -393,6 +393,7 @@ QMF_DOMAIN_ERROR FDK_QmfDomain_ClearPersistentMemory(
         FDKmemclear(hqd->QmfDomainIn[ch].pOverlapBuffer,
                     size * sizeof(FIXP_DBL));
       }
+      FDKmemclear(&hqd->QmfDomainIn[ch].scaling, sizeof(QMF_SCALE_FACTOR));
     }
     if (FDK_QmfDomain_InitFilterBank(hqd, 0)) {
       err = QMF_DOMAIN_INIT_ERROR;
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "libFDK/FDK_archdef.h"
+#include "libSYS/machine_type.h"
+
+#if defined(__GNUC__)
+
+/* clz on ARMv5 and later, a libgcc helper on Cortex-M0 */
+#define FUNCTION_fixnormz_D
+inline INT fixnormz_D(LONG value) {
+  return (value != 0) ? __builtin_clz((UINT)value) : 32;
+}
+
+/* number of redundant sign bits (cls on AArch64): 31 for -1 */
+#define FUNCTION_fixnorm_D
+inline INT fixnorm_D(LONG value) {
+  return (value != 0) ? __builtin_clrsb((INT)value) : 0;
+}
+
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "libFDK/common_fix.h"
+
+/* 32 bit cores with DSP instructions: the packed twiddle factor is loaded once
+ * and smulwb/smulwt select its halves. The products are truncated before the
+ * addition like in the generic code. */
+#if defined(__GNUC__) && defined(__ARM_FEATURE_DSP) && \
+    !defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN)
+
+#define FUNCTION_cplxMultDiv2_32x16
+inline void cplxMultDiv2(FIXP_DBL *c_Re, FIXP_DBL *c_Im, const FIXP_DBL a_Re,
+                         const FIXP_DBL a_Im, const FIXP_SPK w) {
+  LONG tr1, tr2, ti1;
+
+  __asm__("smulwb %0, %1, %2" : "=r"(tr1) : "r"(a_Re), "r"(w.w));
+  __asm__("smulwt %0, %1, %2" : "=r"(tr2) : "r"(a_Im), "r"(w.w));
+  __asm__("smulwt %0, %1, %2" : "=r"(ti1) : "r"(a_Re), "r"(w.w));
+  __asm__("smlawb %0, %1, %2, %3" : "=r"(ti1) : "r"(a_Im), "r"(w.w), "r"(ti1));
+
+  *c_Re = tr1 - tr2;
+  *c_Im = ti1;
+}
+
+#define FUNCTION_cplxMult_32x16
+inline void cplxMult(FIXP_DBL *c_Re, FIXP_DBL *c_Im, const FIXP_DBL a_Re,
+                     const FIXP_DBL a_Im, const FIXP_SPK w) {
+  LONG tr1, tr2, ti1;
+
+  __asm__("smulwb %0, %1, %2" : "=r"(tr1) : "r"(a_Re), "r"(w.w));
+  __asm__("smulwt %0, %1, %2" : "=r"(tr2) : "r"(a_Im), "r"(w.w));
+  __asm__("smulwt %0, %1, %2" : "=r"(ti1) : "r"(a_Re), "r"(w.w));
+  __asm__("smlawb %0, %1, %2, %3" : "=r"(ti1) : "r"(a_Im), "r"(w.w), "r"(ti1));
+
+  *c_Re = (tr1 - tr2) << 1;
+  *c_Im = ti1 << 1;
+}
+
+#endif /* __ARM_FEATURE_DSP */
@@ -0,0 +1,271 @@
+#pragma once
+
+/* NEON versions of the pre- and post-twiddles of dct_IV() and dst_IV():
+ * included by dct.cpp and selected at runtime by dctSelectKernels(). The
+ * results are bit exact to the generic functions. */
+
+#if defined(SINETABLE_16BIT) && defined(WINDOWTABLE_16BIT) && \
+    (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+
+/* The 16 bit twiddle factors c are held as c << 15 in 32 bit lanes: vqdmulh
+ * gives (x * c * 2^15) >> 31 == fMultDiv2(x, c) and never saturates. */
+
+/* negate the lanes 1 and 3 */
+static inline int32x4_t dct_conj_neon(const int32x4_t x) {
+  const int32x4_t mask = vcombine_s32(vcreate_s32(0xFFFFFFFF00000000ULL),
+                                      vcreate_s32(0xFFFFFFFF00000000ULL));
+  return vsubq_s32(veorq_s32(x, mask), mask);
+}
+
+/* negate the lane 3 */
+static inline int32x4_t dct_neg3_neon(const int32x4_t x) {
+  const int32x4_t mask =
+      vcombine_s32(vdup_n_s32(0), vcreate_s32(0xFFFFFFFF00000000ULL));
+  return vsubq_s32(veorq_s32(x, mask), mask);
+}
+
+/* Rotation of the 2 complex values (x0, x1), (x2, x3) by the twiddle factors
+ * t = (re0, im0, re1, im1):
+ * (x0*re0 + x1*im0, x1*re0 - x0*im0, x2*re1 + x3*im1, x3*re1 - x2*im1), each
+ * product truncated by fMultDiv2(). */
+static inline int32x4_t dct_rotate_neon(const int32x4_t x, const int16x4_t t) {
+  /* (re0, re0, re1, re1), (im0, im0, im1, im1) */
+  const int16x4x2_t c = vtrn_s16(t, t);
+
+  return vaddq_s32(
+      vqdmulhq_s32(x, vshll_n_s16(c.val[0], 15)),
+      dct_conj_neon(vqdmulhq_s32(vrev64q_s32(x), vshll_n_s16(c.val[1], 15))));
+}
+
+/* One step of the pre-twiddle loops: (pDat_0[0], pDat_1[1]) with twiddle[i]
+ * and (pDat_0[1], pDat_1[0]) with twiddle[i + 1]. The result is (pDat_0[0],
+ * pDat_0[1], pDat_1[0], -pDat_1[1]) of the generic code. */
+static inline int32x4_t dct_pre_twiddle_neon(const FIXP_DBL *pDat_0,
+                                             const FIXP_DBL *pDat_1,
+                                             const FIXP_WTP *twiddle,
+                                             const int dst) {
+  const int32x2x2_t z = vzip_s32(vld1_s32((const int32_t *)pDat_0),
+                                 vrev64_s32(vld1_s32((const int32_t *)pDat_1)));
+  const int16x4_t t = vld1_s16((const int16_t *)twiddle);
+  int32x4_t x = vcombine_s32(z.val[0], z.val[1]);
+
+  if (dst) {
+    /* the input halved and negated like in the generic code */
+    const int32x4_t mask = vcombine_s32(vcreate_s32(0x00000000FFFFFFFFULL),
+                                        vcreate_s32(0xFFFFFFFF00000000ULL));
+    x = vsubq_s32(veorq_s32(vshrq_n_s32(x, 1), mask), mask);
+    return dct_rotate_neon(x, t);
+  }
+  return vshrq_n_s32(dct_rotate_neon(x, t), 1);
+}
+
+#define FUNCTION_dct_IV_preTwiddle_neon
+static void dct_IV_preTwiddle_neon(FIXP_DBL *pDat, const int L,
+                                   const FIXP_WTP *twiddle) {
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  int M = L >> 1;
+  int i;
+
+  for (i = 0; i < M - 1; i += 2, pDat_0 += 2, pDat_1 -= 2) {
+    const int32x4_t v =
+        dct_neg3_neon(dct_pre_twiddle_neon(pDat_0, pDat_1, &twiddle[i], 0));
+    vst1_s32((int32_t *)pDat_0, vget_low_s32(v));
+    vst1_s32((int32_t *)pDat_1, vget_high_s32(v));
+  }
+  if (M & 1) {
+    FIXP_DBL accu1, accu2;
+
+    accu1 = pDat_1[1];
+    accu2 = pDat_0[0];
+
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
+  }
+}
+
+#define FUNCTION_dst_IV_preTwiddle_neon
+static void dst_IV_preTwiddle_neon(FIXP_DBL *pDat, const int L,
+                                   const FIXP_WTP *twiddle) {
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  int M = L >> 1;
+  int i;
+
+  for (i = 0; i < M - 1; i += 2, pDat_0 += 2, pDat_1 -= 2) {
+    const int32x4_t v =
+        dct_neg3_neon(dct_pre_twiddle_neon(pDat_0, pDat_1, &twiddle[i], 1));
+    vst1_s32((int32_t *)pDat_0, vget_low_s32(v));
+    vst1_s32((int32_t *)pDat_1, vget_high_s32(v));
+  }
+  if (M & 1) {
+    FIXP_DBL accu1, accu2;
+
+    accu1 = pDat_1[1];
+    accu2 = -pDat_0[0];
+
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
+  }
+}
+
+/* Two steps i, i+1 of the post-twiddle loops, see dct_post_twiddle_sse():
+ *   fr = (a4, a3) of F_i[1], F_i[0] with twd of step i and of F_(i+1)
+ *        with twd of step i+1
+ *   br = (a4, a3) of B_i[0], B_i[1] with twd of step i+1 and of B_(i-1)
+ *        with twd of step i */
+static inline void dct_post_twiddle_neon(int32x4_t *fr, int32x4_t *br,
+                                         const FIXP_DBL *pDat_0,
+                                         const FIXP_DBL *pDat_1,
+                                         const FIXP_STP *sin_twiddle,
+                                         const int idx, const int sin_step) {
+  const int32x2_t tw = vset_lane_s32(sin_twiddle[idx + sin_step].w,
+                                     vdup_n_s32(sin_twiddle[idx].w), 1);
+
+  /* fMult() == fMultDiv2() << 1 */
+  *fr = vshlq_n_s32(dct_rotate_neon(vld1q_s32((const int32_t *)pDat_0),
+                                    vreinterpret_s16_s32(tw)),
+                    1);
+  *br = vshlq_n_s32(
+      dct_rotate_neon(vrev64q_s32(vld1q_s32((const int32_t *)pDat_1)),
+                      vreinterpret_s16_s32(vrev64_s32(tw))),
+      1);
+}
+
+#define FUNCTION_dct_IV_postTwiddle_neon
+static void dct_IV_postTwiddle_neon(FIXP_DBL *pDat, const int L,
+                                    const FIXP_STP *sin_twiddle,
+                                    const int sin_step) {
+  FIXP_DBL *RESTRICT pDat_0;
+  FIXP_DBL *RESTRICT pDat_1;
+  FIXP_DBL accu1, accu2, accu3, accu4;
+  FIXP_DBL carry; /* B_(i-1)[1], stored with the next step */
+  int M = L >> 1;
+  int idx, i;
+
+  carry = -pDat[1];
+
+  for (i = 1; i + 1 < (M + 1) >> 1; i += 2) {
+    int32x4_t fr, br, nfr;
+
+    dct_post_twiddle_neon(&fr, &br, &pDat[2 * i], &pDat[L - 2 - 2 * i],
+                          sin_twiddle, i * sin_step, sin_step);
+    nfr = vnegq_s32(fr);
+
+    /* F_(i-1)[1], F_i[0], F_i[1], F_(i+1)[0] */
+    vst1q_s32((int32_t *)&pDat[2 * i - 1],
+              vtrnq_s32(vextq_s32(br, br, 3), fr).val[0]);
+    /* B_i[0], B_i[1], B_(i-1)[0], B_(i-1)[1] */
+    vst1q_s32(
+        (int32_t *)&pDat[L - 2 - 2 * i],
+        vtrnq_s32(br, vsetq_lane_s32(carry, vextq_s32(nfr, nfr, 1), 2)).val[0]);
+    carry = vgetq_lane_s32(nfr, 3);
+  }
+
+  pDat_0 = &pDat[2 * i - 2];
+  pDat_1 = &pDat[L - 2 * i];
+  accu1 = pDat_1[0];
+  accu2 = pDat_1[1];
+  pDat_1[1] = carry;
+
+  for (idx = i * sin_step; i<(M + 1)>> 1; i++, idx += sin_step) {
+    FIXP_STP twd = sin_twiddle[idx];
+    cplxMult(&accu3, &accu4, accu1, accu2, twd);
+    pDat_0[1] = accu3;
+    pDat_1[0] = accu4;
+
+    pDat_0 += 2;
+    pDat_1 -= 2;
+
+    cplxMult(&accu3, &accu4, pDat_0[1], pDat_0[0], twd);
+
+    accu1 = pDat_1[0];
+    accu2 = pDat_1[1];
+
+    pDat_1[1] = -accu3;
+    pDat_0[0] = accu4;
+  }
+
+  if ((M & 1) == 0) {
+    /* Last Sin and Cos value pair are the same */
+    accu1 = fMult(accu1, WTC(0x5a82799a));
+    accu2 = fMult(accu2, WTC(0x5a82799a));
+
+    pDat_1[0] = accu1 + accu2;
+    pDat_0[1] = accu1 - accu2;
+  }
+}
+
+#define FUNCTION_dst_IV_postTwiddle_neon
+static void dst_IV_postTwiddle_neon(FIXP_DBL *pDat, const int L,
+                                    const FIXP_STP *sin_twiddle,
+                                    const int sin_step) {
+  FIXP_DBL *RESTRICT pDat_0;
+  FIXP_DBL *RESTRICT pDat_1;
+  FIXP_DBL accu1, accu2, accu3, accu4;
+  FIXP_DBL carry; /* B_(i-1)[1], stored with the next step */
+  int M = L >> 1;
+  int idx, i;
+
+  carry = -pDat[0];
+  pDat[0] = pDat[1];
+
+  for (i = 1; i + 1 < (M + 1) >> 1; i += 2) {
+    int32x4_t fr, br, nfr, nbr;
+
+    dct_post_twiddle_neon(&fr, &br, &pDat[2 * i], &pDat[L - 2 - 2 * i],
+                          sin_twiddle, i * sin_step, sin_step);
+    nfr = vnegq_s32(fr);
+    nbr = vnegq_s32(br);
+
+    /* F_(i-1)[1], F_i[0], F_i[1], F_(i+1)[0] */
+    vst1q_s32((int32_t *)&pDat[2 * i - 1],
+              vtrnq_s32(vextq_s32(nbr, nbr, 2), vextq_s32(fr, fr, 1)).val[0]);
+    /* B_i[0], B_i[1], B_(i-1)[0], B_(i-1)[1] */
+    vst1q_s32((int32_t *)&pDat[L - 2 - 2 * i],
+              vtrnq_s32(vextq_s32(nbr, nbr, 1), vsetq_lane_s32(carry, nfr, 2))
+                  .val[0]);
+    carry = vgetq_lane_s32(nfr, 2);
+  }
+
+  pDat_0 = &pDat[2 * i - 2];
+  pDat_1 = &pDat[L - 2 * i];
+  accu1 = pDat_1[0];
+  accu2 = pDat_1[1];
+  pDat_1[1] = carry;
+
+  for (idx = i * sin_step; i<(M + 1)>> 1; i++, idx += sin_step) {
+    FIXP_STP twd = sin_twiddle[idx];
+
+    cplxMult(&accu3, &accu4, accu1, accu2, twd);
+    pDat_1[0] = -accu3;
+    pDat_0[1] = -accu4;
+
+    pDat_0 += 2;
+    pDat_1 -= 2;
+
+    cplxMult(&accu3, &accu4, pDat_0[1], pDat_0[0], twd);
+
+    accu1 = pDat_1[0];
+    accu2 = pDat_1[1];
+
+    pDat_0[0] = accu3;
+    pDat_1[1] = -accu4;
+  }
+
+  if ((M & 1) == 0) {
+    /* Last Sin and Cos value pair are the same */
+    accu1 = fMult(accu1, WTC(0x5a82799a));
+    accu2 = fMult(accu2, WTC(0x5a82799a));
+
+    pDat_0[1] = -accu1 - accu2;
+    pDat_1[0] = accu2 - accu1;
+  }
+}
+
+#endif /* SINETABLE_16BIT && WINDOWTABLE_16BIT && __ARM_NEON */
@@ -0,0 +1,54 @@
+#pragma once
+
+/* NEON versions of functions of fft.cpp: included there and selected at runtime
+ * by fftSelectKernels(). The results are bit exact to the generic functions. */
+
+#if defined(SINETABLE_16BIT) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+
+#define FUNCTION_fft_apply_rot_vector_neon
+static void fft_apply_rot_vector_neon(FIXP_DBL *RESTRICT pData, const int cl,
+                                      const int l, const FIXP_STB *pVecRe,
+                                      const FIXP_STB *pVecIm) {
+  const int32x4_t mask = vcombine_s32(vcreate_s32(0xFFFFFFFF00000000ULL),
+                                      vcreate_s32(0xFFFFFFFF00000000ULL));
+  FIXP_DBL re, im;
+
+  int i, c;
+
+  for (i = 0; i < cl; i++) {
+    pData[2 * i] >>= 2;     /* * 0.25 */
+    pData[2 * i + 1] >>= 2; /* * 0.25 */
+  }
+  for (; i < l; i += cl) {
+    pData[2 * i] >>= 2;     /* * 0.25 */
+    pData[2 * i + 1] >>= 2; /* * 0.25 */
+
+    /* 2 values per step, the factors are scaled by 2^15:
+     * vqdmulh(x, v * 2^15) == fMultDiv2(x, v) */
+    for (c = i + 1; c < i + cl - 1; c += 2) {
+      int32x4_t x = vshrq_n_s32(vld1q_s32((int32_t *)&pData[2 * c]), 1);
+      int32x4_t vre = vcombine_s32(vdup_n_s32((INT)pVecRe[0] << 15),
+                                   vdup_n_s32((INT)pVecRe[1] << 15));
+      int32x4_t vim = vcombine_s32(vdup_n_s32((INT)pVecIm[0] << 15),
+                                   vdup_n_s32((INT)pVecIm[1] << 15));
+      pVecRe += 2;
+      pVecIm += 2;
+
+      /* (re*vre, im*vre) + (im*vim, -re*vim) */
+      int32x4_t y = vqdmulhq_s32(vrev64q_s32(x), vim);
+      x = vqdmulhq_s32(x, vre);
+      vst1q_s32((int32_t *)&pData[2 * c],
+                vaddq_s32(x, vsubq_s32(veorq_s32(y, mask), mask)));
+    }
+    if (c < i + cl) {
+      re = pData[2 * c] >> 1;
+      im = pData[2 * c + 1] >> 1;
+
+      cplxMultDiv2(&pData[2 * c + 1], &pData[2 * c], im, re, *pVecRe++,
+                   *pVecIm++);
+    }
+  }
+}
+
+#endif /* SINETABLE_16BIT && __ARM_NEON */
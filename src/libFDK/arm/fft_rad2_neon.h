@@ -0,0 +1,123 @@
+#pragma once
+
+/* NEON version of dit_fft(): included by fft_rad2.cpp and selected at runtime
+ * by ditFftSelectKernels(). The results are bit exact to the generic
+ * function. */
+
+#if defined(SINETABLE_16BIT) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+
+/* The twiddle factors t are held as 32 bit values t * 2^15: vqdmulh gives
+ * (x * t * 2^15) >> 31 == fMultDiv2(x, t) and the factor 1.0 of the first
+ * butterfly of each stage becomes exact, (x * 2^30) >> 31 == x >> 1. */
+
+/* negate the imaginary parts */
+static inline int32x4_t dit_fft_conj_neon(const int32x4_t x) {
+  const int32x4_t mask = vcombine_s32(vcreate_s32(0xFFFFFFFF00000000ULL),
+                                      vcreate_s32(0xFFFFFFFF00000000ULL));
+  return vsubq_s32(veorq_s32(x, mask), mask);
+}
+
+/* Butterflies of 2 complex values x1, x2 with v = (re2*c + im2*s, im2*c -
+ * re2*s): x1 = x1/2 + v, x2 = x1/2 - v. The second half of a group (formB)
+ * uses v rotated by -90 degrees. */
+static inline void dit_fft_bfly_neon(FIXP_DBL *x1, FIXP_DBL *x2,
+                                     const int32x4_t c, const int32x4_t s,
+                                     const int formB) {
+  int32x4_t a = vld1q_s32((int32_t *)x2);
+  int32x4_t u = vshrq_n_s32(vld1q_s32((int32_t *)x1), 1);
+  int32x4_t v = vaddq_s32(vqdmulhq_s32(a, c),
+                          dit_fft_conj_neon(vqdmulhq_s32(vrev64q_s32(a), s)));
+  if (formB) {
+    v = dit_fft_conj_neon(vrev64q_s32(v));
+  }
+  vst1q_s32((int32_t *)x1, vaddq_s32(u, v));
+  vst1q_s32((int32_t *)x2, vsubq_s32(u, v));
+}
+
+/* Twiddle factors (scaled by 2^15) of the butterflies k and k + mh/2 of a
+ * stage, 0 <= k < mh/2. The generic code handles k > mh/4 with the factor of
+ * mh/2 - k and cos and sin swapped. */
+static inline void dit_fft_twiddle(INT *c, INT *s, const INT k, const INT mh,
+                                   const FIXP_STP *trigdata,
+                                   const INT trigstep) {
+  if (k == 0) {
+    *c = 1 << 30;
+    *s = 0;
+  } else if (k < (mh >> 2)) {
+    *c = (INT)trigdata[k * trigstep].v.re << 15;
+    *s = (INT)trigdata[k * trigstep].v.im << 15;
+  } else if (k == (mh >> 2)) {
+    *c = *s = (INT)STC(0x5a82799a) << 15;
+  } else {
+    *c = (INT)trigdata[((mh >> 1) - k) * trigstep].v.im << 15;
+    *s = (INT)trigdata[((mh >> 1) - k) * trigstep].v.re << 15;
+  }
+}
+
+#define FUNCTION_dit_fft_neon
+static void dit_fft_neon(FIXP_DBL *x, const INT ldn, const FIXP_STP *trigdata,
+                         const INT trigDataSize) {
+  const INT n = 1 << ldn;
+  INT i, ldm;
+
+  C_ALLOC_ALIGNED_CHECK(x);
+
+  scramble(x, n);
+
+  /*
+   * 1+2 stage radix 4: A,B and C,D of 4 complex values are in one register
+   */
+  {
+    const int32x4_t maskB =
+        vcombine_s32(vdup_n_s32(0), vdup_n_s32((int32_t)0xFFFFFFFF));
+    const int32x4_t maskD =
+        vcombine_s32(vdup_n_s32(0), vcreate_s32(0xFFFFFFFF00000000ULL));
+
+    for (i = 0; i < n * 2; i += 8) {
+      int32x4_t ab = vld1q_s32((int32_t *)&x[i]);
+      int32x4_t cd = vld1q_s32((int32_t *)&x[i + 4]);
+
+      /* (A + B)/2, (A + B)/2 - B */
+      ab = vsubq_s32(vshrq_n_s32(vaddq_s32(ab, vextq_s32(ab, ab, 2)), 1),
+                     vandq_s32(ab, maskB));
+      /* (C + D)/2, (Im C - Im D, -Re C + Re D) */
+      cd = vsubq_s32(vshrq_n_s32(vaddq_s32(cd, vextq_s32(cd, cd, 2)), 1),
+                     vandq_s32(cd, maskB));
+      cd = vcombine_s32(vget_low_s32(cd), vrev64_s32(vget_high_s32(cd)));
+      cd = vsubq_s32(veorq_s32(cd, maskD), maskD);
+
+      vst1q_s32((int32_t *)&x[i], vaddq_s32(ab, cd));     /* A', B' */
+      vst1q_s32((int32_t *)&x[i + 4], vsubq_s32(ab, cd)); /* C', D' */
+    }
+  }
+
+  for (ldm = 3; ldm <= ldn; ++ldm) {
+    const INT m = (1 << ldm);
+    const INT mh = (m >> 1);
+    const INT trigstep = ((trigDataSize << 2) >> ldm);
+    INT k, r;
+
+    FDK_ASSERT(trigstep > 0);
+
+    for (k = 0; k < mh / 2; k += 2) {
+      INT c0, s0, c1, s1;
+
+      dit_fft_twiddle(&c0, &s0, k, mh, trigdata, trigstep);
+      dit_fft_twiddle(&c1, &s1, k + 1, mh, trigdata, trigstep);
+      const int32x4_t c =
+          vcombine_s32(vdup_n_s32((int32_t)c0), vdup_n_s32((int32_t)c1));
+      const int32x4_t s =
+          vcombine_s32(vdup_n_s32((int32_t)s0), vdup_n_s32((int32_t)s1));
+
+      for (r = 0; r < n; r += m) {
+        FIXP_DBL *x1 = &x[(r + k) << 1];
+
+        dit_fft_bfly_neon(x1, x1 + m, c, s, 0);
+        dit_fft_bfly_neon(x1 + mh, x1 + mh + m, c, s, 1);
+      }
+    }
+  }
+}
+
+#endif /* SINETABLE_16BIT && __ARM_NEON */
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "libFDK/FDK_archdef.h"
+#include "libSYS/machine_type.h"
+
+/* The 32x32 multiplication is exact on ARM: the bit exact variants are the
+ * same functions. */
+#define FUNCTION_fixmuldiv2BitExact_DD
+#define FUNCTION_fixmulBitExact_DD
+#define FUNCTION_fixmulBitExact_SD
+#define FUNCTION_fixmulBitExact_DS
+#define fixmuldiv2BitExact_DD(a, b) fixmuldiv2_DD(a, b)
+#define fixmulBitExact_DD(a, b) fixmul_DD(a, b)
+#define fixmulBitExact_SD(a, b) fixmul_SD(a, b)
+#define fixmulBitExact_DS(a, b) fixmul_DS(a, b)
+
+/* 32 bit cores with DSP instructions (ARMv5TE and later, Cortex-M4/M7). The
+ * compiler doesn't use them for the generic code. AArch64 uses smull. */
+#if defined(__GNUC__) && defined(__ARM_FEATURE_DSP) && !defined(__aarch64__)
+
+#define FUNCTION_fixmuldiv2_DD
+inline LONG fixmuldiv2_DD(const LONG a, const LONG b) {
+  LONG result;
+#if (__ARM_ARCH >= 6)
+  __asm__("smmul %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+#else
+  LONG discard;
+  __asm__("smull %0, %1, %2, %3"
+          : "=&r"(discard), "=&r"(result)
+          : "r"(a), "r"(b));
+#endif
+  return result;
+}
+
+/* bits 47..16 of the 32x16 product */
+#define FUNCTION_fixmuldiv2_DS
+inline LONG fixmuldiv2_DS(const LONG a, const SHORT b) {
+  LONG result;
+  __asm__("smulwb %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+  return result;
+}
+
+#endif /* __ARM_FEATURE_DSP */
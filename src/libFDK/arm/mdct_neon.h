@@ -0,0 +1,72 @@
+#pragma once
+
+/* NEON version of the windowing and overlap-add of imlt_block(): included by
+ * mdct.cpp and selected at runtime by mdctSelectKernels(). The result is bit
+ * exact to the generic function. */
+
+#if defined(WINDOWTABLE_16BIT) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+
+/* Remaining samples i .. n-1 of imdct_window_overlap() */
+static inline void imdct_window_overlap_tail(
+    FIXP_DBL *pOut0, FIXP_DBL *pOut1, const FIXP_DBL *pCurr,
+    const FIXP_DBL *pOvl, const FIXP_WTP *pWindow, int i, const int n,
+    const int prevPrevAliasSymmetry, const int prevAliasSymmetry) {
+  for (; i < n; i++) {
+    FIXP_DBL x0, x1;
+    cplxMultDiv2(&x1, &x0, pCurr[i],
+                 (prevPrevAliasSymmetry == 0) ? -pOvl[-i] : pOvl[-i],
+                 pWindow[i]);
+    pOut0[i] = IMDCT_SCALE_DBL_LSH1(x0);
+    pOut1[-i] = IMDCT_SCALE_DBL_LSH1((prevAliasSymmetry == 0) ? -x1 : x1);
+  }
+}
+
+/* IMDCT_SCALE_DBL_LSH1(): x << 1 saturated to 0x7FFFFFFF and 0x80000001 */
+static inline int32x4_t imdct_lsh1_neon(const int32x4_t x) {
+  return vmaxq_s32(vqshlq_n_s32(x, 1), vdupq_n_s32(MINVAL_DBL + 1));
+}
+
+/* reverse the order of the lanes */
+static inline int32x4_t imdct_reverse_neon(const int32x4_t x) {
+  const int32x4_t r = vrev64q_s32(x);
+  return vextq_s32(r, r, 2);
+}
+
+/* The window coefficients w are held as w << 15 in 32 bit lanes: vqdmulh gives
+ * (x * w * 2^15) >> 31 == fMultDiv2(x, w) and never saturates. */
+#define FUNCTION_imdct_window_overlap_neon
+static void imdct_window_overlap_neon(FIXP_DBL *pOut0, FIXP_DBL *pOut1,
+                                      const FIXP_DBL *pCurr,
+                                      const FIXP_DBL *pOvl,
+                                      const FIXP_WTP *pWindow, const int n,
+                                      const int prevPrevAliasSymmetry,
+                                      const int prevAliasSymmetry) {
+  /* negation as (x ^ mask) - mask */
+  const int32x4_t maskOvl = vdupq_n_s32((prevPrevAliasSymmetry == 0) ? -1 : 0);
+  const int32x4_t maskX1 = vdupq_n_s32((prevAliasSymmetry == 0) ? -1 : 0);
+  int i;
+
+  for (i = 0; i < n - 3; i += 4) {
+    const int16x4x2_t w = vld2_s16((const int16_t *)&pWindow[i]);
+    const int32x4_t wRe = vshll_n_s16(w.val[0], 15);
+    const int32x4_t wIm = vshll_n_s16(w.val[1], 15);
+    const int32x4_t curr = vld1q_s32((const int32_t *)&pCurr[i]);
+    const int32x4_t ovl = vsubq_s32(
+        veorq_s32(imdct_reverse_neon(
+                      vld1q_s32((const int32_t *)&pOvl[-i - 3])),
+                  maskOvl),
+        maskOvl);
+    /* cplxMultDiv2(&x1, &x0, curr, ovl, w) */
+    int32x4_t x1 = vsubq_s32(vqdmulhq_s32(curr, wRe), vqdmulhq_s32(ovl, wIm));
+    int32x4_t x0 = vaddq_s32(vqdmulhq_s32(curr, wIm), vqdmulhq_s32(ovl, wRe));
+
+    vst1q_s32((int32_t *)&pOut0[i], imdct_lsh1_neon(x0));
+    x1 = imdct_lsh1_neon(vsubq_s32(veorq_s32(x1, maskX1), maskX1));
+    vst1q_s32((int32_t *)&pOut1[-i - 3], imdct_reverse_neon(x1));
+  }
+  imdct_window_overlap_tail(pOut0, pOut1, pCurr, pOvl, pWindow, i, n,
+                            prevPrevAliasSymmetry, prevAliasSymmetry);
+}
+
+#endif /* WINDOWTABLE_16BIT && __ARM_NEON */
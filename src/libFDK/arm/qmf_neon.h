@@ -0,0 +1,148 @@
+#pragma once
+
+/* NEON versions of the prototype filters and the analysis rotation of
+ * qmf.cpp: included there and selected at runtime by qmfSelectKernels(). The
+ * results are bit exact to the generic functions. */
+
+#if defined(QMF_COEFF_16BIT) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+
+/* The 16 bit coefficients c are held as c << 15 in 32 bit lanes: vqdmulh gives
+ * (x * c * 2^15) >> 31 == fMultDiv2(x, c) and never saturates. */
+
+/* One band per step: the states sta[0..7] are updated from sta[1..8] with the
+ * coefficients (p_flt[4], p_fltm[1], p_flt[3], p_fltm[2]) and (p_flt[2],
+ * p_fltm[3], p_flt[1], p_fltm[4]) applied alternately to imag and real. */
+#define FUNCTION_qmfSynPrototypeFir_neon
+static void qmfSynPrototypeFir_neon(FIXP_DBL *RESTRICT sta,
+                                    FIXP_DBL *RESTRICT realSlot,
+                                    const FIXP_DBL *RESTRICT imagSlot,
+                                    const FIXP_PFT *RESTRICT p_flt,
+                                    const FIXP_PFT *RESTRICT p_fltm,
+                                    const INT pfltStep, const INT no_channels) {
+  int j;
+
+  for (j = no_channels - 1; j >= 0; j--) {
+    const FIXP_DBL imag = imagSlot[j];
+    const FIXP_DBL real = realSlot[j];
+    const int16x4x2_t c =
+        vzip_s16(vrev64_s16(vld1_s16((const int16_t *)&p_flt[1])),
+                 vld1_s16((const int16_t *)&p_fltm[1]));
+    const int32x2_t x2 = vset_lane_s32(real, vdup_n_s32(imag), 1);
+    const int32x4_t x = vcombine_s32(x2, x2);
+
+    realSlot[j] = fMultAddDiv2(sta[0], p_fltm[0], real);
+
+    vst1q_s32((int32_t *)&sta[0],
+              vaddq_s32(vld1q_s32((const int32_t *)&sta[1]),
+                        vqdmulhq_s32(x, vshll_n_s16(c.val[0], 15))));
+    vst1q_s32((int32_t *)&sta[4],
+              vaddq_s32(vld1q_s32((const int32_t *)&sta[5]),
+                        vqdmulhq_s32(x, vshll_n_s16(c.val[1], 15))));
+    sta[8] = fMultDiv2(p_flt[0], imag);
+
+    p_flt += pfltStep;
+    p_fltm -= pfltStep;
+    sta += 2 * QMF_NO_POLY - 1;
+  }
+}
+
+/* Coefficients p = 0..4 of the 4 coefficient sets flt, flt + step, ...,
+ * flt + 3 * step, each shifted left by 15 into the lanes of c[p]. */
+static inline void qmf_coeff_transpose_neon(int32x4_t *c, const FIXP_PFT *flt,
+                                            const INT step) {
+  const int16x4x2_t z02 = vzip_s16(vld1_s16((const int16_t *)&flt[0 * step]),
+                                   vld1_s16((const int16_t *)&flt[2 * step]));
+  const int16x4x2_t z13 = vzip_s16(vld1_s16((const int16_t *)&flt[1 * step]),
+                                   vld1_s16((const int16_t *)&flt[3 * step]));
+  const int16x4x2_t c01 = vzip_s16(z02.val[0], z13.val[0]);
+  const int16x4x2_t c23 = vzip_s16(z02.val[1], z13.val[1]);
+  const INT c4[4] = {(INT)flt[4] << 15, (INT)flt[1 * step + 4] << 15,
+                     (INT)flt[2 * step + 4] << 15,
+                     (INT)flt[3 * step + 4] << 15};
+
+  c[0] = vshll_n_s16(c01.val[0], 15);
+  c[1] = vshll_n_s16(c01.val[1], 15);
+  c[2] = vshll_n_s16(c23.val[0], 15);
+  c[3] = vshll_n_s16(c23.val[1], 15);
+  c[4] = vld1q_s32((const int32_t *)c4);
+}
+
+/* 4 bands k per step, the coefficient sets of neighboring bands are
+ * QMF_NO_POLY * p_stride apart. */
+#define FUNCTION_qmfAnaPrototypeFirSlot_neon
+static void qmfAnaPrototypeFirSlot_neon(FIXP_DBL *analysisBuffer,
+                                        INT no_channels,
+                                        const FIXP_PFT *p_filter, INT p_stride,
+                                        FIXP_DBL *RESTRICT pFilterStates) {
+  const INT pfltStep = QMF_NO_POLY * p_stride;
+  const INT staStep = no_channels << 1;
+  const FIXP_DBL *sta_0 = pFilterStates;
+  const FIXP_DBL *sta_1 = pFilterStates + (2 * QMF_NO_POLY * no_channels) - 4;
+  FIXP_DBL *pData_0 = analysisBuffer + 2 * no_channels - 4;
+  FIXP_DBL *pData_1 = analysisBuffer;
+  INT k, p;
+
+  FDK_ASSERT((no_channels & 3) == 0);
+
+  for (k = 0; k < no_channels; k += 4) {
+    const FIXP_PFT *p_flt = p_filter + k * pfltStep;
+    int32x4_t c_0[QMF_NO_POLY], c_1[QMF_NO_POLY];
+    int32x4_t accu_0 = vdupq_n_s32(0);
+    int32x4_t accu_1 = vdupq_n_s32(0);
+
+    /* bands k .. k+3 use the sets k .. k+3 with sta_1 and the sets
+     * k+1 .. k+4 with sta_0 */
+    qmf_coeff_transpose_neon(c_1, p_flt, pfltStep);
+    qmf_coeff_transpose_neon(c_0, p_flt + pfltStep, pfltStep);
+
+    for (p = 0; p < QMF_NO_POLY; p++) {
+      /* sta_1 runs backwards */
+      int32x4_t s1 = vrev64q_s32(
+          vld1q_s32((const int32_t *)(sta_1 - p * staStep)));
+      accu_1 = vaddq_s32(accu_1,
+                         vqdmulhq_s32(vextq_s32(s1, s1, 2), c_1[p]));
+      accu_0 = vaddq_s32(
+          accu_0, vqdmulhq_s32(vld1q_s32((const int32_t *)(sta_0 + p * staStep)),
+                               c_0[p]));
+    }
+
+    vst1q_s32((int32_t *)pData_1, vshlq_n_s32(accu_1, 1));
+    accu_0 = vrev64q_s32(vshlq_n_s32(accu_0, 1));
+    vst1q_s32((int32_t *)pData_0, vextq_s32(accu_0, accu_0, 2));
+
+    sta_0 += 4;
+    sta_1 -= 4;
+    pData_0 -= 4;
+    pData_1 += 4;
+  }
+}
+
+/* cplxMult() of 4 bands per step, fMult() = fMultDiv2() << 1 */
+#define FUNCTION_qmfForwardRotation_neon
+static void qmfForwardRotation_neon(FIXP_DBL *RESTRICT rSubband,
+                                    FIXP_DBL *RESTRICT iSubband,
+                                    const FIXP_QTW *t_cos,
+                                    const FIXP_QTW *t_sin, const int len) {
+  int i;
+
+  for (i = 0; i < len - 3; i += 4) {
+    const int32x4_t c = vshll_n_s16(vld1_s16((const int16_t *)&t_cos[i]), 15);
+    const int32x4_t s = vshll_n_s16(vld1_s16((const int16_t *)&t_sin[i]), 15);
+    const int32x4_t re = vld1q_s32((const int32_t *)&rSubband[i]);
+    const int32x4_t im = vld1q_s32((const int32_t *)&iSubband[i]);
+
+    vst1q_s32((int32_t *)&iSubband[i],
+              vshlq_n_s32(vsubq_s32(vqdmulhq_s32(im, c), vqdmulhq_s32(re, s)),
+                          1));
+    vst1q_s32((int32_t *)&rSubband[i],
+              vshlq_n_s32(vaddq_s32(vqdmulhq_s32(im, s), vqdmulhq_s32(re, c)),
+                          1));
+  }
+  for (; i < len; i++) {
+    cplxMult(&iSubband[i], &rSubband[i], iSubband[i], rSubband[i], t_cos[i],
+             t_sin[i]);
+  }
+}
+
+#endif /* QMF_COEFF_16BIT && __ARM_NEON */
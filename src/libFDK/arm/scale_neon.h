@@ -0,0 +1,213 @@
+#pragma once
+
+/* NEON versions of the vector functions of scale.cpp: included there and
+ * selected at runtime by scaleSelectKernels(). The results are bit exact to the
+ * generic functions. */
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+
+/* scaleValueSaturate() of 4 values, scalefactor in range -31 ... +31 */
+static inline int32x4_t scaleValueSaturate_neon(const int32x4_t value,
+                                                const int32x4_t shift,
+                                                const INT scalefactor) {
+  if (scalefactor >= 0) {
+    /* vqshl saturates to 0x8000.0000 instead of 0x8000.0001 */
+    return vmaxq_s32(vqshlq_s32(value, shift),
+                     vdupq_n_s32((INT)MINVAL_DBL + 1));
+  } else {
+    /* values which would become -1 are cleared */
+    int32x4_t result = vshlq_s32(value, shift);
+    return vbicq_s32(result, vreinterpretq_s32_u32(
+                                 vceqq_s32(result, vdupq_n_s32(-1))));
+  }
+}
+
+#define FUNCTION_scaleValues_SGL_neon
+static void scaleValues_SGL_neon(FIXP_SGL *vector, INT len, INT scalefactor) {
+  INT i;
+
+  if (scalefactor == 0) return;
+
+  /* vshl shifts right for negative counts */
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)FRACT_BITS - 1),
+                         (INT) - (FRACT_BITS - 1));
+  const int16x8_t shift = vdupq_n_s16((SHORT)scalefactor);
+
+  for (i = len >> 3; i--; vector += 8) {
+    vst1q_s16((int16_t *)vector, vshlq_s16(vld1q_s16((int16_t *)vector), shift));
+  }
+  for (i = len & 7; i--; vector++) {
+    if (scalefactor > 0) {
+      *vector <<= scalefactor;
+    } else {
+      *vector >>= -scalefactor;
+    }
+  }
+}
+
+#define FUNCTION_scaleValues_DBLDBL_neon
+static void scaleValues_DBLDBL_neon(FIXP_DBL *dst, const FIXP_DBL *src,
+                                    INT len, INT scalefactor) {
+  INT i;
+
+  if (scalefactor == 0) {
+    if (dst != src) FDKmemmove(dst, src, len * sizeof(FIXP_DBL));
+    return;
+  }
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const int32x4_t shift = vdupq_n_s32(scalefactor);
+
+  for (i = len >> 2; i--; dst += 4, src += 4) {
+    vst1q_s32((int32_t *)dst, vshlq_s32(vld1q_s32((const int32_t *)src), shift));
+  }
+  for (i = len & 3; i--; dst++, src++) {
+    *dst = (scalefactor > 0) ? (*src << scalefactor) : (*src >> -scalefactor);
+  }
+}
+
+#define FUNCTION_scaleValues_DBL_neon
+static void scaleValues_DBL_neon(FIXP_DBL *vector, INT len, INT scalefactor) {
+  scaleValues_DBLDBL_neon(vector, vector, len, scalefactor);
+}
+
+#define FUNCTION_scaleValuesSaturate_DBL_DBL_neon
+static void scaleValuesSaturate_DBL_DBL_neon(FIXP_DBL *dst,
+                                             const FIXP_DBL *src, INT len,
+                                             INT scalefactor) {
+  INT i;
+
+  if (scalefactor == 0) {
+    FDKmemmove(dst, src, len * sizeof(FIXP_DBL));
+    return;
+  }
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const int32x4_t shift = vdupq_n_s32(scalefactor);
+
+  for (i = len >> 2; i--; dst += 4, src += 4) {
+    vst1q_s32((int32_t *)dst,
+              scaleValueSaturate_neon(vld1q_s32((const int32_t *)src), shift,
+                                      scalefactor));
+  }
+  for (i = len & 3; i--;) {
+    *(dst++) = scaleValueSaturate(*(src++), scalefactor);
+  }
+}
+
+#define FUNCTION_scaleValuesSaturate_DBL_neon
+static void scaleValuesSaturate_DBL_neon(FIXP_DBL *vector, INT len,
+                                         INT scalefactor) {
+  if (scalefactor == 0) return;
+
+  scaleValuesSaturate_DBL_DBL_neon(vector, vector, len, scalefactor);
+}
+
+#define FUNCTION_scaleValuesSaturate_SGL_DBL_neon
+static void scaleValuesSaturate_SGL_DBL_neon(FIXP_SGL *dst,
+                                             const FIXP_DBL *src, INT len,
+                                             INT scalefactor) {
+  INT i;
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const int32x4_t shift = vdupq_n_s32(scalefactor);
+  const int32x4_t round = vdupq_n_s32(0x8000);
+  const int32x4_t max = vdupq_n_s32((INT)MAXVAL_DBL >> 1);
+
+  for (i = len >> 2; i--; dst += 4, src += 4) {
+    int32x4_t value = scaleValueSaturate_neon(vld1q_s32((const int32_t *)src),
+                                              shift, scalefactor);
+    /* fAddSaturate(): ((value >> 1) + 0x4000) saturated and shifted back */
+    value = vminq_s32(vhaddq_s32(value, round), max);
+    vst1_s16((int16_t *)dst, vshrn_n_s32(value, 15));
+  }
+  for (i = len & 3; i--;) {
+    *(dst++) = FX_DBL2FX_SGL(fAddSaturate(
+        scaleValueSaturate(*(src++), scalefactor), (FIXP_DBL)0x8000));
+  }
+}
+
+#define FUNCTION_scaleValuesSaturate_SGL_SGL_neon
+static void scaleValuesSaturate_SGL_SGL_neon(FIXP_SGL *dst,
+                                             const FIXP_SGL *src, INT len,
+                                             INT scalefactor) {
+  INT i;
+
+  if (scalefactor == 0) {
+    FDKmemmove(dst, src, len * sizeof(FIXP_SGL));
+    return;
+  }
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const int32x4_t shift = vdupq_n_s32(scalefactor);
+
+  for (i = len >> 2; i--; dst += 4, src += 4) {
+    int32x4_t value = vshll_n_s16(vld1_s16((const int16_t *)src), 16);
+    value = scaleValueSaturate_neon(value, shift, scalefactor);
+    vst1_s16((int16_t *)dst, vshrn_n_s32(value, 16));
+  }
+  for (i = len & 3; i--;) {
+    *(dst++) = FX_DBL2FX_SGL(
+        scaleValueSaturate(FX_SGL2FX_DBL(*(src++)), scalefactor));
+  }
+}
+
+#define FUNCTION_scaleValuesSaturate_SGL_neon
+static void scaleValuesSaturate_SGL_neon(FIXP_SGL *vector, INT len,
+                                         INT scalefactor) {
+  if (scalefactor == 0) return;
+
+  scaleValuesSaturate_SGL_SGL_neon(vector, vector, len, scalefactor);
+}
+
+#define FUNCTION_getScalefactor_DBL_neon
+static INT getScalefactor_DBL_neon(const FIXP_DBL *vector, INT len) {
+  INT i;
+  int32x4_t maxVal4 = vdupq_n_s32(0);
+  int32x2_t maxVal2;
+  FIXP_DBL temp, maxVal;
+
+  for (i = len >> 2; i--; vector += 4) {
+    int32x4_t value = vld1q_s32((const int32_t *)vector);
+    maxVal4 = vorrq_s32(maxVal4, veorq_s32(value, vshrq_n_s32(value, 31)));
+  }
+  maxVal2 = vorr_s32(vget_low_s32(maxVal4), vget_high_s32(maxVal4));
+  maxVal = (FIXP_DBL)(vget_lane_s32(maxVal2, 0) | vget_lane_s32(maxVal2, 1));
+
+  for (i = len & 3; i--;) {
+    temp = *vector++;
+    maxVal |= (FIXP_DBL)((LONG)temp ^ (LONG)(temp >> (DFRACT_BITS - 1)));
+  }
+
+  return fixmax_I((INT)0, (INT)(fixnormz_D(maxVal) - 1));
+}
+
+#define FUNCTION_getScalefactor_SGL_neon
+static INT getScalefactor_SGL_neon(const FIXP_SGL *vector, INT len) {
+  INT i;
+  int16x8_t maxVal8 = vdupq_n_s16(0);
+  int16x4_t maxVal4;
+  SHORT temp, maxVal;
+
+  for (i = len >> 3; i--; vector += 8) {
+    int16x8_t value = vld1q_s16((const int16_t *)vector);
+    maxVal8 = vorrq_s16(maxVal8, veorq_s16(value, vshrq_n_s16(value, 15)));
+  }
+  maxVal4 = vorr_s16(vget_low_s16(maxVal8), vget_high_s16(maxVal8));
+  maxVal = vget_lane_s16(maxVal4, 0) | vget_lane_s16(maxVal4, 1) |
+           vget_lane_s16(maxVal4, 2) | vget_lane_s16(maxVal4, 3);
+
+  for (i = len & 7; i--;) {
+    temp = (SHORT)(*vector++);
+    maxVal |= (temp ^ (temp >> (FRACT_BITS - 1)));
+  }
+
+  return fixmax_I((INT)0, (INT)(fixnormz_S((FIXP_SGL)maxVal)) - 1);
+}
+
+#endif /* __ARM_NEON */
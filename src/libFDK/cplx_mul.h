@@ -105,10 +105,11 @@ amm-info@iis.fraunhofer.de
 
 #include "libFDK/common_fix.h"
 
-// #if defined(__arm__) || defined(_M_ARM)
-// #include "arm/cplx_mul_arm.h"
+#if defined(__arm__)
+#include "libFDK/arm/cplx_mul_arm.h"
+#endif
 
-// #elif defined(__GNUC__) && defined(__mips__) && __mips_isa_rev < 6
+// #if defined(__GNUC__) && defined(__mips__) && __mips_isa_rev < 6
 // #include "mips/cplx_mul_mips.h"
 
 // #endif /* #if defined all cores: bfin, arm, etc. */
@@ -123,6 +123,15 @@ amm-info@iis.fraunhofer.de
 
 #include "libFDK/FDK_tools_rom.h"
 #include "libFDK/fft.h"
+#include "libFDK/FDK_dispatch.h"
+
+#if defined(__x86__)
+#include "libFDK/x86/dct_x86.h"
+
+#elif defined(__arm__)
+#include "libFDK/arm/dct_neon.h"
+
+#endif
 
 void dct_getTables(const FIXP_WTP **ptwiddle, const FIXP_STP **sin_twiddle,
                    int *sin_step, int length) {
@@ -370,104 +379,102 @@ void dct_II(
 
 #if !defined(FUNCTION_dct_IV)
 
-void dct_IV(FIXP_DBL *pDat, int L, int *pDat_e) {
-  int sin_step = 0;
+/* Pre-twiddle of dct_IV(): the pairs pDat[i], pDat[L-1-i] are multiplied by
+ * twiddle[i] and scaled by 0.5. */
+static void dct_IV_preTwiddle(FIXP_DBL *pDat, const int L,
+                              const FIXP_WTP *twiddle) {
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
   int M = L >> 1;
+  int i;
 
-  const FIXP_WTP *twiddle;
-  const FIXP_STP *sin_twiddle;
+  if (FDK_kernels.dct_IV_preTwiddle != NULL) {
+    FDK_kernels.dct_IV_preTwiddle(pDat, L, twiddle);
+    return;
+  }
 
-  FDK_ASSERT(L >= 4);
+  /* 29 cycles on ARM926 */
+  for (i = 0; i < M - 1; i += 2, pDat_0 += 2, pDat_1 -= 2) {
+    FIXP_DBL accu1, accu2, accu3, accu4;
 
-  FDK_ASSERT(L >= 4);
+    accu1 = pDat_1[1];
+    accu2 = pDat_0[0];
+    accu3 = pDat_0[1];
+    accu4 = pDat_1[0];
 
-  dct_getTables(&twiddle, &sin_twiddle, &sin_step, L);
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+    cplxMultDiv2(&accu3, &accu4, accu4, accu3, twiddle[i + 1]);
 
-  {
-    FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
-    FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
-    int i;
-
-    /* 29 cycles on ARM926 */
-    for (i = 0; i < M - 1; i += 2, pDat_0 += 2, pDat_1 -= 2) {
-      FIXP_DBL accu1, accu2, accu3, accu4;
-
-      accu1 = pDat_1[1];
-      accu2 = pDat_0[0];
-      accu3 = pDat_0[1];
-      accu4 = pDat_1[0];
-
-      cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
-      cplxMultDiv2(&accu3, &accu4, accu4, accu3, twiddle[i + 1]);
-
-      pDat_0[0] = accu2 >> 1;
-      pDat_0[1] = accu1 >> 1;
-      pDat_1[0] = accu4 >> 1;
-      pDat_1[1] = -(accu3 >> 1);
-    }
-    if (M & 1) {
-      FIXP_DBL accu1, accu2;
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
+    pDat_1[0] = accu4 >> 1;
+    pDat_1[1] = -(accu3 >> 1);
+  }
+  if (M & 1) {
+    FIXP_DBL accu1, accu2;
 
-      accu1 = pDat_1[1];
-      accu2 = pDat_0[0];
+    accu1 = pDat_1[1];
+    accu2 = pDat_0[0];
 
-      cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
 
-      pDat_0[0] = accu2 >> 1;
-      pDat_0[1] = accu1 >> 1;
-    }
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
   }
+}
 
-  fft(M, pDat, pDat_e);
+/* Post-twiddle of dct_IV(): the FFT output is multiplied by
+ * sin_twiddle[i * sin_step] and reordered. */
+static void dct_IV_postTwiddle(FIXP_DBL *pDat, const int L,
+                               const FIXP_STP *sin_twiddle,
+                               const int sin_step) {
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  FIXP_DBL accu1, accu2, accu3, accu4;
+  int M = L >> 1;
+  int idx, i;
 
-  {
-    FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
-    FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
-    FIXP_DBL accu1, accu2, accu3, accu4;
-    int idx, i;
+  if (FDK_kernels.dct_IV_postTwiddle != NULL) {
+    FDK_kernels.dct_IV_postTwiddle(pDat, L, sin_twiddle, sin_step);
+    return;
+  }
 
-    /* Sin and Cos values are 0.0f and 1.0f */
-    accu1 = pDat_1[0];
-    accu2 = pDat_1[1];
+  /* Sin and Cos values are 0.0f and 1.0f */
+  accu1 = pDat_1[0];
+  accu2 = pDat_1[1];
 
-    pDat_1[1] = -pDat_0[1];
+  pDat_1[1] = -pDat_0[1];
 
-    /* 28 cycles for ARM926 */
-    for (idx = sin_step, i = 1; i<(M + 1)>> 1; i++, idx += sin_step) {
-      FIXP_STP twd = sin_twiddle[idx];
-      cplxMult(&accu3, &accu4, accu1, accu2, twd);
-      pDat_0[1] = accu3;
-      pDat_1[0] = accu4;
+  /* 28 cycles for ARM926 */
+  for (idx = sin_step, i = 1; i<(M + 1)>> 1; i++, idx += sin_step) {
+    FIXP_STP twd = sin_twiddle[idx];
+    cplxMult(&accu3, &accu4, accu1, accu2, twd);
+    pDat_0[1] = accu3;
+    pDat_1[0] = accu4;
 
-      pDat_0 += 2;
-      pDat_1 -= 2;
+    pDat_0 += 2;
+    pDat_1 -= 2;
 
-      cplxMult(&accu3, &accu4, pDat_0[1], pDat_0[0], twd);
+    cplxMult(&accu3, &accu4, pDat_0[1], pDat_0[0], twd);
 
-      accu1 = pDat_1[0];
-      accu2 = pDat_1[1];
+    accu1 = pDat_1[0];
+    accu2 = pDat_1[1];
 
-      pDat_1[1] = -accu3;
-      pDat_0[0] = accu4;
-    }
+    pDat_1[1] = -accu3;
+    pDat_0[0] = accu4;
+  }
 
-    if ((M & 1) == 0) {
-      /* Last Sin and Cos value pair are the same */
-      accu1 = fMult(accu1, WTC(0x5a82799a));
-      accu2 = fMult(accu2, WTC(0x5a82799a));
+  if ((M & 1) == 0) {
+    /* Last Sin and Cos value pair are the same */
+    accu1 = fMult(accu1, WTC(0x5a82799a));
+    accu2 = fMult(accu2, WTC(0x5a82799a));
 
-      pDat_1[0] = accu1 + accu2;
-      pDat_0[1] = accu1 - accu2;
-    }
+    pDat_1[0] = accu1 + accu2;
+    pDat_0[1] = accu1 - accu2;
   }
-
-  /* Add twiddeling scale. */
-  *pDat_e += 2;
 }
-#endif /* defined (FUNCTION_dct_IV) */
 
-#if !defined(FUNCTION_dst_IV)
-void dst_IV(FIXP_DBL *pDat, int L, int *pDat_e) {
+void dct_IV(FIXP_DBL *pDat, int L, int *pDat_e) {
   int sin_step = 0;
   int M = L >> 1;
 
@@ -480,89 +487,162 @@ void dst_IV(FIXP_DBL *pDat, int L, int *pDat_e) {
 
   dct_getTables(&twiddle, &sin_twiddle, &sin_step, L);
 
-  {
-    FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
-    FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
-    int i;
-
-    /* 34 cycles on ARM926 */
-    for (i = 0; i < M - 1; i += 2, pDat_0 += 2, pDat_1 -= 2) {
-      FIXP_DBL accu1, accu2, accu3, accu4;
-
-      accu1 = pDat_1[1] >> 1;
-      accu2 = -(pDat_0[0] >> 1);
-      accu3 = pDat_0[1] >> 1;
-      accu4 = -(pDat_1[0] >> 1);
-
-      cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
-      cplxMultDiv2(&accu3, &accu4, accu4, accu3, twiddle[i + 1]);
-
-      pDat_0[0] = accu2;
-      pDat_0[1] = accu1;
-      pDat_1[0] = accu4;
-      pDat_1[1] = -accu3;
-    }
-    if (M & 1) {
-      FIXP_DBL accu1, accu2;
+  dct_IV_preTwiddle(pDat, L, twiddle);
 
-      accu1 = pDat_1[1];
-      accu2 = -pDat_0[0];
+  fft(M, pDat, pDat_e);
 
-      cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+  dct_IV_postTwiddle(pDat, L, sin_twiddle, sin_step);
 
-      pDat_0[0] = accu2 >> 1;
-      pDat_0[1] = accu1 >> 1;
-    }
-  }
+  /* Add twiddeling scale. */
+  *pDat_e += 2;
+}
+#endif /* defined (FUNCTION_dct_IV) */
 
-  fft(M, pDat, pDat_e);
+#if !defined(FUNCTION_dst_IV)
 
-  {
-    FIXP_DBL *RESTRICT pDat_0;
-    FIXP_DBL *RESTRICT pDat_1;
+/* Pre-twiddle of dst_IV(), like dct_IV_preTwiddle() with the odd input values
+ * negated. */
+static void dst_IV_preTwiddle(FIXP_DBL *pDat, const int L,
+                              const FIXP_WTP *twiddle) {
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  int M = L >> 1;
+  int i;
+
+  if (FDK_kernels.dst_IV_preTwiddle != NULL) {
+    FDK_kernels.dst_IV_preTwiddle(pDat, L, twiddle);
+    return;
+  }
+
+  /* 34 cycles on ARM926 */
+  for (i = 0; i < M - 1; i += 2, pDat_0 += 2, pDat_1 -= 2) {
     FIXP_DBL accu1, accu2, accu3, accu4;
-    int idx, i;
 
-    pDat_0 = &pDat[0];
-    pDat_1 = &pDat[L - 2];
+    accu1 = pDat_1[1] >> 1;
+    accu2 = -(pDat_0[0] >> 1);
+    accu3 = pDat_0[1] >> 1;
+    accu4 = -(pDat_1[0] >> 1);
+
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+    cplxMultDiv2(&accu3, &accu4, accu4, accu3, twiddle[i + 1]);
+
+    pDat_0[0] = accu2;
+    pDat_0[1] = accu1;
+    pDat_1[0] = accu4;
+    pDat_1[1] = -accu3;
+  }
+  if (M & 1) {
+    FIXP_DBL accu1, accu2;
+
+    accu1 = pDat_1[1];
+    accu2 = -pDat_0[0];
+
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
+  }
+}
+
+/* Post-twiddle of dst_IV(), like dct_IV_postTwiddle() with the output in
+ * reversed order. */
+static void dst_IV_postTwiddle(FIXP_DBL *pDat, const int L,
+                               const FIXP_STP *sin_twiddle,
+                               const int sin_step) {
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  FIXP_DBL accu1, accu2, accu3, accu4;
+  int M = L >> 1;
+  int idx, i;
+
+  if (FDK_kernels.dst_IV_postTwiddle != NULL) {
+    FDK_kernels.dst_IV_postTwiddle(pDat, L, sin_twiddle, sin_step);
+    return;
+  }
+
+  /* Sin and Cos values are 0.0f and 1.0f */
+  accu1 = pDat_1[0];
+  accu2 = pDat_1[1];
+
+  pDat_1[1] = -pDat_0[0];
+  pDat_0[0] = pDat_0[1];
+
+  for (idx = sin_step, i = 1; i<(M + 1)>> 1; i++, idx += sin_step) {
+    FIXP_STP twd = sin_twiddle[idx];
+
+    cplxMult(&accu3, &accu4, accu1, accu2, twd);
+    pDat_1[0] = -accu3;
+    pDat_0[1] = -accu4;
+
+    pDat_0 += 2;
+    pDat_1 -= 2;
+
+    cplxMult(&accu3, &accu4, pDat_0[1], pDat_0[0], twd);
 
-    /* Sin and Cos values are 0.0f and 1.0f */
     accu1 = pDat_1[0];
     accu2 = pDat_1[1];
 
-    pDat_1[1] = -pDat_0[0];
-    pDat_0[0] = pDat_0[1];
+    pDat_0[0] = accu3;
+    pDat_1[1] = -accu4;
+  }
 
-    for (idx = sin_step, i = 1; i<(M + 1)>> 1; i++, idx += sin_step) {
-      FIXP_STP twd = sin_twiddle[idx];
+  if ((M & 1) == 0) {
+    /* Last Sin and Cos value pair are the same */
+    accu1 = fMult(accu1, WTC(0x5a82799a));
+    accu2 = fMult(accu2, WTC(0x5a82799a));
 
-      cplxMult(&accu3, &accu4, accu1, accu2, twd);
-      pDat_1[0] = -accu3;
-      pDat_0[1] = -accu4;
+    pDat_0[1] = -accu1 - accu2;
+    pDat_1[0] = accu2 - accu1;
+  }
+}
 
-      pDat_0 += 2;
-      pDat_1 -= 2;
+void dst_IV(FIXP_DBL *pDat, int L, int *pDat_e) {
+  int sin_step = 0;
+  int M = L >> 1;
 
-      cplxMult(&accu3, &accu4, pDat_0[1], pDat_0[0], twd);
+  const FIXP_WTP *twiddle;
+  const FIXP_STP *sin_twiddle;
 
-      accu1 = pDat_1[0];
-      accu2 = pDat_1[1];
+  FDK_ASSERT(L >= 4);
 
-      pDat_0[0] = accu3;
-      pDat_1[1] = -accu4;
-    }
+  FDK_ASSERT(L >= 4);
 
-    if ((M & 1) == 0) {
-      /* Last Sin and Cos value pair are the same */
-      accu1 = fMult(accu1, WTC(0x5a82799a));
-      accu2 = fMult(accu2, WTC(0x5a82799a));
+  dct_getTables(&twiddle, &sin_twiddle, &sin_step, L);
 
-      pDat_0[1] = -accu1 - accu2;
-      pDat_1[0] = accu2 - accu1;
-    }
-  }
+  dst_IV_preTwiddle(pDat, L, twiddle);
+
+  fft(M, pDat, pDat_e);
+
+  dst_IV_postTwiddle(pDat, L, sin_twiddle, sin_step);
 
   /* Add twiddeling scale. */
   *pDat_e += 2;
 }
 #endif /* !defined(FUNCTION_dst_IV) */
+
+void dctSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures) {
+#if defined(FUNCTION_dct_IV_preTwiddle_sse41)
+  if (cpuFeatures & FDK_CPU_SSE41) {
+    kernels->dct_IV_preTwiddle = dct_IV_preTwiddle_sse41;
+    kernels->dct_IV_postTwiddle = dct_IV_postTwiddle_sse41;
+    kernels->dst_IV_preTwiddle = dst_IV_preTwiddle_sse41;
+    kernels->dst_IV_postTwiddle = dst_IV_postTwiddle_sse41;
+  }
+#endif
+#if defined(FUNCTION_dct_IV_preTwiddle_avx2)
+  if (cpuFeatures & FDK_CPU_AVX2) {
+    kernels->dct_IV_preTwiddle = dct_IV_preTwiddle_avx2;
+    kernels->dst_IV_preTwiddle = dst_IV_preTwiddle_avx2;
+  }
+#endif
+#if defined(FUNCTION_dct_IV_preTwiddle_neon)
+  if (cpuFeatures & FDK_CPU_NEON) {
+    kernels->dct_IV_preTwiddle = dct_IV_preTwiddle_neon;
+    kernels->dct_IV_postTwiddle = dct_IV_postTwiddle_neon;
+    kernels->dst_IV_preTwiddle = dst_IV_preTwiddle_neon;
+    kernels->dst_IV_postTwiddle = dst_IV_postTwiddle_neon;
+  }
+#endif
+  (void)kernels;
+  (void)cpuFeatures;
+}
@@ -102,6 +102,15 @@ amm-info@iis.fraunhofer.de
 
 #include "libFDK/fft_rad2.h"
 #include "libFDK/FDK_tools_rom.h"
+#include "libFDK/FDK_dispatch.h"
+
+#if defined(__x86__)
+#include "libFDK/x86/fft_x86.h"
+
+#elif defined(__arm__)
+#include "libFDK/arm/fft_neon.h"
+
+#endif
 
 #define W_PiFOURTH STC(0x5a82799a)
 //#define W_PiFOURTH ((FIXP_DBL)(0x5a82799a))
@@ -1545,6 +1554,11 @@ static inline void fft_apply_rot_vector(FIXP_DBL *RESTRICT pData, const int cl,
 
   int i, c;
 
+  if (FDK_kernels.fft_apply_rot_vector != NULL) {
+    FDK_kernels.fft_apply_rot_vector(pData, cl, l, pVecRe, pVecIm);
+    return;
+  }
+
   for (i = 0; i < cl; i++) {
     re = pData[2 * i];
     im = pData[2 * i + 1];
@@ -1920,3 +1934,18 @@ void ifft(int length, FIXP_DBL *pInput, INT *scalefactor) {
       break;
   }
 }
+
+void fftSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures) {
+#if defined(FUNCTION_fft_apply_rot_vector_sse41)
+  if (cpuFeatures & FDK_CPU_SSE41) {
+    kernels->fft_apply_rot_vector = fft_apply_rot_vector_sse41;
+  }
+#endif
+#if defined(FUNCTION_fft_apply_rot_vector_neon)
+  if (cpuFeatures & FDK_CPU_NEON) {
+    kernels->fft_apply_rot_vector = fft_apply_rot_vector_neon;
+  }
+#endif
+  (void)kernels;
+  (void)cpuFeatures;
+}
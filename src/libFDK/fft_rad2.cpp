@@ -103,16 +103,20 @@ amm-info@iis.fraunhofer.de
 #include "libFDK/fft_rad2.h"
 
 #include "libFDK/scramble.h"
+#include "libFDK/FDK_dispatch.h"
 
 #define __FFT_RAD2_CPP__
 
-// #if defined(__arm__)
-// #include "arm/fft_rad2_arm.cpp"
+#if defined(__x86__)
+#include "libFDK/x86/fft_rad2_x86.h"
+
+#elif defined(__arm__)
+#include "libFDK/arm/fft_rad2_neon.h"
 
 // #elif defined(__GNUC__) && defined(__mips__) && defined(__mips_dsp) && !defined(__mips16)
 // #include "mips/fft_rad2_mips.cpp"
 
-// #endif
+#endif
 
 /*****************************************************************************
 
@@ -133,6 +137,11 @@ void dit_fft(FIXP_DBL *x, const INT ldn, const FIXP_STP *trigdata,
   const INT n = 1 << ldn;
   INT trigstep, i, ldm;
 
+  if (FDK_kernels.dit_fft != NULL) {
+    FDK_kernels.dit_fft(x, ldn, trigdata, trigDataSize);
+    return;
+  }
+
   C_ALLOC_ALIGNED_CHECK(x);
 
   scramble(x, n);
@@ -322,3 +331,23 @@ void dit_fft(FIXP_DBL *x, const INT ldn, const FIXP_STP *trigdata,
 }
 
 #endif
+
+void ditFftSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures) {
+#if defined(FUNCTION_dit_fft_sse41)
+  if (cpuFeatures & FDK_CPU_SSE41) {
+    kernels->dit_fft = dit_fft_sse41;
+  }
+#endif
+#if defined(FUNCTION_dit_fft_avx2)
+  if (cpuFeatures & FDK_CPU_AVX2) {
+    kernels->dit_fft = dit_fft_avx2;
+  }
+#endif
+#if defined(FUNCTION_dit_fft_neon)
+  if (cpuFeatures & FDK_CPU_NEON) {
+    kernels->dit_fft = dit_fft_neon;
+  }
+#endif
+  (void)kernels;
+  (void)cpuFeatures;
+}
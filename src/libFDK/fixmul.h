@@ -109,17 +109,15 @@ amm-info@iis.fraunhofer.de
 
 #if defined(__xtensa__)
 #include "libFDK/xtensa/fixmul_xtensa.h"
+#elif defined(__x86__)
+#include "libFDK/x86/fixmul_x86.h"
+#elif defined(__arm__)
+#include "libFDK/arm/fixmul_arm.h"
 #endif
 
-// #if defined(__arm__)
-// #include "arm/fixmul_arm.h"
-
-// #elif defined(__mips__)
+// #if defined(__mips__)
 // #include "mips/fixmul_mips.h"
 
-// #elif defined(__x86__)
-// #include "x86/fixmul_x86.h"
-
 // #elif defined(__powerpc__)
 // #include "ppc/fixmul_ppc.h"
 
@@ -105,6 +105,15 @@ amm-info@iis.fraunhofer.de
 #include "libFDK/FDK_tools_rom.h"
 #include "libFDK/dct.h"
 #include "libFDK/fixpoint_math.h"
+#include "libFDK/FDK_dispatch.h"
+
+#if defined(__x86__)
+#include "libFDK/x86/mdct_x86.h"
+
+#elif defined(__arm__)
+#include "libFDK/arm/mdct_neon.h"
+
+#endif
 
 void mdct_init(H_MDCT hMdct, FIXP_DBL *overlap, INT overlapBufferSize) {
   hMdct->overlap.freq = overlap;
@@ -418,6 +427,69 @@ void imdct_adapt_parameters(H_MDCT hMdct, int *pfl, int *pnl, int tl,
   *pnl = nl;
 }
 
+/*
+Windowing and overlap-add around the window crossing point of imlt_block(): the
+current half pCurr[0..n-1] and the overlap pOvl[0..-(n-1)] are combined with
+the window slope into pOut0[0..n-1] and pOut1[0..-(n-1)]. The aliasing
+symmetries of the previous windows select the signs of the overlap and of the
+second output.
+*/
+static void imdct_window_overlap(FIXP_DBL *pOut0, FIXP_DBL *pOut1,
+                                 const FIXP_DBL *pCurr, const FIXP_DBL *pOvl,
+                                 const FIXP_WTP *pWindow, const int n,
+                                 const int prevPrevAliasSymmetry,
+                                 const int prevAliasSymmetry) {
+  int i;
+
+  if (FDK_kernels.imdct_window_overlap != NULL) {
+    FDK_kernels.imdct_window_overlap(pOut0, pOut1, pCurr, pOvl, pWindow, n,
+                                     prevPrevAliasSymmetry, prevAliasSymmetry);
+    return;
+  }
+
+  if (prevPrevAliasSymmetry == 0) {
+    if (prevAliasSymmetry == 0) {
+      for (i = 0; i < n; i++) {
+        FIXP_DBL x0, x1;
+        cplxMultDiv2(&x1, &x0, *pCurr++, -*pOvl--, pWindow[i]);
+        *pOut0 = IMDCT_SCALE_DBL_LSH1(x0);
+        *pOut1 = IMDCT_SCALE_DBL_LSH1(-x1);
+        pOut0++;
+        pOut1--;
+      }
+    } else { /* prevAliasingSymmetry == 1 */
+      for (i = 0; i < n; i++) {
+        FIXP_DBL x0, x1;
+        cplxMultDiv2(&x1, &x0, *pCurr++, -*pOvl--, pWindow[i]);
+        *pOut0 = IMDCT_SCALE_DBL_LSH1(x0);
+        *pOut1 = IMDCT_SCALE_DBL_LSH1(x1);
+        pOut0++;
+        pOut1--;
+      }
+    }
+  } else { /* prevPrevAliasingSymmetry == 1 */
+    if (prevAliasSymmetry == 0) {
+      for (i = 0; i < n; i++) {
+        FIXP_DBL x0, x1;
+        cplxMultDiv2(&x1, &x0, *pCurr++, *pOvl--, pWindow[i]);
+        *pOut0 = IMDCT_SCALE_DBL_LSH1(x0);
+        *pOut1 = IMDCT_SCALE_DBL_LSH1(-x1);
+        pOut0++;
+        pOut1--;
+      }
+    } else { /* prevAliasingSymmetry == 1 */
+      for (i = 0; i < n; i++) {
+        FIXP_DBL x0, x1;
+        cplxMultDiv2(&x1, &x0, *pCurr++, *pOvl--, pWindow[i]);
+        *pOut0 = IMDCT_SCALE_DBL_LSH1(x0);
+        *pOut1 = IMDCT_SCALE_DBL_LSH1(x1);
+        pOut0++;
+        pOut1--;
+      }
+    }
+  }
+}
+
 /*
 This program implements the inverse modulated lapped transform, a generalized
 version of the inverse MDCT transform. Setting none of the MLT_*_ALIAS_FLAG
@@ -614,63 +686,28 @@ INT imlt_block(H_MDCT hMdct, FIXP_DBL *output, FIXP_DBL *spectrum,
     DWORD_ALIGNED(pWindow);
     C_ALLOC_ALIGNED_UNREGISTER(pWindow);
 
-    if (hMdct->prevPrevAliasSymmetry == 0) {
-      if (hMdct->prevAliasSymmetry == 0) {
-        if (!hMdct->pAsymOvlp) {
-          for (i = 0; i < fl / 2; i++) {
-            FIXP_DBL x0, x1;
-            cplxMultDiv2(&x1, &x0, *pCurr++, -*pOvl--, pWindow[i]);
-            *pOut0 = IMDCT_SCALE_DBL_LSH1(x0);
-            *pOut1 = IMDCT_SCALE_DBL_LSH1(-x1);
-            pOut0++;
-            pOut1--;
-          }
-        } else {
-          FIXP_DBL *pAsymOvl = hMdct->pAsymOvlp + fl / 2 - 1;
-          for (i = 0; i < fl / 2; i++) {
-            FIXP_DBL x0, x1;
-            x1 = -fMultDiv2(*pCurr, pWindow[i].v.re) +
-                 fMultDiv2(*pAsymOvl, pWindow[i].v.im);
-            x0 = fMultDiv2(*pCurr, pWindow[i].v.im) -
-                 fMultDiv2(*pOvl, pWindow[i].v.re);
-            pCurr++;
-            pOvl--;
-            pAsymOvl--;
-            *pOut0++ = IMDCT_SCALE_DBL_LSH1(x0);
-            *pOut1-- = IMDCT_SCALE_DBL_LSH1(x1);
-          }
-          hMdct->pAsymOvlp = NULL;
-        }
-      } else { /* prevAliasingSymmetry == 1 */
-        for (i = 0; i < fl / 2; i++) {
-          FIXP_DBL x0, x1;
-          cplxMultDiv2(&x1, &x0, *pCurr++, -*pOvl--, pWindow[i]);
-          *pOut0 = IMDCT_SCALE_DBL_LSH1(x0);
-          *pOut1 = IMDCT_SCALE_DBL_LSH1(x1);
-          pOut0++;
-          pOut1--;
-        }
-      }
-    } else { /* prevPrevAliasingSymmetry == 1 */
-      if (hMdct->prevAliasSymmetry == 0) {
-        for (i = 0; i < fl / 2; i++) {
-          FIXP_DBL x0, x1;
-          cplxMultDiv2(&x1, &x0, *pCurr++, *pOvl--, pWindow[i]);
-          *pOut0 = IMDCT_SCALE_DBL_LSH1(x0);
-          *pOut1 = IMDCT_SCALE_DBL_LSH1(-x1);
-          pOut0++;
-          pOut1--;
-        }
-      } else { /* prevAliasingSymmetry == 1 */
-        for (i = 0; i < fl / 2; i++) {
-          FIXP_DBL x0, x1;
-          cplxMultDiv2(&x1, &x0, *pCurr++, *pOvl--, pWindow[i]);
-          *pOut0 = IMDCT_SCALE_DBL_LSH1(x0);
-          *pOut1 = IMDCT_SCALE_DBL_LSH1(x1);
-          pOut0++;
-          pOut1--;
-        }
+    if ((hMdct->prevPrevAliasSymmetry == 0) &&
+        (hMdct->prevAliasSymmetry == 0) && hMdct->pAsymOvlp) {
+      FIXP_DBL *pAsymOvl = hMdct->pAsymOvlp + fl / 2 - 1;
+      for (i = 0; i < fl / 2; i++) {
+        FIXP_DBL x0, x1;
+        x1 = -fMultDiv2(*pCurr, pWindow[i].v.re) +
+             fMultDiv2(*pAsymOvl, pWindow[i].v.im);
+        x0 = fMultDiv2(*pCurr, pWindow[i].v.im) -
+             fMultDiv2(*pOvl, pWindow[i].v.re);
+        pCurr++;
+        pOvl--;
+        pAsymOvl--;
+        *pOut0++ = IMDCT_SCALE_DBL_LSH1(x0);
+        *pOut1-- = IMDCT_SCALE_DBL_LSH1(x1);
       }
+      hMdct->pAsymOvlp = NULL;
+    } else {
+      imdct_window_overlap(pOut0, pOut1, pCurr, pOvl, pWindow, fl / 2,
+                           hMdct->prevPrevAliasSymmetry,
+                           hMdct->prevAliasSymmetry);
+      pOut0 += fl / 2;
+      pOut1 -= fl / 2;
     }
 
     if (hMdct->pFacZir != 0) {
@@ -725,3 +762,23 @@ INT imlt_block(H_MDCT hMdct, FIXP_DBL *output, FIXP_DBL *spectrum,
 
   return nrSamples;
 }
+
+void mdctSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures) {
+#if defined(FUNCTION_imdct_window_overlap_sse41)
+  if (cpuFeatures & FDK_CPU_SSE41) {
+    kernels->imdct_window_overlap = imdct_window_overlap_sse41;
+  }
+#endif
+#if defined(FUNCTION_imdct_window_overlap_avx2)
+  if (cpuFeatures & FDK_CPU_AVX2) {
+    kernels->imdct_window_overlap = imdct_window_overlap_avx2;
+  }
+#endif
+#if defined(FUNCTION_imdct_window_overlap_neon)
+  if (cpuFeatures & FDK_CPU_NEON) {
+    kernels->imdct_window_overlap = imdct_window_overlap_neon;
+  }
+#endif
+  (void)kernels;
+  (void)cpuFeatures;
+}
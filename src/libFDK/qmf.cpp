@@ -138,11 +138,67 @@ amm-info@iis.fraunhofer.de
 #include "libFDK/FDK_trigFcts.h"
 #include "libFDK/fixpoint_math.h"
 #include "libFDK/dct.h"
+#include "libFDK/FDK_dispatch.h"
+
+#if defined(__x86__)
+#include "libFDK/x86/qmf_x86.h"
+
+#elif defined(__arm__)
+#include "libFDK/arm/qmf_neon.h"
+
+#endif
 
 #define QSSCALE (0)
 #define FX_DBL2FX_QSS(x) (x)
 #define FX_QSS2FX_DBL(x) (x)
 
+/*!
+  \brief Perform the symmetric synthesis prototype filtering of one slot.
+
+  Updates the filter states and replaces realSlot[j] by the filter output of
+  band j. Gain and output scaling are applied by qmfSynPrototypeFirSlot().
+*/
+static void qmfSynPrototypeFir(
+    FIXP_QSS *RESTRICT sta,            /*!< Filter states */
+    FIXP_DBL *RESTRICT realSlot,       /*!< In: real slot, out: filter output */
+    const FIXP_DBL *RESTRICT imagSlot, /*!< Input: imag slot */
+    const FIXP_PFT *RESTRICT p_flt,    /*!< Coefficients of the last band */
+    const FIXP_PFT *RESTRICT p_fltm,   /*!< Mirrored coefficients */
+    const INT pfltStep,                /*!< Coefficient step per band */
+    const INT no_channels) {
+  int j;
+
+  if (FDK_kernels.qmfSynPrototypeFir != NULL) {
+    FDK_kernels.qmfSynPrototypeFir(sta, realSlot, imagSlot, p_flt, p_fltm,
+                                   pfltStep, no_channels);
+    return;
+  }
+
+  for (j = no_channels - 1; j >= 0; j--) {
+    FIXP_DBL imag = imagSlot[j]; /* no_channels-1 .. 0 */
+    FIXP_DBL real = realSlot[j]; /* no_channels-1 .. 0 */
+
+    realSlot[j] = fMultAddDiv2(FX_QSS2FX_DBL(sta[0]), p_fltm[0], real);
+
+    sta[0] = FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[1]), p_flt[4], imag));
+    sta[1] =
+        FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[2]), p_fltm[1], real));
+    sta[2] = FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[3]), p_flt[3], imag));
+    sta[3] =
+        FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[4]), p_fltm[2], real));
+    sta[4] = FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[5]), p_flt[2], imag));
+    sta[5] =
+        FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[6]), p_fltm[3], real));
+    sta[6] = FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[7]), p_flt[1], imag));
+    sta[7] =
+        FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[8]), p_fltm[4], real));
+    sta[8] = FX_DBL2FX_QSS(fMultDiv2(p_flt[0], imag));
+    p_flt += pfltStep;
+    p_fltm -= pfltStep;
+    sta += 9;  // = (2*QMF_NO_POLY-1);
+  }
+}
+
 /* moved to qmf_pcm.h: -> qmfSynPrototypeFirSlot */
 /* moved to qmf_pcm.h: -> qmfSynPrototypeFirSlot_NonSymmetric */
 /* moved to qmf_pcm.h: -> qmfSynthesisFilteringSlot */
@@ -209,6 +265,29 @@ static void qmfForwardModulationLP_odd(
 }
 #endif /* !defined(FUNCTION_qmfForwardModulationLP_odd) */
 
+/*!
+ *
+ * \brief Rotate the complex subband samples of one analysis slot by the
+ *        phase shift tables t_cos, t_sin
+ *
+ */
+static void qmfForwardRotation(FIXP_DBL *RESTRICT rSubband,
+                               FIXP_DBL *RESTRICT iSubband,
+                               const FIXP_QTW *t_cos, const FIXP_QTW *t_sin,
+                               const int len) {
+  int i;
+
+  if (FDK_kernels.qmfForwardRotation != NULL) {
+    FDK_kernels.qmfForwardRotation(rSubband, iSubband, t_cos, t_sin, len);
+    return;
+  }
+
+  for (i = 0; i < len; i++) {
+    cplxMult(&iSubband[i], &rSubband[i], iSubband[i], rSubband[i], t_cos[i],
+             t_sin[i]);
+  }
+}
+
 /*!
  *
  * \brief Perform complex-valued forward modulation of the time domain
@@ -290,10 +369,7 @@ static void qmfForwardModulationHQ(
       sbr_t_cos = anaQmf->t_cos;
       sbr_t_sin = anaQmf->t_sin;
 
-      for (i = 0; i < len; i++) {
-        cplxMult(&iSubband[i], &rSubband[i], iSubband[i], rSubband[i],
-                 sbr_t_cos[i], sbr_t_sin[i]);
-      }
+      qmfForwardRotation(rSubband, iSubband, sbr_t_cos, sbr_t_sin, len);
     }
   }
 }
@@ -831,3 +907,27 @@ void qmfChangeOutGain(
 #define INT_PCM_QMFIN LONG
 #include "libFDK/qmf_pcm.h"
 #endif
+
+void qmfSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures) {
+#if defined(FUNCTION_qmfSynPrototypeFir_sse41)
+  if (cpuFeatures & FDK_CPU_SSE41) {
+    kernels->qmfSynPrototypeFir = qmfSynPrototypeFir_sse41;
+    kernels->qmfAnaPrototypeFirSlot = qmfAnaPrototypeFirSlot_sse41;
+    kernels->qmfForwardRotation = qmfForwardRotation_sse41;
+  }
+#endif
+#if defined(FUNCTION_qmfSynPrototypeFir_avx2)
+  if (cpuFeatures & FDK_CPU_AVX2) {
+    kernels->qmfSynPrototypeFir = qmfSynPrototypeFir_avx2;
+  }
+#endif
+#if defined(FUNCTION_qmfSynPrototypeFir_neon)
+  if (cpuFeatures & FDK_CPU_NEON) {
+    kernels->qmfSynPrototypeFir = qmfSynPrototypeFir_neon;
+    kernels->qmfAnaPrototypeFirSlot = qmfAnaPrototypeFirSlot_neon;
+    kernels->qmfForwardRotation = qmfForwardRotation_neon;
+  }
+#endif
+  (void)kernels;
+  (void)cpuFeatures;
+}
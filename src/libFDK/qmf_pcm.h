@@ -140,8 +140,7 @@ void qmfSynPrototypeFirSlot_fallback(
   const FIXP_PFT *p_Filter = qmf->p_filter;
   int p_stride = qmf->p_stride;
   int j;
-  FIXP_QSS *RESTRICT sta = FilterStates;
-  const FIXP_PFT *RESTRICT p_flt, *RESTRICT p_fltm;
+  const FIXP_PFT *p_flt, *p_fltm;
   int scale = (DFRACT_BITS - SAMPLE_BITS_QMFOUT) - 1 - qmf->outScalefactor -
               qmf->outGain_e;
 
@@ -163,54 +162,35 @@ void qmfSynPrototypeFirSlot_fallback(
     scale = fMax(scale, -(DFRACT_BITS - 1));
   }
 
+  /* realSlot[j] becomes the filter output of band j */
+  qmfSynPrototypeFir(FilterStates, realSlot, imagSlot, p_flt, p_fltm,
+                     p_stride * QMF_NO_POLY, no_channels);
+
   for (j = no_channels - 1; j >= 0; j--) {
-    FIXP_DBL imag = imagSlot[j]; /* no_channels-1 .. 0 */
-    FIXP_DBL real = realSlot[j]; /* no_channels-1 .. 0 */
+    INT_PCM_QMFOUT tmp;
+    FIXP_DBL Are = realSlot[j];
+
+    /* This PCM formatting performs:
+       - multiplication with 16-bit gain, if not -1.0f
+       - rounding, if shift right is applied
+       - apply shift left (or right) with saturation to 32 (or 16) bits
+       - store output with --stride in 32 (or 16) bit format
+    */
+    if (gain != (FIXP_SGL)(-32768)) /* -1.0f */
     {
-      INT_PCM_QMFOUT tmp;
-      FIXP_DBL Are = fMultAddDiv2(FX_QSS2FX_DBL(sta[0]), p_fltm[0], real);
-
-      /* This PCM formatting performs:
-         - multiplication with 16-bit gain, if not -1.0f
-         - rounding, if shift right is applied
-         - apply shift left (or right) with saturation to 32 (or 16) bits
-         - store output with --stride in 32 (or 16) bit format
-      */
-      if (gain != (FIXP_SGL)(-32768)) /* -1.0f */
-      {
-        Are = fMult(Are, gain);
-      }
-      if (scale >= 0) {
-        FDK_ASSERT(
-            Are <=
-            (Are + rnd_val)); /* Round-addition must not overflow, might be
-                                 equal for rnd_val=0 */
-        tmp = (INT_PCM_QMFOUT)(
-            SATURATE_RIGHT_SHIFT(Are + rnd_val, scale, SAMPLE_BITS_QMFOUT));
-      } else {
-        tmp = (INT_PCM_QMFOUT)(
-            SATURATE_LEFT_SHIFT(Are, -scale, SAMPLE_BITS_QMFOUT));
-      }
-
-      { timeOut[(j)*stride] = tmp; }
+      Are = fMult(Are, gain);
+    }
+    if (scale >= 0) {
+      FDK_ASSERT(Are <= (Are + rnd_val)); /* Round-addition must not overflow,
+                                             might be equal for rnd_val=0 */
+      tmp = (INT_PCM_QMFOUT)(
+          SATURATE_RIGHT_SHIFT(Are + rnd_val, scale, SAMPLE_BITS_QMFOUT));
+    } else {
+      tmp = (INT_PCM_QMFOUT)(
+          SATURATE_LEFT_SHIFT(Are, -scale, SAMPLE_BITS_QMFOUT));
     }
 
-    sta[0] = FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[1]), p_flt[4], imag));
-    sta[1] =
-        FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[2]), p_fltm[1], real));
-    sta[2] = FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[3]), p_flt[3], imag));
-    sta[3] =
-        FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[4]), p_fltm[2], real));
-    sta[4] = FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[5]), p_flt[2], imag));
-    sta[5] =
-        FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[6]), p_fltm[3], real));
-    sta[6] = FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[7]), p_flt[1], imag));
-    sta[7] =
-        FX_DBL2FX_QSS(fMultAddDiv2(FX_QSS2FX_DBL(sta[8]), p_fltm[4], real));
-    sta[8] = FX_DBL2FX_QSS(fMultDiv2(p_flt[0], imag));
-    p_flt += (p_stride * QMF_NO_POLY);
-    p_fltm -= (p_stride * QMF_NO_POLY);
-    sta += 9;  // = (2*QMF_NO_POLY-1);
+    timeOut[j * stride] = tmp;
   }
 }
 
@@ -455,6 +435,15 @@ static void qmfAnaPrototypeFirSlot(
   INT staStep1 = no_channels << 1;
   INT staStep2 = (no_channels << 3) - 1; /* Rewind one less */
 
+#if (QAS_BITS == DFRACT_BITS)
+  /* the kernels filter 4 bands per step */
+  if ((FDK_kernels.qmfAnaPrototypeFirSlot != NULL) && !(no_channels & 3)) {
+    FDK_kernels.qmfAnaPrototypeFirSlot(analysisBuffer, no_channels, p_filter,
+                                       p_stride, pFilterStates);
+    return;
+  }
+#endif
+
   /* FIR filters 127..64 0..63 */
   for (k = 0; k < no_channels; k++) {
     accu = fMultDiv2(p_flt[0], *sta_1);
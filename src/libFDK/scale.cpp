@@ -109,13 +109,15 @@ amm-info@iis.fraunhofer.de
  **************************************************/
 
 #include "libFDK/scale.h"
+#include "libFDK/FDK_dispatch.h"
+
+#if defined(__arm__)
+#include "libFDK/arm/scale_neon.h"
+#endif
 
 // #if defined(__mips__)
 // #include "mips/scale_mips.cpp"
 
-// #elif defined(__arm__)
-// #include "arm/scale_arm.cpp"
-
 // #endif
 
 #ifndef FUNCTION_scaleValues_SGL
@@ -133,6 +135,11 @@ void scaleValues(FIXP_SGL *vector, /*!< Vector */
 ) {
   INT i;
 
+  if (FDK_kernels.scaleValues_SGL != NULL) {
+    FDK_kernels.scaleValues_SGL(vector, len, scalefactor);
+    return;
+  }
+
   /* Return if scalefactor is Zero */
   if (scalefactor == 0) return;
 
@@ -178,6 +185,11 @@ void scaleValues(FIXP_DBL *vector, /*!< Vector */
 ) {
   INT i;
 
+  if (FDK_kernels.scaleValues_DBL != NULL) {
+    FDK_kernels.scaleValues_DBL(vector, len, scalefactor);
+    return;
+  }
+
   /* Return if scalefactor is Zero */
   if (scalefactor == 0) return;
 
@@ -225,6 +237,11 @@ void scaleValuesSaturate(FIXP_DBL *vector, /*!< Vector */
 ) {
   INT i;
 
+  if (FDK_kernels.scaleValuesSaturate_DBL != NULL) {
+    FDK_kernels.scaleValuesSaturate_DBL(vector, len, scalefactor);
+    return;
+  }
+
   /* Return if scalefactor is Zero */
   if (scalefactor == 0) return;
 
@@ -257,6 +274,11 @@ void scaleValuesSaturate(FIXP_DBL *dst,       /*!< Output */
 ) {
   INT i;
 
+  if (FDK_kernels.scaleValuesSaturate_DBL_DBL != NULL) {
+    FDK_kernels.scaleValuesSaturate_DBL_DBL(dst, src, len, scalefactor);
+    return;
+  }
+
   /* Return if scalefactor is Zero */
   if (scalefactor == 0) {
     FDKmemmove(dst, src, len * sizeof(FIXP_DBL));
@@ -291,6 +313,12 @@ void scaleValuesSaturate(FIXP_SGL *dst,       /*!< Output */
                          INT scalefactor)     /*!< Scalefactor */
 {
   INT i;
+
+  if (FDK_kernels.scaleValuesSaturate_SGL_DBL != NULL) {
+    FDK_kernels.scaleValuesSaturate_SGL_DBL(dst, src, len, scalefactor);
+    return;
+  }
+
   scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
                          (INT) - (DFRACT_BITS - 1));
 
@@ -319,6 +347,11 @@ void scaleValuesSaturate(FIXP_SGL *vector, /*!< Vector */
 ) {
   INT i;
 
+  if (FDK_kernels.scaleValuesSaturate_SGL != NULL) {
+    FDK_kernels.scaleValuesSaturate_SGL(vector, len, scalefactor);
+    return;
+  }
+
   /* Return if scalefactor is Zero */
   if (scalefactor == 0) return;
 
@@ -352,6 +385,11 @@ void scaleValuesSaturate(FIXP_SGL *dst,       /*!< Output */
 ) {
   INT i;
 
+  if (FDK_kernels.scaleValuesSaturate_SGL_SGL != NULL) {
+    FDK_kernels.scaleValuesSaturate_SGL_SGL(dst, src, len, scalefactor);
+    return;
+  }
+
   /* Return if scalefactor is Zero */
   if (scalefactor == 0) {
     FDKmemmove(dst, src, len * sizeof(FIXP_SGL));
@@ -389,6 +427,11 @@ void scaleValues(FIXP_DBL *dst,       /*!< dst Vector */
 ) {
   INT i;
 
+  if (FDK_kernels.scaleValues_DBLDBL != NULL) {
+    FDK_kernels.scaleValues_DBLDBL(dst, src, len, scalefactor);
+    return;
+  }
+
   /* Return if scalefactor is Zero */
   if (scalefactor == 0) {
     if (dst != src) FDKmemmove(dst, src, len * sizeof(FIXP_DBL));
@@ -692,6 +735,10 @@ INT getScalefactor(const FIXP_DBL *vector, /*!< Pointer to input vector */
   INT i;
   FIXP_DBL temp, maxVal = (FIXP_DBL)0;
 
+  if (FDK_kernels.getScalefactor_DBL != NULL) {
+    return FDK_kernels.getScalefactor_DBL(vector, len);
+  }
+
   for (i = len; i != 0; i--) {
     temp = (LONG)(*vector++);
     maxVal |= (FIXP_DBL)((LONG)temp ^ (LONG)(temp >> (DFRACT_BITS - 1)));
@@ -710,6 +757,10 @@ INT getScalefactor(const FIXP_SGL *vector, /*!< Pointer to input vector */
   INT i;
   SHORT temp, maxVal = (FIXP_SGL)0;
 
+  if (FDK_kernels.getScalefactor_SGL != NULL) {
+    return FDK_kernels.getScalefactor_SGL(vector, len);
+  }
+
   for (i = len; i != 0; i--) {
     temp = (SHORT)(*vector++);
     maxVal |= (temp ^ (temp >> (FRACT_BITS - 1)));
@@ -718,3 +769,22 @@ INT getScalefactor(const FIXP_SGL *vector, /*!< Pointer to input vector */
   return fixmax_I((INT)0, (INT)(fixnormz_S((FIXP_SGL)maxVal)) - 1);
 }
 #endif
+
+void scaleSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures) {
+#if defined(FUNCTION_scaleValues_SGL_neon)
+  if (cpuFeatures & FDK_CPU_NEON) {
+    kernels->scaleValues_SGL = scaleValues_SGL_neon;
+    kernels->scaleValues_DBL = scaleValues_DBL_neon;
+    kernels->scaleValues_DBLDBL = scaleValues_DBLDBL_neon;
+    kernels->scaleValuesSaturate_DBL = scaleValuesSaturate_DBL_neon;
+    kernels->scaleValuesSaturate_DBL_DBL = scaleValuesSaturate_DBL_DBL_neon;
+    kernels->scaleValuesSaturate_SGL_DBL = scaleValuesSaturate_SGL_DBL_neon;
+    kernels->scaleValuesSaturate_SGL = scaleValuesSaturate_SGL_neon;
+    kernels->scaleValuesSaturate_SGL_SGL = scaleValuesSaturate_SGL_SGL_neon;
+    kernels->getScalefactor_DBL = getScalefactor_DBL_neon;
+    kernels->getScalefactor_SGL = getScalefactor_SGL_neon;
+  }
+#endif
+  (void)kernels;
+  (void)cpuFeatures;
+}
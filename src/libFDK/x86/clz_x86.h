@@ -0,0 +1,40 @@
+#pragma once
+
+#include "libFDK/FDK_archdef.h"
+#include "libSYS/machine_type.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+#define FUNCTION_fixnormz_D
+inline INT fixnormz_D(LONG value) {
+  unsigned long idx;
+  if (_BitScanReverse(&idx, (unsigned long)value)) {
+    return 31 - (INT)idx;
+  }
+  return 32;
+}
+
+#define FUNCTION_fixnorm_D
+inline INT fixnorm_D(LONG value) {
+  if (value == 0) {
+    return 0;
+  }
+  return fixnormz_D(value ^ (value >> 31)) - 1;
+}
+
+#else /* GCC, Clang */
+
+/* bsr, or lzcnt with -mlzcnt (-march=haswell and later) */
+#define FUNCTION_fixnormz_D
+inline INT fixnormz_D(LONG value) {
+  return (value != 0) ? __builtin_clz((UINT)value) : 32;
+}
+
+/* number of redundant sign bits: 31 for -1 */
+#define FUNCTION_fixnorm_D
+inline INT fixnorm_D(LONG value) {
+  return (value != 0) ? __builtin_clrsb((INT)value) : 0;
+}
+
+#endif
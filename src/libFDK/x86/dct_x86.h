@@ -0,0 +1,430 @@
+#pragma once
+
+/* SSE4.1 and AVX2 versions of the pre- and post-twiddles of dct_IV() and dst_IV():
+ * included by dct.cpp and selected at runtime by dctSelectKernels(). The
+ * results are bit exact to the generic functions. */
+
+#if defined(SINETABLE_16BIT) && defined(WINDOWTABLE_16BIT) && \
+    (defined(__GNUC__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+#include "libSYS/FDK_cpu.h"
+
+/* The 16 bit twiddle factors c are held as c << 16 in 32 bit lanes: the high
+ * half of the 64 bit product x * (c << 16) is fMultDiv2(x, c). */
+FDK_TARGET("sse4.1")
+static inline __m128i dct_mult_sse(const __m128i x, const __m128i c) {
+  __m128i even = _mm_srli_epi64(_mm_mul_epi32(x, c), 32);
+  __m128i odd = _mm_mul_epi32(_mm_srli_epi64(x, 32), _mm_srli_epi64(c, 32));
+  return _mm_blend_epi16(even, odd, 0xCC);
+}
+
+FDK_TARGET("avx2")
+static inline __m256i dct_mult_avx2(const __m256i x, const __m256i c) {
+  __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(x, c), 32);
+  __m256i odd =
+      _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(c, 32));
+  return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+/* Rotation of the 2 complex values (x0, x1), (x2, x3) by the twiddle factors
+ * t = (re0, im0, re1, im1) of the lanes tw:
+ * (x0*re0 + x1*im0, x1*re0 - x0*im0, x2*re1 + x3*im1, x3*re1 - x2*im1), each
+ * product truncated by fMultDiv2(). */
+FDK_TARGET("sse4.1")
+static inline __m128i dct_rotate_sse(const __m128i x, const __m128i tw) {
+  const __m128i shufRe = _mm_set_epi8(5, 4, -128, -128, 5, 4, -128, -128, 1, 0,
+                                      -128, -128, 1, 0, -128, -128);
+  const __m128i shufIm = _mm_set_epi8(7, 6, -128, -128, 7, 6, -128, -128, 3, 2,
+                                      -128, -128, 3, 2, -128, -128);
+  const __m128i sign = _mm_set_epi32(-1, 1, -1, 1);
+
+  return _mm_add_epi32(
+      dct_mult_sse(x, _mm_shuffle_epi8(tw, shufRe)),
+      _mm_sign_epi32(
+          dct_mult_sse(_mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)),
+                       _mm_shuffle_epi8(tw, shufIm)),
+          sign));
+}
+
+/* One step of the pre-twiddle loops: v = (pDat_0[0], pDat_0[1], pDat_1[0],
+ * pDat_1[1]) becomes (pDat_0[0], pDat_0[1], pDat_1[0], -pDat_1[1]) of the
+ * generic code, before the final shift of dct_IV(). */
+FDK_TARGET("sse4.1")
+static inline __m128i dct_pre_twiddle_sse(const __m128i v,
+                                          const FIXP_WTP *twiddle) {
+  /* (pDat_0[0], pDat_1[1]) with twiddle[i], (pDat_0[1], pDat_1[0]) with
+   * twiddle[i + 1] */
+  return dct_rotate_sse(_mm_shuffle_epi32(v, _MM_SHUFFLE(2, 1, 3, 0)),
+                        _mm_loadl_epi64((const __m128i *)twiddle));
+}
+
+#define FUNCTION_dct_IV_preTwiddle_sse41
+FDK_TARGET("sse4.1")
+static void dct_IV_preTwiddle_sse41(FIXP_DBL *pDat, const int L,
+                                    const FIXP_WTP *twiddle) {
+  const __m128i neg = _mm_set_epi32(-1, 1, 1, 1);
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  int M = L >> 1;
+  int i;
+
+  for (i = 0; i < M - 1; i += 2, pDat_0 += 2, pDat_1 -= 2) {
+    __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)pDat_0),
+                                   _mm_loadl_epi64((__m128i *)pDat_1));
+    v = _mm_sign_epi32(_mm_srai_epi32(dct_pre_twiddle_sse(v, &twiddle[i]), 1),
+                       neg);
+    _mm_storel_epi64((__m128i *)pDat_0, v);
+    _mm_storel_epi64((__m128i *)pDat_1, _mm_unpackhi_epi64(v, v));
+  }
+  if (M & 1) {
+    FIXP_DBL accu1, accu2;
+
+    accu1 = pDat_1[1];
+    accu2 = pDat_0[0];
+
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
+  }
+}
+
+#define FUNCTION_dst_IV_preTwiddle_sse41
+FDK_TARGET("sse4.1")
+static void dst_IV_preTwiddle_sse41(FIXP_DBL *pDat, const int L,
+                                    const FIXP_WTP *twiddle) {
+  const __m128i negIn = _mm_set_epi32(1, -1, 1, -1);
+  const __m128i neg = _mm_set_epi32(-1, 1, 1, 1);
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  int M = L >> 1;
+  int i;
+
+  for (i = 0; i < M - 1; i += 2, pDat_0 += 2, pDat_1 -= 2) {
+    __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)pDat_0),
+                                   _mm_loadl_epi64((__m128i *)pDat_1));
+    v = _mm_sign_epi32(_mm_srai_epi32(v, 1), negIn);
+    v = _mm_sign_epi32(dct_pre_twiddle_sse(v, &twiddle[i]), neg);
+    _mm_storel_epi64((__m128i *)pDat_0, v);
+    _mm_storel_epi64((__m128i *)pDat_1, _mm_unpackhi_epi64(v, v));
+  }
+  if (M & 1) {
+    FIXP_DBL accu1, accu2;
+
+    accu1 = pDat_1[1];
+    accu2 = -pDat_0[0];
+
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
+  }
+}
+
+/* Two steps i, i+2 of the pre-twiddle loops: f = pDat_0[0..3] and
+ * b = pDat_1[-2..1] like dct_pre_twiddle_sse() with the results of step i in
+ * the lower and of step i+2 in the upper 128 bit lane. */
+FDK_TARGET("avx2")
+static inline __m256i dct_pre_twiddle_avx2(const __m128i f, const __m128i b,
+                                           const FIXP_WTP *twiddle) {
+  const __m256i shufRe = _mm256_set_epi8(
+      5, 4, -128, -128, 5, 4, -128, -128, 1, 0, -128, -128, 1, 0, -128, -128,
+      5, 4, -128, -128, 5, 4, -128, -128, 1, 0, -128, -128, 1, 0, -128, -128);
+  const __m256i shufIm = _mm256_set_epi8(
+      7, 6, -128, -128, 7, 6, -128, -128, 3, 2, -128, -128, 3, 2, -128, -128,
+      7, 6, -128, -128, 7, 6, -128, -128, 3, 2, -128, -128, 3, 2, -128, -128);
+  const __m256i sign = _mm256_set_epi32(-1, 1, -1, 1, -1, 1, -1, 1);
+  const __m128i tw = _mm_loadu_si128((const __m128i *)twiddle);
+  /* (pDat_0[0], pDat_0[1], pDat_1[0], pDat_1[1]) of both steps */
+  __m256i x = _mm256_set_m128i(
+      _mm_shuffle_epi32(_mm_blend_epi32(f, b, 0x3), _MM_SHUFFLE(1, 0, 3, 2)),
+      _mm_blend_epi32(f, b, 0xC));
+  const __m256i t = _mm256_set_m128i(_mm_unpackhi_epi64(tw, tw), tw);
+
+  x = _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 1, 3, 0));
+  return _mm256_add_epi32(
+      dct_mult_avx2(x, _mm256_shuffle_epi8(t, shufRe)),
+      _mm256_sign_epi32(
+          dct_mult_avx2(_mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)),
+                        _mm256_shuffle_epi8(t, shufIm)),
+          sign));
+}
+
+/* Stores the results of dct_pre_twiddle_avx2() */
+FDK_TARGET("avx2")
+static inline void dct_pre_twiddle_store_avx2(FIXP_DBL *pDat_0,
+                                              FIXP_DBL *pDat_1,
+                                              const __m256i v) {
+  const __m128i lo = _mm256_castsi256_si128(v);
+  const __m128i hi = _mm256_extracti128_si256(v, 1);
+
+  _mm_storeu_si128((__m128i *)pDat_0, _mm_unpacklo_epi64(lo, hi));
+  _mm_storeu_si128((__m128i *)(pDat_1 - 2), _mm_unpackhi_epi64(hi, lo));
+}
+
+#define FUNCTION_dct_IV_preTwiddle_avx2
+FDK_TARGET("avx2")
+static void dct_IV_preTwiddle_avx2(FIXP_DBL *pDat, const int L,
+                                   const FIXP_WTP *twiddle) {
+  const __m256i neg = _mm256_set_epi32(-1, 1, 1, 1, -1, 1, 1, 1);
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  int M = L >> 1;
+  int i;
+
+  for (i = 0; i < M - 3; i += 4, pDat_0 += 4, pDat_1 -= 4) {
+    dct_pre_twiddle_store_avx2(
+        pDat_0, pDat_1,
+        _mm256_sign_epi32(
+            _mm256_srai_epi32(
+                dct_pre_twiddle_avx2(
+                    _mm_loadu_si128((const __m128i *)pDat_0),
+                    _mm_loadu_si128((const __m128i *)(pDat_1 - 2)),
+                    &twiddle[i]),
+                1),
+            neg));
+  }
+  if (i < M - 1) {
+    const __m128i neg = _mm_set_epi32(-1, 1, 1, 1);
+    __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)pDat_0),
+                                   _mm_loadl_epi64((__m128i *)pDat_1));
+    v = _mm_sign_epi32(_mm_srai_epi32(dct_pre_twiddle_sse(v, &twiddle[i]), 1),
+                       neg);
+    _mm_storel_epi64((__m128i *)pDat_0, v);
+    _mm_storel_epi64((__m128i *)pDat_1, _mm_unpackhi_epi64(v, v));
+    i += 2;
+    pDat_0 += 2;
+    pDat_1 -= 2;
+  }
+  if (M & 1) {
+    FIXP_DBL accu1, accu2;
+
+    accu1 = pDat_1[1];
+    accu2 = pDat_0[0];
+
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
+  }
+}
+
+#define FUNCTION_dst_IV_preTwiddle_avx2
+FDK_TARGET("avx2")
+static void dst_IV_preTwiddle_avx2(FIXP_DBL *pDat, const int L,
+                                   const FIXP_WTP *twiddle) {
+  const __m256i neg = _mm256_set_epi32(-1, 1, 1, 1, -1, 1, 1, 1);
+  const __m128i negIn = _mm_set_epi32(1, -1, 1, -1);
+  FIXP_DBL *RESTRICT pDat_0 = &pDat[0];
+  FIXP_DBL *RESTRICT pDat_1 = &pDat[L - 2];
+  int M = L >> 1;
+  int i;
+
+  for (i = 0; i < M - 3; i += 4, pDat_0 += 4, pDat_1 -= 4) {
+    const __m128i f = _mm_sign_epi32(
+        _mm_srai_epi32(_mm_loadu_si128((const __m128i *)pDat_0), 1), negIn);
+    const __m128i b = _mm_sign_epi32(
+        _mm_srai_epi32(_mm_loadu_si128((const __m128i *)(pDat_1 - 2)), 1),
+        negIn);
+    dct_pre_twiddle_store_avx2(
+        pDat_0, pDat_1,
+        _mm256_sign_epi32(dct_pre_twiddle_avx2(f, b, &twiddle[i]), neg));
+  }
+  if (i < M - 1) {
+    const __m128i neg = _mm_set_epi32(-1, 1, 1, 1);
+    __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)pDat_0),
+                                   _mm_loadl_epi64((__m128i *)pDat_1));
+    v = _mm_sign_epi32(_mm_srai_epi32(v, 1), negIn);
+    v = _mm_sign_epi32(dct_pre_twiddle_sse(v, &twiddle[i]), neg);
+    _mm_storel_epi64((__m128i *)pDat_0, v);
+    _mm_storel_epi64((__m128i *)pDat_1, _mm_unpackhi_epi64(v, v));
+    i += 2;
+    pDat_0 += 2;
+    pDat_1 -= 2;
+  }
+  if (M & 1) {
+    FIXP_DBL accu1, accu2;
+
+    accu1 = pDat_1[1];
+    accu2 = -pDat_0[0];
+
+    cplxMultDiv2(&accu1, &accu2, accu1, accu2, twiddle[i]);
+
+    pDat_0[0] = accu2 >> 1;
+    pDat_0[1] = accu1 >> 1;
+  }
+}
+
+/* Two steps i, i+1 of the post-twiddle loops. The generic loop step i rotates
+ * the pair F_i = pDat[2i .. 2i+1] from the front and the pair B_(i-1) =
+ * pDat[L-2i .. L-2i+1] from the back with twd = sin_twiddle[i * sin_step],
+ * cplxMult() gives (a3, a4) = (x1*re - x0*im, x1*im + x0*re) for (x1, x0):
+ *   fr = (a4, a3) of F_i[1], F_i[0] with twd of step i and of F_(i+1)
+ *        with twd of step i+1
+ *   br = (a4, a3) of B_i[0], B_i[1] with twd of step i+1 and of B_(i-1)
+ *        with twd of step i */
+FDK_TARGET("sse4.1")
+static inline void dct_post_twiddle_sse(__m128i *fr, __m128i *br,
+                                        const FIXP_DBL *pDat_0,
+                                        const FIXP_DBL *pDat_1,
+                                        const FIXP_STP *sin_twiddle,
+                                        const int idx, const int sin_step) {
+  const __m128i tw = _mm_unpacklo_epi32(
+      _mm_cvtsi32_si128(sin_twiddle[idx].w),
+      _mm_cvtsi32_si128(sin_twiddle[idx + sin_step].w));
+
+  /* fMult() == fMultDiv2() << 1 */
+  *fr = _mm_slli_epi32(
+      dct_rotate_sse(_mm_loadu_si128((const __m128i *)pDat_0), tw), 1);
+  *br = _mm_slli_epi32(
+      dct_rotate_sse(
+          _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)pDat_1),
+                            _MM_SHUFFLE(2, 3, 0, 1)),
+          _mm_shuffle_epi32(tw, _MM_SHUFFLE(3, 2, 0, 1))),
+      1);
+}
+
+#define FUNCTION_dct_IV_postTwiddle_sse41
+FDK_TARGET("sse4.1")
+static void dct_IV_postTwiddle_sse41(FIXP_DBL *pDat, const int L,
+                                     const FIXP_STP *sin_twiddle,
+                                     const int sin_step) {
+  FIXP_DBL *RESTRICT pDat_0;
+  FIXP_DBL *RESTRICT pDat_1;
+  FIXP_DBL accu1, accu2, accu3, accu4;
+  FIXP_DBL carry; /* B_(i-1)[1], stored with the next step */
+  int M = L >> 1;
+  int idx, i;
+
+  carry = -pDat[1];
+
+  for (i = 1; i + 1 < (M + 1) >> 1; i += 2) {
+    __m128i fr, br, nfr;
+
+    dct_post_twiddle_sse(&fr, &br, &pDat[2 * i], &pDat[L - 2 - 2 * i],
+                         sin_twiddle, i * sin_step, sin_step);
+    nfr = _mm_sub_epi32(_mm_setzero_si128(), fr);
+
+    /* F_(i-1)[1], F_i[0], F_i[1], F_(i+1)[0] */
+    _mm_storeu_si128(
+        (__m128i *)&pDat[2 * i - 1],
+        _mm_unpacklo_epi32(_mm_shuffle_epi32(br, _MM_SHUFFLE(3, 3, 1, 3)),
+                           _mm_shuffle_epi32(fr, _MM_SHUFFLE(3, 3, 2, 0))));
+    /* B_i[0], B_i[1], B_(i-1)[0], B_(i-1)[1] */
+    _mm_storeu_si128(
+        (__m128i *)&pDat[L - 2 - 2 * i],
+        _mm_unpacklo_epi32(
+            _mm_shuffle_epi32(br, _MM_SHUFFLE(2, 2, 2, 0)),
+            _mm_insert_epi32(_mm_shuffle_epi32(nfr, _MM_SHUFFLE(3, 3, 3, 1)),
+                             carry, 1)));
+    carry = _mm_extract_epi32(nfr, 3);
+  }
+
+  pDat_0 = &pDat[2 * i - 2];
+  pDat_1 = &pDat[L - 2 * i];
+  accu1 = pDat_1[0];
+  accu2 = pDat_1[1];
+  pDat_1[1] = carry;
+
+  for (idx = i * sin_step; i<(M + 1)>> 1; i++, idx += sin_step) {
+    FIXP_STP twd = sin_twiddle[idx];
+    cplxMult(&accu3, &accu4, accu1, accu2, twd);
+    pDat_0[1] = accu3;
+    pDat_1[0] = accu4;
+
+    pDat_0 += 2;
+    pDat_1 -= 2;
+
+    cplxMult(&accu3, &accu4, pDat_0[1], pDat_0[0], twd);
+
+    accu1 = pDat_1[0];
+    accu2 = pDat_1[1];
+
+    pDat_1[1] = -accu3;
+    pDat_0[0] = accu4;
+  }
+
+  if ((M & 1) == 0) {
+    /* Last Sin and Cos value pair are the same */
+    accu1 = fMult(accu1, WTC(0x5a82799a));
+    accu2 = fMult(accu2, WTC(0x5a82799a));
+
+    pDat_1[0] = accu1 + accu2;
+    pDat_0[1] = accu1 - accu2;
+  }
+}
+
+#define FUNCTION_dst_IV_postTwiddle_sse41
+FDK_TARGET("sse4.1")
+static void dst_IV_postTwiddle_sse41(FIXP_DBL *pDat, const int L,
+                                     const FIXP_STP *sin_twiddle,
+                                     const int sin_step) {
+  FIXP_DBL *RESTRICT pDat_0;
+  FIXP_DBL *RESTRICT pDat_1;
+  FIXP_DBL accu1, accu2, accu3, accu4;
+  FIXP_DBL carry; /* B_(i-1)[1], stored with the next step */
+  int M = L >> 1;
+  int idx, i;
+
+  carry = -pDat[0];
+  pDat[0] = pDat[1];
+
+  for (i = 1; i + 1 < (M + 1) >> 1; i += 2) {
+    __m128i fr, br, nfr, nbr;
+
+    dct_post_twiddle_sse(&fr, &br, &pDat[2 * i], &pDat[L - 2 - 2 * i],
+                         sin_twiddle, i * sin_step, sin_step);
+    nfr = _mm_sub_epi32(_mm_setzero_si128(), fr);
+    nbr = _mm_sub_epi32(_mm_setzero_si128(), br);
+
+    /* F_(i-1)[1], F_i[0], F_i[1], F_(i+1)[0] */
+    _mm_storeu_si128(
+        (__m128i *)&pDat[2 * i - 1],
+        _mm_unpacklo_epi32(_mm_shuffle_epi32(nbr, _MM_SHUFFLE(3, 3, 0, 2)),
+                           _mm_shuffle_epi32(fr, _MM_SHUFFLE(3, 3, 3, 1))));
+    /* B_i[0], B_i[1], B_(i-1)[0], B_(i-1)[1] */
+    _mm_storeu_si128(
+        (__m128i *)&pDat[L - 2 - 2 * i],
+        _mm_unpacklo_epi32(
+            _mm_shuffle_epi32(nbr, _MM_SHUFFLE(3, 3, 3, 1)),
+            _mm_insert_epi32(nfr, carry, 1)));
+    carry = _mm_extract_epi32(nfr, 2);
+  }
+
+  pDat_0 = &pDat[2 * i - 2];
+  pDat_1 = &pDat[L - 2 * i];
+  accu1 = pDat_1[0];
+  accu2 = pDat_1[1];
+  pDat_1[1] = carry;
+
+  for (idx = i * sin_step; i<(M + 1)>> 1; i++, idx += sin_step) {
+    FIXP_STP twd = sin_twiddle[idx];
+
+    cplxMult(&accu3, &accu4, accu1, accu2, twd);
+    pDat_1[0] = -accu3;
+    pDat_0[1] = -accu4;
+
+    pDat_0 += 2;
+    pDat_1 -= 2;
+
+    cplxMult(&accu3, &accu4, pDat_0[1], pDat_0[0], twd);
+
+    accu1 = pDat_1[0];
+    accu2 = pDat_1[1];
+
+    pDat_0[0] = accu3;
+    pDat_1[1] = -accu4;
+  }
+
+  if ((M & 1) == 0) {
+    /* Last Sin and Cos value pair are the same */
+    accu1 = fMult(accu1, WTC(0x5a82799a));
+    accu2 = fMult(accu2, WTC(0x5a82799a));
+
+    pDat_0[1] = -accu1 - accu2;
+    pDat_1[0] = accu2 - accu1;
+  }
+}
+
+#endif /* SINETABLE_16BIT && WINDOWTABLE_16BIT && (__GNUC__ || _MSC_VER) */
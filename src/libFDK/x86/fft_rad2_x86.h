@@ -0,0 +1,223 @@
+#pragma once
+
+/* SSE4.1 and AVX2 versions of dit_fft(): included by fft_rad2.cpp and selected
+ * at runtime by ditFftSelectKernels(). The results are bit exact to the generic
+ * function. */
+
+#if defined(SINETABLE_16BIT) && (defined(__GNUC__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+#include "libSYS/FDK_cpu.h"
+
+/* The twiddle factors t are held as 32 bit values t * 2^15 in the even lanes:
+ * (x * t * 2^15) >> 31 is fMultDiv2(x, t) and the factor 1.0 of the first
+ * butterfly of each stage becomes exact, (x * 2^30) >> 31 == x >> 1. */
+
+/* fMultDiv2() of 2 complex values by the factors in the even lanes of w */
+FDK_TARGET("sse4.1")
+static inline __m128i dit_fft_mult_sse(const __m128i x, const __m128i w) {
+  __m128i re = _mm_srli_epi64(_mm_mul_epi32(x, w), 31);
+  __m128i im = _mm_slli_epi64(_mm_mul_epi32(_mm_srli_epi64(x, 32), w), 1);
+  return _mm_blend_epi16(re, im, 0xCC);
+}
+
+/* Butterflies of 2 complex values x1, x2 with v = (re2*c + im2*s, im2*c -
+ * re2*s): x1 = x1/2 + v, x2 = x1/2 - v. The second half of a group (formB)
+ * uses v rotated by -90 degrees. */
+FDK_TARGET("sse4.1")
+static inline void dit_fft_bfly_sse(FIXP_DBL *x1, FIXP_DBL *x2,
+                                    const __m128i c, const __m128i s,
+                                    const int formB) {
+  const __m128i sign = _mm_set_epi32(-1, 1, -1, 1);
+  __m128i a = _mm_loadu_si128((__m128i *)x2);
+  __m128i u = _mm_srai_epi32(_mm_loadu_si128((__m128i *)x1), 1);
+  __m128i v = _mm_add_epi32(
+      dit_fft_mult_sse(a, c),
+      _mm_sign_epi32(
+          dit_fft_mult_sse(_mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)), s),
+          sign));
+  if (formB) {
+    v = _mm_sign_epi32(_mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), sign);
+  }
+  _mm_storeu_si128((__m128i *)x1, _mm_add_epi32(u, v));
+  _mm_storeu_si128((__m128i *)x2, _mm_sub_epi32(u, v));
+}
+
+FDK_TARGET("avx2")
+static inline __m256i dit_fft_mult_avx2(const __m256i x, const __m256i w) {
+  __m256i re = _mm256_srli_epi64(_mm256_mul_epi32(x, w), 31);
+  __m256i im =
+      _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(x, 32), w), 1);
+  return _mm256_blend_epi32(re, im, 0xAA);
+}
+
+/* dit_fft_bfly_sse() of 4 complex values */
+FDK_TARGET("avx2")
+static inline void dit_fft_bfly_avx2(FIXP_DBL *x1, FIXP_DBL *x2,
+                                     const __m256i c, const __m256i s,
+                                     const int formB) {
+  const __m256i sign = _mm256_set_epi32(-1, 1, -1, 1, -1, 1, -1, 1);
+  __m256i a = _mm256_loadu_si256((__m256i *)x2);
+  __m256i u = _mm256_srai_epi32(_mm256_loadu_si256((__m256i *)x1), 1);
+  __m256i v = _mm256_add_epi32(
+      dit_fft_mult_avx2(a, c),
+      _mm256_sign_epi32(
+          dit_fft_mult_avx2(_mm256_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)),
+                            s),
+          sign));
+  if (formB) {
+    v = _mm256_sign_epi32(_mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)),
+                          sign);
+  }
+  _mm256_storeu_si256((__m256i *)x1, _mm256_add_epi32(u, v));
+  _mm256_storeu_si256((__m256i *)x2, _mm256_sub_epi32(u, v));
+}
+
+/* Twiddle factors (scaled by 2^15) of the butterflies k and k + mh/2 of a
+ * stage, 0 <= k < mh/2. The generic code handles k > mh/4 with the factor of
+ * mh/2 - k and cos and sin swapped. */
+static inline void dit_fft_twiddle(INT *c, INT *s, const INT k, const INT mh,
+                                   const FIXP_STP *trigdata,
+                                   const INT trigstep) {
+  if (k == 0) {
+    *c = 1 << 30;
+    *s = 0;
+  } else if (k < (mh >> 2)) {
+    *c = (INT)trigdata[k * trigstep].v.re << 15;
+    *s = (INT)trigdata[k * trigstep].v.im << 15;
+  } else if (k == (mh >> 2)) {
+    *c = *s = (INT)STC(0x5a82799a) << 15;
+  } else {
+    *c = (INT)trigdata[((mh >> 1) - k) * trigstep].v.im << 15;
+    *s = (INT)trigdata[((mh >> 1) - k) * trigstep].v.re << 15;
+  }
+}
+
+/*
+ * 1+2 stage radix 4: A,B and C,D of 4 complex values are in one register
+ */
+FDK_TARGET("sse4.1")
+static inline void dit_fft_radix4_sse(FIXP_DBL *x, const INT n) {
+  const __m128i maskB = _mm_set_epi32(-1, -1, 0, 0);
+  const __m128i signD = _mm_set_epi32(-1, 1, 1, 1);
+
+  for (INT i = 0; i < n * 2; i += 8) {
+    __m128i ab = _mm_loadu_si128((__m128i *)&x[i]);
+    __m128i cd = _mm_loadu_si128((__m128i *)&x[i + 4]);
+
+    /* (A + B)/2, (A + B)/2 - B */
+    ab = _mm_sub_epi32(
+        _mm_srai_epi32(
+            _mm_add_epi32(ab, _mm_shuffle_epi32(ab, _MM_SHUFFLE(1, 0, 3, 2))),
+            1),
+        _mm_and_si128(ab, maskB));
+    /* (C + D)/2, (Im C - Im D, -Re C + Re D) */
+    cd = _mm_sub_epi32(
+        _mm_srai_epi32(
+            _mm_add_epi32(cd, _mm_shuffle_epi32(cd, _MM_SHUFFLE(1, 0, 3, 2))),
+            1),
+        _mm_and_si128(cd, maskB));
+    cd = _mm_sign_epi32(_mm_shuffle_epi32(cd, _MM_SHUFFLE(2, 3, 1, 0)), signD);
+
+    _mm_storeu_si128((__m128i *)&x[i], _mm_add_epi32(ab, cd));     /* A', B' */
+    _mm_storeu_si128((__m128i *)&x[i + 4], _mm_sub_epi32(ab, cd)); /* C', D' */
+  }
+}
+
+/* radix 2 stage ldm, 2 butterflies per step */
+FDK_TARGET("sse4.1")
+static inline void dit_fft_stage_sse(FIXP_DBL *x, const INT n, const INT ldm,
+                                     const FIXP_STP *trigdata,
+                                     const INT trigstep) {
+  const INT m = (1 << ldm);
+  const INT mh = (m >> 1);
+  INT k, r;
+
+  for (k = 0; k < mh / 2; k += 2) {
+    INT c0, s0, c1, s1;
+
+    dit_fft_twiddle(&c0, &s0, k, mh, trigdata, trigstep);
+    dit_fft_twiddle(&c1, &s1, k + 1, mh, trigdata, trigstep);
+    const __m128i c = _mm_set_epi32(0, c1, 0, c0);
+    const __m128i s = _mm_set_epi32(0, s1, 0, s0);
+
+    for (r = 0; r < n; r += m) {
+      FIXP_DBL *x1 = &x[(r + k) << 1];
+
+      dit_fft_bfly_sse(x1, x1 + m, c, s, 0);
+      dit_fft_bfly_sse(x1 + mh, x1 + mh + m, c, s, 1);
+    }
+  }
+}
+
+/* radix 2 stage ldm >= 4, 4 butterflies per step */
+FDK_TARGET("avx2")
+static inline void dit_fft_stage_avx2(FIXP_DBL *x, const INT n, const INT ldm,
+                                      const FIXP_STP *trigdata,
+                                      const INT trigstep) {
+  const INT m = (1 << ldm);
+  const INT mh = (m >> 1);
+  INT k, r;
+
+  for (k = 0; k < mh / 2; k += 4) {
+    INT c0, s0, c1, s1, c2, s2, c3, s3;
+
+    dit_fft_twiddle(&c0, &s0, k, mh, trigdata, trigstep);
+    dit_fft_twiddle(&c1, &s1, k + 1, mh, trigdata, trigstep);
+    dit_fft_twiddle(&c2, &s2, k + 2, mh, trigdata, trigstep);
+    dit_fft_twiddle(&c3, &s3, k + 3, mh, trigdata, trigstep);
+    const __m256i c = _mm256_set_epi32(0, c3, 0, c2, 0, c1, 0, c0);
+    const __m256i s = _mm256_set_epi32(0, s3, 0, s2, 0, s1, 0, s0);
+
+    for (r = 0; r < n; r += m) {
+      FIXP_DBL *x1 = &x[(r + k) << 1];
+
+      dit_fft_bfly_avx2(x1, x1 + m, c, s, 0);
+      dit_fft_bfly_avx2(x1 + mh, x1 + mh + m, c, s, 1);
+    }
+  }
+}
+
+#define FUNCTION_dit_fft_sse41
+FDK_TARGET("sse4.1")
+static void dit_fft_sse41(FIXP_DBL *x, const INT ldn, const FIXP_STP *trigdata,
+                          const INT trigDataSize) {
+  const INT n = 1 << ldn;
+
+  C_ALLOC_ALIGNED_CHECK(x);
+
+  scramble(x, n);
+  dit_fft_radix4_sse(x, n);
+
+  for (INT ldm = 3; ldm <= ldn; ++ldm) {
+    const INT trigstep = ((trigDataSize << 2) >> ldm);
+    FDK_ASSERT(trigstep > 0);
+
+    dit_fft_stage_sse(x, n, ldm, trigdata, trigstep);
+  }
+}
+
+#define FUNCTION_dit_fft_avx2
+FDK_TARGET("avx2")
+static void dit_fft_avx2(FIXP_DBL *x, const INT ldn, const FIXP_STP *trigdata,
+                         const INT trigDataSize) {
+  const INT n = 1 << ldn;
+
+  C_ALLOC_ALIGNED_CHECK(x);
+
+  scramble(x, n);
+  dit_fft_radix4_sse(x, n);
+
+  for (INT ldm = 3; ldm <= ldn; ++ldm) {
+    const INT trigstep = ((trigDataSize << 2) >> ldm);
+    FDK_ASSERT(trigstep > 0);
+
+    if (ldm >= 4) {
+      dit_fft_stage_avx2(x, n, ldm, trigdata, trigstep);
+    } else {
+      dit_fft_stage_sse(x, n, ldm, trigdata, trigstep);
+    }
+  }
+}
+
+#endif /* SINETABLE_16BIT && (__GNUC__ || _MSC_VER) */
@@ -0,0 +1,62 @@
+#pragma once
+
+/* SSE4.1 versions of functions of fft.cpp: included there and selected at
+ * runtime by fftSelectKernels(). The results are bit exact to the generic
+ * functions. */
+
+#if defined(SINETABLE_16BIT) && (defined(__GNUC__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+#include "libSYS/FDK_cpu.h"
+
+#define FUNCTION_fft_apply_rot_vector_sse41
+FDK_TARGET("sse4.1")
+static void fft_apply_rot_vector_sse41(FIXP_DBL *RESTRICT pData, const int cl,
+                                       const int l, const FIXP_STB *pVecRe,
+                                       const FIXP_STB *pVecIm) {
+  const __m128i sign = _mm_set_epi32(-1, 1, -1, 1);
+  FIXP_DBL re, im;
+
+  int i, c;
+
+  for (i = 0; i < cl; i++) {
+    pData[2 * i] >>= 2;     /* * 0.25 */
+    pData[2 * i + 1] >>= 2; /* * 0.25 */
+  }
+  for (; i < l; i += cl) {
+    pData[2 * i] >>= 2;     /* * 0.25 */
+    pData[2 * i + 1] >>= 2; /* * 0.25 */
+
+    /* 2 values per step, the factors are scaled by 2^15 into the even lanes:
+     * (x * v * 2^15) >> 31 == fMultDiv2(x, v) */
+    for (c = i + 1; c < i + cl - 1; c += 2) {
+      __m128i x = _mm_srai_epi32(_mm_loadu_si128((__m128i *)&pData[2 * c]), 1);
+      __m128i y = _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+      __m128i vre = _mm_set_epi32(0, (INT)pVecRe[1] << 15, 0,
+                                  (INT)pVecRe[0] << 15);
+      __m128i vim = _mm_set_epi32(0, (INT)pVecIm[1] << 15, 0,
+                                  (INT)pVecIm[0] << 15);
+      pVecRe += 2;
+      pVecIm += 2;
+
+      /* (re*vre, im*vre) + (im*vim, -re*vim) */
+      x = _mm_blend_epi16(
+          _mm_srli_epi64(_mm_mul_epi32(x, vre), 31),
+          _mm_slli_epi64(_mm_mul_epi32(_mm_srli_epi64(x, 32), vre), 1), 0xCC);
+      y = _mm_blend_epi16(
+          _mm_srli_epi64(_mm_mul_epi32(y, vim), 31),
+          _mm_slli_epi64(_mm_mul_epi32(_mm_srli_epi64(y, 32), vim), 1), 0xCC);
+      _mm_storeu_si128((__m128i *)&pData[2 * c],
+                       _mm_add_epi32(x, _mm_sign_epi32(y, sign)));
+    }
+    if (c < i + cl) {
+      re = pData[2 * c] >> 1;
+      im = pData[2 * c + 1] >> 1;
+
+      cplxMultDiv2(&pData[2 * c + 1], &pData[2 * c], im, re, *pVecRe++,
+                   *pVecIm++);
+    }
+  }
+}
+
+#endif /* SINETABLE_16BIT && (__GNUC__ || _MSC_VER) */
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "libFDK/FDK_archdef.h"
+#include "libSYS/machine_type.h"
+
+/* The 32x32 multiplication is exact on x86: the bit exact variants are the
+ * same functions. */
+#define FUNCTION_fixmuldiv2BitExact_DD
+#define FUNCTION_fixmulBitExact_DD
+#define FUNCTION_fixmulBitExact_SD
+#define FUNCTION_fixmulBitExact_DS
+#define fixmuldiv2BitExact_DD(a, b) fixmuldiv2_DD(a, b)
+#define fixmulBitExact_DD(a, b) fixmul_DD(a, b)
+#define fixmulBitExact_SD(a, b) fixmul_SD(a, b)
+#define fixmulBitExact_DS(a, b) fixmul_DS(a, b)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+/* 32x32->64 bit signed multiplication without the 64x64 bit helper of 32 bit
+ * builds */
+#define FUNCTION_fixmuldiv2_DD
+inline LONG fixmuldiv2_DD(const LONG a, const LONG b) {
+  return (LONG)(__emul(a, b) >> 32);
+}
+
+#define FUNCTION_fixmuldiv2_SD
+inline LONG fixmuldiv2_SD(const SHORT a, const LONG b) {
+  return (LONG)(__emul(a, b) >> 16);
+}
+
+#endif /* GCC and Clang compile the generic code to a single imul */
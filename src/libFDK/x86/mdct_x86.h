@@ -0,0 +1,141 @@
+#pragma once
+
+/* SSE4.1 and AVX2 versions of the windowing and overlap-add of imlt_block():
+ * included by mdct.cpp and selected at runtime by mdctSelectKernels(). The
+ * results are bit exact to the generic function. */
+
+#if defined(WINDOWTABLE_16BIT) && (defined(__GNUC__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+#include "libSYS/FDK_cpu.h"
+
+/* Remaining samples i .. n-1 of imdct_window_overlap() */
+static inline void imdct_window_overlap_tail(
+    FIXP_DBL *pOut0, FIXP_DBL *pOut1, const FIXP_DBL *pCurr,
+    const FIXP_DBL *pOvl, const FIXP_WTP *pWindow, int i, const int n,
+    const int prevPrevAliasSymmetry, const int prevAliasSymmetry) {
+  for (; i < n; i++) {
+    FIXP_DBL x0, x1;
+    cplxMultDiv2(&x1, &x0, pCurr[i],
+                 (prevPrevAliasSymmetry == 0) ? -pOvl[-i] : pOvl[-i],
+                 pWindow[i]);
+    pOut0[i] = IMDCT_SCALE_DBL_LSH1(x0);
+    pOut1[-i] = IMDCT_SCALE_DBL_LSH1((prevAliasSymmetry == 0) ? -x1 : x1);
+  }
+}
+
+/* The window coefficients w of the packed pairs (re, im) are used as re << 16
+ * and im << 16 in 32 bit lanes: the high half of the 64 bit product
+ * x * (w << 16) is fMultDiv2(x, w). */
+FDK_TARGET("sse4.1")
+static inline __m128i imdct_mult_sse(const __m128i x, const __m128i w) {
+  __m128i even = _mm_srli_epi64(_mm_mul_epi32(x, w), 32);
+  __m128i odd = _mm_mul_epi32(_mm_srli_epi64(x, 32), _mm_srli_epi64(w, 32));
+  return _mm_blend_epi16(even, odd, 0xCC);
+}
+
+/* IMDCT_SCALE_DBL_LSH1(): x << 1 saturated to 0x7FFFFFFF and 0x80000001 */
+FDK_TARGET("sse4.1")
+static inline __m128i imdct_lsh1_sse(const __m128i x) {
+  const __m128i max = _mm_set1_epi32(0x3FFFFFFF);
+  const __m128i min = _mm_set1_epi32(-0x3FFFFFFF);
+  __m128i r = _mm_slli_epi32(_mm_min_epi32(_mm_max_epi32(x, min), max), 1);
+  /* +1 above and -1 below the range */
+  return _mm_add_epi32(_mm_sub_epi32(r, _mm_cmpgt_epi32(x, max)),
+                       _mm_cmplt_epi32(x, min));
+}
+
+#define FUNCTION_imdct_window_overlap_sse41
+FDK_TARGET("sse4.1")
+static void imdct_window_overlap_sse41(FIXP_DBL *pOut0, FIXP_DBL *pOut1,
+                                       const FIXP_DBL *pCurr,
+                                       const FIXP_DBL *pOvl,
+                                       const FIXP_WTP *pWindow, const int n,
+                                       const int prevPrevAliasSymmetry,
+                                       const int prevAliasSymmetry) {
+  const __m128i signOvl = _mm_set1_epi32((prevPrevAliasSymmetry == 0) ? -1 : 1);
+  const __m128i signX1 = _mm_set1_epi32((prevAliasSymmetry == 0) ? -1 : 1);
+  const __m128i maskIm = _mm_set1_epi32((INT)0xFFFF0000);
+  int i;
+
+  for (i = 0; i < n - 3; i += 4) {
+    const __m128i w = _mm_loadu_si128((const __m128i *)&pWindow[i]);
+    const __m128i wRe = _mm_slli_epi32(w, 16);
+    const __m128i wIm = _mm_and_si128(w, maskIm);
+    const __m128i curr = _mm_loadu_si128((const __m128i *)&pCurr[i]);
+    const __m128i ovl = _mm_sign_epi32(
+        _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&pOvl[-i - 3]),
+                          _MM_SHUFFLE(0, 1, 2, 3)),
+        signOvl);
+    /* cplxMultDiv2(&x1, &x0, curr, ovl, w) */
+    __m128i x1 = _mm_sub_epi32(imdct_mult_sse(curr, wRe),
+                               imdct_mult_sse(ovl, wIm));
+    __m128i x0 = _mm_add_epi32(imdct_mult_sse(curr, wIm),
+                               imdct_mult_sse(ovl, wRe));
+
+    _mm_storeu_si128((__m128i *)&pOut0[i], imdct_lsh1_sse(x0));
+    x1 = imdct_lsh1_sse(_mm_sign_epi32(x1, signX1));
+    _mm_storeu_si128((__m128i *)&pOut1[-i - 3],
+                     _mm_shuffle_epi32(x1, _MM_SHUFFLE(0, 1, 2, 3)));
+  }
+  imdct_window_overlap_tail(pOut0, pOut1, pCurr, pOvl, pWindow, i, n,
+                            prevPrevAliasSymmetry, prevAliasSymmetry);
+}
+
+FDK_TARGET("avx2")
+static inline __m256i imdct_mult_avx2(const __m256i x, const __m256i w) {
+  __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(x, w), 32);
+  __m256i odd =
+      _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(w, 32));
+  return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+FDK_TARGET("avx2")
+static inline __m256i imdct_lsh1_avx2(const __m256i x) {
+  const __m256i max = _mm256_set1_epi32(0x3FFFFFFF);
+  const __m256i min = _mm256_set1_epi32(-0x3FFFFFFF);
+  __m256i r =
+      _mm256_slli_epi32(_mm256_min_epi32(_mm256_max_epi32(x, min), max), 1);
+  return _mm256_add_epi32(_mm256_sub_epi32(r, _mm256_cmpgt_epi32(x, max)),
+                          _mm256_cmpgt_epi32(min, x));
+}
+
+#define FUNCTION_imdct_window_overlap_avx2
+FDK_TARGET("avx2")
+static void imdct_window_overlap_avx2(FIXP_DBL *pOut0, FIXP_DBL *pOut1,
+                                      const FIXP_DBL *pCurr,
+                                      const FIXP_DBL *pOvl,
+                                      const FIXP_WTP *pWindow, const int n,
+                                      const int prevPrevAliasSymmetry,
+                                      const int prevAliasSymmetry) {
+  const __m256i signOvl =
+      _mm256_set1_epi32((prevPrevAliasSymmetry == 0) ? -1 : 1);
+  const __m256i signX1 = _mm256_set1_epi32((prevAliasSymmetry == 0) ? -1 : 1);
+  const __m256i maskIm = _mm256_set1_epi32((INT)0xFFFF0000);
+  const __m256i reverse = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  int i;
+
+  for (i = 0; i < n - 7; i += 8) {
+    const __m256i w = _mm256_loadu_si256((const __m256i *)&pWindow[i]);
+    const __m256i wRe = _mm256_slli_epi32(w, 16);
+    const __m256i wIm = _mm256_and_si256(w, maskIm);
+    const __m256i curr = _mm256_loadu_si256((const __m256i *)&pCurr[i]);
+    const __m256i ovl = _mm256_sign_epi32(
+        _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256((const __m256i *)&pOvl[-i - 7]), reverse),
+        signOvl);
+    __m256i x1 = _mm256_sub_epi32(imdct_mult_avx2(curr, wRe),
+                                  imdct_mult_avx2(ovl, wIm));
+    __m256i x0 = _mm256_add_epi32(imdct_mult_avx2(curr, wIm),
+                                  imdct_mult_avx2(ovl, wRe));
+
+    _mm256_storeu_si256((__m256i *)&pOut0[i], imdct_lsh1_avx2(x0));
+    x1 = imdct_lsh1_avx2(_mm256_sign_epi32(x1, signX1));
+    _mm256_storeu_si256((__m256i *)&pOut1[-i - 7],
+                        _mm256_permutevar8x32_epi32(x1, reverse));
+  }
+  imdct_window_overlap_tail(pOut0, pOut1, pCurr, pOvl, pWindow, i, n,
+                            prevPrevAliasSymmetry, prevAliasSymmetry);
+}
+
+#endif /* WINDOWTABLE_16BIT && (__GNUC__ || _MSC_VER) */
@@ -0,0 +1,233 @@
+#pragma once
+
+/* SSE4.1 and AVX2 versions of the prototype filters and the analysis rotation
+ * of qmf.cpp: included there and selected at runtime by qmfSelectKernels().
+ * The results are bit exact to the generic functions. */
+
+#if defined(QMF_COEFF_16BIT) && (defined(__GNUC__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+#include "libSYS/FDK_cpu.h"
+
+/* The 16 bit coefficients c are held as c << 16 in 32 bit lanes: the high
+ * half of the 64 bit product x * (c << 16) is fMultDiv2(x, c). */
+FDK_TARGET("sse4.1")
+static inline __m128i qmf_mult_sse(const __m128i x, const __m128i c) {
+  __m128i even = _mm_srli_epi64(_mm_mul_epi32(x, c), 32);
+  __m128i odd = _mm_mul_epi32(_mm_srli_epi64(x, 32), _mm_srli_epi64(c, 32));
+  return _mm_blend_epi16(even, odd, 0xCC);
+}
+
+FDK_TARGET("sse4.1")
+static inline __m128i qmf_coeff_sse(const FIXP_SGL *c) {
+  return _mm_slli_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)c)),
+                        16);
+}
+
+FDK_TARGET("avx2")
+static inline __m256i qmf_mult_avx2(const __m256i x, const __m256i c) {
+  __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(x, c), 32);
+  __m256i odd =
+      _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(c, 32));
+  return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+/* One band per step: the states sta[0..7] are updated from sta[1..8] with the
+ * coefficients (p_flt[4], p_fltm[1], p_flt[3], p_fltm[2], p_flt[2], p_fltm[3],
+ * p_flt[1], p_fltm[4]) applied alternately to imag and real. */
+#define FUNCTION_qmfSynPrototypeFir_sse41
+FDK_TARGET("sse4.1")
+static void qmfSynPrototypeFir_sse41(FIXP_DBL *RESTRICT sta,
+                                     FIXP_DBL *RESTRICT realSlot,
+                                     const FIXP_DBL *RESTRICT imagSlot,
+                                     const FIXP_PFT *RESTRICT p_flt,
+                                     const FIXP_PFT *RESTRICT p_fltm,
+                                     const INT pfltStep,
+                                     const INT no_channels) {
+  /* p_flt[1..4], p_fltm[1..4] to the upper halfs of the 32 bit lanes */
+  const __m128i shufA = _mm_set_epi8(11, 10, -128, -128, 5, 4, -128, -128, 9,
+                                     8, -128, -128, 7, 6, -128, -128);
+  const __m128i shufB = _mm_set_epi8(15, 14, -128, -128, 1, 0, -128, -128, 13,
+                                     12, -128, -128, 3, 2, -128, -128);
+  int j;
+
+  for (j = no_channels - 1; j >= 0; j--) {
+    const FIXP_DBL imag = imagSlot[j];
+    const FIXP_DBL real = realSlot[j];
+    const __m128i c =
+        _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)&p_flt[1]),
+                           _mm_loadl_epi64((const __m128i *)&p_fltm[1]));
+    __m128i x = _mm_unpacklo_epi32(_mm_cvtsi32_si128(imag),
+                                   _mm_cvtsi32_si128(real));
+    x = _mm_unpacklo_epi64(x, x);
+
+    realSlot[j] = fMultAddDiv2(sta[0], p_fltm[0], real);
+
+    _mm_storeu_si128(
+        (__m128i *)&sta[0],
+        _mm_add_epi32(_mm_loadu_si128((const __m128i *)&sta[1]),
+                      qmf_mult_sse(x, _mm_shuffle_epi8(c, shufA))));
+    _mm_storeu_si128(
+        (__m128i *)&sta[4],
+        _mm_add_epi32(_mm_loadu_si128((const __m128i *)&sta[5]),
+                      qmf_mult_sse(x, _mm_shuffle_epi8(c, shufB))));
+    sta[8] = fMultDiv2(p_flt[0], imag);
+
+    p_flt += pfltStep;
+    p_fltm -= pfltStep;
+    sta += 2 * QMF_NO_POLY - 1;
+  }
+}
+
+#define FUNCTION_qmfSynPrototypeFir_avx2
+FDK_TARGET("avx2")
+static void qmfSynPrototypeFir_avx2(FIXP_DBL *RESTRICT sta,
+                                    FIXP_DBL *RESTRICT realSlot,
+                                    const FIXP_DBL *RESTRICT imagSlot,
+                                    const FIXP_PFT *RESTRICT p_flt,
+                                    const FIXP_PFT *RESTRICT p_fltm,
+                                    const INT pfltStep, const INT no_channels) {
+  /* p_flt[1..4], p_fltm[1..4] to the order of the states */
+  const __m128i shuf =
+      _mm_set_epi8(15, 14, 1, 0, 13, 12, 3, 2, 11, 10, 5, 4, 9, 8, 7, 6);
+  int j;
+
+  for (j = no_channels - 1; j >= 0; j--) {
+    const FIXP_DBL imag = imagSlot[j];
+    const FIXP_DBL real = realSlot[j];
+    const __m128i c =
+        _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)&p_flt[1]),
+                           _mm_loadl_epi64((const __m128i *)&p_fltm[1]));
+    const __m256i x = _mm256_broadcastq_epi64(_mm_unpacklo_epi32(
+        _mm_cvtsi32_si128(imag), _mm_cvtsi32_si128(real)));
+
+    realSlot[j] = fMultAddDiv2(sta[0], p_fltm[0], real);
+
+    _mm256_storeu_si256(
+        (__m256i *)&sta[0],
+        _mm256_add_epi32(
+            _mm256_loadu_si256((const __m256i *)&sta[1]),
+            qmf_mult_avx2(x, _mm256_slli_epi32(
+                                 _mm256_cvtepi16_epi32(_mm_shuffle_epi8(c, shuf)),
+                                 16))));
+    sta[8] = fMultDiv2(p_flt[0], imag);
+
+    p_flt += pfltStep;
+    p_fltm -= pfltStep;
+    sta += 2 * QMF_NO_POLY - 1;
+  }
+}
+
+/* Coefficients p = 0..4 of the 4 coefficient sets flt, flt + step, ...,
+ * flt + 3 * step, each shifted left by 16 into the lanes of c[p]. */
+FDK_TARGET("sse4.1")
+static inline void qmf_coeff_transpose_sse(__m128i *c, const FIXP_PFT *flt,
+                                           const INT step) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i r0 = _mm_loadl_epi64((const __m128i *)&flt[0 * step]);
+  const __m128i r1 = _mm_loadl_epi64((const __m128i *)&flt[1 * step]);
+  const __m128i r2 = _mm_loadl_epi64((const __m128i *)&flt[2 * step]);
+  const __m128i r3 = _mm_loadl_epi64((const __m128i *)&flt[3 * step]);
+  const __m128i t01 = _mm_unpacklo_epi16(r0, r1);
+  const __m128i t23 = _mm_unpacklo_epi16(r2, r3);
+  __m128i u;
+
+  u = _mm_unpacklo_epi32(t01, t23);
+  c[0] = _mm_unpacklo_epi16(zero, u);
+  c[1] = _mm_unpackhi_epi16(zero, u);
+  u = _mm_unpackhi_epi32(t01, t23);
+  c[2] = _mm_unpacklo_epi16(zero, u);
+  c[3] = _mm_unpackhi_epi16(zero, u);
+  c[4] = _mm_set_epi32((INT)flt[3 * step + 4] << 16,
+                       (INT)flt[2 * step + 4] << 16,
+                       (INT)flt[1 * step + 4] << 16, (INT)flt[4] << 16);
+}
+
+/* 4 bands k per step, the coefficient sets of neighboring bands are
+ * QMF_NO_POLY * p_stride apart. */
+#define FUNCTION_qmfAnaPrototypeFirSlot_sse41
+FDK_TARGET("sse4.1")
+static void qmfAnaPrototypeFirSlot_sse41(FIXP_DBL *analysisBuffer,
+                                         INT no_channels,
+                                         const FIXP_PFT *p_filter,
+                                         INT p_stride,
+                                         FIXP_DBL *RESTRICT pFilterStates) {
+  const INT pfltStep = QMF_NO_POLY * p_stride;
+  const INT staStep = no_channels << 1;
+  const FIXP_DBL *sta_0 = pFilterStates;
+  const FIXP_DBL *sta_1 = pFilterStates + (2 * QMF_NO_POLY * no_channels) - 4;
+  FIXP_DBL *pData_0 = analysisBuffer + 2 * no_channels - 4;
+  FIXP_DBL *pData_1 = analysisBuffer;
+  INT k, p;
+
+  FDK_ASSERT((no_channels & 3) == 0);
+
+  for (k = 0; k < no_channels; k += 4) {
+    const FIXP_PFT *p_flt = p_filter + k * pfltStep;
+    __m128i c_0[QMF_NO_POLY], c_1[QMF_NO_POLY];
+    __m128i accu_0 = _mm_setzero_si128();
+    __m128i accu_1 = _mm_setzero_si128();
+
+    /* bands k .. k+3 use the sets k .. k+3 with sta_1 and the sets
+     * k+1 .. k+4 with sta_0 */
+    qmf_coeff_transpose_sse(c_1, p_flt, pfltStep);
+    qmf_coeff_transpose_sse(c_0, p_flt + pfltStep, pfltStep);
+
+    for (p = 0; p < QMF_NO_POLY; p++) {
+      /* sta_1 runs backwards */
+      accu_1 = _mm_add_epi32(
+          accu_1,
+          qmf_mult_sse(
+              _mm_shuffle_epi32(
+                  _mm_loadu_si128((const __m128i *)(sta_1 - p * staStep)),
+                  _MM_SHUFFLE(0, 1, 2, 3)),
+              c_1[p]));
+      accu_0 = _mm_add_epi32(
+          accu_0,
+          qmf_mult_sse(_mm_loadu_si128((const __m128i *)(sta_0 + p * staStep)),
+                       c_0[p]));
+    }
+
+    _mm_storeu_si128((__m128i *)pData_1, _mm_slli_epi32(accu_1, 1));
+    _mm_storeu_si128(
+        (__m128i *)pData_0,
+        _mm_shuffle_epi32(_mm_slli_epi32(accu_0, 1), _MM_SHUFFLE(0, 1, 2, 3)));
+
+    sta_0 += 4;
+    sta_1 -= 4;
+    pData_0 -= 4;
+    pData_1 += 4;
+  }
+}
+
+/* cplxMult() of 4 bands per step, fMult() = fMultDiv2() << 1 */
+#define FUNCTION_qmfForwardRotation_sse41
+FDK_TARGET("sse4.1")
+static void qmfForwardRotation_sse41(FIXP_DBL *RESTRICT rSubband,
+                                     FIXP_DBL *RESTRICT iSubband,
+                                     const FIXP_QTW *t_cos,
+                                     const FIXP_QTW *t_sin, const int len) {
+  int i;
+
+  for (i = 0; i < len - 3; i += 4) {
+    const __m128i c = qmf_coeff_sse(&t_cos[i]);
+    const __m128i s = qmf_coeff_sse(&t_sin[i]);
+    const __m128i re = _mm_loadu_si128((const __m128i *)&rSubband[i]);
+    const __m128i im = _mm_loadu_si128((const __m128i *)&iSubband[i]);
+
+    _mm_storeu_si128(
+        (__m128i *)&iSubband[i],
+        _mm_slli_epi32(
+            _mm_sub_epi32(qmf_mult_sse(im, c), qmf_mult_sse(re, s)), 1));
+    _mm_storeu_si128(
+        (__m128i *)&rSubband[i],
+        _mm_slli_epi32(
+            _mm_add_epi32(qmf_mult_sse(im, s), qmf_mult_sse(re, c)), 1));
+  }
+  for (; i < len; i++) {
+    cplxMult(&iSubband[i], &rSubband[i], iSubband[i], rSubband[i], t_cos[i],
+             t_sin[i]);
+  }
+}
+
+#endif /* QMF_COEFF_16BIT && (__GNUC__ || _MSC_VER) */
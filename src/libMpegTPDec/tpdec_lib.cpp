@@ -140,6 +140,9 @@ struct TRANSPORTDEC {
 
   FDK_BITSTREAM bitStream[1]; /* Bitstream reader */
   UCHAR *bsBuffer;            /* Internal bitstreamd data buffer */
+  const UCHAR *pExtBuffer;    /* Caller owned bitstream read in place. */
+  UINT64 extSize;             /* Size of pExtBuffer in bytes. */
+  UINT64 extWindowEnd;        /* End of the bitstream window in pExtBuffer. */
 
   transportdec_parser_t parser; /* Format specific parser structs. */
 
@@ -646,6 +649,10 @@ TRANSPORTDEC_ERROR transportDec_FillData(const HANDLE_TRANSPORTDEC hTp,
   if ((hTp == NULL) || (layer >= 1)) {
     return TRANSPORTDEC_INVALID_PARAMETER;
   }
+  if (hTp->pExtBuffer != NULL) {
+    /* the bit buffer points to caller memory */
+    return TRANSPORTDEC_INVALID_PARAMETER;
+  }
 
   /* set bitbuffer shortcut */
   hBs = &hTp->bitStream[layer];
@@ -678,6 +685,63 @@ TRANSPORTDEC_ERROR transportDec_FillData(const HANDLE_TRANSPORTDEC hTp,
   return TRANSPORTDEC_OK;
 }
 
+/*
+ * Let the bit stream read pExtBuffer from bitPos on. The bit buffer is a ring
+ * of a power of 2 size whose readers may access a few bytes beyond the valid
+ * bits, so a window of the internal buffer size is mapped as long as enough
+ * data is left and the tail is copied into the internal buffer.
+ */
+static void transportDec_MapInputBuffer(HANDLE_TRANSPORTDEC hTp,
+                                        const UINT64 bitPos) {
+  HANDLE_FDK_BITSTREAM hBs = &hTp->bitStream[0];
+  UINT64 offset = bitPos >> 3;
+  UINT64 remaining = hTp->extSize - offset;
+
+  if (remaining >= (8192 * 4)) {
+    FDKinitBitStream(hBs, (UCHAR *)hTp->pExtBuffer + offset, (8192 * 4),
+                     (8192 * 4) << 3, BS_READER);
+    hTp->extWindowEnd = offset + (8192 * 4);
+  } else {
+    UINT bytesValid = (UINT)remaining;
+
+    FDKinitBitStream(hBs, hTp->bsBuffer, (8192 * 4), 0, BS_READER);
+    FDKfeedBuffer(hBs, hTp->pExtBuffer + offset, (UINT)remaining, &bytesValid);
+    hTp->pExtBuffer = NULL;
+  }
+  FDKpushFor(hBs, (UINT)(bitPos & 7));
+}
+
+TRANSPORTDEC_ERROR transportDec_SetInputBuffer(const HANDLE_TRANSPORTDEC hTp,
+                                               const UCHAR *pBuffer,
+                                               const UINT64 bufferSize) {
+  if (hTp == NULL) {
+    return TRANSPORTDEC_INVALID_PARAMETER;
+  }
+  if (TT_IS_PACKET(hTp->transportFmt)) {
+    return TRANSPORTDEC_UNSUPPORTED_FORMAT;
+  }
+
+  hTp->pExtBuffer = pBuffer;
+  hTp->extSize = (pBuffer != NULL) ? bufferSize : 0;
+  hTp->numberOfRawDataBlocks = 0;
+  transportDec_MapInputBuffer(hTp, 0);
+
+  return TRANSPORTDEC_OK;
+}
+
+void transportDec_AdvanceInput(const HANDLE_TRANSPORTDEC hTp) {
+  INT validBits;
+
+  if ((hTp == NULL) || (hTp->pExtBuffer == NULL) ||
+      (hTp->numberOfRawDataBlocks > 0)) {
+    return;
+  }
+
+  validBits = (INT)FDKgetValidBits(&hTp->bitStream[0]);
+  transportDec_MapInputBuffer(
+      hTp, (hTp->extWindowEnd << 3) - (UINT64)FDKmax(0, validBits));
+}
+
 HANDLE_FDK_BITSTREAM transportDec_GetBitstream(const HANDLE_TRANSPORTDEC hTp,
                                                const UINT layer) {
   return &hTp->bitStream[layer];
@@ -1056,6 +1120,116 @@ bail:
 /* How many bits to advance for synchronization search. */
 #define TPDEC_SYNCSKIP 8
 
+/* Byte at offset i from the read position of the bit buffer */
+static inline UCHAR tpdecPeekByte(const FDK_BITBUF *hBitBuf, const INT i) {
+  return hBitBuf->Buffer[((hBitBuf->BitNdx >> 3) + i) &
+                         (hBitBuf->bufSize - 1)];
+}
+
+/**
+ * \brief Check a candidate sync word position of the sync word pre-scan. The
+ * header fields which can be checked without parsing must be valid and, if the
+ * start of the next frame is in the buffer, it must carry a sync word as well.
+ *
+ * \param hBitBuf    Bit buffer, the read position is byte aligned.
+ * \param transportFmt  TT_MP4_ADTS or TT_MP4_LOAS.
+ * \param pos        Byte offset of the candidate.
+ * \param numBytes   Number of valid bytes in the buffer.
+ * \return           1 if the candidate is handed to the header parser.
+ */
+static int tpdecCheckSyncCandidate(const FDK_BITBUF *hBitBuf,
+                                   const TRANSPORT_TYPE transportFmt,
+                                   const INT pos, const INT numBytes) {
+  INT next;
+
+  if (transportFmt == TT_MP4_ADTS) {
+    if (pos + 7 > numBytes) return 1; /* let the parser wait for the header */
+
+    UCHAR b1 = tpdecPeekByte(hBitBuf, pos + 1);
+    UCHAR b2 = tpdecPeekByte(hBitBuf, pos + 2);
+    INT frameLength = ((tpdecPeekByte(hBitBuf, pos + 3) & 0x3) << 11) |
+                      (tpdecPeekByte(hBitBuf, pos + 4) << 3) |
+                      (tpdecPeekByte(hBitBuf, pos + 5) >> 5);
+    INT headerLength = (b1 & 0x1) ? 7 : 9; /* protection_absent */
+
+    if (((b1 >> 1) & 0x3) != 0) return 0;   /* layer */
+    if (((b2 >> 2) & 0xF) >= 13) return 0;  /* sampling_frequency_index */
+    if (frameLength < headerLength) return 0;
+
+    next = pos + frameLength;
+    if (next + 2 <= numBytes) {
+      return (tpdecPeekByte(hBitBuf, next) == 0xFF) &&
+             ((tpdecPeekByte(hBitBuf, next + 1) & 0xF0) == 0xF0);
+    }
+  } else {
+    if (pos + 3 > numBytes) return 1;
+
+    /* audioMuxLengthBytes */
+    next = pos + 3 +
+           (((tpdecPeekByte(hBitBuf, pos + 1) & 0x1F) << 8) |
+            tpdecPeekByte(hBitBuf, pos + 2));
+    if (next + 2 <= numBytes) {
+      return (tpdecPeekByte(hBitBuf, next) == 0x56) &&
+             ((tpdecPeekByte(hBitBuf, next + 1) & 0xE0) == 0xE0);
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * \brief Sync word pre-scan of ADTS and LOAS streams. Searches the bit buffer
+ * for the first byte of the sync word with FDKmemchr() instead of sliding the
+ * sync word through the bitstream reader one byte at a time, and skips
+ * candidates which fail tpdecCheckSyncCandidate().
+ *
+ * \param hBs            Bitstream with synced cache and byte aligned read
+ * position.
+ * \param transportFmt   TT_MP4_ADTS or TT_MP4_LOAS.
+ * \param syncLength     Length of the sync word in bits.
+ * \param bitsAvail      Valid bits of hBs.
+ * \return Number of bytes without an acceptable candidate which can be
+ * skipped. If there is no candidate, all but the last two positions where the
+ * sync word fits are skipped, so the bit search ends where it did without the
+ * pre-scan.
+ */
+static INT tpdecSyncPreScan(HANDLE_FDK_BITSTREAM hBs,
+                            const TRANSPORT_TYPE transportFmt,
+                            const INT syncLength, const INT bitsAvail) {
+  const FDK_BITBUF *hBitBuf = &hBs->hBitBuf;
+  const INT numBytes = bitsAvail >> 3;
+  const INT lastPos = (bitsAvail - syncLength) / TPDEC_SYNCSKIP - 1;
+  const UCHAR firstByte = (transportFmt == TT_MP4_ADTS) ? 0xFF : 0x56;
+  const UCHAR secondMask = (transportFmt == TT_MP4_ADTS) ? 0xF0 : 0xE0;
+  INT pos = 0;
+
+  if ((hBitBuf->BitNdx & 0x7) || (lastPos <= 0)) {
+    return 0;
+  }
+
+  while (pos < lastPos) {
+    /* search the contiguous part of the ring buffer */
+    UINT start = ((hBitBuf->BitNdx >> 3) + pos) & (hBitBuf->bufSize - 1);
+    INT len = FDKmin(lastPos - pos, (INT)(hBitBuf->bufSize - start));
+    const UCHAR *pFound =
+        (const UCHAR *)FDKmemchr(&hBitBuf->Buffer[start], firstByte, len);
+
+    if (pFound == NULL) {
+      pos += len;
+      continue;
+    }
+    pos += (INT)(pFound - &hBitBuf->Buffer[start]);
+
+    if (((tpdecPeekByte(hBitBuf, pos + 1) & secondMask) == secondMask) &&
+        tpdecCheckSyncCandidate(hBitBuf, transportFmt, pos, numBytes)) {
+      break;
+    }
+    pos++;
+  }
+
+  return pos;
+}
+
 static TRANSPORTDEC_ERROR synchronization(HANDLE_TRANSPORTDEC hTp,
                                           INT *pHeaderBits) {
   TRANSPORTDEC_ERROR err = TRANSPORTDEC_OK, errFirstFrame = TRANSPORTDEC_OK;
@@ -1125,6 +1299,14 @@ static TRANSPORTDEC_ERROR synchronization(HANDLE_TRANSPORTDEC hTp,
 
       FDK_ASSERT((bitsAvail % TPDEC_SYNCSKIP) == 0);
 
+      if (!(hTp->flags & TPDEC_SYNCOK) &&
+          ((hTp->transportFmt == TT_MP4_ADTS) ||
+           (hTp->transportFmt == TT_MP4_LOAS))) {
+        INT skipBytes = tpdecSyncPreScan(hBs, hTp->transportFmt, syncLength, bitsAvail);
+        FDKpushFor(hBs, skipBytes * TPDEC_SYNCSKIP);
+        bitsAvail -= skipBytes * TPDEC_SYNCSKIP;
+      }
+
       if ((bitsAvail - syncLength) < TPDEC_SYNCSKIP) {
         err = TRANSPORTDEC_NOT_ENOUGH_BITS;
         headerBits = 0;
@@ -1697,6 +1879,11 @@ TRANSPORTDEC_ERROR transportDec_SetParam(const HANDLE_TRANSPORTDEC hTp,
     case TPDEC_PARAM_RESET: {
       int i;
 
+      if (hTp->pExtBuffer != NULL) {
+        hTp->pExtBuffer = NULL;
+        FDKinitBitStream(&hTp->bitStream[0], hTp->bsBuffer, (8192 * 4), 0,
+                         BS_READER);
+      }
       for (i = 0; i < (1 * 1); i++) {
         FDKresetBitbuffer(&hTp->bitStream[i]);
         hTp->auLength[i] = 0;
@@ -1745,6 +1932,89 @@ UINT transportDec_GetNrOfSubFrames(HANDLE_TRANSPORTDEC hTp) {
   return nSubFrames;
 }
 
+TRANSPORTDEC_ERROR transportDec_BuildFrameIndex(HANDLE_TRANSPORTDEC hTp,
+                                                const UCHAR *pBuffer,
+                                                const UINT64 bufferSize,
+                                                FDK_FRAME_INDEX *pIndex,
+                                                UINT *pNumEntries) {
+  HANDLE_FDK_BITSTREAM hBs;
+  UINT maxEntries, numEntries = 0, frame = 0;
+  UINT64 fed = 0, sample = 0;
+
+  if ((hTp == NULL) || (pBuffer == NULL) || (pNumEntries == NULL)) {
+    return TRANSPORTDEC_INVALID_PARAMETER;
+  }
+  if ((hTp->transportFmt != TT_MP4_ADTS) &&
+      (hTp->transportFmt != TT_MP4_LOAS)) {
+    return TRANSPORTDEC_UNSUPPORTED_FORMAT;
+  }
+  maxEntries = (pIndex != NULL) ? *pNumEntries : 0;
+  hBs = &hTp->bitStream[0];
+  transportDec_SetParam(hTp, TPDEC_PARAM_RESET, 1);
+
+  for (;;) {
+    TRANSPORTDEC_ERROR err;
+    UINT64 pos;
+    INT newFrame;
+
+    if (fed < bufferSize) {
+      UINT size = (UINT)FDKmin(bufferSize - fed, (UINT64)(1 << 20));
+      UINT valid = size;
+
+      transportDec_FillData(hTp, (UCHAR *)pBuffer + fed, size, &valid, 0);
+      fed += size - valid;
+    }
+
+    /* byte position of the next header, which may be preceded by garbage */
+    pos = fed - (FDKgetValidBits(hBs) >> 3);
+    newFrame = (hTp->numberOfRawDataBlocks <= 0);
+
+    err = transportDec_ReadAccessUnit(hTp, 0);
+    if (err == TRANSPORTDEC_NOT_ENOUGH_BITS) {
+      if (fed < bufferSize) continue;
+      break;
+    }
+    if ((err != TRANSPORTDEC_OK) && (err != TRANSPORTDEC_CRC_ERROR)) {
+      /* the sync search has advanced, make sure of it for other errors */
+      if (pos == fed - (FDKgetValidBits(hBs) >> 3)) {
+        if (FDKgetValidBits(hBs) < 8) break;
+        FDKpushFor(hBs, 8);
+      }
+      continue;
+    }
+
+    /* a LOAS frame is only decodable on its own if it carries the
+     * StreamMuxConfig */
+    if (newFrame && ((hTp->transportFmt != TT_MP4_LOAS) ||
+                     !hTp->parser.latm.m_useSameStreamMux)) {
+      if (numEntries < maxEntries) {
+        pIndex[numEntries].offset = pos;
+        pIndex[numEntries].sample = sample;
+        pIndex[numEntries].frame = frame;
+      }
+      numEntries++;
+    }
+    FDKpushFor(hBs, FDKmax(0, transportDec_GetAuBitsRemaining(hTp, 0)));
+    transportDec_EndAccessUnit(hTp);
+
+    frame++;
+    sample += hTp->asc[0].m_samplesPerFrame;
+  }
+
+  /* the last entry marks the end of the stream */
+  if (numEntries < maxEntries) {
+    pIndex[numEntries].offset = bufferSize;
+    pIndex[numEntries].sample = sample;
+    pIndex[numEntries].frame = frame;
+  }
+  numEntries++;
+
+  transportDec_SetParam(hTp, TPDEC_PARAM_RESET, 1);
+  *pNumEntries = numEntries;
+
+  return TRANSPORTDEC_OK;
+}
+
 void transportDec_Close(HANDLE_TRANSPORTDEC *phTp) {
   if (phTp != NULL) {
     if (*phTp != NULL) {
@@ -501,6 +501,34 @@ TRANSPORTDEC_ERROR transportDec_FillData(const HANDLE_TRANSPORTDEC hTp,
                                          UCHAR *pBuffer, const UINT bufferSize,
                                          UINT *pBytesValid, const INT layer);
 
+/**
+ * \brief Read the bitstream in place from a caller owned buffer instead of
+ * copying it with transportDec_FillData(). The buffer must stay valid and
+ * unchanged while it is in use. The bit stream reader sees a window of the
+ * size of the internal buffer, which transportDec_AdvanceInput() moves along;
+ * the last window of the buffer is copied into the internal buffer, after
+ * which the buffer is no longer referenced and transportDec_FillData() can
+ * append new data. Until then transportDec_FillData() fails. Any data in the
+ * internal buffer is discarded. Only for streaming formats.
+ * \param hTp         Handle of transportDec.
+ * \param pBuffer     Complete bitstream, starting at a transport frame, or
+ * NULL to go back to the internal buffer.
+ * \param bufferSize  Size of pBuffer in bytes.
+ * \return            Error code.
+ */
+TRANSPORTDEC_ERROR transportDec_SetInputBuffer(const HANDLE_TRANSPORTDEC hTp,
+                                               const UCHAR *pBuffer,
+                                               const UINT64 bufferSize);
+
+/**
+ * \brief Move the window on the buffer of transportDec_SetInputBuffer() to
+ * the current read position. Does nothing inside of a transport frame or
+ * without such a buffer. Must be called before an access unit is read and
+ * changes the amount of valid bits.
+ * \param hTp  Handle of transportDec.
+ */
+void transportDec_AdvanceInput(const HANDLE_TRANSPORTDEC hTp);
+
 /**
  * \brief      Get transportDec bitstream handle.
  * \param hTp  Pointer to a transport decoder handle.
@@ -613,6 +641,25 @@ TRANSPORTDEC_ERROR transportDec_SetParam(const HANDLE_TRANSPORTDEC hTp,
  */
 UINT transportDec_GetNrOfSubFrames(HANDLE_TRANSPORTDEC hTp);
 
+/**
+ * \brief Build the frame index of an ADTS or LOAS stream. The transport
+ * headers of the whole buffer are parsed and the payload of the access units
+ * is skipped. The transport decoder is reset before and after.
+ * \param hTp          Transport Handle with registered callbacks.
+ * \param pBuffer      Stream, e.g. a memory mapped file.
+ * \param bufferSize   Size of the stream in bytes.
+ * \param pIndex       Array of *pNumEntries entries, or NULL to count only.
+ * \param pNumEntries  In: size of pIndex. Out: number of ADTS frames or LOAS
+ * frames with a StreamMuxConfig plus one entry for the end of the stream, of
+ * which at most the input value were written.
+ * \return             Error code.
+ */
+TRANSPORTDEC_ERROR transportDec_BuildFrameIndex(HANDLE_TRANSPORTDEC hTp,
+                                                const UCHAR *pBuffer,
+                                                const UINT64 bufferSize,
+                                                FDK_FRAME_INDEX *pIndex,
+                                                UINT *pNumEntries);
+
 /**
  * \brief       Get info structure of transport decoder library.
  * \param info  A pointer to an allocated LIB_INFO struct.
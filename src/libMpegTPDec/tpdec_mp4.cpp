@@ -0,0 +1,1200 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/******************* MPEG transport format decoder library *********************
+
+   Author(s):
+
+   Description: ISO base media file format (MP4) demultiplexer
+
+*******************************************************************************/
+
+#include "libMpegTPDec/tpdec_mp4.h"
+
+#include "libSYS/genericStds.h"
+
+#define MP4_FOURCC(a, b, c, d) \
+  (((UINT)(a) << 24) | ((UINT)(b) << 16) | ((UINT)(c) << 8) | (UINT)(d))
+
+/* end of a top level box which extends to the end of the file */
+#define MP4_FILE_END (~(UINT64)0)
+
+/* tfhd flags */
+#define TFHD_BASE_DATA_OFFSET 0x000001
+#define TFHD_SAMPLE_DESCRIPTION_INDEX 0x000002
+#define TFHD_DEFAULT_DURATION 0x000008
+#define TFHD_DEFAULT_SIZE 0x000010
+#define TFHD_DEFAULT_FLAGS 0x000020
+
+/* trun flags */
+#define TRUN_DATA_OFFSET 0x000001
+#define TRUN_FIRST_SAMPLE_FLAGS 0x000004
+#define TRUN_DURATION 0x000100
+#define TRUN_SIZE 0x000200
+#define TRUN_FLAGS 0x000400
+#define TRUN_CTS_OFFSET 0x000800
+
+/* sample_is_non_sync_sample of the sample flags */
+#define MP4_NON_SYNC_SAMPLE 0x00010000
+
+typedef struct {
+  UINT64 offset; /* start of the box */
+  UINT64 body;   /* start of its payload */
+  UINT64 end;    /* end of the box */
+  UINT type;
+} MP4_BOX;
+
+/* Sample tables of the moov as file offsets of their first entry. A table
+ * which is not present has no entries. */
+typedef struct {
+  UINT64 stts;
+  UINT sttsCount;
+  UINT64 stss;
+  UINT stssCount;
+  UCHAR hasStss; /* without stss every sample is a sync sample */
+  UINT64 stsz;
+  UINT stszCount;
+  UINT stszSize; /* constant sample size, 0 if the table is used */
+  UINT stszBits; /* 32 for stsz, 4, 8 or 16 for stz2 */
+  UINT64 stsc;
+  UINT stscCount;
+  UINT64 stco;
+  UINT stcoCount;
+  UINT stcoBytes; /* 4 for stco, 8 for co64 */
+} MP4_SAMPLE_TABLES;
+
+typedef struct {
+  UINT trackId;
+  UINT handler;
+  UINT timescale;
+  UINT64 duration;
+  UINT sampleRate;
+  UINT channels;
+  UINT64 asc;
+  UINT ascLength;
+  UINT64 ludt;
+  UINT ludtLength;
+  MP4_SAMPLE_TABLES tables;
+} MP4_TRACK;
+
+/* position in the sample tables of the moov */
+typedef struct {
+  UINT sample; /* next sample */
+  UINT chunk;  /* its chunk */
+  UINT sampleInChunk;
+  UINT stscIdx;
+  UINT sttsIdx;
+  UINT sttsLeft; /* samples of stts entry sttsIdx from the next one on */
+  UINT stssIdx;
+  UINT64 chunkPos; /* offset of the next sample within its chunk */
+  UINT64 time;
+} MP4_TABLE_CURSOR;
+
+/* position in the track fragments */
+typedef struct {
+  UINT64 nextTop;  /* next top level box to look for a moof */
+  UINT64 moof;     /* current moof, 0 if none */
+  UINT64 moofEnd;
+  UINT64 moofScan; /* next child of the moof */
+  UINT64 trafEnd;  /* current traf of the track, 0 if none */
+  UINT64 trafScan; /* next child of the traf */
+  UINT64 trun;     /* next sample record of the current trun */
+  UINT trunLeft;   /* samples left in the trun */
+  UINT trunFlags;
+  UINT firstFlags;
+  UCHAR hasFirstFlags; /* firstFlags apply to the next sample */
+  UINT64 base;         /* base data offset of the traf */
+  UINT64 dataPos;      /* file offset of the next sample */
+  UINT defDuration;
+  UINT defSize;
+  UINT defFlags;
+  UINT64 time;
+} MP4_FRAG_CURSOR;
+
+struct CMp4Demux {
+  const UCHAR *pData;
+  UINT64 size;
+  UINT64 scan; /* next top level box while the moov is searched */
+  UCHAR moovFound;
+  UCHAR fragmented;
+
+  MP4_TRACK track;
+  UINT64 tablesDuration; /* sum of the durations of the moov samples */
+  UINT64 fragStart;      /* first top level box after the moov */
+  UINT trexDuration;
+  UINT trexSize;
+  UINT trexFlags;
+
+  MP4_TABLE_CURSOR table;
+  MP4_FRAG_CURSOR frag;
+};
+
+C_ALLOC_MEM(Ram_Mp4Demux, struct CMp4Demux, 1)
+
+static inline UINT mp4Read16(const UCHAR *p) { return (p[0] << 8) | p[1]; }
+
+static inline UINT mp4Read32(const UCHAR *p) {
+  return ((UINT)p[0] << 24) | ((UINT)p[1] << 16) | ((UINT)p[2] << 8) | p[3];
+}
+
+static inline UINT64 mp4Read64(const UCHAR *p) {
+  return ((UINT64)mp4Read32(p) << 32) | mp4Read32(p + 4);
+}
+
+/*
+ * Read the header of the box at offset of a parent which ends at end, or
+ * MP4_FILE_END on the top level. Only the top level can be incomplete, its
+ * payload may still be missing.
+ */
+static TRANSPORTDEC_ERROR mp4Demux_ReadBox(const CMp4Demux *h,
+                                           const UINT64 offset,
+                                           const UINT64 end, MP4_BOX *pBox) {
+  const UINT64 avail = FDKmin(end, h->size);
+  const UCHAR *p;
+  UINT64 size, header = 8;
+
+  if ((avail < 8) || (offset > avail - 8)) {
+    return (end == MP4_FILE_END) ? TRANSPORTDEC_NOT_ENOUGH_BITS
+                                 : TRANSPORTDEC_PARSE_ERROR;
+  }
+  p = h->pData + offset;
+  size = mp4Read32(p);
+  pBox->type = mp4Read32(p + 4);
+  if (size == 1) {
+    if ((avail < 16) || (offset > avail - 16)) {
+      return (end == MP4_FILE_END) ? TRANSPORTDEC_NOT_ENOUGH_BITS
+                                   : TRANSPORTDEC_PARSE_ERROR;
+    }
+    size = mp4Read64(p + 8);
+    header = 16;
+  } else if (size == 0) {
+    size = end - offset; /* up to the end of the parent or file */
+  }
+  if ((size < header) || (size > end - offset)) {
+    return TRANSPORTDEC_PARSE_ERROR;
+  }
+
+  pBox->offset = offset;
+  pBox->body = offset + header;
+  pBox->end = offset + size;
+
+  return TRANSPORTDEC_OK;
+}
+
+/* first child of a type within [offset, end) of a complete parent */
+static TRANSPORTDEC_ERROR mp4Demux_FindBox(const CMp4Demux *h, UINT64 offset,
+                                           const UINT64 end, const UINT type,
+                                           MP4_BOX *pBox) {
+  while ((end - offset) >= 8) {
+    TRANSPORTDEC_ERROR err = mp4Demux_ReadBox(h, offset, end, pBox);
+    if (err != TRANSPORTDEC_OK) return err;
+    if (pBox->type == type) return TRANSPORTDEC_OK;
+    offset = pBox->end;
+  }
+  return TRANSPORTDEC_NOT_ENOUGH_BITS;
+}
+
+/* Read the tag and length of the descriptor at *pPos, which is moved to its
+ * payload. Returns the tag, or 0 if the descriptor exceeds end. */
+static UINT mp4Demux_ReadDescriptor(const UCHAR *pData, UINT64 *pPos,
+                                    const UINT64 end, UINT *pLength) {
+  UINT64 pos = *pPos;
+  UINT tag, length = 0;
+
+  if (pos >= end) return 0;
+  tag = pData[pos++];
+  for (int i = 0; i < 4; i++) {
+    if (pos >= end) return 0;
+    UINT b = pData[pos++];
+    length = (length << 7) | (b & 0x7f);
+    if (!(b & 0x80)) break;
+  }
+  if (length > end - pos) return 0;
+
+  *pPos = pos;
+  *pLength = length;
+  return tag;
+}
+
+/* AudioSpecificConfig of an esds box: ES_Descriptor, DecoderConfigDescriptor
+ * and DecoderSpecificInfo */
+static TRANSPORTDEC_ERROR mp4Demux_ParseEsds(const CMp4Demux *h,
+                                             const MP4_BOX *pEsds,
+                                             MP4_TRACK *pTrack) {
+  const UCHAR *p = h->pData;
+  UINT64 pos = pEsds->body + 4, end;
+  UINT length, flags;
+
+  if (mp4Demux_ReadDescriptor(p, &pos, pEsds->end, &length) != 0x03) {
+    return TRANSPORTDEC_PARSE_ERROR;
+  }
+  end = pos + length;
+  if (end - pos < 3) return TRANSPORTDEC_PARSE_ERROR;
+  flags = p[pos + 2];
+  pos += 3;
+  if (flags & 0x80) pos += 2; /* dependsOn_ES_ID */
+  if ((flags & 0x40) && (pos < end)) pos += 1 + p[pos]; /* URL */
+  if (flags & 0x20) pos += 2;                          /* OCR_ES_Id */
+
+  while (pos < end) {
+    UINT tag = mp4Demux_ReadDescriptor(p, &pos, end, &length);
+    if (tag == 0) return TRANSPORTDEC_PARSE_ERROR;
+    if (tag == 0x04) {
+      UINT64 dcdEnd = pos + length;
+      /* MPEG-4 audio or MPEG-2 AAC main, LC, SSR */
+      if ((length < 13) ||
+          ((p[pos] != 0x40) && ((p[pos] < 0x66) || (p[pos] > 0x68)))) {
+        return TRANSPORTDEC_UNSUPPORTED_FORMAT;
+      }
+      pos += 13;
+      while (pos < dcdEnd) {
+        tag = mp4Demux_ReadDescriptor(p, &pos, dcdEnd, &length);
+        if (tag == 0) return TRANSPORTDEC_PARSE_ERROR;
+        if ((tag == 0x05) && (length > 0)) {
+          pTrack->asc = pos;
+          pTrack->ascLength = length;
+          return TRANSPORTDEC_OK;
+        }
+        pos += length;
+      }
+      return TRANSPORTDEC_PARSE_ERROR;
+    }
+    pos += length;
+  }
+  return TRANSPORTDEC_PARSE_ERROR;
+}
+
+/* mp4a sample entry: ISO AudioSampleEntry or QuickTime sound description
+ * version 1 or 2, with an esds box which may be wrapped into a wave box */
+static TRANSPORTDEC_ERROR mp4Demux_ParseStsd(const CMp4Demux *h,
+                                             const MP4_BOX *pStsd,
+                                             MP4_TRACK *pTrack) {
+  const UCHAR *p = h->pData;
+  MP4_BOX entry, esds;
+  UINT64 children;
+  TRANSPORTDEC_ERROR err;
+
+  if (pStsd->end - pStsd->body < 8) return TRANSPORTDEC_PARSE_ERROR;
+  err = mp4Demux_ReadBox(h, pStsd->body + 8, pStsd->end, &entry);
+  if (err != TRANSPORTDEC_OK) return err;
+  if (entry.type != MP4_FOURCC('m', 'p', '4', 'a')) {
+    return TRANSPORTDEC_UNSUPPORTED_FORMAT;
+  }
+  if (entry.end - entry.body < 28) return TRANSPORTDEC_PARSE_ERROR;
+
+  children = entry.body + 28;
+  pTrack->channels = mp4Read16(p + entry.body + 16);
+  pTrack->sampleRate = mp4Read32(p + entry.body + 24) >> 16;
+  switch (mp4Read16(p + entry.body + 8)) {
+    case 1:
+      children += 16;
+      break;
+    case 2:
+      if (entry.end - entry.body < 28 + 36) return TRANSPORTDEC_PARSE_ERROR;
+      {
+        union {
+          UINT64 u;
+          double d;
+        } rate;
+        rate.u = mp4Read64(p + entry.body + 32);
+        pTrack->sampleRate = (UINT)rate.d;
+        pTrack->channels = mp4Read32(p + entry.body + 40);
+      }
+      children += 36;
+      break;
+    default:
+      break;
+  }
+  if (children > entry.end) return TRANSPORTDEC_PARSE_ERROR;
+
+  err = mp4Demux_FindBox(h, children, entry.end, MP4_FOURCC('e', 's', 'd', 's'),
+                         &esds);
+  if (err == TRANSPORTDEC_NOT_ENOUGH_BITS) {
+    MP4_BOX wave;
+    err = mp4Demux_FindBox(h, children, entry.end,
+                           MP4_FOURCC('w', 'a', 'v', 'e'), &wave);
+    if (err == TRANSPORTDEC_OK) {
+      err = mp4Demux_FindBox(h, wave.body, wave.end,
+                             MP4_FOURCC('e', 's', 'd', 's'), &esds);
+    }
+  }
+  if (err == TRANSPORTDEC_NOT_ENOUGH_BITS) return TRANSPORTDEC_PARSE_ERROR;
+  if (err != TRANSPORTDEC_OK) return err;
+
+  return mp4Demux_ParseEsds(h, &esds, pTrack);
+}
+
+/* Entries of a sample table: count at countPos, entries of entryBits bits from
+ * first on up to the end of the box. */
+static TRANSPORTDEC_ERROR mp4Demux_Table(const CMp4Demux *h,
+                                         const MP4_BOX *pBox,
+                                         const UINT64 countPos,
+                                         const UINT64 first,
+                                         const UINT entryBits, UINT64 *pTable,
+                                         UINT *pCount) {
+  UINT count;
+
+  if (first > pBox->end) return TRANSPORTDEC_PARSE_ERROR;
+  count = mp4Read32(h->pData + countPos);
+  if (((UINT64)count * entryBits + 7) / 8 > pBox->end - first) {
+    return TRANSPORTDEC_PARSE_ERROR;
+  }
+  *pTable = first;
+  *pCount = count;
+  return TRANSPORTDEC_OK;
+}
+
+static TRANSPORTDEC_ERROR mp4Demux_ParseStbl(const CMp4Demux *h,
+                                             const MP4_BOX *pStbl,
+                                             MP4_TRACK *pTrack) {
+  MP4_SAMPLE_TABLES *t = &pTrack->tables;
+  UINT64 offset = pStbl->body;
+  MP4_BOX box;
+
+  while ((pStbl->end - offset) >= 8) {
+    TRANSPORTDEC_ERROR err = mp4Demux_ReadBox(h, offset, pStbl->end, &box);
+    if (err != TRANSPORTDEC_OK) return err;
+    offset = box.end;
+
+    const UCHAR *p = h->pData + box.body;
+    UINT64 b = box.body;
+    if (box.end - box.body < 12) {
+      if (box.type == MP4_FOURCC('s', 't', 's', 'd')) {
+        return TRANSPORTDEC_PARSE_ERROR;
+      }
+      continue;
+    }
+
+    switch (box.type) {
+      case MP4_FOURCC('s', 't', 's', 'd'):
+        err = mp4Demux_ParseStsd(h, &box, pTrack);
+        break;
+      case MP4_FOURCC('s', 't', 't', 's'):
+        err = mp4Demux_Table(h, &box, b + 4, b + 8, 64, &t->stts,
+                             &t->sttsCount);
+        break;
+      case MP4_FOURCC('s', 't', 's', 's'):
+        err = mp4Demux_Table(h, &box, b + 4, b + 8, 32, &t->stss,
+                             &t->stssCount);
+        t->hasStss = 1;
+        break;
+      case MP4_FOURCC('s', 't', 's', 'z'):
+        t->stszSize = mp4Read32(p + 4);
+        t->stszBits = 32;
+        err = mp4Demux_Table(h, &box, b + 8, b + 12,
+                             (t->stszSize != 0) ? 0 : 32, &t->stsz,
+                             &t->stszCount);
+        break;
+      case MP4_FOURCC('s', 't', 'z', '2'):
+        t->stszSize = 0;
+        t->stszBits = p[7];
+        if ((t->stszBits != 4) && (t->stszBits != 8) && (t->stszBits != 16)) {
+          return TRANSPORTDEC_PARSE_ERROR;
+        }
+        err = mp4Demux_Table(h, &box, b + 8, b + 12, t->stszBits, &t->stsz,
+                             &t->stszCount);
+        break;
+      case MP4_FOURCC('s', 't', 's', 'c'):
+        err = mp4Demux_Table(h, &box, b + 4, b + 8, 96, &t->stsc,
+                             &t->stscCount);
+        break;
+      case MP4_FOURCC('s', 't', 'c', 'o'):
+        t->stcoBytes = 4;
+        err = mp4Demux_Table(h, &box, b + 4, b + 8, 32, &t->stco,
+                             &t->stcoCount);
+        break;
+      case MP4_FOURCC('c', 'o', '6', '4'):
+        t->stcoBytes = 8;
+        err = mp4Demux_Table(h, &box, b + 4, b + 8, 64, &t->stco,
+                             &t->stcoCount);
+        break;
+      default:
+        break;
+    }
+    if (err != TRANSPORTDEC_OK) return err;
+  }
+
+  return TRANSPORTDEC_OK;
+}
+
+static TRANSPORTDEC_ERROR mp4Demux_ParseTrak(const CMp4Demux *h,
+                                             const MP4_BOX *pTrak,
+                                             MP4_TRACK *pTrack) {
+  const UCHAR *p = h->pData;
+  MP4_BOX box, mdia, minf, stbl;
+  TRANSPORTDEC_ERROR err;
+
+  FDKmemclear(pTrack, sizeof(MP4_TRACK));
+
+  err = mp4Demux_FindBox(h, pTrak->body, pTrak->end,
+                         MP4_FOURCC('t', 'k', 'h', 'd'), &box);
+  if (err != TRANSPORTDEC_OK) return TRANSPORTDEC_PARSE_ERROR;
+  if (box.end - box.body < ((p[box.body] == 1) ? 24U : 16U)) {
+    return TRANSPORTDEC_PARSE_ERROR;
+  }
+  pTrack->trackId = mp4Read32(p + box.body + ((p[box.body] == 1) ? 20 : 12));
+
+  err = mp4Demux_FindBox(h, pTrak->body, pTrak->end,
+                         MP4_FOURCC('m', 'd', 'i', 'a'), &mdia);
+  if (err != TRANSPORTDEC_OK) return TRANSPORTDEC_PARSE_ERROR;
+
+  err = mp4Demux_FindBox(h, mdia.body, mdia.end, MP4_FOURCC('h', 'd', 'l', 'r'),
+                         &box);
+  if ((err != TRANSPORTDEC_OK) || (box.end - box.body < 12)) {
+    return TRANSPORTDEC_PARSE_ERROR;
+  }
+  pTrack->handler = mp4Read32(p + box.body + 8);
+  if (pTrack->handler != MP4_FOURCC('s', 'o', 'u', 'n')) {
+    return TRANSPORTDEC_UNSUPPORTED_FORMAT;
+  }
+
+  err = mp4Demux_FindBox(h, mdia.body, mdia.end, MP4_FOURCC('m', 'd', 'h', 'd'),
+                         &box);
+  if ((err != TRANSPORTDEC_OK) ||
+      (box.end - box.body < ((p[box.body] == 1) ? 32U : 20U))) {
+    return TRANSPORTDEC_PARSE_ERROR;
+  }
+  if (p[box.body] == 1) {
+    pTrack->timescale = mp4Read32(p + box.body + 20);
+    pTrack->duration = mp4Read64(p + box.body + 24);
+  } else {
+    pTrack->timescale = mp4Read32(p + box.body + 12);
+    pTrack->duration = mp4Read32(p + box.body + 16);
+  }
+  if (pTrack->timescale == 0) return TRANSPORTDEC_PARSE_ERROR;
+
+  err = mp4Demux_FindBox(h, mdia.body, mdia.end, MP4_FOURCC('m', 'i', 'n', 'f'),
+                         &minf);
+  if (err == TRANSPORTDEC_OK) {
+    err = mp4Demux_FindBox(h, minf.body, minf.end,
+                           MP4_FOURCC('s', 't', 'b', 'l'), &stbl);
+  }
+  if (err != TRANSPORTDEC_OK) return TRANSPORTDEC_PARSE_ERROR;
+  err = mp4Demux_ParseStbl(h, &stbl, pTrack);
+  if (err != TRANSPORTDEC_OK) return err;
+  if (pTrack->ascLength == 0) return TRANSPORTDEC_PARSE_ERROR;
+
+  /* loudness of the track for the DRC decoder */
+  err = mp4Demux_FindBox(h, pTrak->body, pTrak->end,
+                         MP4_FOURCC('u', 'd', 't', 'a'), &box);
+  if ((err == TRANSPORTDEC_OK) &&
+      (mp4Demux_FindBox(h, box.body, box.end, MP4_FOURCC('l', 'u', 'd', 't'),
+                        &box) == TRANSPORTDEC_OK)) {
+    pTrack->ludt = box.offset;
+    pTrack->ludtLength = (UINT)(box.end - box.offset);
+  }
+
+  return TRANSPORTDEC_OK;
+}
+
+static UINT mp4Demux_SampleSize(const CMp4Demux *h, const UINT s) {
+  const MP4_SAMPLE_TABLES *t = &h->track.tables;
+  const UCHAR *p = h->pData + t->stsz;
+
+  if (t->stszSize != 0) return t->stszSize;
+  switch (t->stszBits) {
+    case 4:
+      return (s & 1) ? (p[s >> 1] & 0xf) : (p[s >> 1] >> 4);
+    case 8:
+      return p[s];
+    case 16:
+      return mp4Read16(p + 2 * s);
+    default:
+      return mp4Read32(p + 4 * s);
+  }
+}
+
+static UINT64 mp4Demux_ChunkOffset(const CMp4Demux *h, const UINT c) {
+  const MP4_SAMPLE_TABLES *t = &h->track.tables;
+
+  return (t->stcoBytes == 8) ? mp4Read64(h->pData + t->stco + 8 * c)
+                             : mp4Read32(h->pData + t->stco + 4 * c);
+}
+
+static void mp4Demux_ResetFragments(CMp4Demux *h) {
+  FDKmemclear(&h->frag, sizeof(MP4_FRAG_CURSOR));
+  h->frag.nextTop = h->fragStart;
+  h->frag.time = h->tablesDuration;
+}
+
+/* Move the table cursor to a sample, at most the number of samples. */
+static TRANSPORTDEC_ERROR mp4Demux_SetTableCursor(CMp4Demux *h,
+                                                  const UINT sample) {
+  const MP4_SAMPLE_TABLES *t = &h->track.tables;
+  const UINT s = FDKmin(sample, t->stszCount);
+  const UCHAR *p = h->pData;
+  MP4_TABLE_CURSOR *c = &h->table;
+  UINT64 done;
+  UINT i;
+
+  FDKmemclear(c, sizeof(MP4_TABLE_CURSOR));
+  c->sample = s;
+
+  /* decoding time */
+  done = 0;
+  for (i = 0; i < t->sttsCount; i++) {
+    UINT n = mp4Read32(p + t->stts + 8 * i);
+    UINT delta = mp4Read32(p + t->stts + 8 * i + 4);
+    c->sttsIdx = i;
+    if (s - done < n) {
+      c->sttsLeft = n - (UINT)(s - done);
+      c->time += (s - done) * delta;
+      break;
+    }
+    done += n;
+    c->time += (UINT64)n * delta;
+  }
+
+  /* chunk within the sample-to-chunk run which contains the sample */
+  done = 0;
+  for (i = 0; i < t->stscCount; i++) {
+    UINT first = mp4Read32(p + t->stsc + 12 * i) - 1;
+    UINT perChunk = mp4Read32(p + t->stsc + 12 * i + 4);
+    UINT next = (i + 1 < t->stscCount)
+                    ? mp4Read32(p + t->stsc + 12 * (i + 1)) - 1
+                    : t->stcoCount;
+    UINT64 runSamples;
+
+    if ((perChunk == 0) || (next < first)) return TRANSPORTDEC_PARSE_ERROR;
+    runSamples = (UINT64)(next - first) * perChunk;
+    c->stscIdx = i;
+    if ((s - done < runSamples) || (i + 1 == t->stscCount)) {
+      c->chunk = first + (UINT)((s - done) / perChunk);
+      c->sampleInChunk = (UINT)((s - done) % perChunk);
+      break;
+    }
+    done += runSamples;
+  }
+  for (i = s - c->sampleInChunk; i < s; i++) {
+    c->chunkPos += mp4Demux_SampleSize(h, i);
+  }
+
+  /* next sync sample */
+  if (t->hasStss) {
+    UINT lo = 0, hi = t->stssCount;
+    while (lo < hi) {
+      UINT mid = lo + (hi - lo) / 2;
+      if (mp4Read32(p + t->stss + 4 * mid) < s + 1) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    c->stssIdx = lo;
+  }
+
+  return TRANSPORTDEC_OK;
+}
+
+static TRANSPORTDEC_ERROR mp4Demux_ReadTableSample(CMp4Demux *h,
+                                                   MP4_SAMPLE *pSample) {
+  const MP4_SAMPLE_TABLES *t = &h->track.tables;
+  const UCHAR *p = h->pData;
+  MP4_TABLE_CURSOR *c = &h->table;
+  UINT size, perChunk;
+  UINT64 offset;
+
+  if ((c->chunk >= t->stcoCount) || (c->stscIdx >= t->stscCount)) {
+    return TRANSPORTDEC_PARSE_ERROR;
+  }
+  perChunk = mp4Read32(p + t->stsc + 12 * c->stscIdx + 4);
+  if (perChunk == 0) return TRANSPORTDEC_PARSE_ERROR;
+
+  size = mp4Demux_SampleSize(h, c->sample);
+  offset = mp4Demux_ChunkOffset(h, c->chunk) + c->chunkPos;
+  if ((offset > h->size) || (size > h->size - offset)) {
+    return TRANSPORTDEC_NOT_ENOUGH_BITS;
+  }
+
+  pSample->pData = (UCHAR *)p + offset;
+  pSample->size = size;
+  pSample->time = c->time;
+  pSample->duration = (c->sttsIdx < t->sttsCount)
+                          ? mp4Read32(p + t->stts + 8 * c->sttsIdx + 4)
+                          : 0;
+  pSample->isSync = 1;
+  if (t->hasStss) {
+    pSample->isSync = (c->stssIdx < t->stssCount) &&
+                      (mp4Read32(p + t->stss + 4 * c->stssIdx) == c->sample + 1);
+    if (pSample->isSync) c->stssIdx++;
+  }
+
+  c->sample++;
+  c->time += pSample->duration;
+  if (c->sttsLeft > 0) c->sttsLeft--;
+  while ((c->sttsLeft == 0) && (c->sttsIdx + 1 < t->sttsCount)) {
+    c->sttsIdx++;
+    c->sttsLeft = mp4Read32(p + t->stts + 8 * c->sttsIdx);
+  }
+  c->chunkPos += size;
+  if (++c->sampleInChunk >= perChunk) {
+    c->chunk++;
+    c->sampleInChunk = 0;
+    c->chunkPos = 0;
+    if ((c->stscIdx + 1 < t->stscCount) &&
+        (c->chunk + 1 >= mp4Read32(p + t->stsc + 12 * (c->stscIdx + 1)))) {
+      c->stscIdx++;
+    }
+  }
+
+  return TRANSPORTDEC_OK;
+}
+
+/* Next complete moof box on the top level. */
+static TRANSPORTDEC_ERROR mp4Demux_NextMoof(CMp4Demux *h) {
+  MP4_FRAG_CURSOR *c = &h->frag;
+  MP4_BOX box;
+
+  for (;;) {
+    TRANSPORTDEC_ERROR err =
+        mp4Demux_ReadBox(h, c->nextTop, MP4_FILE_END, &box);
+    if (err != TRANSPORTDEC_OK) return err;
+    if (box.type == MP4_FOURCC('m', 'o', 'o', 'f')) {
+      if (box.end > h->size) return TRANSPORTDEC_NOT_ENOUGH_BITS;
+      c->moof = box.offset;
+      c->moofEnd = box.end;
+      c->moofScan = box.body;
+      c->nextTop = box.end;
+      return TRANSPORTDEC_OK;
+    }
+    c->nextTop = box.end;
+  }
+}
+
+/* Next traf of the track in the current moof, TRANSPORTDEC_NOT_ENOUGH_BITS if
+ * there is none. */
+static TRANSPORTDEC_ERROR mp4Demux_NextTraf(CMp4Demux *h) {
+  MP4_FRAG_CURSOR *c = &h->frag;
+  const UCHAR *p = h->pData;
+  MP4_BOX traf, box;
+
+  while ((c->moofEnd - c->moofScan) >= 8) {
+    TRANSPORTDEC_ERROR err = mp4Demux_ReadBox(h, c->moofScan, c->moofEnd, &traf);
+    if (err != TRANSPORTDEC_OK) return err;
+    c->moofScan = traf.end;
+    if (traf.type != MP4_FOURCC('t', 'r', 'a', 'f')) continue;
+
+    err = mp4Demux_FindBox(h, traf.body, traf.end,
+                           MP4_FOURCC('t', 'f', 'h', 'd'), &box);
+    if (err != TRANSPORTDEC_OK) return TRANSPORTDEC_PARSE_ERROR;
+    if (box.end - box.body < 8) return TRANSPORTDEC_PARSE_ERROR;
+    if (mp4Read32(p + box.body + 4) != h->track.trackId) continue;
+
+    UINT flags = mp4Read32(p + box.body) & 0xffffff;
+    UINT64 pos = box.body + 8;
+    UINT64 need = ((flags & TFHD_BASE_DATA_OFFSET) ? 8 : 0) +
+                  ((flags & TFHD_SAMPLE_DESCRIPTION_INDEX) ? 4 : 0) +
+                  ((flags & TFHD_DEFAULT_DURATION) ? 4 : 0) +
+                  ((flags & TFHD_DEFAULT_SIZE) ? 4 : 0) +
+                  ((flags & TFHD_DEFAULT_FLAGS) ? 4 : 0);
+    if (box.end - pos < need) return TRANSPORTDEC_PARSE_ERROR;
+
+    /* Without an explicit base the data of a single track fragment starts at
+     * the moof, the common case with default-base-is-moof. */
+    c->base = c->moof;
+    c->defDuration = h->trexDuration;
+    c->defSize = h->trexSize;
+    c->defFlags = h->trexFlags;
+    if (flags & TFHD_BASE_DATA_OFFSET) {
+      c->base = mp4Read64(p + pos);
+      pos += 8;
+    }
+    if (flags & TFHD_SAMPLE_DESCRIPTION_INDEX) pos += 4;
+    if (flags & TFHD_DEFAULT_DURATION) {
+      c->defDuration = mp4Read32(p + pos);
+      pos += 4;
+    }
+    if (flags & TFHD_DEFAULT_SIZE) {
+      c->defSize = mp4Read32(p + pos);
+      pos += 4;
+    }
+    if (flags & TFHD_DEFAULT_FLAGS) {
+      c->defFlags = mp4Read32(p + pos);
+    }
+
+    if (mp4Demux_FindBox(h, traf.body, traf.end, MP4_FOURCC('t', 'f', 'd', 't'),
+                         &box) == TRANSPORTDEC_OK) {
+      if (box.end - box.body < ((p[box.body] == 1) ? 12U : 8U)) {
+        return TRANSPORTDEC_PARSE_ERROR;
+      }
+      c->time = (p[box.body] == 1) ? mp4Read64(p + box.body + 4)
+                                   : mp4Read32(p + box.body + 4);
+    }
+
+    c->dataPos = c->base;
+    c->trafScan = traf.body;
+    c->trafEnd = traf.end;
+    return TRANSPORTDEC_OK;
+  }
+
+  return TRANSPORTDEC_NOT_ENOUGH_BITS;
+}
+
+/* Next trun of the current traf, TRANSPORTDEC_NOT_ENOUGH_BITS if there is
+ * none. */
+static TRANSPORTDEC_ERROR mp4Demux_NextTrun(CMp4Demux *h) {
+  MP4_FRAG_CURSOR *c = &h->frag;
+  const UCHAR *p = h->pData;
+  MP4_BOX box;
+
+  while ((c->trafEnd - c->trafScan) >= 8) {
+    TRANSPORTDEC_ERROR err = mp4Demux_ReadBox(h, c->trafScan, c->trafEnd, &box);
+    if (err != TRANSPORTDEC_OK) return err;
+    c->trafScan = box.end;
+    if (box.type != MP4_FOURCC('t', 'r', 'u', 'n')) continue;
+    if (box.end - box.body < 8) return TRANSPORTDEC_PARSE_ERROR;
+
+    UINT flags = mp4Read32(p + box.body) & 0xffffff;
+    UINT count = mp4Read32(p + box.body + 4);
+    UINT64 pos = box.body + 8;
+    UINT record = ((flags & TRUN_DURATION) ? 4 : 0) +
+                  ((flags & TRUN_SIZE) ? 4 : 0) +
+                  ((flags & TRUN_FLAGS) ? 4 : 0) +
+                  ((flags & TRUN_CTS_OFFSET) ? 4 : 0);
+    UINT64 need = ((flags & TRUN_DATA_OFFSET) ? 4 : 0) +
+                  ((flags & TRUN_FIRST_SAMPLE_FLAGS) ? 4 : 0) +
+                  (UINT64)count * record;
+    if (box.end - pos < need) return TRANSPORTDEC_PARSE_ERROR;
+
+    /* a trun without data offset continues after the previous one */
+    if (flags & TRUN_DATA_OFFSET) {
+      c->dataPos = c->base + (INT64)(INT)mp4Read32(p + pos);
+      pos += 4;
+    }
+    c->hasFirstFlags = 0;
+    if (flags & TRUN_FIRST_SAMPLE_FLAGS) {
+      c->firstFlags = mp4Read32(p + pos);
+      c->hasFirstFlags = 1;
+      pos += 4;
+    }
+    c->trun = pos;
+    c->trunLeft = count;
+    c->trunFlags = flags;
+    return TRANSPORTDEC_OK;
+  }
+
+  return TRANSPORTDEC_NOT_ENOUGH_BITS;
+}
+
+static TRANSPORTDEC_ERROR mp4Demux_ReadFragmentSample(CMp4Demux *h,
+                                                      MP4_SAMPLE *pSample) {
+  MP4_FRAG_CURSOR *c = &h->frag;
+  TRANSPORTDEC_ERROR err;
+
+  for (;;) {
+    if (c->trunLeft > 0) {
+      const UCHAR *p = h->pData + c->trun;
+      UINT duration = c->defDuration, size = c->defSize, flags = c->defFlags;
+      UINT record = 0;
+
+      if (c->trunFlags & TRUN_DURATION) {
+        duration = mp4Read32(p + record);
+        record += 4;
+      }
+      if (c->trunFlags & TRUN_SIZE) {
+        size = mp4Read32(p + record);
+        record += 4;
+      }
+      if (c->trunFlags & TRUN_FLAGS) {
+        flags = mp4Read32(p + record);
+        record += 4;
+      } else if (c->hasFirstFlags) {
+        flags = c->firstFlags;
+      }
+      if (c->trunFlags & TRUN_CTS_OFFSET) record += 4;
+
+      if ((c->dataPos > h->size) || (size > h->size - c->dataPos)) {
+        return TRANSPORTDEC_NOT_ENOUGH_BITS;
+      }
+      pSample->pData = (UCHAR *)h->pData + c->dataPos;
+      pSample->size = size;
+      pSample->time = c->time;
+      pSample->duration = duration;
+      pSample->isSync = !(flags & MP4_NON_SYNC_SAMPLE);
+
+      c->trun += record;
+      c->trunLeft--;
+      c->hasFirstFlags = 0;
+      c->dataPos += size;
+      c->time += duration;
+      return TRANSPORTDEC_OK;
+    }
+
+    if (c->trafEnd != 0) {
+      err = mp4Demux_NextTrun(h);
+      if (err == TRANSPORTDEC_OK) continue;
+      if (err != TRANSPORTDEC_NOT_ENOUGH_BITS) return err;
+      c->trafEnd = 0;
+    }
+    if (c->moof != 0) {
+      err = mp4Demux_NextTraf(h);
+      if (err == TRANSPORTDEC_OK) continue;
+      if (err != TRANSPORTDEC_NOT_ENOUGH_BITS) return err;
+      c->moof = 0;
+    }
+    err = mp4Demux_NextMoof(h);
+    if (err != TRANSPORTDEC_OK) return err;
+  }
+}
+
+static TRANSPORTDEC_ERROR mp4Demux_ParseMoov(CMp4Demux *h,
+                                             const MP4_BOX *pMoov) {
+  const UCHAR *p = h->pData;
+  UINT64 offset = pMoov->body;
+  UCHAR found = 0, unsupported = 0;
+  MP4_TRACK track;
+  MP4_BOX box, mvex;
+
+  FDKmemclear(&mvex, sizeof(MP4_BOX));
+  while ((pMoov->end - offset) >= 8) {
+    TRANSPORTDEC_ERROR err = mp4Demux_ReadBox(h, offset, pMoov->end, &box);
+    if (err != TRANSPORTDEC_OK) return err;
+    offset = box.end;
+
+    if ((box.type == MP4_FOURCC('t', 'r', 'a', 'k')) && !found) {
+      err = mp4Demux_ParseTrak(h, &box, &track);
+      if (err == TRANSPORTDEC_OK) {
+        h->track = track;
+        found = 1;
+      } else if (err == TRANSPORTDEC_UNSUPPORTED_FORMAT) {
+        unsupported = 1; /* e.g. a video track or another audio codec */
+      } else {
+        return err;
+      }
+    } else if (box.type == MP4_FOURCC('m', 'v', 'e', 'x')) {
+      mvex = box;
+    }
+  }
+  if (!found) {
+    return unsupported ? TRANSPORTDEC_UNSUPPORTED_FORMAT
+                       : TRANSPORTDEC_PARSE_ERROR;
+  }
+
+  /* sample defaults of the track fragments */
+  if (mvex.end != 0) {
+    h->fragmented = 1;
+    offset = mvex.body;
+    while ((mvex.end - offset) >= 8) {
+      TRANSPORTDEC_ERROR err = mp4Demux_ReadBox(h, offset, mvex.end, &box);
+      if (err != TRANSPORTDEC_OK) return err;
+      offset = box.end;
+      if ((box.type == MP4_FOURCC('t', 'r', 'e', 'x')) &&
+          (box.end - box.body >= 24) &&
+          (mp4Read32(p + box.body + 4) == h->track.trackId)) {
+        h->trexDuration = mp4Read32(p + box.body + 12);
+        h->trexSize = mp4Read32(p + box.body + 16);
+        h->trexFlags = mp4Read32(p + box.body + 20);
+      }
+    }
+  }
+
+  /* Every sample needs its size and chunk. stts may be shorter, the samples
+   * beyond it get the last duration. */
+  {
+    const MP4_SAMPLE_TABLES *t = &h->track.tables;
+    UINT i;
+    UINT64 samples = 0;
+    UINT prev = 0;
+    if ((t->stszCount > 0) && ((t->stscCount == 0) || (t->stcoCount == 0))) {
+      return TRANSPORTDEC_PARSE_ERROR;
+    }
+
+    /* The cursors index stsz and stco with these entries, reject any which
+     * point outside of them. */
+    for (i = 0; i < t->stssCount; i++) {
+      UINT sync = mp4Read32(p + t->stss + 4 * i);
+      if ((sync <= prev) || (sync > t->stszCount)) {
+        return TRANSPORTDEC_PARSE_ERROR;
+      }
+      prev = sync;
+    }
+    prev = 0;
+    for (i = 0; i < t->stscCount; i++) {
+      UINT first = mp4Read32(p + t->stsc + 12 * i);
+      UINT perChunk = mp4Read32(p + t->stsc + 12 * i + 4);
+      UINT next = (i + 1 < t->stscCount) ? mp4Read32(p + t->stsc + 12 * (i + 1))
+                                         : t->stcoCount + 1;
+      if ((first <= prev) || (first > t->stcoCount) || (next < first) ||
+          (perChunk == 0) || ((t->stszCount > 0) && (samples >= t->stszCount))) {
+        return TRANSPORTDEC_PARSE_ERROR;
+      }
+      samples += (UINT64)(next - first) * perChunk;
+      prev = first;
+    }
+    if (samples < t->stszCount) return TRANSPORTDEC_PARSE_ERROR;
+
+    h->tablesDuration = 0;
+    for (i = 0; i < t->sttsCount; i++) {
+      h->tablesDuration += (UINT64)mp4Read32(p + t->stts + 8 * i) *
+                           mp4Read32(p + t->stts + 8 * i + 4);
+    }
+  }
+
+  h->fragStart = pMoov->end;
+  return TRANSPORTDEC_OK;
+}
+
+HANDLE_MP4_DEMUX CMp4Demux_Open(void) { return GetRam_Mp4Demux(0); }
+
+void CMp4Demux_Close(HANDLE_MP4_DEMUX *phDemux) {
+  if (phDemux != NULL) {
+    FreeRam_Mp4Demux(phDemux);
+  }
+}
+
+TRANSPORTDEC_ERROR CMp4Demux_SetInput(HANDLE_MP4_DEMUX hDemux,
+                                      const UCHAR *pData, const UINT64 size) {
+  TRANSPORTDEC_ERROR err;
+  MP4_BOX box;
+
+  if ((hDemux == NULL) || (pData == NULL) || (size < hDemux->size)) {
+    return TRANSPORTDEC_INVALID_PARAMETER;
+  }
+  hDemux->pData = pData;
+  hDemux->size = size;
+  if (hDemux->moovFound) return TRANSPORTDEC_OK;
+
+  for (;;) {
+    err = mp4Demux_ReadBox(hDemux, hDemux->scan, MP4_FILE_END, &box);
+    if (err != TRANSPORTDEC_OK) return err;
+    if (box.type == MP4_FOURCC('m', 'o', 'o', 'v')) break;
+    if (box.end == MP4_FILE_END) return TRANSPORTDEC_UNSUPPORTED_FORMAT;
+    hDemux->scan = box.end;
+  }
+  if (box.end > size) return TRANSPORTDEC_NOT_ENOUGH_BITS;
+
+  err = mp4Demux_ParseMoov(hDemux, &box);
+  if (err != TRANSPORTDEC_OK) return err;
+  err = mp4Demux_SetTableCursor(hDemux, 0);
+  if (err != TRANSPORTDEC_OK) return err;
+  mp4Demux_ResetFragments(hDemux);
+  hDemux->moovFound = 1;
+
+  return TRANSPORTDEC_OK;
+}
+
+TRANSPORTDEC_ERROR CMp4Demux_GetTrackInfo(HANDLE_MP4_DEMUX hDemux,
+                                          MP4_TRACK_INFO *pInfo) {
+  const MP4_TRACK *t;
+
+  if ((hDemux == NULL) || (pInfo == NULL)) {
+    return TRANSPORTDEC_INVALID_PARAMETER;
+  }
+  if (!hDemux->moovFound) return TRANSPORTDEC_NOT_ENOUGH_BITS;
+
+  t = &hDemux->track;
+  pInfo->trackId = t->trackId;
+  pInfo->timescale = t->timescale;
+  pInfo->duration = t->duration;
+  pInfo->numSamples = t->tables.stszCount;
+  pInfo->sampleRate = t->sampleRate;
+  pInfo->channels = t->channels;
+  pInfo->fragmented = hDemux->fragmented;
+  pInfo->pAsc = (UCHAR *)hDemux->pData + t->asc;
+  pInfo->ascLength = t->ascLength;
+  pInfo->pLoudness =
+      (t->ludtLength != 0) ? (UCHAR *)hDemux->pData + t->ludt : NULL;
+  pInfo->loudnessLength = t->ludtLength;
+
+  return TRANSPORTDEC_OK;
+}
+
+TRANSPORTDEC_ERROR CMp4Demux_ReadSample(HANDLE_MP4_DEMUX hDemux,
+                                        MP4_SAMPLE *pSample) {
+  if ((hDemux == NULL) || (pSample == NULL)) {
+    return TRANSPORTDEC_INVALID_PARAMETER;
+  }
+  if (!hDemux->moovFound) return TRANSPORTDEC_NOT_ENOUGH_BITS;
+
+  if (hDemux->table.sample < hDemux->track.tables.stszCount) {
+    return mp4Demux_ReadTableSample(hDemux, pSample);
+  }
+  if (!hDemux->fragmented) return TRANSPORTDEC_NOT_ENOUGH_BITS;
+
+  return mp4Demux_ReadFragmentSample(hDemux, pSample);
+}
+
+TRANSPORTDEC_ERROR CMp4Demux_Seek(HANDLE_MP4_DEMUX hDemux, const UINT64 time,
+                                  UINT64 *pTime) {
+  const MP4_SAMPLE_TABLES *t;
+  TRANSPORTDEC_ERROR err;
+  MP4_SAMPLE sample;
+
+  if (hDemux == NULL) return TRANSPORTDEC_INVALID_PARAMETER;
+  if (!hDemux->moovFound) return TRANSPORTDEC_NOT_ENOUGH_BITS;
+  t = &hDemux->track.tables;
+
+  if ((t->stszCount > 0) && (time < hDemux->tablesDuration)) {
+    const UCHAR *p = hDemux->pData;
+    UINT64 start = 0;
+    UINT s = 0, i;
+
+    /* sample which contains the time */
+    for (i = 0; i < t->sttsCount; i++) {
+      UINT n = mp4Read32(p + t->stts + 8 * i);
+      UINT delta = mp4Read32(p + t->stts + 8 * i + 4);
+      if ((delta > 0) && (time - start < (UINT64)n * delta)) {
+        s += (UINT)((time - start) / delta);
+        break;
+      }
+      s += n;
+      start += (UINT64)n * delta;
+    }
+    s = FDKmin(s, t->stszCount - 1);
+
+    /* last sync sample at or before it */
+    if (t->hasStss) {
+      UINT lo = 0, hi = t->stssCount;
+      while (lo < hi) {
+        UINT mid = lo + (hi - lo) / 2;
+        if (mp4Read32(p + t->stss + 4 * mid) <= s + 1) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      s = (lo > 0) ? mp4Read32(p + t->stss + 4 * (lo - 1)) - 1 : 0;
+      s = FDKmin(s, t->stszCount - 1);
+    }
+
+    err = mp4Demux_SetTableCursor(hDemux, s);
+    if (err != TRANSPORTDEC_OK) return err;
+    mp4Demux_ResetFragments(hDemux);
+    if (pTime != NULL) *pTime = hDemux->table.time;
+    return TRANSPORTDEC_OK;
+  }
+
+  if (!hDemux->fragmented) return TRANSPORTDEC_NOT_ENOUGH_BITS;
+
+  /* Walk the samples of the track fragments from the first one on and keep
+   * the cursor of the last sync sample which starts at or before the time. */
+  {
+    MP4_TABLE_CURSOR table = hDemux->table;
+    MP4_FRAG_CURSOR frag = hDemux->frag, sync;
+    UINT64 syncTime = 0;
+    UCHAR found = 0, reached = 0;
+
+    hDemux->table.sample = t->stszCount;
+    mp4Demux_ResetFragments(hDemux);
+    for (;;) {
+      MP4_FRAG_CURSOR prev = hDemux->frag;
+      err = mp4Demux_ReadFragmentSample(hDemux, &sample);
+      if (err != TRANSPORTDEC_OK) break;
+      if (found && (sample.time > time)) {
+        reached = 1;
+        break;
+      }
+      if (sample.isSync || !found) {
+        sync = prev;
+        syncTime = sample.time;
+        found = 1;
+      }
+      if (sample.time + sample.duration > time) {
+        reached = 1;
+        break;
+      }
+    }
+
+    if (!reached) {
+      hDemux->table = table;
+      hDemux->frag = frag;
+      return (err == TRANSPORTDEC_PARSE_ERROR) ? err
+                                               : TRANSPORTDEC_NOT_ENOUGH_BITS;
+    }
+    hDemux->frag = sync;
+    if (pTime != NULL) *pTime = syncTime;
+  }
+
+  return TRANSPORTDEC_OK;
+}
@@ -0,0 +1,225 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/******************* MPEG transport format decoder library *********************
+
+   Author(s):
+
+   Description: ISO base media file format (MP4) demultiplexer
+
+*******************************************************************************/
+
+/** \file   tpdec_mp4.h
+    \brief  Demultiplexer of the first AAC audio track of an MP4 file (.m4a,
+   .mp4) in memory, e.g. memory mapped. It reads the AudioSpecificConfig from
+   the esds box and walks the sample tables of the moov box (stts, stss, stsz
+   or stz2, stsc, stco or co64) and the track fragments of fragmented MP4
+   (moof, traf, tfhd, tfdt, trun) with a few cursors, so neither the tables nor
+   the samples are copied and nothing is allocated besides the demultiplexer
+   itself. The samples are raw access units for a decoder opened with
+   TT_MP4_RAW:
+
+   \code
+   CMp4Demux_SetInput(hDemux, pFile, fileSize);
+   CMp4Demux_GetTrackInfo(hDemux, &track);
+   aacDecoder_ConfigRaw(hDecoder, &track.pAsc, &track.ascLength);
+   while (CMp4Demux_ReadSample(hDemux, &sample) == TRANSPORTDEC_OK) {
+     aacDecoder_Fill(hDecoder, &sample.pData, &sample.size, &bytesValid);
+     aacDecoder_DecodeFrame(hDecoder, pcm, pcmSize, 0);
+   }
+   \endcode
+
+   The file may grow while it is read, e.g. fragments of a live stream which
+   are appended: calling CMp4Demux_SetInput() again with the larger buffer
+   continues where CMp4Demux_ReadSample() returned TRANSPORTDEC_NOT_ENOUGH_BITS.
+ */
+
+#ifndef TPDEC_MP4_H
+#define TPDEC_MP4_H
+
+#include "libMpegTPDec/tpdec_lib.h"
+
+typedef struct CMp4Demux *HANDLE_MP4_DEMUX;
+
+/** Audio track of CMp4Demux_GetTrackInfo(). The pointers refer to the buffer
+ * of the last CMp4Demux_SetInput(). */
+typedef struct {
+  UINT trackId;
+  UINT timescale;    /*!< Ticks per second of the sample times. */
+  UINT64 duration;   /*!< Duration in ticks of the moov, 0 if unknown. */
+  UINT numSamples;   /*!< Samples of the moov sample tables, without the
+                          samples of the track fragments. */
+  UINT sampleRate;   /*!< Sample rate of the sample entry. */
+  UINT channels;     /*!< Channels of the sample entry. */
+  UCHAR fragmented;  /*!< The moov announces track fragments (mvex). */
+  UCHAR *pAsc;       /*!< AudioSpecificConfig, for aacDecoder_ConfigRaw(). */
+  UINT ascLength;    /*!< Length of the AudioSpecificConfig in bytes. */
+  UCHAR *pLoudness;  /*!< ludt box of the track including its header, for
+                          aacDecoder_RawISOBMFFData(), or NULL. */
+  UINT loudnessLength; /*!< Length of the ludt box in bytes. */
+} MP4_TRACK_INFO;
+
+/** Access unit of CMp4Demux_ReadSample(). */
+typedef struct {
+  UCHAR *pData;    /*!< Sample in the buffer of CMp4Demux_SetInput(). */
+  UINT size;       /*!< Size of the sample in bytes. */
+  UINT64 time;     /*!< Decoding time in ticks of the timescale. */
+  UINT duration;   /*!< Duration in ticks of the timescale. */
+  UCHAR isSync;    /*!< The sample is a random access point. */
+} MP4_SAMPLE;
+
+/**
+ * \brief  Allocate a demultiplexer.
+ * \return Handle or NULL if no memory is available.
+ */
+HANDLE_MP4_DEMUX CMp4Demux_Open(void);
+
+/**
+ * \brief        Release a demultiplexer.
+ * \param phDemux Pointer to the handle which is set to NULL.
+ */
+void CMp4Demux_Close(HANDLE_MP4_DEMUX *phDemux);
+
+/**
+ * \brief Set the file to read. The first call searches the moov box and
+ * selects the first audio track with an AAC sample entry. Later calls extend
+ * or move the same file, which must be at least as large as before.
+ * \param hDemux  Demultiplexer handle.
+ * \param pData   File, starting with its first box.
+ * \param size    Size of the available part of the file in bytes.
+ * \return TRANSPORTDEC_OK, TRANSPORTDEC_NOT_ENOUGH_BITS if the moov box is
+ * not complete yet, TRANSPORTDEC_UNSUPPORTED_FORMAT if there is no AAC audio
+ * track or TRANSPORTDEC_PARSE_ERROR.
+ */
+TRANSPORTDEC_ERROR CMp4Demux_SetInput(HANDLE_MP4_DEMUX hDemux,
+                                      const UCHAR *pData, const UINT64 size);
+
+/**
+ * \brief Get the selected audio track.
+ * \param hDemux  Demultiplexer handle.
+ * \param pInfo   Returns the track.
+ * \return TRANSPORTDEC_OK or TRANSPORTDEC_NOT_ENOUGH_BITS if the moov box was
+ * not found yet.
+ */
+TRANSPORTDEC_ERROR CMp4Demux_GetTrackInfo(HANDLE_MP4_DEMUX hDemux,
+                                          MP4_TRACK_INFO *pInfo);
+
+/**
+ * \brief Read the next sample of the track, first from the sample tables of
+ * the moov and then from the track fragments in file order.
+ * \param hDemux   Demultiplexer handle.
+ * \param pSample  Returns the sample.
+ * \return TRANSPORTDEC_OK, TRANSPORTDEC_NOT_ENOUGH_BITS at the end of the
+ * available data or TRANSPORTDEC_PARSE_ERROR.
+ */
+TRANSPORTDEC_ERROR CMp4Demux_ReadSample(HANDLE_MP4_DEMUX hDemux,
+                                        MP4_SAMPLE *pSample);
+
+/**
+ * \brief Continue with the last random access point at or before a time.
+ * The tables are searched for the sample tables of the moov, the track
+ * fragments are located by their tfdt boxes or the sum of the sample
+ * durations. Like after aacDecoder_SeekToFrame() the decoder needs the
+ * preceding access units to reproduce the output of a continuous decode, so
+ * seek a few frames earlier and drop their output.
+ * \param hDemux  Demultiplexer handle.
+ * \param time    Target in ticks of the timescale.
+ * \param pTime   Returns the time of the next sample, or NULL.
+ * \return TRANSPORTDEC_OK, TRANSPORTDEC_NOT_ENOUGH_BITS if the time is beyond
+ * the available samples or TRANSPORTDEC_PARSE_ERROR.
+ */
+TRANSPORTDEC_ERROR CMp4Demux_Seek(HANDLE_MP4_DEMUX hDemux, const UINT64 time,
+                                  UINT64 *pTime);
+
+#endif /* TPDEC_MP4_H */
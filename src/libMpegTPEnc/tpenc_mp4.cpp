@@ -0,0 +1,573 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/******************* MPEG transport format encoder library *********************
+
+   Author(s):
+
+   Description: Fragmented MP4 (CMAF) multiplexer
+
+*******************************************************************************/
+
+#include "libMpegTPEnc/tpenc_mp4.h"
+
+#include "libSYS/genericStds.h"
+
+#define MP4_FOURCC(a, b, c, d) \
+  (((UINT)(a) << 24) | ((UINT)(b) << 16) | ((UINT)(c) << 8) | (UINT)(d))
+
+#define MP4_MUX_MAX_INIT (1024) /* init segment in bytes */
+#define MP4_MUX_MAX_ASC (256)   /* AudioSpecificConfig in bytes */
+#define MP4_MUX_TRACK_ID (1)
+
+/* Layout of the moof template: mfhd, traf with tfhd (default-base-is-moof),
+ * tfdt version 1 and a trun with data offset and sample sizes. */
+#define MOOF_SEQUENCE 20     /* sequence_number of mfhd */
+#define MOOF_TRAF 24         /* traf box */
+#define MOOF_DECODE_TIME 60  /* baseMediaDecodeTime of tfdt */
+#define MOOF_TRUN 68         /* trun box */
+#define MOOF_SAMPLE_COUNT 80 /* sample_count of trun */
+#define MOOF_DATA_OFFSET 84  /* data_offset of trun */
+#define MOOF_SAMPLE_SIZES 88 /* sample_size of each sample */
+
+struct CMp4Mux {
+  UCHAR init[MP4_MUX_MAX_INIT];
+  UINT initLength;
+
+  UCHAR *pSegment; /* moof template, mdat header and samples */
+  UINT samplesPerFragment;
+  UINT moofLength; /* moof of a complete fragment */
+  UINT maxSampleSize;
+  UINT frameLength;
+
+  UCHAR shortFragment; /* the template was patched for a short fragment */
+  UINT numSamples;     /* samples of the current fragment */
+  UINT dataLength; /* bytes of the samples */
+  UINT sequence;
+  UINT64 time; /* decode time of the current fragment */
+};
+
+C_ALLOC_MEM(Ram_Mp4Mux, struct CMp4Mux, 1)
+
+static UCHAR *mp4Put8(UCHAR *p, const UINT v) {
+  p[0] = (UCHAR)v;
+  return p + 1;
+}
+
+static UCHAR *mp4Put16(UCHAR *p, const UINT v) {
+  p[0] = (UCHAR)(v >> 8);
+  p[1] = (UCHAR)v;
+  return p + 2;
+}
+
+static UCHAR *mp4Put32(UCHAR *p, const UINT v) {
+  p[0] = (UCHAR)(v >> 24);
+  p[1] = (UCHAR)(v >> 16);
+  p[2] = (UCHAR)(v >> 8);
+  p[3] = (UCHAR)v;
+  return p + 4;
+}
+
+static UCHAR *mp4Put64(UCHAR *p, const UINT64 v) {
+  p = mp4Put32(p, (UINT)(v >> 32));
+  return mp4Put32(p, (UINT)v);
+}
+
+static UCHAR *mp4PutZeros(UCHAR *p, const UINT n) {
+  FDKmemclear(p, n);
+  return p + n;
+}
+
+/* Box header with a size which is set by mp4BoxEnd(). */
+static UCHAR *mp4BoxStart(UCHAR *p, const UINT type) {
+  p = mp4Put32(p, 0);
+  return mp4Put32(p, type);
+}
+
+static UCHAR *mp4FullBoxStart(UCHAR *p, const UINT type, const UINT version,
+                              const UINT flags) {
+  p = mp4BoxStart(p, type);
+  return mp4Put32(p, (version << 24) | flags);
+}
+
+static void mp4BoxEnd(UCHAR *pBox, const UCHAR *p) {
+  mp4Put32(pBox, (UINT)(p - pBox));
+}
+
+/* Descriptor header, with the length in 4 bytes like most writers do */
+static UCHAR *mp4PutDescriptor(UCHAR *p, const UINT tag, const UINT length) {
+  p = mp4Put8(p, tag);
+  p = mp4Put8(p, 0x80 | ((length >> 21) & 0x7f));
+  p = mp4Put8(p, 0x80 | ((length >> 14) & 0x7f));
+  p = mp4Put8(p, 0x80 | ((length >> 7) & 0x7f));
+  return mp4Put8(p, length & 0x7f);
+}
+
+/* unity matrix of mvhd and tkhd */
+static UCHAR *mp4PutMatrix(UCHAR *p) {
+  p = mp4Put32(p, 0x00010000);
+  p = mp4PutZeros(p, 12);
+  p = mp4Put32(p, 0x00010000);
+  p = mp4PutZeros(p, 12);
+  return mp4Put32(p, 0x40000000);
+}
+
+/* mp4a sample entry with the esds box of the AudioSpecificConfig */
+static UCHAR *mp4PutSampleEntry(UCHAR *p, const MP4_MUX_CONFIG *pConfig) {
+  const UINT dcdLength = 13 + 5 + pConfig->ascLength;
+  const UINT esLength = 3 + 5 + dcdLength + 5 + 1;
+  UCHAR *pEntry = p, *pEsds;
+
+  p = mp4BoxStart(p, MP4_FOURCC('m', 'p', '4', 'a'));
+  p = mp4PutZeros(p, 6);
+  p = mp4Put16(p, 1); /* data_reference_index */
+  p = mp4PutZeros(p, 8);
+  p = mp4Put16(p, pConfig->channels);
+  p = mp4Put16(p, 16); /* samplesize */
+  p = mp4PutZeros(p, 4);
+  p = mp4Put32(p, (pConfig->sampleRate < 65536) ? pConfig->sampleRate << 16
+                                                 : 0);
+
+  pEsds = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('e', 's', 'd', 's'), 0, 0);
+  p = mp4PutDescriptor(p, 0x03, esLength); /* ES_Descriptor */
+  p = mp4Put16(p, 0);                      /* ES_ID */
+  p = mp4Put8(p, 0);                       /* no dependencies, URL, OCR */
+  p = mp4PutDescriptor(p, 0x04, dcdLength); /* DecoderConfigDescriptor */
+  p = mp4Put8(p, 0x40);                     /* MPEG-4 audio */
+  p = mp4Put8(p, (0x05 << 2) | 1);          /* audio stream */
+  p = mp4Put8(p, (pConfig->maxSampleSize >> 16) & 0xff); /* bufferSizeDB */
+  p = mp4Put16(p, pConfig->maxSampleSize & 0xffff);
+  p = mp4Put32(p, pConfig->bitrate); /* maxBitrate */
+  p = mp4Put32(p, pConfig->bitrate); /* avgBitrate */
+  p = mp4PutDescriptor(p, 0x05, pConfig->ascLength); /* DecoderSpecificInfo */
+  FDKmemcpy(p, pConfig->pAsc, pConfig->ascLength);
+  p += pConfig->ascLength;
+  p = mp4PutDescriptor(p, 0x06, 1); /* SLConfigDescriptor */
+  p = mp4Put8(p, 0x02);             /* predefined for MP4 files */
+  mp4BoxEnd(pEsds, p);
+
+  mp4BoxEnd(pEntry, p);
+  return p;
+}
+
+/* ftyp and moov */
+static UINT mp4Mux_WriteInit(UCHAR *pInit, const MP4_MUX_CONFIG *pConfig) {
+  const UINT timescale = pConfig->sampleRate;
+  UCHAR *p = pInit, *pMoov, *pTrak, *pMdia, *pMinf, *pStbl, *pBox[4];
+
+  pBox[0] = p;
+  p = mp4BoxStart(p, MP4_FOURCC('f', 't', 'y', 'p'));
+  p = mp4Put32(p, MP4_FOURCC('c', 'm', 'f', 'c'));
+  p = mp4Put32(p, 0);
+  p = mp4Put32(p, MP4_FOURCC('c', 'm', 'f', 'c'));
+  p = mp4Put32(p, MP4_FOURCC('i', 's', 'o', '6'));
+  p = mp4Put32(p, MP4_FOURCC('m', 'p', '4', '1'));
+  mp4BoxEnd(pBox[0], p);
+
+  pMoov = p;
+  p = mp4BoxStart(p, MP4_FOURCC('m', 'o', 'o', 'v'));
+
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('m', 'v', 'h', 'd'), 0, 0);
+  p = mp4PutZeros(p, 8); /* creation and modification time */
+  p = mp4Put32(p, timescale);
+  p = mp4Put32(p, 0); /* duration, given by the fragments */
+  p = mp4Put32(p, 0x00010000); /* rate */
+  p = mp4Put16(p, 0x0100);     /* volume */
+  p = mp4PutZeros(p, 10);
+  p = mp4PutMatrix(p);
+  p = mp4PutZeros(p, 24);
+  p = mp4Put32(p, MP4_MUX_TRACK_ID + 1); /* next_track_ID */
+  mp4BoxEnd(pBox[0], p);
+
+  pTrak = p;
+  p = mp4BoxStart(p, MP4_FOURCC('t', 'r', 'a', 'k'));
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('t', 'k', 'h', 'd'), 0,
+                      0x3); /* enabled, in movie */
+  p = mp4PutZeros(p, 8);
+  p = mp4Put32(p, MP4_MUX_TRACK_ID);
+  p = mp4PutZeros(p, 4 + 4 + 8 + 2 + 2); /* duration, layer, group */
+  p = mp4Put16(p, 0x0100);               /* volume */
+  p = mp4PutZeros(p, 2);
+  p = mp4PutMatrix(p);
+  p = mp4PutZeros(p, 8); /* width, height */
+  mp4BoxEnd(pBox[0], p);
+
+  /* edit list which skips the encoder delay */
+  if (pConfig->delay > 0) {
+    pBox[0] = p;
+    p = mp4BoxStart(p, MP4_FOURCC('e', 'd', 't', 's'));
+    pBox[1] = p;
+    p = mp4FullBoxStart(p, MP4_FOURCC('e', 'l', 's', 't'), 0, 0);
+    p = mp4Put32(p, 1);
+    p = mp4Put32(p, 0); /* segment_duration, the whole track */
+    p = mp4Put32(p, pConfig->delay);
+    p = mp4Put32(p, 0x00010000); /* media_rate */
+    mp4BoxEnd(pBox[1], p);
+    mp4BoxEnd(pBox[0], p);
+  }
+
+  pMdia = p;
+  p = mp4BoxStart(p, MP4_FOURCC('m', 'd', 'i', 'a'));
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('m', 'd', 'h', 'd'), 0, 0);
+  p = mp4PutZeros(p, 8);
+  p = mp4Put32(p, timescale);
+  p = mp4Put32(p, 0);
+  p = mp4Put16(p, 0x55c4); /* language "und" */
+  p = mp4Put16(p, 0);
+  mp4BoxEnd(pBox[0], p);
+
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('h', 'd', 'l', 'r'), 0, 0);
+  p = mp4Put32(p, 0);
+  p = mp4Put32(p, MP4_FOURCC('s', 'o', 'u', 'n'));
+  p = mp4PutZeros(p, 12);
+  FDKmemcpy(p, "SoundHandler", 13);
+  p += 13;
+  mp4BoxEnd(pBox[0], p);
+
+  pMinf = p;
+  p = mp4BoxStart(p, MP4_FOURCC('m', 'i', 'n', 'f'));
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('s', 'm', 'h', 'd'), 0, 0);
+  p = mp4PutZeros(p, 4);
+  mp4BoxEnd(pBox[0], p);
+
+  pBox[0] = p;
+  p = mp4BoxStart(p, MP4_FOURCC('d', 'i', 'n', 'f'));
+  pBox[1] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('d', 'r', 'e', 'f'), 0, 0);
+  p = mp4Put32(p, 1);
+  pBox[2] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('u', 'r', 'l', ' '), 0,
+                      0x1); /* media data in the same file */
+  mp4BoxEnd(pBox[2], p);
+  mp4BoxEnd(pBox[1], p);
+  mp4BoxEnd(pBox[0], p);
+
+  /* empty sample tables, the samples are in the fragments */
+  pStbl = p;
+  p = mp4BoxStart(p, MP4_FOURCC('s', 't', 'b', 'l'));
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('s', 't', 's', 'd'), 0, 0);
+  p = mp4Put32(p, 1);
+  p = mp4PutSampleEntry(p, pConfig);
+  mp4BoxEnd(pBox[0], p);
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('s', 't', 't', 's'), 0, 0);
+  p = mp4Put32(p, 0);
+  mp4BoxEnd(pBox[0], p);
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('s', 't', 's', 'c'), 0, 0);
+  p = mp4Put32(p, 0);
+  mp4BoxEnd(pBox[0], p);
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('s', 't', 's', 'z'), 0, 0);
+  p = mp4PutZeros(p, 8);
+  mp4BoxEnd(pBox[0], p);
+  pBox[0] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('s', 't', 'c', 'o'), 0, 0);
+  p = mp4Put32(p, 0);
+  mp4BoxEnd(pBox[0], p);
+  mp4BoxEnd(pStbl, p);
+  mp4BoxEnd(pMinf, p);
+  mp4BoxEnd(pMdia, p);
+  mp4BoxEnd(pTrak, p);
+
+  /* every sample lasts one frame and is a sync sample */
+  pBox[0] = p;
+  p = mp4BoxStart(p, MP4_FOURCC('m', 'v', 'e', 'x'));
+  pBox[1] = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('t', 'r', 'e', 'x'), 0, 0);
+  p = mp4Put32(p, MP4_MUX_TRACK_ID);
+  p = mp4Put32(p, 1); /* default_sample_description_index */
+  p = mp4Put32(p, pConfig->frameLength);
+  p = mp4Put32(p, 0); /* default_sample_size */
+  p = mp4Put32(p, 0); /* default_sample_flags */
+  mp4BoxEnd(pBox[1], p);
+  mp4BoxEnd(pBox[0], p);
+  mp4BoxEnd(pMoov, p);
+
+  return (UINT)(p - pInit);
+}
+
+/* moof of a complete fragment, the sample sizes are filled in later */
+static UINT mp4Mux_WriteMoof(UCHAR *pMoof, const UINT numSamples) {
+  UCHAR *p = pMoof, *pTraf, *pBox;
+
+  p = mp4BoxStart(p, MP4_FOURCC('m', 'o', 'o', 'f'));
+  pBox = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('m', 'f', 'h', 'd'), 0, 0);
+  p = mp4Put32(p, 0);
+  mp4BoxEnd(pBox, p);
+
+  pTraf = p;
+  p = mp4BoxStart(p, MP4_FOURCC('t', 'r', 'a', 'f'));
+  pBox = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('t', 'f', 'h', 'd'), 0,
+                      0x020000); /* default-base-is-moof */
+  p = mp4Put32(p, MP4_MUX_TRACK_ID);
+  mp4BoxEnd(pBox, p);
+  pBox = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('t', 'f', 'd', 't'), 1, 0);
+  p = mp4Put64(p, 0);
+  mp4BoxEnd(pBox, p);
+  pBox = p;
+  p = mp4FullBoxStart(p, MP4_FOURCC('t', 'r', 'u', 'n'), 0,
+                      0x000201); /* data offset, sample sizes */
+  p = mp4Put32(p, numSamples);
+  p = mp4Put32(p, 0);
+  p = mp4PutZeros(p, 4 * numSamples);
+  mp4BoxEnd(pBox, p);
+  mp4BoxEnd(pTraf, p);
+  mp4BoxEnd(pMoof, p);
+
+  return (UINT)(p - pMoof);
+}
+
+/* Patch the moof template for a fragment of numSamples samples. */
+static void mp4Mux_SetSampleCount(CMp4Mux *h, const UINT numSamples) {
+  UCHAR *p = h->pSegment;
+  const UINT moofLength = MOOF_SAMPLE_SIZES + 4 * numSamples;
+
+  mp4Put32(p, moofLength);
+  mp4Put32(p + MOOF_TRAF, moofLength - MOOF_TRAF);
+  mp4Put32(p + MOOF_TRUN, moofLength - MOOF_TRUN);
+  mp4Put32(p + MOOF_SAMPLE_COUNT, numSamples);
+  mp4Put32(p + MOOF_DATA_OFFSET, moofLength + 8);
+}
+
+/* Complete the current fragment. */
+static void mp4Mux_EndFragment(CMp4Mux *h, UCHAR **ppSegment, UINT *pLength) {
+  UCHAR *p = h->pSegment;
+  UINT moofLength = h->moofLength;
+
+  if (h->numSamples < h->samplesPerFragment) {
+    /* shorter trun, move the mdat behind it */
+    moofLength = MOOF_SAMPLE_SIZES + 4 * h->numSamples;
+    mp4Mux_SetSampleCount(h, h->numSamples);
+    FDKmemmove(p + moofLength, p + h->moofLength, 8 + h->dataLength);
+    h->shortFragment = 1;
+  }
+  mp4Put32(p + MOOF_SEQUENCE, ++h->sequence);
+  mp4Put64(p + MOOF_DECODE_TIME, h->time);
+  mp4Put32(p + moofLength, 8 + h->dataLength);
+
+  *ppSegment = p;
+  *pLength = moofLength + 8 + h->dataLength;
+
+  h->time += (UINT64)h->numSamples * h->frameLength;
+  h->numSamples = 0;
+  h->dataLength = 0;
+}
+
+/* Restore the template after a short fragment, before the next sample is
+ * written behind it. */
+static void mp4Mux_RestoreTemplate(CMp4Mux *h) {
+  if (h->shortFragment) {
+    mp4Mux_SetSampleCount(h, h->samplesPerFragment);
+    mp4BoxStart(h->pSegment + h->moofLength, MP4_FOURCC('m', 'd', 'a', 't'));
+    h->shortFragment = 0;
+  }
+}
+
+TRANSPORTENC_ERROR CMp4Mux_Open(HANDLE_MP4_MUX *phMux,
+                                const MP4_MUX_CONFIG *pConfig) {
+  HANDLE_MP4_MUX h;
+  UINT64 segmentSize;
+  UINT samples;
+
+  if ((phMux == NULL) || (pConfig == NULL) || (pConfig->pAsc == NULL) ||
+      (pConfig->ascLength == 0) || (pConfig->ascLength > MP4_MUX_MAX_ASC) ||
+      (pConfig->sampleRate == 0) || (pConfig->frameLength == 0) ||
+      (pConfig->maxSampleSize == 0) || (pConfig->channels == 0)) {
+    return TRANSPORTENC_INVALID_PARAMETER;
+  }
+  samples = (UINT)(((UINT64)pConfig->fragmentDuration + pConfig->frameLength -
+                    1) /
+                   pConfig->frameLength);
+  samples = FDKmax(1, samples);
+  segmentSize = MOOF_SAMPLE_SIZES + 4 * (UINT64)samples + 8 +
+                (UINT64)samples * pConfig->maxSampleSize;
+  if (segmentSize > (UINT64)0x7fffffff) return TRANSPORTENC_INVALID_PARAMETER;
+
+  h = GetRam_Mp4Mux(0);
+  if (h == NULL) return TRANSPORTENC_NO_MEM;
+  h->pSegment = (UCHAR *)FDKcalloc((UINT)segmentSize, 1);
+  if (h->pSegment == NULL) {
+    FreeRam_Mp4Mux(&h);
+    return TRANSPORTENC_NO_MEM;
+  }
+
+  h->initLength = mp4Mux_WriteInit(h->init, pConfig);
+  h->samplesPerFragment = samples;
+  h->maxSampleSize = pConfig->maxSampleSize;
+  h->frameLength = pConfig->frameLength;
+  h->moofLength = mp4Mux_WriteMoof(h->pSegment, samples);
+  mp4BoxStart(h->pSegment + h->moofLength, MP4_FOURCC('m', 'd', 'a', 't'));
+  mp4Mux_SetSampleCount(h, samples);
+
+  *phMux = h;
+  return TRANSPORTENC_OK;
+}
+
+void CMp4Mux_Close(HANDLE_MP4_MUX *phMux) {
+  if ((phMux != NULL) && (*phMux != NULL)) {
+    FDKfree((*phMux)->pSegment);
+    FreeRam_Mp4Mux(phMux);
+  }
+}
+
+TRANSPORTENC_ERROR CMp4Mux_GetInitSegment(HANDLE_MP4_MUX hMux, UCHAR **ppData,
+                                          UINT *pLength) {
+  if ((hMux == NULL) || (ppData == NULL) || (pLength == NULL)) {
+    return TRANSPORTENC_INVALID_PARAMETER;
+  }
+  *ppData = hMux->init;
+  *pLength = hMux->initLength;
+  return TRANSPORTENC_OK;
+}
+
+TRANSPORTENC_ERROR CMp4Mux_GetSampleBuffer(HANDLE_MP4_MUX hMux, UCHAR **ppData,
+                                           UINT *pSize) {
+  if ((hMux == NULL) || (ppData == NULL) || (pSize == NULL)) {
+    return TRANSPORTENC_INVALID_PARAMETER;
+  }
+  mp4Mux_RestoreTemplate(hMux);
+  *ppData = hMux->pSegment + hMux->moofLength + 8 + hMux->dataLength;
+  *pSize = hMux->maxSampleSize;
+  return TRANSPORTENC_OK;
+}
+
+TRANSPORTENC_ERROR CMp4Mux_WriteSample(HANDLE_MP4_MUX hMux, const UCHAR *pData,
+                                       const UINT size, UCHAR **ppSegment,
+                                       UINT *pLength) {
+  UCHAR *pSample;
+
+  if ((hMux == NULL) || (ppSegment == NULL) || (pLength == NULL) ||
+      ((pData == NULL) && (size > 0)) || (size > hMux->maxSampleSize)) {
+    return TRANSPORTENC_INVALID_PARAMETER;
+  }
+  *pLength = 0;
+  if (size == 0) return TRANSPORTENC_OK;
+
+  mp4Mux_RestoreTemplate(hMux);
+  pSample = hMux->pSegment + hMux->moofLength + 8 + hMux->dataLength;
+  if (pData != pSample) {
+    FDKmemmove(pSample, pData, size);
+  }
+  mp4Put32(hMux->pSegment + MOOF_SAMPLE_SIZES + 4 * hMux->numSamples, size);
+  hMux->numSamples++;
+  hMux->dataLength += size;
+
+  if (hMux->numSamples == hMux->samplesPerFragment) {
+    mp4Mux_EndFragment(hMux, ppSegment, pLength);
+  }
+  return TRANSPORTENC_OK;
+}
+
+TRANSPORTENC_ERROR CMp4Mux_Flush(HANDLE_MP4_MUX hMux, UCHAR **ppSegment,
+                                 UINT *pLength) {
+  if ((hMux == NULL) || (ppSegment == NULL) || (pLength == NULL)) {
+    return TRANSPORTENC_INVALID_PARAMETER;
+  }
+  *pLength = 0;
+  if (hMux->numSamples > 0) {
+    mp4Mux_EndFragment(hMux, ppSegment, pLength);
+  }
+  return TRANSPORTENC_OK;
+}
@@ -0,0 +1,221 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/******************* MPEG transport format encoder library *********************
+
+   Author(s):
+
+   Description: Fragmented MP4 (CMAF) multiplexer
+
+*******************************************************************************/
+
+/** \file   tpenc_mp4.h
+    \brief  Multiplexer of the raw access units of an encoder configured with
+   TT_MP4_RAW into a fragmented MP4 (CMAF) audio track: an init segment with
+   the moov box and media segments of a moof and an mdat box each. Both are
+   built once from templates when the multiplexer is opened. A fragment only
+   patches the sample sizes, its sequence number, its decode time and the box
+   sizes in place, and the encoder can write the access units directly into the
+   mdat box:
+
+   \code
+   aacEncInfo(hEncoder, &info);
+   config.pAsc = info.confBuf;
+   config.ascLength = info.confSize;
+   ...
+   CMp4Mux_Open(&hMux, &config);
+   CMp4Mux_GetInitSegment(hMux, &pInit, &initLength);
+   while (...) {
+     CMp4Mux_GetSampleBuffer(hMux, &pSample, &sampleSize);
+     ... aacEncEncode() into pSample, sampleSize ...
+     CMp4Mux_WriteSample(hMux, pSample, outArgs.numOutBytes, &pSegment,
+                         &segmentLength);
+     if (segmentLength > 0) ... send pSegment ...
+   }
+   CMp4Mux_Flush(hMux, &pSegment, &segmentLength);
+   \endcode
+ */
+
+#ifndef TPENC_MP4_H
+#define TPENC_MP4_H
+
+#include "libMpegTPEnc/tpenc_lib.h"
+
+typedef struct CMp4Mux *HANDLE_MP4_MUX;
+
+/** Track of CMp4Mux_Open(). */
+typedef struct {
+  const UCHAR *pAsc; /*!< AudioSpecificConfig, e.g. confBuf of aacEncInfo()
+                          with TT_MP4_RAW or of transportEnc_GetConf(). */
+  UINT ascLength;    /*!< Length of the AudioSpecificConfig in bytes. */
+  UINT sampleRate;   /*!< Input sample rate, also the timescale. */
+  UINT channels;     /*!< Output channels of the decoder. */
+  UINT frameLength;  /*!< Input samples per access unit (frameLength of
+                          aacEncInfo()). */
+  UINT maxSampleSize; /*!< Maximum size of an access unit in bytes
+                           (maxOutBufBytes of aacEncInfo()). */
+  UINT fragmentDuration; /*!< Duration of a fragment in samples, rounded up to
+                              whole access units. */
+  UINT delay;   /*!< Samples at the start which are not presented, e.g.
+                     nDelayCore of aacEncInfo(). Written as edit list if not 0.
+                 */
+  UINT bitrate; /*!< Average bitrate for the esds box, 0 if unknown. */
+} MP4_MUX_CONFIG;
+
+/**
+ * \brief Allocate a multiplexer and build the init segment and the fragment
+ * template of a track.
+ * \param phMux    Returns the handle.
+ * \param pConfig  Track configuration.
+ * \return TRANSPORTENC_OK, TRANSPORTENC_NO_MEM or
+ * TRANSPORTENC_INVALID_PARAMETER.
+ */
+TRANSPORTENC_ERROR CMp4Mux_Open(HANDLE_MP4_MUX *phMux,
+                                const MP4_MUX_CONFIG *pConfig);
+
+/**
+ * \brief        Release a multiplexer.
+ * \param phMux  Pointer to the handle which is set to NULL.
+ */
+void CMp4Mux_Close(HANDLE_MP4_MUX *phMux);
+
+/**
+ * \brief Get the init segment: ftyp and moov box with the sample entry and
+ * the defaults of the track fragments.
+ * \param hMux     Multiplexer handle.
+ * \param ppData   Returns the segment, valid until the multiplexer is closed.
+ * \param pLength  Returns its length in bytes.
+ * \return TRANSPORTENC_OK or TRANSPORTENC_INVALID_PARAMETER.
+ */
+TRANSPORTENC_ERROR CMp4Mux_GetInitSegment(HANDLE_MP4_MUX hMux, UCHAR **ppData,
+                                          UINT *pLength);
+
+/**
+ * \brief Get the place of the next access unit in the mdat box, to let the
+ * encoder write it there.
+ * \param hMux    Multiplexer handle.
+ * \param ppData  Returns the buffer.
+ * \param pSize   Returns its size, maxSampleSize.
+ * \return TRANSPORTENC_OK or TRANSPORTENC_INVALID_PARAMETER.
+ */
+TRANSPORTENC_ERROR CMp4Mux_GetSampleBuffer(HANDLE_MP4_MUX hMux, UCHAR **ppData,
+                                           UINT *pSize);
+
+/**
+ * \brief Add the next access unit. It is copied unless it was written to the
+ * buffer of CMp4Mux_GetSampleBuffer(). An access unit of 0 bytes is ignored.
+ * \param hMux       Multiplexer handle.
+ * \param pData      Access unit.
+ * \param size       Its size in bytes, at most maxSampleSize.
+ * \param ppSegment  Returns the media segment if the access unit completed a
+ * fragment, valid until the next call of the multiplexer.
+ * \param pLength    Returns the length of the segment, 0 if the fragment is
+ * not complete yet.
+ * \return TRANSPORTENC_OK or TRANSPORTENC_INVALID_PARAMETER.
+ */
+TRANSPORTENC_ERROR CMp4Mux_WriteSample(HANDLE_MP4_MUX hMux, const UCHAR *pData,
+                                       const UINT size, UCHAR **ppSegment,
+                                       UINT *pLength);
+
+/**
+ * \brief Complete the current fragment early, e.g. at the end of the stream.
+ * \param hMux       Multiplexer handle.
+ * \param ppSegment  Returns the media segment.
+ * \param pLength    Returns its length, 0 if the fragment has no samples.
+ * \return TRANSPORTENC_OK or TRANSPORTENC_INVALID_PARAMETER.
+ */
+TRANSPORTENC_ERROR CMp4Mux_Flush(HANDLE_MP4_MUX hMux, UCHAR **ppSegment,
+                                 UINT *pLength);
+
+#endif /* TPENC_MP4_H */
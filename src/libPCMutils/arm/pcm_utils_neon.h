@@ -0,0 +1,475 @@
+#pragma once
+
+/* NEON versions of the (de)interleaving functions of pcm_utils.cpp for 1, 2, 6
+ * and 8 channels: included there and selected at runtime by
+ * pcmUtilsSelectKernels(). The results are bit exact to the generic
+ * functions. */
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+
+/* Transpose of the 4x4 matrix of 32 bit values x[0..3] */
+static inline void pcm_transpose4x4_neon(int32x4_t *x) {
+  const int32x4x2_t t01 = vtrnq_s32(x[0], x[1]);
+  const int32x4x2_t t23 = vtrnq_s32(x[2], x[3]);
+
+  x[0] = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+  x[1] = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+  x[2] = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+  x[3] = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+/* Stores 4 samples of the channels c[0 .. channels-1] interleaved */
+static inline void pcm_interleave32_neon(LONG *pOut, int32x4_t *c,
+                                         const UINT channels) {
+  switch (channels) {
+    case 1:
+      vst1q_s32((int32_t *)pOut, c[0]);
+      break;
+    case 2: {
+      const int32x4x2_t x = {{c[0], c[1]}};
+      vst2q_s32((int32_t *)pOut, x);
+    } break;
+    case 6: {
+      /* channels 4 and 5 of the samples 0, 1 and 2, 3 */
+      const int32x4x2_t z = vzipq_s32(c[4], c[5]);
+
+      pcm_transpose4x4_neon(c);
+      vst1q_s32((int32_t *)&pOut[0], c[0]);
+      vst1_s32((int32_t *)&pOut[4], vget_low_s32(z.val[0]));
+      vst1q_s32((int32_t *)&pOut[6], c[1]);
+      vst1_s32((int32_t *)&pOut[10], vget_high_s32(z.val[0]));
+      vst1q_s32((int32_t *)&pOut[12], c[2]);
+      vst1_s32((int32_t *)&pOut[16], vget_low_s32(z.val[1]));
+      vst1q_s32((int32_t *)&pOut[18], c[3]);
+      vst1_s32((int32_t *)&pOut[22], vget_high_s32(z.val[1]));
+    } break;
+    case 8:
+      pcm_transpose4x4_neon(&c[0]);
+      pcm_transpose4x4_neon(&c[4]);
+      for (int s = 0; s < 4; s++) {
+        vst1q_s32((int32_t *)&pOut[8 * s], c[s]);
+        vst1q_s32((int32_t *)&pOut[8 * s + 4], c[4 + s]);
+      }
+      break;
+  }
+}
+
+/* Loads 4 interleaved samples into the channels c[0 .. channels-1] */
+static inline void pcm_deinterleave32_neon(int32x4_t *c, const LONG *pIn,
+                                           const UINT channels) {
+  switch (channels) {
+    case 1:
+      c[0] = vld1q_s32((const int32_t *)pIn);
+      break;
+    case 2: {
+      const int32x4x2_t x = vld2q_s32((const int32_t *)pIn);
+      c[0] = x.val[0];
+      c[1] = x.val[1];
+    } break;
+    case 6: {
+      const int32x4x2_t z = vuzpq_s32(
+          vcombine_s32(vld1_s32((const int32_t *)&pIn[4]),
+                       vld1_s32((const int32_t *)&pIn[10])),
+          vcombine_s32(vld1_s32((const int32_t *)&pIn[16]),
+                       vld1_s32((const int32_t *)&pIn[22])));
+
+      for (int s = 0; s < 4; s++) {
+        c[s] = vld1q_s32((const int32_t *)&pIn[6 * s]);
+      }
+      pcm_transpose4x4_neon(c);
+      c[4] = z.val[0];
+      c[5] = z.val[1];
+    } break;
+    case 8:
+      for (int s = 0; s < 4; s++) {
+        c[s] = vld1q_s32((const int32_t *)&pIn[8 * s]);
+        c[4 + s] = vld1q_s32((const int32_t *)&pIn[8 * s + 4]);
+      }
+      pcm_transpose4x4_neon(&c[0]);
+      pcm_transpose4x4_neon(&c[4]);
+      break;
+  }
+}
+
+/* Stores 8 samples of the channels c[0 .. channels-1] interleaved. For 6 and
+ * 8 channels the pairs of channels are interleaved as 32 bit values. */
+static inline void pcm_interleave16_neon(SHORT *pOut, const int16x8_t *c,
+                                         const UINT channels) {
+  switch (channels) {
+    case 1:
+      vst1q_s16((int16_t *)pOut, c[0]);
+      break;
+    case 2: {
+      const int16x8x2_t x = {{c[0], c[1]}};
+      vst2q_s16((int16_t *)pOut, x);
+    } break;
+    case 6: {
+      const int16x8x2_t z01 = vzipq_s16(c[0], c[1]);
+      const int16x8x2_t z23 = vzipq_s16(c[2], c[3]);
+      const int16x8x2_t z45 = vzipq_s16(c[4], c[5]);
+
+      for (int h = 0; h < 2; h++) {
+        const int32x4x3_t x = {{vreinterpretq_s32_s16(z01.val[h]),
+                                vreinterpretq_s32_s16(z23.val[h]),
+                                vreinterpretq_s32_s16(z45.val[h])}};
+        vst3q_s32((int32_t *)&pOut[24 * h], x);
+      }
+    } break;
+    case 8: {
+      const int16x8x2_t z01 = vzipq_s16(c[0], c[1]);
+      const int16x8x2_t z23 = vzipq_s16(c[2], c[3]);
+      const int16x8x2_t z45 = vzipq_s16(c[4], c[5]);
+      const int16x8x2_t z67 = vzipq_s16(c[6], c[7]);
+
+      for (int h = 0; h < 2; h++) {
+        const int32x4x4_t x = {{vreinterpretq_s32_s16(z01.val[h]),
+                                vreinterpretq_s32_s16(z23.val[h]),
+                                vreinterpretq_s32_s16(z45.val[h]),
+                                vreinterpretq_s32_s16(z67.val[h])}};
+        vst4q_s32((int32_t *)&pOut[32 * h], x);
+      }
+    } break;
+  }
+}
+
+/* Loads 8 interleaved samples into the channels c[0 .. channels-1] */
+static inline void pcm_deinterleave16_neon(int16x8_t *c, const SHORT *pIn,
+                                           const UINT channels) {
+  switch (channels) {
+    case 1:
+      c[0] = vld1q_s16((const int16_t *)pIn);
+      break;
+    case 2: {
+      const int16x8x2_t x = vld2q_s16((const int16_t *)pIn);
+      c[0] = x.val[0];
+      c[1] = x.val[1];
+    } break;
+    case 6: {
+      const int32x4x3_t x0 = vld3q_s32((const int32_t *)&pIn[0]);
+      const int32x4x3_t x1 = vld3q_s32((const int32_t *)&pIn[24]);
+
+      for (int p = 0; p < 3; p++) {
+        const int16x8x2_t u = vuzpq_s16(vreinterpretq_s16_s32(x0.val[p]),
+                                        vreinterpretq_s16_s32(x1.val[p]));
+        c[2 * p] = u.val[0];
+        c[2 * p + 1] = u.val[1];
+      }
+    } break;
+    case 8: {
+      const int32x4x4_t x0 = vld4q_s32((const int32_t *)&pIn[0]);
+      const int32x4x4_t x1 = vld4q_s32((const int32_t *)&pIn[32]);
+
+      for (int p = 0; p < 4; p++) {
+        const int16x8x2_t u = vuzpq_s16(vreinterpretq_s16_s32(x0.val[p]),
+                                        vreinterpretq_s16_s32(x1.val[p]));
+        c[2 * p] = u.val[0];
+        c[2 * p + 1] = u.val[1];
+      }
+    } break;
+  }
+}
+
+#define FUNCTION_FDK_interleave_DBL_neon
+static void FDK_interleave_DBL_neon(const FIXP_DBL *RESTRICT pIn,
+                                    LONG *RESTRICT pOut, const UINT channels,
+                                    const UINT frameSize, const UINT length) {
+  int32x4_t c[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (length & ~3u); sample += 4) {
+    for (ch = 0; ch < channels; ch++) {
+      c[ch] = vld1q_s32((const int32_t *)&pIn[ch * frameSize + sample]);
+    }
+    pcm_interleave32_neon(pOut, c, channels);
+    pOut += 4 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (LONG)In[0];
+      In += frameSize;
+    }
+  }
+}
+
+#define FUNCTION_FDK_interleave_SGL_neon
+static void FDK_interleave_SGL_neon(const FIXP_SGL *RESTRICT pIn,
+                                    SHORT *RESTRICT pOut, const UINT channels,
+                                    const UINT frameSize, const UINT length) {
+  int16x8_t c[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (length & ~7u); sample += 8) {
+    for (ch = 0; ch < channels; ch++) {
+      c[ch] = vld1q_s16((const int16_t *)&pIn[ch * frameSize + sample]);
+    }
+    pcm_interleave16_neon(pOut, c, channels);
+    pOut += 8 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_SGL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (SHORT)In[0];
+      In += frameSize;
+    }
+  }
+}
+
+#define FUNCTION_FDK_deinterleave_DBL_neon
+static void FDK_deinterleave_DBL_neon(const LONG *RESTRICT pIn,
+                                      LONG *RESTRICT pOut, const UINT channels,
+                                      const UINT frameSize, const UINT length) {
+  int32x4_t c[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (frameSize & ~3u); sample += 4) {
+    pcm_deinterleave32_neon(c, pIn, channels);
+    for (ch = 0; ch < channels; ch++) {
+      vst1q_s32((int32_t *)&pOut[ch * length + sample], c[ch]);
+    }
+    pIn += 4 * channels;
+  }
+  for (; sample < frameSize; sample++) {
+    for (ch = 0; ch < channels; ch++) {
+      pOut[ch * length + sample] = *pIn++;
+    }
+  }
+}
+
+#define FUNCTION_FDK_deinterleave_SGL_neon
+static void FDK_deinterleave_SGL_neon(const SHORT *RESTRICT pIn,
+                                      SHORT *RESTRICT pOut,
+                                      const UINT channels,
+                                      const UINT frameSize,
+                                      const UINT length) {
+  int16x8_t c[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (frameSize & ~7u); sample += 8) {
+    pcm_deinterleave16_neon(c, pIn, channels);
+    for (ch = 0; ch < channels; ch++) {
+      vst1q_s16((int16_t *)&pOut[ch * length + sample], c[ch]);
+    }
+    pIn += 8 * channels;
+  }
+  for (; sample < frameSize; sample++) {
+    for (ch = 0; ch < channels; ch++) {
+      pOut[ch * length + sample] = *pIn++;
+    }
+  }
+}
+
+/* scaleValueSaturate() of 4 values, scalefactor in range -31 ... +31 */
+static inline int32x4_t pcm_scale_saturate_neon(const int32x4_t value,
+                                                const int32x4_t shift,
+                                                const INT scalefactor) {
+  int32x4_t result;
+
+  if (scalefactor >= 0) {
+    /* vqshl saturates to 0x8000.0000 instead of 0x8000.0001 */
+    result = vmaxq_s32(vqshlq_s32(value, shift),
+                       vdupq_n_s32((INT)MINVAL_DBL + 1));
+  } else {
+    /* values which would become -1 are cleared */
+    result = vshlq_s32(value, shift);
+    result = vbicq_s32(result, vreinterpretq_s32_u32(
+                                   vceqq_s32(result, vdupq_n_s32(-1))));
+  }
+  return result;
+}
+
+/* FX_DBL2FX_SGL(fAddSaturate(scaleValueSaturate(x), 0x8000)) of 4 values,
+ * scalefactor in range -31 ... +31 */
+static inline int16x4_t pcm_saturate16_neon(const int32x4_t value,
+                                            const int32x4_t shift,
+                                            const INT scalefactor) {
+  int32x4_t result = pcm_scale_saturate_neon(value, shift, scalefactor);
+
+  /* fAddSaturate(): ((result >> 1) + 0x4000) saturated and shifted back */
+  result = vminq_s32(vhaddq_s32(result, vdupq_n_s32(0x8000)),
+                     vdupq_n_s32((INT)MAXVAL_DBL >> 1));
+  return vshrn_n_s32(result, 15);
+}
+
+#define FUNCTION_FDK_interleaveSaturate_neon
+static void FDK_interleaveSaturate_neon(const FIXP_DBL *RESTRICT pIn,
+                                        SHORT *RESTRICT pOut,
+                                        const UINT channels,
+                                        const UINT frameSize,
+                                        const UINT length, INT scalefactor) {
+  int16x8_t c[8];
+  UINT sample, ch;
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const int32x4_t shift = vdupq_n_s32(scalefactor);
+
+  for (sample = 0; sample < (length & ~7u); sample += 8) {
+    for (ch = 0; ch < channels; ch++) {
+      const FIXP_DBL *In = &pIn[ch * frameSize + sample];
+      c[ch] = vcombine_s16(
+          pcm_saturate16_neon(vld1q_s32((const int32_t *)&In[0]), shift,
+                              scalefactor),
+          pcm_saturate16_neon(vld1q_s32((const int32_t *)&In[4]), shift,
+                              scalefactor));
+    }
+    pcm_interleave16_neon(pOut, c, channels);
+    pOut += 8 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (SHORT)FX_DBL2FX_SGL(fAddSaturate(
+          scaleValueSaturate(In[0], scalefactor), (FIXP_DBL)0x8000));
+      In += frameSize;
+    }
+  }
+}
+
+#define FUNCTION_FDK_interleaveSaturateInt24_neon
+static void FDK_interleaveSaturateInt24_neon(const FIXP_DBL *RESTRICT pIn,
+                                             LONG *RESTRICT pOut,
+                                             const UINT channels,
+                                             const UINT frameSize,
+                                             const UINT length,
+                                             INT scalefactor) {
+  int32x4_t c[8];
+  UINT sample, ch;
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const int32x4_t shift = vdupq_n_s32(scalefactor);
+
+  for (sample = 0; sample < (length & ~3u); sample += 4) {
+    for (ch = 0; ch < channels; ch++) {
+      const int32x4_t x = pcm_scale_saturate_neon(
+          vld1q_s32((const int32_t *)&pIn[ch * frameSize + sample]), shift,
+          scalefactor);
+      /* fAddSaturate(x, 0x80) >> 8 as in pcm_saturate16_neon() */
+      c[ch] = vshrq_n_s32(vminq_s32(vhaddq_s32(x, vdupq_n_s32(0x80)),
+                                    vdupq_n_s32((INT)MAXVAL_DBL >> 1)),
+                          7);
+    }
+    pcm_interleave32_neon(pOut, c, channels);
+    pOut += 4 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (LONG)(fAddSaturate(scaleValueSaturate(In[0], scalefactor),
+                                    (FIXP_DBL)0x80) >>
+                       8);
+      In += frameSize;
+    }
+  }
+}
+
+#define FUNCTION_FDK_interleaveFloat_neon
+static void FDK_interleaveFloat_neon(const FIXP_DBL *RESTRICT pIn,
+                                     float *RESTRICT pOut, const UINT channels,
+                                     const UINT frameSize, const UINT length,
+                                     INT scalefactor) {
+  int32x4_t c[8];
+  UINT sample, ch;
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const float scale = FDK_pow2f(scalefactor - (DFRACT_BITS - 1));
+
+  for (sample = 0; sample < (length & ~3u); sample += 4) {
+    for (ch = 0; ch < channels; ch++) {
+      c[ch] = vreinterpretq_s32_f32(vmulq_n_f32(
+          vcvtq_f32_s32(
+              vld1q_s32((const int32_t *)&pIn[ch * frameSize + sample])),
+          scale));
+    }
+    pcm_interleave32_neon((LONG *)pOut, c, channels);
+    pOut += 4 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (float)In[0] * scale;
+      In += frameSize;
+    }
+  }
+}
+
+/* pcmFloatToSgl() of 4 values. vmaxq/vminq would return NaN, so the limits
+ * are selected by comparison like in the generic function. */
+static inline int16x4_t pcm_float_to_sgl_neon(const float32x4_t x) {
+  const float32x4_t lo = vdupq_n_f32(PCM_FLT_MIN);
+  const float32x4_t hi = vdupq_n_f32(PCM_FLT_MAX);
+  float32x4_t t = vmulq_n_f32(x, 2147483648.0f);
+
+  t = vbslq_f32(vcgtq_f32(t, lo), t, lo);
+  t = vbslq_f32(vcltq_f32(t, hi), t, hi);
+  return vmovn_s32(
+      vshrq_n_s32(vaddq_s32(vcvtq_s32_f32(t), vdupq_n_s32(0x8000)), 16));
+}
+
+/* pcmInt24ToSgl() of 4 values */
+static inline int16x4_t pcm_int24_to_sgl_neon(const int32x4_t x) {
+  const int32x4_t t = vshlq_n_s32(
+      vmaxq_s32(vminq_s32(x, vdupq_n_s32(0x7FFFFF)), vdupq_n_s32(-0x800000)),
+      8);
+  return vshrn_n_s32(
+      vaddq_s32(vminq_s32(t, vdupq_n_s32(0x7FFF7FFF)), vdupq_n_s32(0x8000)),
+      16);
+}
+
+#define FUNCTION_FDK_deinterleaveFloat_neon
+static void FDK_deinterleaveFloat_neon(const float *RESTRICT pIn,
+                                       SHORT *RESTRICT pOut,
+                                       const UINT channels,
+                                       const UINT frameSize,
+                                       const UINT length) {
+  int32x4_t c[8], d[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (frameSize & ~7u); sample += 8) {
+    pcm_deinterleave32_neon(c, (const LONG *)pIn, channels);
+    pcm_deinterleave32_neon(d, (const LONG *)pIn + 4 * channels, channels);
+    for (ch = 0; ch < channels; ch++) {
+      vst1q_s16(
+          (int16_t *)&pOut[ch * length + sample],
+          vcombine_s16(pcm_float_to_sgl_neon(vreinterpretq_f32_s32(c[ch])),
+                       pcm_float_to_sgl_neon(vreinterpretq_f32_s32(d[ch]))));
+    }
+    pIn += 8 * channels;
+  }
+  for (; sample < frameSize; sample++) {
+    for (ch = 0; ch < channels; ch++) {
+      pOut[ch * length + sample] = pcmFloatToSgl(*pIn++);
+    }
+  }
+}
+
+#define FUNCTION_FDK_deinterleaveInt24_neon
+static void FDK_deinterleaveInt24_neon(const LONG *RESTRICT pIn,
+                                       SHORT *RESTRICT pOut,
+                                       const UINT channels,
+                                       const UINT frameSize,
+                                       const UINT length) {
+  int32x4_t c[8], d[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (frameSize & ~7u); sample += 8) {
+    pcm_deinterleave32_neon(c, pIn, channels);
+    pcm_deinterleave32_neon(d, pIn + 4 * channels, channels);
+    for (ch = 0; ch < channels; ch++) {
+      vst1q_s16((int16_t *)&pOut[ch * length + sample],
+                vcombine_s16(pcm_int24_to_sgl_neon(c[ch]),
+                             pcm_int24_to_sgl_neon(d[ch])));
+    }
+    pIn += 8 * channels;
+  }
+  for (; sample < frameSize; sample++) {
+    for (ch = 0; ch < channels; ch++) {
+      pOut[ch * length + sample] = pcmInt24ToSgl(*pIn++);
+    }
+  }
+}
+
+#endif /* __ARM_NEON */
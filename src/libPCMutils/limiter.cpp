@@ -101,6 +101,7 @@ amm-info@iis.fraunhofer.de
 *******************************************************************************/
 
 #include "libPCMutils/limiter.h"
+#include "libPCMutils/pcm_utils.h"
 #include "libFDK/FDK_core.h"
 
 /* library version */
@@ -163,10 +164,36 @@ TDLimiterPtr pcmLimiter_Create(unsigned int maxAttackMs, unsigned int releaseMs,
   return limiter;
 }
 
-/* apply limiter */
-TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
-                                 INT_PCM* samplesOut, FIXP_DBL* pGainPerSample,
-                                 const INT scaling, const UINT nSamples) {
+/* Store one limited sample in the output format. The 16 and 24 bit samples
+   are rounded, the float samples are tmp * scale. */
+static inline void limiterStore(INT_PCM* pOut, const FIXP_DBL tmp,
+                                const INT shift, const float) {
+#if (SAMPLE_BITS == DFRACT_BITS)
+  *pOut = (INT_PCM)FX_DBL2FX_PCM(
+      (FIXP_DBL)SATURATE_LEFT_SHIFT(tmp, shift, DFRACT_BITS));
+#else
+  *pOut = (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(
+      tmp + ((FIXP_DBL)0x8000 >> shift), shift, DFRACT_BITS));
+#endif
+}
+
+static inline void limiterStore(LONG* pOut, const FIXP_DBL tmp,
+                                const INT shift, const float) {
+  *pOut = (LONG)((FIXP_DBL)SATURATE_LEFT_SHIFT(
+                     tmp + ((FIXP_DBL)0x80 >> shift), shift, DFRACT_BITS) >>
+                 8);
+}
+
+static inline void limiterStore(float* pOut, const FIXP_DBL tmp, const INT,
+                                const float scale) {
+  *pOut = (float)tmp * scale;
+}
+
+/* apply limiter, T is the type of the output samples */
+template <class T>
+static TDLIMITER_ERROR limiterApply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
+                                    T* samplesOut, FIXP_DBL* pGainPerSample,
+                                    const INT scaling, const UINT nSamples) {
   unsigned int i, j;
   FIXP_DBL tmp2;
   FIXP_DBL tmp, old, gain, additionalGain = 0;
@@ -191,6 +218,10 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
 
     FIXP_DBL smoothState0 = limiter->smoothState0;
 
+    /* float output scaling with and without the gain applied */
+    const float scaleGain = FDK_pow2f(scaling + 1 - (DFRACT_BITS - 1));
+    const float scale = FDK_pow2f(scaling - (DFRACT_BITS - 1));
+
     if (limiter->scaling != scaling) {
       scaleValuesSaturate(delayBuf, attack * channels,
                           limiter->scaling - scaling);
@@ -297,14 +328,7 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
 
           /* Apply gain to delayed signal */
           tmp = fMultDiv2(tmp, gain);
-#if (SAMPLE_BITS == DFRACT_BITS)
-          samplesOut[j] = (INT_PCM)FX_DBL2FX_PCM(
-              (FIXP_DBL)SATURATE_LEFT_SHIFT(tmp, scaling + 1, DFRACT_BITS));
-#else
-          samplesOut[j] = (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(
-              tmp + ((FIXP_DBL)0x8000 >> (scaling + 1)), scaling + 1,
-              DFRACT_BITS));
-#endif
+          limiterStore(&samplesOut[j], tmp, scaling + 1, scaleGain);
         }
         gain >>= 1;
       } else {
@@ -317,13 +341,7 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
             p_delayBuf[j] = PCM_LIM2FIXP_DBL(samplesIn[j]);
           }
 
-#if (SAMPLE_BITS == DFRACT_BITS)
-          samplesOut[j] = (INT_PCM)FX_DBL2FX_PCM(
-              (FIXP_DBL)SATURATE_LEFT_SHIFT(tmp, scaling, DFRACT_BITS));
-#else
-          samplesOut[j] = (INT_PCM)FX_DBL2FX_PCM((FIXP_DBL)SATURATE_LEFT_SHIFT(
-              tmp + ((FIXP_DBL)0x8000 >> scaling), scaling, DFRACT_BITS));
-#endif
+          limiterStore(&samplesOut[j], tmp, scaling, scale);
         }
       }
 
@@ -355,6 +373,27 @@ TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
   }
 }
 
+TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
+                                 INT_PCM* samplesOut, FIXP_DBL* pGainPerSample,
+                                 const INT scaling, const UINT nSamples) {
+  return limiterApply(limiter, samplesIn, samplesOut, pGainPerSample, scaling,
+                      nSamples);
+}
+
+TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
+                                 LONG* samplesOut, FIXP_DBL* pGainPerSample,
+                                 const INT scaling, const UINT nSamples) {
+  return limiterApply(limiter, samplesIn, samplesOut, pGainPerSample, scaling,
+                      nSamples);
+}
+
+TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
+                                 float* samplesOut, FIXP_DBL* pGainPerSample,
+                                 const INT scaling, const UINT nSamples) {
+  return limiterApply(limiter, samplesIn, samplesOut, pGainPerSample, scaling,
+                      nSamples);
+}
+
 /* set limiter threshold */
 TDLIMITER_ERROR pcmLimiter_SetThreshold(TDLimiterPtr limiter,
                                         FIXP_DBL threshold) {
@@ -252,7 +252,8 @@ TDLIMITER_ERROR pcmLimiter_SetThreshold(TDLimiterPtr limiter,
  * pcmLimiter_Apply                                                            *
  * limiter:        limiter handle                                              *
  * samplesIn:      pointer to input buffer containing interleaved samples      *
- * samplesOut:     pointer to output buffer containing interleaved samples     *
+ * samplesOut:     pointer to output buffer containing interleaved samples,    *
+ *                 INT_PCM, 24 bit in LONG or float (see PCM_FORMAT)           *
  * pGainPerSample: pointer to gains for each sample                            *
  * scaling:        scaling of output samples                                   *
  * nSamples:       number of samples per channel                               *
@@ -261,5 +262,11 @@ TDLIMITER_ERROR pcmLimiter_SetThreshold(TDLimiterPtr limiter,
 TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
                                  INT_PCM* samplesOut, FIXP_DBL* pGainPerSample,
                                  const INT scaling, const UINT nSamples);
+TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
+                                 LONG* samplesOut, FIXP_DBL* pGainPerSample,
+                                 const INT scaling, const UINT nSamples);
+TDLIMITER_ERROR pcmLimiter_Apply(TDLimiterPtr limiter, PCM_LIM* samplesIn,
+                                 float* samplesOut, FIXP_DBL* pGainPerSample,
+                                 const INT scaling, const UINT nSamples);
 
 #endif /* #ifndef LIMITER_H */
@@ -103,12 +103,54 @@ change
 
 #include "libPCMutils/pcm_utils.h"
 
+#include "libFDK/FDK_dispatch.h"
+#include "libFDK/scale.h"
+
 /* library version */
 #include "libPCMutils/version.h"
 
+/* Limits of the float samples scaled by 2^31, as 16.16 fixed point values:
+ * -32768.0 and 32767.0 */
+#define PCM_FLT_MIN (-2147483648.0f)
+#define PCM_FLT_MAX (2147418112.0f)
+
+/* Float sample to 16 bit, rounded and saturated. The comparisons are written
+ * such that NaN becomes the lower limit. */
+static inline SHORT pcmFloatToSgl(const float x) {
+  float t = x * 2147483648.0f;
+  t = (t > PCM_FLT_MIN) ? t : PCM_FLT_MIN;
+  t = (t < PCM_FLT_MAX) ? t : PCM_FLT_MAX;
+  return (SHORT)(((INT)t + 0x8000) >> 16);
+}
+
+/* 24 bit sample to 16 bit, rounded and saturated */
+static inline SHORT pcmInt24ToSgl(const LONG x) {
+  const INT t = fixmax_I(fixmin_I((INT)x, 0x7FFFFF), -0x800000);
+  return (SHORT)((fixmin_I(t << 8, 0x7FFF7FFF) + 0x8000) >> 16);
+}
+
+#if defined(__x86__)
+#include "libPCMutils/x86/pcm_utils_x86.h"
+
+#elif defined(__arm__)
+#include "libPCMutils/arm/pcm_utils_neon.h"
+
+#endif
+
+/* The SIMD kernels handle the common layouts only */
+static inline int pcmKernelChannels(const UINT channels) {
+  return (channels == 1) || (channels == 2) || (channels == 6) ||
+         (channels == 8);
+}
+
 void FDK_interleave(const FIXP_DBL *RESTRICT pIn, LONG *RESTRICT pOut,
                     const UINT channels, const UINT frameSize,
                     const UINT length) {
+  if ((FDK_kernels.interleave_DBL != NULL) && pcmKernelChannels(channels)) {
+    FDK_kernels.interleave_DBL(pIn, pOut, channels, frameSize, length);
+    return;
+  }
+
   for (UINT sample = 0; sample < length; sample++) {
     const FIXP_DBL *In = &pIn[sample];
     for (UINT ch = 0; ch < channels; ch++) {
@@ -130,9 +172,84 @@ void FDK_interleave(const FIXP_DBL *RESTRICT pIn, SHORT *RESTRICT pOut,
   }
 }
 
+void FDK_interleaveSaturate(const FIXP_DBL *RESTRICT pIn,
+                            SHORT *RESTRICT pOut, const UINT channels,
+                            const UINT frameSize, const UINT length,
+                            INT scalefactor) {
+  if ((FDK_kernels.interleaveSaturate != NULL) && pcmKernelChannels(channels)) {
+    FDK_kernels.interleaveSaturate(pIn, pOut, channels, frameSize, length,
+                                   scalefactor);
+    return;
+  }
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+
+  for (UINT sample = 0; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (UINT ch = 0; ch < channels; ch++) {
+      *pOut++ = (SHORT)FX_DBL2FX_SGL(fAddSaturate(
+          scaleValueSaturate(In[0], scalefactor), (FIXP_DBL)0x8000));
+      In += frameSize;
+    }
+  }
+}
+
+void FDK_interleaveSaturateInt24(const FIXP_DBL *RESTRICT pIn,
+                                 LONG *RESTRICT pOut, const UINT channels,
+                                 const UINT frameSize, const UINT length,
+                                 INT scalefactor) {
+  if ((FDK_kernels.interleaveSaturateInt24 != NULL) &&
+      pcmKernelChannels(channels)) {
+    FDK_kernels.interleaveSaturateInt24(pIn, pOut, channels, frameSize, length,
+                                        scalefactor);
+    return;
+  }
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+
+  for (UINT sample = 0; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (UINT ch = 0; ch < channels; ch++) {
+      *pOut++ = (LONG)(fAddSaturate(scaleValueSaturate(In[0], scalefactor),
+                                    (FIXP_DBL)0x80) >>
+                       8);
+      In += frameSize;
+    }
+  }
+}
+
+void FDK_interleaveFloat(const FIXP_DBL *RESTRICT pIn, float *RESTRICT pOut,
+                         const UINT channels, const UINT frameSize,
+                         const UINT length, INT scalefactor) {
+  if ((FDK_kernels.interleaveFloat != NULL) && pcmKernelChannels(channels)) {
+    FDK_kernels.interleaveFloat(pIn, pOut, channels, frameSize, length,
+                                scalefactor);
+    return;
+  }
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const float scale = FDK_pow2f(scalefactor - (DFRACT_BITS - 1));
+
+  for (UINT sample = 0; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (UINT ch = 0; ch < channels; ch++) {
+      *pOut++ = (float)In[0] * scale;
+      In += frameSize;
+    }
+  }
+}
+
 void FDK_interleave(const FIXP_SGL *RESTRICT pIn, SHORT *RESTRICT pOut,
                     const UINT channels, const UINT frameSize,
                     const UINT length) {
+  if ((FDK_kernels.interleave_SGL != NULL) && pcmKernelChannels(channels)) {
+    FDK_kernels.interleave_SGL(pIn, pOut, channels, frameSize, length);
+    return;
+  }
+
   for (UINT sample = 0; sample < length; sample++) {
     const FIXP_SGL *In = &pIn[sample];
     for (UINT ch = 0; ch < channels; ch++) {
@@ -158,6 +275,11 @@ void FDK_deinterleave(const LONG *RESTRICT pIn, SHORT *RESTRICT _pOut,
 void FDK_deinterleave(const LONG *RESTRICT pIn, LONG *RESTRICT _pOut,
                       const UINT channels, const UINT frameSize,
                       const UINT length) {
+  if ((FDK_kernels.deinterleave_DBL != NULL) && pcmKernelChannels(channels)) {
+    FDK_kernels.deinterleave_DBL(pIn, _pOut, channels, frameSize, length);
+    return;
+  }
+
   for (UINT ch = 0; ch < channels; ch++) {
     LONG *pOut = _pOut + length * ch;
     const LONG *In = &pIn[ch];
@@ -171,6 +293,11 @@ void FDK_deinterleave(const LONG *RESTRICT pIn, LONG *RESTRICT _pOut,
 void FDK_deinterleave(const SHORT *RESTRICT pIn, SHORT *RESTRICT _pOut,
                       const UINT channels, const UINT frameSize,
                       const UINT length) {
+  if ((FDK_kernels.deinterleave_SGL != NULL) && pcmKernelChannels(channels)) {
+    FDK_kernels.deinterleave_SGL(pIn, _pOut, channels, frameSize, length);
+    return;
+  }
+
   for (UINT ch = 0; ch < channels; ch++) {
     SHORT *pOut = _pOut + length * ch;
     const SHORT *In = &pIn[ch];
@@ -193,3 +320,70 @@ void FDK_deinterleave(const SHORT *RESTRICT pIn, LONG *RESTRICT _pOut,
     }
   }
 }
+
+void FDK_deinterleave(const float *RESTRICT pIn, SHORT *RESTRICT _pOut,
+                      const UINT channels, const UINT frameSize,
+                      const UINT length) {
+  if ((FDK_kernels.deinterleaveFloat != NULL) && pcmKernelChannels(channels)) {
+    FDK_kernels.deinterleaveFloat(pIn, _pOut, channels, frameSize, length);
+    return;
+  }
+
+  for (UINT ch = 0; ch < channels; ch++) {
+    SHORT *pOut = _pOut + length * ch;
+    const float *In = &pIn[ch];
+    for (UINT sample = 0; sample < frameSize; sample++) {
+      *pOut++ = pcmFloatToSgl(In[0]);
+      In += channels;
+    }
+  }
+}
+
+void FDK_deinterleaveInt24(const LONG *RESTRICT pIn, SHORT *RESTRICT _pOut,
+                           const UINT channels, const UINT frameSize,
+                           const UINT length) {
+  if ((FDK_kernels.deinterleaveInt24 != NULL) && pcmKernelChannels(channels)) {
+    FDK_kernels.deinterleaveInt24(pIn, _pOut, channels, frameSize, length);
+    return;
+  }
+
+  for (UINT ch = 0; ch < channels; ch++) {
+    SHORT *pOut = _pOut + length * ch;
+    const LONG *In = &pIn[ch];
+    for (UINT sample = 0; sample < frameSize; sample++) {
+      *pOut++ = pcmInt24ToSgl(In[0]);
+      In += channels;
+    }
+  }
+}
+
+void pcmUtilsSelectKernels(FDK_KERNELS *kernels, const UINT cpuFeatures) {
+#if defined(FUNCTION_FDK_interleave_DBL_sse41)
+  if (cpuFeatures & FDK_CPU_SSE41) {
+    kernels->interleave_DBL = FDK_interleave_DBL_sse41;
+    kernels->interleave_SGL = FDK_interleave_SGL_sse41;
+    kernels->deinterleave_DBL = FDK_deinterleave_DBL_sse41;
+    kernels->deinterleave_SGL = FDK_deinterleave_SGL_sse41;
+    kernels->interleaveSaturate = FDK_interleaveSaturate_sse41;
+    kernels->interleaveSaturateInt24 = FDK_interleaveSaturateInt24_sse41;
+    kernels->interleaveFloat = FDK_interleaveFloat_sse41;
+    kernels->deinterleaveFloat = FDK_deinterleaveFloat_sse41;
+    kernels->deinterleaveInt24 = FDK_deinterleaveInt24_sse41;
+  }
+#endif
+#if defined(FUNCTION_FDK_interleave_DBL_neon)
+  if (cpuFeatures & FDK_CPU_NEON) {
+    kernels->interleave_DBL = FDK_interleave_DBL_neon;
+    kernels->interleave_SGL = FDK_interleave_SGL_neon;
+    kernels->deinterleave_DBL = FDK_deinterleave_DBL_neon;
+    kernels->deinterleave_SGL = FDK_deinterleave_SGL_neon;
+    kernels->interleaveSaturate = FDK_interleaveSaturate_neon;
+    kernels->interleaveSaturateInt24 = FDK_interleaveSaturateInt24_neon;
+    kernels->interleaveFloat = FDK_interleaveFloat_neon;
+    kernels->deinterleaveFloat = FDK_deinterleaveFloat_neon;
+    kernels->deinterleaveInt24 = FDK_deinterleaveInt24_neon;
+  }
+#endif
+  (void)kernels;
+  (void)cpuFeatures;
+}
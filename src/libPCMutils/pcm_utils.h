@@ -105,6 +105,22 @@ change
 #define PCM_UTILS_H
 
 #include "libFDK/common_fix.h"
+#include "libSYS/FDK_audio.h"
+
+/* Size in bytes of one sample of a PCM buffer of the given format */
+inline UINT FDK_pcmSampleSize(const PCM_FORMAT format) {
+  return (format == PCM_FMT_INT16) ? (UINT)sizeof(INT_PCM) : 4;
+}
+
+/* 2^e as float for -126 <= e <= 127 */
+inline float FDK_pow2f(const INT e) {
+  union {
+    UINT i;
+    float f;
+  } x;
+  x.i = (UINT)(e + 127) << 23;
+  return x.f;
+}
 
 void FDK_interleave(const FIXP_DBL *RESTRICT pIn, LONG *RESTRICT pOut,
                     const UINT channels, const UINT frameSize,
@@ -112,6 +128,21 @@ void FDK_interleave(const FIXP_DBL *RESTRICT pIn, LONG *RESTRICT pOut,
 void FDK_interleave(const FIXP_DBL *RESTRICT pIn, SHORT *RESTRICT pOut,
                     const UINT channels, const UINT frameSize,
                     const UINT length);
+/* FDK_interleave() combined with scaleValuesSaturate() to 16 bit */
+void FDK_interleaveSaturate(const FIXP_DBL *RESTRICT pIn,
+                            SHORT *RESTRICT pOut, const UINT channels,
+                            const UINT frameSize, const UINT length,
+                            INT scalefactor);
+/* FDK_interleaveSaturate() to 24 bit samples in 32 bit words */
+void FDK_interleaveSaturateInt24(const FIXP_DBL *RESTRICT pIn,
+                                 LONG *RESTRICT pOut, const UINT channels,
+                                 const UINT frameSize, const UINT length,
+                                 INT scalefactor);
+/* FDK_interleave() to float samples scaled by 2^(scalefactor-31), without
+ * saturation */
+void FDK_interleaveFloat(const FIXP_DBL *RESTRICT pIn, float *RESTRICT pOut,
+                         const UINT channels, const UINT frameSize,
+                         const UINT length, INT scalefactor);
 void FDK_interleave(const FIXP_SGL *RESTRICT pIn, SHORT *RESTRICT pOut,
                     const UINT channels, const UINT frameSize,
                     const UINT length);
@@ -128,4 +159,12 @@ void FDK_deinterleave(const SHORT *RESTRICT pIn, SHORT *RESTRICT pOut,
 void FDK_deinterleave(const SHORT *RESTRICT pIn, LONG *RESTRICT pOut,
                       const UINT channels, const UINT frameSize,
                       const UINT length);
+/* Float samples with full scale at +-1.0 to 16 bit, rounded and saturated */
+void FDK_deinterleave(const float *RESTRICT pIn, SHORT *RESTRICT pOut,
+                      const UINT channels, const UINT frameSize,
+                      const UINT length);
+/* 24 bit samples in 32 bit words to 16 bit, rounded and saturated */
+void FDK_deinterleaveInt24(const LONG *RESTRICT pIn, SHORT *RESTRICT pOut,
+                           const UINT channels, const UINT frameSize,
+                           const UINT length);
 #endif /* !defined(PCM_UTILS_H) */
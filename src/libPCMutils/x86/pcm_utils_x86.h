@@ -0,0 +1,543 @@
+#pragma once
+
+/* SSE4.1 versions of the (de)interleaving functions of pcm_utils.cpp for 1, 2,
+ * 6 and 8 channels: included there and selected at runtime by
+ * pcmUtilsSelectKernels(). The results are bit exact to the generic
+ * functions. */
+
+#if defined(__GNUC__) || defined(_MSC_VER)
+#include <immintrin.h>
+
+#include "libSYS/FDK_cpu.h"
+
+/* Transpose of the 4x4 matrix of 32 bit values x[0..3] */
+FDK_TARGET("sse4.1")
+static inline void pcm_transpose4x4_sse(__m128i *x) {
+  const __m128i a0 = _mm_unpacklo_epi32(x[0], x[1]);
+  const __m128i a1 = _mm_unpackhi_epi32(x[0], x[1]);
+  const __m128i a2 = _mm_unpacklo_epi32(x[2], x[3]);
+  const __m128i a3 = _mm_unpackhi_epi32(x[2], x[3]);
+
+  x[0] = _mm_unpacklo_epi64(a0, a2);
+  x[1] = _mm_unpackhi_epi64(a0, a2);
+  x[2] = _mm_unpacklo_epi64(a1, a3);
+  x[3] = _mm_unpackhi_epi64(a1, a3);
+}
+
+/* Transpose of the 8x8 matrix of 16 bit values x[0..7] */
+FDK_TARGET("sse4.1")
+static inline void pcm_transpose8x8_sse(__m128i *x) {
+  const __m128i a0 = _mm_unpacklo_epi16(x[0], x[1]);
+  const __m128i a1 = _mm_unpackhi_epi16(x[0], x[1]);
+  const __m128i a2 = _mm_unpacklo_epi16(x[2], x[3]);
+  const __m128i a3 = _mm_unpackhi_epi16(x[2], x[3]);
+  const __m128i a4 = _mm_unpacklo_epi16(x[4], x[5]);
+  const __m128i a5 = _mm_unpackhi_epi16(x[4], x[5]);
+  const __m128i a6 = _mm_unpacklo_epi16(x[6], x[7]);
+  const __m128i a7 = _mm_unpackhi_epi16(x[6], x[7]);
+  const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+  const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+  const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+  const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+  const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+  const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+  const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+  const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+  x[0] = _mm_unpacklo_epi64(b0, b4);
+  x[1] = _mm_unpackhi_epi64(b0, b4);
+  x[2] = _mm_unpacklo_epi64(b1, b5);
+  x[3] = _mm_unpackhi_epi64(b1, b5);
+  x[4] = _mm_unpacklo_epi64(b2, b6);
+  x[5] = _mm_unpackhi_epi64(b2, b6);
+  x[6] = _mm_unpacklo_epi64(b3, b7);
+  x[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+/* Stores 4 samples of the channels c[0 .. channels-1] interleaved */
+FDK_TARGET("sse4.1")
+static inline void pcm_interleave32_sse(LONG *pOut, __m128i *c,
+                                        const UINT channels) {
+  switch (channels) {
+    case 1:
+      _mm_storeu_si128((__m128i *)pOut, c[0]);
+      break;
+    case 2:
+      _mm_storeu_si128((__m128i *)&pOut[0], _mm_unpacklo_epi32(c[0], c[1]));
+      _mm_storeu_si128((__m128i *)&pOut[4], _mm_unpackhi_epi32(c[0], c[1]));
+      break;
+    case 6: {
+      /* channels 4 and 5 of the samples 0, 1 and 2, 3 */
+      const __m128i lo = _mm_unpacklo_epi32(c[4], c[5]);
+      const __m128i hi = _mm_unpackhi_epi32(c[4], c[5]);
+
+      pcm_transpose4x4_sse(c);
+      _mm_storeu_si128((__m128i *)&pOut[0], c[0]);
+      _mm_storel_epi64((__m128i *)&pOut[4], lo);
+      _mm_storeu_si128((__m128i *)&pOut[6], c[1]);
+      _mm_storel_epi64((__m128i *)&pOut[10], _mm_unpackhi_epi64(lo, lo));
+      _mm_storeu_si128((__m128i *)&pOut[12], c[2]);
+      _mm_storel_epi64((__m128i *)&pOut[16], hi);
+      _mm_storeu_si128((__m128i *)&pOut[18], c[3]);
+      _mm_storel_epi64((__m128i *)&pOut[22], _mm_unpackhi_epi64(hi, hi));
+    } break;
+    case 8:
+      pcm_transpose4x4_sse(&c[0]);
+      pcm_transpose4x4_sse(&c[4]);
+      for (int s = 0; s < 4; s++) {
+        _mm_storeu_si128((__m128i *)&pOut[8 * s], c[s]);
+        _mm_storeu_si128((__m128i *)&pOut[8 * s + 4], c[4 + s]);
+      }
+      break;
+  }
+}
+
+/* Loads 4 interleaved samples into the channels c[0 .. channels-1] */
+FDK_TARGET("sse4.1")
+static inline void pcm_deinterleave32_sse(__m128i *c, const LONG *pIn,
+                                          const UINT channels) {
+  switch (channels) {
+    case 1:
+      c[0] = _mm_loadu_si128((const __m128i *)pIn);
+      break;
+    case 2: {
+      const __m128i v0 = _mm_loadu_si128((const __m128i *)&pIn[0]);
+      const __m128i v1 = _mm_loadu_si128((const __m128i *)&pIn[4]);
+      const __m128i x = _mm_unpacklo_epi32(v0, v1);
+      const __m128i y = _mm_unpackhi_epi32(v0, v1);
+
+      c[0] = _mm_unpacklo_epi32(x, y);
+      c[1] = _mm_unpackhi_epi32(x, y);
+    } break;
+    case 6: {
+      __m128i t0, t1;
+
+      for (int s = 0; s < 4; s++) {
+        c[s] = _mm_loadu_si128((const __m128i *)&pIn[6 * s]);
+      }
+      t0 = _mm_unpacklo_epi32(_mm_loadl_epi64((const __m128i *)&pIn[4]),
+                              _mm_loadl_epi64((const __m128i *)&pIn[10]));
+      t1 = _mm_unpacklo_epi32(_mm_loadl_epi64((const __m128i *)&pIn[16]),
+                              _mm_loadl_epi64((const __m128i *)&pIn[22]));
+      pcm_transpose4x4_sse(c);
+      c[4] = _mm_unpacklo_epi64(t0, t1);
+      c[5] = _mm_unpackhi_epi64(t0, t1);
+    } break;
+    case 8:
+      for (int s = 0; s < 4; s++) {
+        c[s] = _mm_loadu_si128((const __m128i *)&pIn[8 * s]);
+        c[4 + s] = _mm_loadu_si128((const __m128i *)&pIn[8 * s + 4]);
+      }
+      pcm_transpose4x4_sse(&c[0]);
+      pcm_transpose4x4_sse(&c[4]);
+      break;
+  }
+}
+
+/* Stores 8 samples of the channels c[0 .. channels-1] interleaved */
+FDK_TARGET("sse4.1")
+static inline void pcm_interleave16_sse(SHORT *pOut, __m128i *c,
+                                        const UINT channels) {
+  switch (channels) {
+    case 1:
+      _mm_storeu_si128((__m128i *)pOut, c[0]);
+      break;
+    case 2:
+      _mm_storeu_si128((__m128i *)&pOut[0], _mm_unpacklo_epi16(c[0], c[1]));
+      _mm_storeu_si128((__m128i *)&pOut[8], _mm_unpackhi_epi16(c[0], c[1]));
+      break;
+    case 6:
+      /* the samples with 2 empty channels, 6 * 8 values in 6 vectors */
+      c[6] = c[7] = _mm_setzero_si128();
+      pcm_transpose8x8_sse(c);
+      for (int s = 0; s < 8; s += 4) {
+        _mm_storeu_si128((__m128i *)&pOut[0],
+                         _mm_or_si128(c[s], _mm_slli_si128(c[s + 1], 12)));
+        _mm_storeu_si128((__m128i *)&pOut[8],
+                         _mm_or_si128(_mm_srli_si128(c[s + 1], 4),
+                                      _mm_slli_si128(c[s + 2], 8)));
+        _mm_storeu_si128((__m128i *)&pOut[16],
+                         _mm_or_si128(_mm_srli_si128(c[s + 2], 8),
+                                      _mm_slli_si128(c[s + 3], 4)));
+        pOut += 24;
+      }
+      break;
+    case 8:
+      pcm_transpose8x8_sse(c);
+      for (int s = 0; s < 8; s++) {
+        _mm_storeu_si128((__m128i *)&pOut[8 * s], c[s]);
+      }
+      break;
+  }
+}
+
+/* Loads 8 interleaved samples into the channels c[0 .. channels-1] */
+FDK_TARGET("sse4.1")
+static inline void pcm_deinterleave16_sse(__m128i *c, const SHORT *pIn,
+                                          const UINT channels) {
+  switch (channels) {
+    case 1:
+      c[0] = _mm_loadu_si128((const __m128i *)pIn);
+      break;
+    case 2: {
+      /* even and odd values to the lower and upper half */
+      const __m128i shuf =
+          _mm_set_epi8(15, 14, 11, 10, 7, 6, 3, 2, 13, 12, 9, 8, 5, 4, 1, 0);
+      const __m128i x0 =
+          _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&pIn[0]), shuf);
+      const __m128i x1 =
+          _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&pIn[8]), shuf);
+
+      c[0] = _mm_unpacklo_epi64(x0, x1);
+      c[1] = _mm_unpackhi_epi64(x0, x1);
+    } break;
+    case 6:
+      /* the samples s start at pIn[6 * s] */
+      for (int s = 0; s < 8; s += 4) {
+        const __m128i v0 = _mm_loadu_si128((const __m128i *)&pIn[0]);
+        const __m128i v1 = _mm_loadu_si128((const __m128i *)&pIn[8]);
+        const __m128i v2 = _mm_loadu_si128((const __m128i *)&pIn[16]);
+
+        c[s] = v0;
+        c[s + 1] = _mm_alignr_epi8(v1, v0, 12);
+        c[s + 2] = _mm_alignr_epi8(v2, v1, 8);
+        c[s + 3] = _mm_srli_si128(v2, 4);
+        pIn += 24;
+      }
+      pcm_transpose8x8_sse(c);
+      break;
+    case 8:
+      for (int s = 0; s < 8; s++) {
+        c[s] = _mm_loadu_si128((const __m128i *)&pIn[8 * s]);
+      }
+      pcm_transpose8x8_sse(c);
+      break;
+  }
+}
+
+#define FUNCTION_FDK_interleave_DBL_sse41
+FDK_TARGET("sse4.1")
+static void FDK_interleave_DBL_sse41(const FIXP_DBL *RESTRICT pIn,
+                                     LONG *RESTRICT pOut, const UINT channels,
+                                     const UINT frameSize, const UINT length) {
+  __m128i c[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (length & ~3u); sample += 4) {
+    for (ch = 0; ch < channels; ch++) {
+      c[ch] = _mm_loadu_si128((const __m128i *)&pIn[ch * frameSize + sample]);
+    }
+    pcm_interleave32_sse(pOut, c, channels);
+    pOut += 4 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (LONG)In[0];
+      In += frameSize;
+    }
+  }
+}
+
+#define FUNCTION_FDK_interleave_SGL_sse41
+FDK_TARGET("sse4.1")
+static void FDK_interleave_SGL_sse41(const FIXP_SGL *RESTRICT pIn,
+                                     SHORT *RESTRICT pOut, const UINT channels,
+                                     const UINT frameSize, const UINT length) {
+  __m128i c[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (length & ~7u); sample += 8) {
+    for (ch = 0; ch < channels; ch++) {
+      c[ch] = _mm_loadu_si128((const __m128i *)&pIn[ch * frameSize + sample]);
+    }
+    pcm_interleave16_sse(pOut, c, channels);
+    pOut += 8 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_SGL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (SHORT)In[0];
+      In += frameSize;
+    }
+  }
+}
+
+#define FUNCTION_FDK_deinterleave_DBL_sse41
+FDK_TARGET("sse4.1")
+static void FDK_deinterleave_DBL_sse41(const LONG *RESTRICT pIn,
+                                       LONG *RESTRICT pOut,
+                                       const UINT channels,
+                                       const UINT frameSize,
+                                       const UINT length) {
+  __m128i c[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (frameSize & ~3u); sample += 4) {
+    pcm_deinterleave32_sse(c, pIn, channels);
+    for (ch = 0; ch < channels; ch++) {
+      _mm_storeu_si128((__m128i *)&pOut[ch * length + sample], c[ch]);
+    }
+    pIn += 4 * channels;
+  }
+  for (; sample < frameSize; sample++) {
+    for (ch = 0; ch < channels; ch++) {
+      pOut[ch * length + sample] = *pIn++;
+    }
+  }
+}
+
+#define FUNCTION_FDK_deinterleave_SGL_sse41
+FDK_TARGET("sse4.1")
+static void FDK_deinterleave_SGL_sse41(const SHORT *RESTRICT pIn,
+                                       SHORT *RESTRICT pOut,
+                                       const UINT channels,
+                                       const UINT frameSize,
+                                       const UINT length) {
+  __m128i c[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (frameSize & ~7u); sample += 8) {
+    pcm_deinterleave16_sse(c, pIn, channels);
+    for (ch = 0; ch < channels; ch++) {
+      _mm_storeu_si128((__m128i *)&pOut[ch * length + sample], c[ch]);
+    }
+    pIn += 8 * channels;
+  }
+  for (; sample < frameSize; sample++) {
+    for (ch = 0; ch < channels; ch++) {
+      pOut[ch * length + sample] = *pIn++;
+    }
+  }
+}
+
+/* scaleValueSaturate() of 4 values, lo and hi are the limits of the left
+ * shifts without overflow. */
+FDK_TARGET("sse4.1")
+static inline __m128i pcm_scale_saturate_sse(const __m128i value,
+                                             const __m128i shift,
+                                             const __m128i lo,
+                                             const __m128i hi,
+                                             const INT scalefactor) {
+  if (scalefactor >= 0) {
+    __m128i result = _mm_sll_epi32(_mm_min_epi32(_mm_max_epi32(value, lo), hi),
+                                   shift);
+    result = _mm_blendv_epi8(result, _mm_set1_epi32((INT)MAXVAL_DBL),
+                             _mm_cmpgt_epi32(value, hi));
+    return _mm_max_epi32(result, _mm_set1_epi32((INT)MINVAL_DBL + 1));
+  } else {
+    /* values which would become -1 are cleared */
+    const __m128i result = _mm_sra_epi32(value, shift);
+    return _mm_andnot_si128(_mm_cmpeq_epi32(result, _mm_set1_epi32(-1)),
+                            result);
+  }
+}
+
+/* FX_DBL2FX_SGL(fAddSaturate(x, 0x8000)) of 4 values */
+FDK_TARGET("sse4.1")
+static inline __m128i pcm_round_sse(const __m128i x) {
+  return _mm_srai_epi32(
+      _mm_add_epi32(_mm_min_epi32(x, _mm_set1_epi32(0x7FFF7FFF)),
+                    _mm_set1_epi32(0x8000)),
+      16);
+}
+
+#define FUNCTION_FDK_interleaveSaturate_sse41
+FDK_TARGET("sse4.1")
+static void FDK_interleaveSaturate_sse41(const FIXP_DBL *RESTRICT pIn,
+                                         SHORT *RESTRICT pOut,
+                                         const UINT channels,
+                                         const UINT frameSize,
+                                         const UINT length, INT scalefactor) {
+  __m128i c[8];
+  UINT sample, ch;
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const __m128i shift =
+      _mm_cvtsi32_si128((scalefactor >= 0) ? scalefactor : -scalefactor);
+  const __m128i lo =
+      _mm_set1_epi32((INT)MINVAL_DBL >> fixmax_I(scalefactor, 0));
+  const __m128i hi =
+      _mm_set1_epi32((INT)MAXVAL_DBL >> fixmax_I(scalefactor, 0));
+
+  for (sample = 0; sample < (length & ~7u); sample += 8) {
+    for (ch = 0; ch < channels; ch++) {
+      const FIXP_DBL *In = &pIn[ch * frameSize + sample];
+      c[ch] = _mm_packs_epi32(
+          pcm_round_sse(pcm_scale_saturate_sse(
+              _mm_loadu_si128((const __m128i *)&In[0]), shift, lo, hi,
+              scalefactor)),
+          pcm_round_sse(pcm_scale_saturate_sse(
+              _mm_loadu_si128((const __m128i *)&In[4]), shift, lo, hi,
+              scalefactor)));
+    }
+    pcm_interleave16_sse(pOut, c, channels);
+    pOut += 8 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (SHORT)FX_DBL2FX_SGL(fAddSaturate(
+          scaleValueSaturate(In[0], scalefactor), (FIXP_DBL)0x8000));
+      In += frameSize;
+    }
+  }
+}
+
+#define FUNCTION_FDK_interleaveSaturateInt24_sse41
+FDK_TARGET("sse4.1")
+static void FDK_interleaveSaturateInt24_sse41(const FIXP_DBL *RESTRICT pIn,
+                                              LONG *RESTRICT pOut,
+                                              const UINT channels,
+                                              const UINT frameSize,
+                                              const UINT length,
+                                              INT scalefactor) {
+  __m128i c[8];
+  UINT sample, ch;
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const __m128i shift =
+      _mm_cvtsi32_si128((scalefactor >= 0) ? scalefactor : -scalefactor);
+  const __m128i lo =
+      _mm_set1_epi32((INT)MINVAL_DBL >> fixmax_I(scalefactor, 0));
+  const __m128i hi =
+      _mm_set1_epi32((INT)MAXVAL_DBL >> fixmax_I(scalefactor, 0));
+
+  for (sample = 0; sample < (length & ~3u); sample += 4) {
+    for (ch = 0; ch < channels; ch++) {
+      const __m128i x = pcm_scale_saturate_sse(
+          _mm_loadu_si128((const __m128i *)&pIn[ch * frameSize + sample]),
+          shift, lo, hi, scalefactor);
+      /* fAddSaturate(x, 0x80) >> 8 */
+      c[ch] = _mm_srai_epi32(
+          _mm_add_epi32(_mm_min_epi32(x, _mm_set1_epi32(0x7FFFFF7F)),
+                        _mm_set1_epi32(0x80)),
+          8);
+    }
+    pcm_interleave32_sse(pOut, c, channels);
+    pOut += 4 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (LONG)(fAddSaturate(scaleValueSaturate(In[0], scalefactor),
+                                    (FIXP_DBL)0x80) >>
+                       8);
+      In += frameSize;
+    }
+  }
+}
+
+#define FUNCTION_FDK_interleaveFloat_sse41
+FDK_TARGET("sse4.1")
+static void FDK_interleaveFloat_sse41(const FIXP_DBL *RESTRICT pIn,
+                                      float *RESTRICT pOut,
+                                      const UINT channels,
+                                      const UINT frameSize, const UINT length,
+                                      INT scalefactor) {
+  __m128i c[8];
+  UINT sample, ch;
+
+  scalefactor = fixmax_I(fixmin_I(scalefactor, (INT)DFRACT_BITS - 1),
+                         (INT) - (DFRACT_BITS - 1));
+  const float scale = FDK_pow2f(scalefactor - (DFRACT_BITS - 1));
+  const __m128 vscale = _mm_set1_ps(scale);
+
+  for (sample = 0; sample < (length & ~3u); sample += 4) {
+    for (ch = 0; ch < channels; ch++) {
+      c[ch] = _mm_castps_si128(_mm_mul_ps(
+          _mm_cvtepi32_ps(_mm_loadu_si128(
+              (const __m128i *)&pIn[ch * frameSize + sample])),
+          vscale));
+    }
+    pcm_interleave32_sse((LONG *)pOut, c, channels);
+    pOut += 4 * channels;
+  }
+  for (; sample < length; sample++) {
+    const FIXP_DBL *In = &pIn[sample];
+    for (ch = 0; ch < channels; ch++) {
+      *pOut++ = (float)In[0] * scale;
+      In += frameSize;
+    }
+  }
+}
+
+/* pcmFloatToSgl() of 4 values */
+FDK_TARGET("sse4.1")
+static inline __m128i pcm_float_to_sgl_sse(const __m128 x) {
+  __m128 t = _mm_mul_ps(x, _mm_set1_ps(2147483648.0f));
+
+  /* maxps returns the second operand for NaN, like the generic comparison */
+  t = _mm_min_ps(_mm_max_ps(t, _mm_set1_ps(PCM_FLT_MIN)),
+                 _mm_set1_ps(PCM_FLT_MAX));
+  return _mm_srai_epi32(
+      _mm_add_epi32(_mm_cvttps_epi32(t), _mm_set1_epi32(0x8000)), 16);
+}
+
+/* pcmInt24ToSgl() of 4 values */
+FDK_TARGET("sse4.1")
+static inline __m128i pcm_int24_to_sgl_sse(const __m128i x) {
+  return pcm_round_sse(_mm_slli_epi32(
+      _mm_max_epi32(_mm_min_epi32(x, _mm_set1_epi32(0x7FFFFF)),
+                    _mm_set1_epi32(-0x800000)),
+      8));
+}
+
+#define FUNCTION_FDK_deinterleaveFloat_sse41
+FDK_TARGET("sse4.1")
+static void FDK_deinterleaveFloat_sse41(const float *RESTRICT pIn,
+                                        SHORT *RESTRICT pOut,
+                                        const UINT channels,
+                                        const UINT frameSize,
+                                        const UINT length) {
+  __m128i c[8], d[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (frameSize & ~7u); sample += 8) {
+    pcm_deinterleave32_sse(c, (const LONG *)pIn, channels);
+    pcm_deinterleave32_sse(d, (const LONG *)pIn + 4 * channels, channels);
+    for (ch = 0; ch < channels; ch++) {
+      _mm_storeu_si128(
+          (__m128i *)&pOut[ch * length + sample],
+          _mm_packs_epi32(pcm_float_to_sgl_sse(_mm_castsi128_ps(c[ch])),
+                          pcm_float_to_sgl_sse(_mm_castsi128_ps(d[ch]))));
+    }
+    pIn += 8 * channels;
+  }
+  for (; sample < frameSize; sample++) {
+    for (ch = 0; ch < channels; ch++) {
+      pOut[ch * length + sample] = pcmFloatToSgl(*pIn++);
+    }
+  }
+}
+
+#define FUNCTION_FDK_deinterleaveInt24_sse41
+FDK_TARGET("sse4.1")
+static void FDK_deinterleaveInt24_sse41(const LONG *RESTRICT pIn,
+                                        SHORT *RESTRICT pOut,
+                                        const UINT channels,
+                                        const UINT frameSize,
+                                        const UINT length) {
+  __m128i c[8], d[8];
+  UINT sample, ch;
+
+  for (sample = 0; sample < (frameSize & ~7u); sample += 8) {
+    pcm_deinterleave32_sse(c, pIn, channels);
+    pcm_deinterleave32_sse(d, pIn + 4 * channels, channels);
+    for (ch = 0; ch < channels; ch++) {
+      _mm_storeu_si128((__m128i *)&pOut[ch * length + sample],
+                       _mm_packs_epi32(pcm_int24_to_sgl_sse(c[ch]),
+                                       pcm_int24_to_sgl_sse(d[ch])));
+    }
+    pIn += 8 * channels;
+  }
+  for (; sample < frameSize; sample++) {
+    for (ch = 0; ch < channels; ch++) {
+      pOut[ch * length + sample] = pcmInt24ToSgl(*pIn++);
+    }
+  }
+}
+
+#endif /* __GNUC__ || _MSC_VER */
@@ -1263,6 +1263,14 @@ createLppTransposer(
   pSettings->nCols = nCols;
   pSettings->overlap = overlap;
 
+  /* The pole moving factors and filter states of a previous stream must not
+   * leak into this one */
+  FDKmemclear(hs->bwVectorOld, sizeof(hs->bwVectorOld));
+  FDKmemclear(hs->lpcFilterStatesRealLegSBR,
+              sizeof(hs->lpcFilterStatesRealLegSBR));
+  FDKmemclear(hs->lpcFilterStatesImagLegSBR,
+              sizeof(hs->lpcFilterStatesImagLegSBR));
+
   switch (timeSlots) {
     case 15:
     case 16:
@@ -489,6 +489,15 @@ unsigned int ReadPsData(
     pBsData->bEnableExt = (UCHAR)FDKreadBits(hBitBuf, 1);
   }
 
+  /* Measure the header distance of the stream */
+  if (h_ps_d->headerAge >= 0) {
+    h_ps_d->headerAge++;
+  }
+  if (bEnableHeader) {
+    h_ps_d->headerGapMax = fMax(h_ps_d->headerGapMax, h_ps_d->headerAge);
+    h_ps_d->headerAge = 0;
+  }
+
   pBsData->bFrameClass = (UCHAR)FDKreadBits(hBitBuf, 1);
   if (pBsData->bFrameClass == 0) {
     /* FIX_BORDERS NoEnv=0,1,2,4 */
@@ -573,6 +582,18 @@ unsigned int ReadPsData(
     }
   }
 
+  /* Measure the distance between frames without time differential coding.
+     Later envelopes of a frame only refer to the first one. */
+  if (h_ps_d->dtRun >= 0) {
+    h_ps_d->dtRun++;
+  }
+  if ((pBsData->noEnv > 0) &&
+      (!pBsData->bEnableIid || !pBsData->abIidDtFlag[0]) &&
+      (!pBsData->bEnableIcc || !pBsData->abIccDtFlag[0])) {
+    h_ps_d->dtRunMax = fMax(h_ps_d->dtRunMax, h_ps_d->dtRun);
+    h_ps_d->dtRun = 0;
+  }
+
   if (pBsData->bEnableExt) {
     /*!
     Decoders that support only the baseline version of the PS tool are allowed
@@ -181,6 +181,10 @@ int CreatePsDec(HANDLE_PS_DEC *h_PS_DEC, /*!< pointer to the module state */
 
   h_ps_d->psDecodedPrv = 0;
   h_ps_d->procFrameBased = -1;
+  h_ps_d->headerAge = -1;
+  h_ps_d->headerGapMax = 0;
+  h_ps_d->dtRun = -1;
+  h_ps_d->dtRunMax = 0;
   for (i = 0; i < (1) + 1; i++) {
     h_ps_d->bPsDataAvail[i] = ppt_none;
   }
@@ -235,6 +239,27 @@ int DeletePsDec(HANDLE_PS_DEC *h_PS_DEC) /*!< pointer to the module state */
   return 0;
 } /*END DeletePsDec */
 
+/***************************************************************************/
+/*!
+  \brief  Number of frames after an interruption until the PS parameters no
+          longer depend on the skipped frames: a header is needed first, then
+          a frame which is not coded relative to its predecessor.
+
+  \return Number of frames, 0 if no PS data was received, -1 if the stream
+          did not yet show two headers and two frames without time
+          differential coding.
+
+****************************************************************************/
+int GetPsResyncFrames(HANDLE_PS_DEC h_ps_d) {
+  if ((h_ps_d == NULL) || (h_ps_d->headerAge < 0)) {
+    return 0;
+  }
+  if ((h_ps_d->headerGapMax == 0) || (h_ps_d->dtRunMax == 0)) {
+    return -1;
+  }
+  return h_ps_d->headerGapMax + h_ps_d->dtRunMax;
+} /*END GetPsResyncFrames */
+
 /***************************************************************************/
 /*!
   \brief resets some values of the PS handle to default states
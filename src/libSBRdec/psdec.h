@@ -262,6 +262,13 @@ struct PS_DEC {
   UCHAR processSlot; /*!< Index of current slot for processing (need for add.
                         delay).   */
 
+  /* resync distances of the stream, see GetPsResyncFrames() */
+  INT headerAge;    /*!< Frames since the last PS header, -1 before the first */
+  INT headerGapMax; /*!< Largest number of frames between two PS headers */
+  INT dtRun;    /*!< Frames since the parameters were last coded without
+                   reference to the previous frame, -1 before the first */
+  INT dtRunMax; /*!< Largest number of frames between two such frames */
+
   union { /* Bitstream data */
     MPEG_PS_BS_DATA
     mpeg; /*!< Struct containing all MPEG specific PS data from bitstream.
@@ -314,6 +321,8 @@ int CreatePsDec(HANDLE_PS_DEC *h_PS_DEC, int aacSamplesPerFrame);
 
 int DeletePsDec(HANDLE_PS_DEC *h_PS_DEC);
 
+int GetPsResyncFrames(HANDLE_PS_DEC h_ps_d);
+
 void PreparePsProcessing(HANDLE_PS_DEC h_ps_d,
                          const FIXP_DBL *const *const rIntBufferLeft,
                          const FIXP_DBL *const *const iIntBufferLeft,
@@ -140,6 +140,12 @@ typedef struct {
   UCHAR useHeaderSlot[(1) + 1]; /* Index array that provides the link between
                                    header and frame data (important when
                                    processing with additional delay). */
+  UCHAR alignGenerators; /* Align the noise and harmonic generators with the
+                            stream position in the next frame that has a valid
+                            header. Set on init and after an interruption. */
+  INT dtRun; /* Frames since the envelopes and noise floors were last coded
+                without reference to the previous frame, -1 before the
+                first. */
 } SBR_DECODER_ELEMENT;
 
 struct SBR_DECODER_INSTANCE {
@@ -171,6 +177,16 @@ struct SBR_DECODER_INSTANCE {
 
   UINT flags;
 
+  INT framePosition; /* Position of the current access unit in frames since the
+                        start of the stream, or -1 if unknown. */
+  INT headerAge;     /* Frames since the last SBR header of the bit stream,
+                        -1 before the first one. */
+  INT headerGapMax;  /* Largest number of frames between two SBR headers of
+                        the bit stream, 0 if unknown. */
+  INT dtRunMax;      /* Largest number of frames between two frames of an
+                        element without time differential coding, 0 if
+                        unknown. */
+
   INT sbrInDataHeadroom; /* Headroom of the SBR input time signal to prevent
                             clipping */
 };
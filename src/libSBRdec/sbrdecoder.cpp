@@ -330,6 +330,13 @@ static SBR_ERROR sbrDecoder_ResetElement(HANDLE_SBRDECODER self,
     for (i = 0; i < (1) + 1; i++) {
       int setDflt;
       hSbrHeader = &(self->sbrHeader[elementIndex][i]);
+      /* A header that was received but not yet applied, e.g. the one in the
+         AAC-ELD configuration of the current access unit, is no history.
+         Keep it across a forced reset. */
+      if ((self->flags & SBRDEC_FORCE_RESET) &&
+          (hSbrHeader->syncState == SBR_HEADER)) {
+        continue;
+      }
       setDflt = ((hSbrHeader->syncState == SBR_NOT_INITIALIZED) ||
                  (self->flags & SBRDEC_FORCE_RESET))
                     ? 1
@@ -470,6 +477,8 @@ SBR_ERROR sbrDecoder_Open(HANDLE_SBRDECODER *pSelf,
   */
 
   self->numDelayFrames = (1); /* set to the max value by default */
+  self->framePosition = -1;
+  self->headerAge = -1;
 
   /* Initialize header sync state */
   for (elIdx = 0; elIdx < (8); elIdx += 1) {
@@ -599,7 +608,9 @@ SBR_ERROR sbrDecoder_InitElement(
   self->sampleRateIn = sampleRateIn;
   self->codecFrameSize = samplesPerFrame;
   self->coreCodec = coreCodec;
-  self->harmonicSBR = harmonicSBR;
+  if (harmonicSBR != 2) { /* 2 only asks to ignore it, keep the current one */
+    self->harmonicSBR = harmonicSBR;
+  }
   self->downscaleFactor = downscaleFactor;
 
   /* Init SBR elements */
@@ -612,6 +623,7 @@ SBR_ERROR sbrDecoder_InitElement(
         sbrError = SBRDEC_MEM_ALLOC_FAILED;
         goto bail;
       }
+      self->pSbrElement[elementIndex]->dtRun = -1;
       self->numSbrElements++;
     } else {
       self->numSbrChannels -= self->pSbrElement[elementIndex]->nChannels;
@@ -695,6 +707,7 @@ SBR_ERROR sbrDecoder_InitElement(
   /* clear error flags for all delay slots */
   FDKmemclear(self->pSbrElement[elementIndex]->frameErrorFlag,
               ((1) + 1) * sizeof(UCHAR));
+  self->pSbrElement[elementIndex]->alignGenerators = 1;
 
   {
     int overlap;
@@ -963,6 +976,7 @@ SBR_ERROR sbrDecoder_SetParam(HANDLE_SBRDECODER self, const SBRDEC_PARAM param,
              This switches off bitstream parsing until a new header arrives. */
           hSbrHeader->syncState = UPSAMPLING;
           hSbrHeader->status |= SBRDEC_HDR_STAT_UPDATE;
+          self->pSbrElement[elementIndex]->alignGenerators = 1;
         }
       }
     } break;
@@ -983,6 +997,17 @@ SBR_ERROR sbrDecoder_SetParam(HANDLE_SBRDECODER self, const SBRDEC_PARAM param,
         }
       }
       break;
+    case SBR_FRAME_POSITION:
+      if (value < -1) {
+        errorStatus = SBRDEC_SET_PARAM_FAIL;
+        break;
+      }
+      if (self == NULL) {
+        errorStatus = SBRDEC_NOT_INITIALIZED;
+      } else {
+        self->framePosition = value;
+      }
+      break;
     default:
       errorStatus = SBRDEC_SET_PARAM_FAIL;
       break;
@@ -1397,6 +1422,8 @@ SBR_ERROR sbrDecoder_Parse(HANDLE_SBRDECODER self, HANDLE_FDK_BITSTREAM hBs,
 
     if (sbrHeaderPresent) {
       headerStatus = sbrGetHeaderData(hSbrHeader, hBs, self->flags, 1, 0);
+      self->headerGapMax = fMax(self->headerGapMax, self->headerAge);
+      self->headerAge = 0;
     }
 
     if (headerStatus == HEADER_RESET) {
@@ -1442,6 +1469,19 @@ SBR_ERROR sbrDecoder_Parse(HANDLE_SBRDECODER self, HANDLE_FDK_BITSTREAM hBs,
     } else {
       INT valBits;
 
+      /* Measure the distance between frames which do not refer to their
+       * predecessor */
+      if (hSbrElement->dtRun >= 0) {
+        hSbrElement->dtRun++;
+      }
+      if (!hFrameDataLeft->domain_vec[0] &&
+          !hFrameDataLeft->domain_vec_noise[0] &&
+          (!stereo || (!hFrameDataRight->domain_vec[0] &&
+                       !hFrameDataRight->domain_vec_noise[0]))) {
+        self->dtRunMax = fMax(self->dtRunMax, hSbrElement->dtRun);
+        hSbrElement->dtRun = 0;
+      }
+
       if (bsPayLen > 0) {
         valBits = bsPayLen - ((INT)startPos - (INT)FDKgetValidBits(hBs));
       } else {
@@ -1556,6 +1596,49 @@ bail:
   return errorStatus;
 }
 
+/*!
+  \brief Align the noise and harmonic generators of an element with the
+         stream position.
+
+  Both generators advance by a fixed step per QMF slot, so a continuous decode
+  reaches a phase at the start of each frame that follows from the number of
+  slots since the start of the stream. Setting it from the frame position lets
+  a decoder that starts in the middle of a stream reproduce the output of a
+  continuous decode, provided the SBR band layout did not change before.
+
+  \param self         SBR decoder handle.
+  \param hSbrElement  Element whose channels are aligned.
+  \param hSbrHeader   Active header of the element.
+*/
+static void sbrDecoder_AlignGenerators(HANDLE_SBRDECODER self,
+                                       SBR_DECODER_ELEMENT *hSbrElement,
+                                       HANDLE_SBR_HEADER_DATA hSbrHeader) {
+  int ch;
+  int noSubbands = hSbrHeader->freqBandData.highSubband -
+                   hSbrHeader->freqBandData.lowSubband;
+  /* the generators wrap after SBR_NF_NO_RANDOM_VAL steps, a power of two */
+  UINT frameSlots =
+      ((UINT)(self->framePosition - self->numDelayFrames) &
+       (SBR_NF_NO_RANDOM_VAL - 1)) *
+      hSbrHeader->numberTimeSlots * hSbrHeader->timeStep;
+
+  for (ch = 0; ch < hSbrElement->nChannels; ch++) {
+    HANDLE_SBR_CHANNEL hSbrChannel = hSbrElement->pSbrChannel[ch];
+    UINT slots;
+
+    if (hSbrChannel == NULL) {
+      continue;
+    }
+    slots = frameSlots +
+            hSbrChannel->frameData[hSbrElement->useFrameSlot]
+                    .frameInfo.borders[0] *
+                hSbrHeader->timeStep;
+    hSbrChannel->SbrDec.SbrCalculateEnvelope.phaseIndex =
+        (int)((slots * noSubbands) & (SBR_NF_NO_RANDOM_VAL - 1));
+    hSbrChannel->SbrDec.SbrCalculateEnvelope.harmIndex = (UCHAR)(slots & 3);
+  }
+}
+
 /**
  * \brief Render one SBR element into time domain signal.
  * \param self SBR decoder handle
@@ -1696,6 +1779,13 @@ static SBR_ERROR sbrDecoder_DecodeElement(
     /* Now we have a full parameter set and can do parameter
        based concealment instead of plain upsampling. */
     hSbrHeader->syncState = SBR_ACTIVE;
+
+    if (hSbrElement->alignGenerators) {
+      if (self->framePosition >= 0) {
+        sbrDecoder_AlignGenerators(self, hSbrElement, hSbrHeader);
+      }
+      hSbrElement->alignGenerators = 0;
+    }
   }
 
   if (timeDataSize <
@@ -1830,6 +1920,10 @@ SBR_ERROR sbrDecoder_Apply(HANDLE_SBRDECODER self, LONG *input, LONG *timeData,
     }
   }
 
+  if (self->headerAge >= 0) {
+    self->headerAge++;
+  }
+
   if (self->numSbrElements != 1 || self->pSbrElement[0]->elementID != ID_SCE) {
     psPossible = 0;
   }
@@ -2007,3 +2101,28 @@ UINT sbrDecoder_GetDelay(const HANDLE_SBRDECODER self) {
 
   return (outputDelay);
 }
+
+INT sbrDecoder_GetResyncFrames(const HANDLE_SBRDECODER self) {
+  INT sbrFrames = -1, psFrames = 0;
+
+  if (self == NULL) {
+    return -1;
+  }
+
+  if (self->dtRunMax > 0) {
+    if ((self->flags & SBRDEC_ELD_GRID) && IS_LOWDELAY(self->coreCodec)) {
+      /* The header is part of the configuration, which is kept */
+      sbrFrames = self->dtRunMax;
+    } else if (self->headerGapMax > 0) {
+      sbrFrames = self->headerGapMax + self->dtRunMax;
+    }
+  }
+  if (self->hParametricStereoDec != NULL) {
+    psFrames = GetPsResyncFrames(self->hParametricStereoDec);
+  }
+
+  if ((sbrFrames < 0) || (psFrames < 0)) {
+    return -1;
+  }
+  return fMax(sbrFrames, psFrames);
+}
@@ -187,8 +187,12 @@ typedef enum {
                          ...). */
   SBR_BS_INTERRUPTION /*!< Signal bit stream interruption. Value is ignored. */
   ,
-  SBR_SKIP_QMF /*!< Enable skipping of QMF step: 1 skip analysis, 2 skip
-                  synthesis */
+  SBR_SKIP_QMF, /*!< Enable skipping of QMF step: 1 skip analysis, 2 skip
+                   synthesis */
+  SBR_FRAME_POSITION /*!< Position of the next access unit in frames since the
+                        start of the stream, or -1 if unknown. Used to align
+                        the noise and harmonic generators after an
+                        interruption. */
 } SBRDEC_PARAM;
 
 typedef struct SBR_DECODER_INSTANCE *HANDLE_SBRDECODER;
@@ -399,6 +403,18 @@ INT sbrDecoder_GetLibInfo(LIB_INFO *info);
  */
 UINT sbrDecoder_GetDelay(const HANDLE_SBRDECODER self);
 
+/**
+ * \brief       Determine how many frames the module needs after an
+ *              interruption until its output no longer depends on the frames
+ *              before: the distance of the SBR and PS headers plus the longest
+ *              run of time differentially coded SBR envelopes or PS
+ *              parameters, as observed in the bit stream so far.
+ * \param self  SBR decoder handle.
+ * \return      The number of frames, or -1 if the bit stream did not yet show
+ *              two headers and two frames without time differential coding.
+ */
+INT sbrDecoder_GetResyncFrames(const HANDLE_SBRDECODER self);
+
 #ifdef __cplusplus
 }
 #endif
@@ -153,6 +153,63 @@ typedef enum {
   (((x) == TT_MP4_RAW) || ((x) == TT_DRM) || ((x) == TT_MP4_LATM_MCP0) || \
    ((x) == TT_MP4_LATM_MCP1))
 
+/**
+ * Sample formats of the PCM buffers exchanged with the encoder and decoder
+ * libraries.
+ */
+typedef enum {
+  PCM_FMT_INT16 = 0, /**< INT_PCM, 16 bit signed integer (default). */
+  PCM_FMT_INT24 = 1, /**< 24 bit signed integer, sign extended to 32 bit. */
+  PCM_FMT_FLOAT = 2  /**< 32 bit float, full scale is -1.0 .. +1.0. */
+
+} PCM_FORMAT;
+
+/**
+ * Stages of the per frame timing of the encoder and decoder libraries. The
+ * timing is only recorded if the libraries are built with FDK_TRACE=1, see
+ * aacDecoder_GetTrace() and aacEncGetTrace().
+ */
+typedef enum {
+  FDK_TRACE_TRANSPORT = 0,  /**< transportDec_ReadAccessUnit() */
+  FDK_TRACE_ELEMENT_READ,   /**< CChannelElement_Read() */
+  FDK_TRACE_ELEMENT_DECODE, /**< CChannelElement_Decode() */
+  FDK_TRACE_RENDER,         /**< Time domain rendering (IMDCT) */
+  FDK_TRACE_SBR,            /**< sbrDecoder_Apply(), including PS */
+  FDK_TRACE_MPS,            /**< mpegSurroundDecoder_Apply() */
+  FDK_TRACE_DRC,            /**< MPEG-D DRC gain decoding and application */
+  FDK_TRACE_LIMITER,        /**< pcmLimiter_Apply() */
+  FDK_TRACE_PSY,            /**< Encoder psychoacoustics, FDKaacEnc_psyMain() */
+  FDK_TRACE_QC,             /**< Encoder FDKaacEnc_QCMain() */
+  FDK_TRACE_NUM_STAGES
+
+} FDK_TRACE_STAGE;
+
+/**
+ * Timing of one frame.
+ */
+typedef struct {
+  UINT frame;   /**< Number of the frame since the instance was opened. */
+  UINT totalNs; /**< Time of the whole aacDecoder_DecodeFrame() or
+                   aacEncEncode() call in ns. */
+  UINT stageNs[FDK_TRACE_NUM_STAGES]; /**< Time of each stage in ns, 0 for
+                                         stages which did not run. */
+
+} FDK_TRACE_FRAME;
+
+/**
+ * Entry of the frame index of an ADTS or LOAS stream, see
+ * aacDecoder_BuildFrameIndex(). The last entry marks the end of the stream:
+ * its offset is the stream size and its frame the number of access units.
+ */
+typedef struct {
+  UINT64 offset; /**< Byte offset of the transport frame in the stream, the
+                    decoder can start there. */
+  UINT64 sample; /**< Position of its first sample per channel at the AAC core
+                    sample rate. */
+  UINT frame;    /**< Number of its first access unit. */
+
+} FDK_FRAME_INDEX;
+
 /**
  * Audio Object Type definitions.
  */
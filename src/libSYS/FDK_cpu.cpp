@@ -0,0 +1,189 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/************************* System integration library **************************
+
+   Author(s):   arduino-fdk-aac contributors
+
+   Description: Detection of the SIMD extensions of the host CPU
+
+*******************************************************************************/
+
+#include "libSYS/FDK_cpu.h"
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || \
+    defined(_M_X64)
+#define FDK_CPU_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+static void FDKcpuid(const UINT leaf, const UINT subleaf, UINT reg[4]) {
+#if defined(_MSC_VER)
+  int r[4];
+  __cpuidex(r, (int)leaf, (int)subleaf);
+  reg[0] = r[0];
+  reg[1] = r[1];
+  reg[2] = r[2];
+  reg[3] = r[3];
+#else
+  __cpuid_count(leaf, subleaf, reg[0], reg[1], reg[2], reg[3]);
+#endif
+}
+
+/* Register state which is saved by the OS (XCR0) */
+static UINT FDKxgetbv(void) {
+#if defined(_MSC_VER)
+  return (UINT)_xgetbv(0);
+#else
+  UINT eax, edx;
+  __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return eax;
+#endif
+}
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FDK_CPU_ARM64
+
+#elif defined(__arm__) && defined(__linux__)
+#define FDK_CPU_ARM_LINUX
+#include <sys/auxv.h>
+#ifndef HWCAP_NEON
+#define HWCAP_NEON (1 << 12)
+#endif
+#endif
+
+UINT FDKgetCpuFeatures(void) {
+  UINT features = 0;
+
+#if defined(FDK_CPU_X86)
+  UINT reg[4];
+
+  FDKcpuid(0, 0, reg);
+  const UINT maxLeaf = reg[0];
+
+  if (maxLeaf >= 1) {
+    FDKcpuid(1, 0, reg);
+    if (reg[2] & (1 << 19)) {
+      features |= FDK_CPU_SSE41;
+    }
+    /* AVX needs OSXSAVE and the OS to save the XMM and YMM registers */
+    const int avx = ((reg[2] & (1 << 27)) && (reg[2] & (1 << 28)) &&
+                     ((FDKxgetbv() & 0x6) == 0x6));
+    if (avx && (maxLeaf >= 7)) {
+      FDKcpuid(7, 0, reg);
+      if (reg[1] & (1 << 5)) {
+        features |= FDK_CPU_AVX2;
+      }
+    }
+  }
+
+#elif defined(FDK_CPU_ARM64)
+  /* AdvSIMD is part of the base architecture */
+  features |= FDK_CPU_NEON;
+
+#elif defined(FDK_CPU_ARM_LINUX)
+  if (getauxval(AT_HWCAP) & HWCAP_NEON) {
+    features |= FDK_CPU_NEON;
+  }
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  /* no way to ask the OS: trust the build configuration */
+  features |= FDK_CPU_NEON;
+#endif
+
+  return features;
+}
@@ -0,0 +1,242 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/************************* System integration library **************************
+
+   Author(s):   arduino-fdk-aac contributors
+
+   Description: Per frame timing of the main codec stages
+
+*******************************************************************************/
+
+#include "libSYS/FDK_trace.h"
+
+#include "libSYS/genericStds.h"
+
+#if FDK_TRACE
+
+#include <chrono>
+#include <new>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || \
+    defined(_M_X64)
+#define FDK_TRACE_TSC
+#endif
+
+#if defined(FDK_TRACE_TSC)
+static UINT64 FDKtraceClockNs(void) {
+  return (UINT64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/* TSC and clock at the first FDKtraceOpen(), the TSC rate is measured against
+ * it when the trace is read */
+struct FDK_TRACE_ORIGIN {
+  UINT64 ticks;
+  UINT64 ns;
+  FDK_TRACE_ORIGIN() : ticks(FDKtraceTicks()), ns(FDKtraceClockNs()) {}
+};
+
+static const FDK_TRACE_ORIGIN &FDKtraceOrigin(void) {
+  static const FDK_TRACE_ORIGIN origin;
+  return origin;
+}
+#endif
+
+/* ticks per ns */
+static double FDKtraceTickRate(void) {
+#if defined(FDK_TRACE_TSC)
+  const FDK_TRACE_ORIGIN &origin = FDKtraceOrigin();
+  UINT64 ns, ticks;
+  do { /* at least 1 ms for a stable rate */
+    ns = FDKtraceClockNs();
+    ticks = FDKtraceTicks();
+  } while (ns - origin.ns < 1000000);
+  return (double)(ticks - origin.ticks) / (double)(ns - origin.ns);
+#elif defined(__aarch64__)
+  UINT64 freq;
+  __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+  return (double)freq * 1e-9;
+#else
+  return 1.0;
+#endif
+}
+
+static UINT FDKtraceNs(const UINT ticks, const double rate) {
+  return (UINT)((double)ticks / rate + 0.5);
+}
+
+HANDLE_FDK_TRACE FDKtraceOpen(void) {
+#if defined(FDK_TRACE_TSC)
+  FDKtraceOrigin();
+#endif
+  /* from the active allocator like all other decoder and encoder memory */
+  void *pMem = FDKcalloc(1, sizeof(FDK_TRACE_INSTANCE));
+  if (pMem == NULL) {
+    return NULL;
+  }
+  return new (pMem) FDK_TRACE_INSTANCE();
+}
+
+void FDKtraceClose(HANDLE_FDK_TRACE *phTrace) {
+  if ((phTrace == NULL) || (*phTrace == NULL)) {
+    return;
+  }
+  (*phTrace)->~FDK_TRACE_INSTANCE();
+  FDKfree(*phTrace);
+  *phTrace = NULL;
+}
+
+UINT FDKtraceRead(HANDLE_FDK_TRACE hTrace, FDK_TRACE_FRAME *pFrames,
+                  const UINT maxFrames) {
+  if ((hTrace == NULL) || (pFrames == NULL) || (maxFrames == 0)) {
+    return 0;
+  }
+
+  UINT numFrames = hTrace->numFrames.load(std::memory_order_acquire);
+  UINT n = numFrames;
+  if (n > FDK_TRACE_RING_SIZE) n = FDK_TRACE_RING_SIZE;
+  if (n > maxFrames) n = maxFrames;
+  UINT first = numFrames - n;
+
+  for (UINT i = 0; i < n; i++) {
+    const FDK_TRACE_TICKS *pTicks =
+        &hTrace->ring[(first + i) & (2 * FDK_TRACE_RING_SIZE - 1)];
+    FDK_TRACE_FRAME *pFrame = &pFrames[i];
+    pFrame->frame = pTicks->frame;
+    pFrame->totalNs = pTicks->total;
+    for (int s = 0; s < FDK_TRACE_NUM_STAGES; s++) {
+      pFrame->stageNs[s] = pTicks->stage[s];
+    }
+  }
+
+  /* If the reader was preempted for more than FDK_TRACE_RING_SIZE frames the
+   * writer may have overwritten the oldest entries while they were copied,
+   * drop them. */
+  std::atomic_thread_fence(std::memory_order_acquire);
+  UINT written = hTrace->numFrames.load(std::memory_order_relaxed);
+  UINT skip = 0;
+  if (written - first >= 2 * FDK_TRACE_RING_SIZE) {
+    skip = written - first - 2 * FDK_TRACE_RING_SIZE + 1;
+    if (skip > n) skip = n;
+  }
+  n -= skip;
+
+  double rate = FDKtraceTickRate();
+  for (UINT i = 0; i < n; i++) {
+    FDK_TRACE_FRAME *pFrame = &pFrames[i];
+    *pFrame = pFrames[i + skip];
+    pFrame->totalNs = FDKtraceNs(pFrame->totalNs, rate);
+    for (int s = 0; s < FDK_TRACE_NUM_STAGES; s++) {
+      pFrame->stageNs[s] = FDKtraceNs(pFrame->stageNs[s], rate);
+    }
+  }
+
+  return n;
+}
+
+#else
+
+HANDLE_FDK_TRACE FDKtraceOpen(void) { return NULL; }
+
+void FDKtraceClose(HANDLE_FDK_TRACE *phTrace) {
+  if (phTrace != NULL) {
+    *phTrace = NULL;
+  }
+}
+
+UINT FDKtraceRead(HANDLE_FDK_TRACE, FDK_TRACE_FRAME *, const UINT) { return 0; }
+
+#endif /* FDK_TRACE */
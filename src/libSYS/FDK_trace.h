@@ -0,0 +1,250 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/************************* System integration library **************************
+
+   Author(s):   arduino-fdk-aac contributors
+
+   Description: Per frame timing of the main codec stages
+
+*******************************************************************************/
+
+/** \file   FDK_trace.h
+    \brief  Optional timing of the main decoder and encoder stages. With
+   FDK_TRACE defined to 1 each codec instance reads the cycle counter (TSC on
+   x86, the generic timer on ARM64) around the stages of FDK_TRACE_STAGE and
+   keeps the last FDK_TRACE_RING_SIZE frames in a ring. The ring has a single
+   writer, the thread which decodes or encodes, and is read without locks by
+   FDKtraceRead(), so it can be polled from another thread. Otherwise the trace
+   points compile to nothing and FDKtraceRead() returns no frames.
+ */
+
+#if !defined(FDK_TRACE_H)
+#define FDK_TRACE_H
+
+#include "libSYS/machine_type.h"
+#include "libSYS/FDK_audio.h"
+
+#if !defined(FDK_TRACE)
+#define FDK_TRACE 0
+#endif
+
+#define FDK_TRACE_RING_SIZE (64) /* frames, power of 2 */
+
+typedef struct FDK_TRACE_INSTANCE *HANDLE_FDK_TRACE;
+
+/**
+ *  Allocate the trace of one codec instance.
+ *
+ * \return  Handle or NULL if tracing is not enabled or no memory is available.
+ * All trace points accept a NULL handle.
+ */
+HANDLE_FDK_TRACE FDKtraceOpen(void);
+
+/**
+ *  Release the trace.
+ *
+ * \param phTrace  Pointer to the handle which is set to NULL.
+ */
+void FDKtraceClose(HANDLE_FDK_TRACE *phTrace);
+
+/**
+ *  Copy the timing of the most recent frames, oldest first. Can be called from
+ * any thread while the codec is running.
+ *
+ * \param hTrace     Handle or NULL.
+ * \param pFrames    Destination of at most maxFrames frames.
+ * \param maxFrames  Size of pFrames.
+ * \return           Number of frames copied.
+ */
+UINT FDKtraceRead(HANDLE_FDK_TRACE hTrace, FDK_TRACE_FRAME *pFrames,
+                  const UINT maxFrames);
+
+#if FDK_TRACE
+
+#include <atomic>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || \
+    defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif !defined(__aarch64__)
+#include <chrono>
+#endif
+
+/* ticks of one frame */
+typedef struct {
+  UINT frame;
+  UINT total;
+  UINT stage[FDK_TRACE_NUM_STAGES];
+} FDK_TRACE_TICKS;
+
+struct FDK_TRACE_INSTANCE {
+  /* twice the frames which are read, so the writer never touches them */
+  FDK_TRACE_TICKS ring[2 * FDK_TRACE_RING_SIZE];
+  std::atomic<UINT> numFrames; /* frames written to the ring */
+
+  /* current frame, only used by the writer */
+  UINT64 frameStart;
+  UINT64 start[FDK_TRACE_NUM_STAGES];
+  UINT stage[FDK_TRACE_NUM_STAGES];
+};
+
+/* cycle counter, nanoseconds where none is available */
+static inline UINT64 FDKtraceTicks(void) {
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || \
+    defined(_M_X64)
+  return (UINT64)__rdtsc();
+#elif defined(__aarch64__)
+  UINT64 t;
+  __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t));
+  return t;
+#else
+  return (UINT64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+static inline void FDKtraceFrameStart(HANDLE_FDK_TRACE hTrace) {
+  if (hTrace == NULL) return;
+  for (int i = 0; i < FDK_TRACE_NUM_STAGES; i++) hTrace->stage[i] = 0;
+  hTrace->frameStart = FDKtraceTicks();
+}
+
+/* publish the current frame, a frame without output is dropped */
+static inline void FDKtraceFrameEnd(HANDLE_FDK_TRACE hTrace, const INT valid) {
+  if ((hTrace == NULL) || !valid) return;
+  UINT n = hTrace->numFrames.load(std::memory_order_relaxed);
+  FDK_TRACE_TICKS *pTicks = &hTrace->ring[n & (2 * FDK_TRACE_RING_SIZE - 1)];
+
+  pTicks->frame = n;
+  pTicks->total = (UINT)(FDKtraceTicks() - hTrace->frameStart);
+  for (int i = 0; i < FDK_TRACE_NUM_STAGES; i++) {
+    pTicks->stage[i] = hTrace->stage[i];
+  }
+  hTrace->numFrames.store(n + 1, std::memory_order_release);
+}
+
+static inline void FDKtraceStart(HANDLE_FDK_TRACE hTrace,
+                                 const FDK_TRACE_STAGE stage) {
+  if (hTrace != NULL) hTrace->start[stage] = FDKtraceTicks();
+}
+
+/* stages which run several times per frame accumulate */
+static inline void FDKtraceStop(HANDLE_FDK_TRACE hTrace,
+                                const FDK_TRACE_STAGE stage) {
+  if (hTrace != NULL) {
+    hTrace->stage[stage] += (UINT)(FDKtraceTicks() - hTrace->start[stage]);
+  }
+}
+
+#define FDK_TRACE_FRAME_START(hTrace) FDKtraceFrameStart(hTrace)
+#define FDK_TRACE_FRAME_END(hTrace, valid) FDKtraceFrameEnd(hTrace, valid)
+#define FDK_TRACE_START(hTrace, stage) FDKtraceStart(hTrace, stage)
+#define FDK_TRACE_STOP(hTrace, stage) FDKtraceStop(hTrace, stage)
+
+#else
+
+#define FDK_TRACE_FRAME_START(hTrace)
+#define FDK_TRACE_FRAME_END(hTrace, valid)
+#define FDK_TRACE_START(hTrace, stage)
+#define FDK_TRACE_STOP(hTrace, stage)
+
+#endif /* FDK_TRACE */
+
+#endif /* FDK_TRACE_H */
@@ -0,0 +1,274 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/************************* System integration library **************************
+
+   Author(s):   arduino-fdk-aac contributors
+
+   Description: Small pool of worker threads for data parallel work items
+
+*******************************************************************************/
+
+#include "libSYS/FDK_workerPool.h"
+
+#include "fdk_log.h"
+
+#if FDK_WORKER_THREADS
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#ifdef ESP32
+#include "esp_pthread.h"
+#endif
+
+/* The items use FDK scratch memory on the stack of the worker threads */
+#ifndef FDK_WORKER_STACK_SIZE
+#define FDK_WORKER_STACK_SIZE (16 * 1024)
+#endif
+
+struct FDK_WORKER_POOL {
+  std::mutex runMutex; /* one FDKworkerPoolRun() at a time */
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+
+  std::thread *threads;
+  INT numThreads;
+  bool quit;
+
+  /* current run */
+  FDK_WORKER_ITEM item;
+  void *ctx;
+  INT numItems;
+  std::atomic<INT> nextItem;
+  INT busyThreads;
+  UINT generation;
+};
+
+static void FDKworkerPoolProcess(HANDLE_FDK_WORKER_POOL hPool) {
+  INT i;
+  while ((i = hPool->nextItem.fetch_add(1)) < hPool->numItems) {
+    hPool->item(hPool->ctx, i);
+  }
+}
+
+static void FDKworkerPoolThread(HANDLE_FDK_WORKER_POOL hPool) {
+  std::unique_lock<std::mutex> lock(hPool->mutex);
+  UINT generation = 0; /* value at FDKworkerPoolOpen() */
+
+  for (;;) {
+    hPool->wake.wait(lock, [&] {
+      return hPool->quit || (hPool->generation != generation);
+    });
+    if (hPool->quit) break;
+    generation = hPool->generation;
+
+    lock.unlock();
+    FDKworkerPoolProcess(hPool);
+    lock.lock();
+
+    if (--hPool->busyThreads == 0) {
+      hPool->done.notify_one();
+    }
+  }
+}
+
+HANDLE_FDK_WORKER_POOL FDKworkerPoolOpen(const INT numThreads) {
+  if (numThreads <= 0) {
+    return NULL;
+  }
+
+  HANDLE_FDK_WORKER_POOL hPool = new (std::nothrow) FDK_WORKER_POOL();
+  if (hPool == NULL) {
+    return NULL;
+  }
+  hPool->threads = new (std::nothrow) std::thread[numThreads];
+  if (hPool->threads == NULL) {
+    delete hPool;
+    return NULL;
+  }
+  hPool->quit = false;
+  hPool->generation = 0;
+  hPool->numItems = 0;
+  hPool->busyThreads = 0;
+#ifdef ESP32
+  /* the pthread config applies to all threads created later by the calling
+     thread, so the one of the application is restored afterwards */
+  esp_pthread_cfg_t prevCfg = esp_pthread_get_default_config();
+  esp_pthread_get_cfg(&prevCfg);
+  esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+  cfg.stack_size = FDK_WORKER_STACK_SIZE;
+  esp_pthread_set_cfg(&cfg);
+#endif
+  for (hPool->numThreads = 0; hPool->numThreads < numThreads;
+       hPool->numThreads++) {
+    hPool->threads[hPool->numThreads] =
+        std::thread(FDKworkerPoolThread, hPool);
+  }
+#ifdef ESP32
+  esp_pthread_set_cfg(&prevCfg);
+#endif
+  LOG_FDK(FDKInfo, "FDKworkerPoolOpen: %d threads", numThreads);
+
+  return hPool;
+}
+
+void FDKworkerPoolClose(HANDLE_FDK_WORKER_POOL *phPool) {
+  if ((phPool == NULL) || (*phPool == NULL)) {
+    return;
+  }
+  HANDLE_FDK_WORKER_POOL hPool = *phPool;
+
+  {
+    std::lock_guard<std::mutex> lock(hPool->mutex);
+    hPool->quit = true;
+  }
+  hPool->wake.notify_all();
+  for (INT i = 0; i < hPool->numThreads; i++) {
+    hPool->threads[i].join();
+  }
+  delete[] hPool->threads;
+  delete hPool;
+  *phPool = NULL;
+}
+
+void FDKworkerPoolRun(HANDLE_FDK_WORKER_POOL hPool, FDK_WORKER_ITEM item,
+                      void *ctx, const INT numItems) {
+  if ((hPool == NULL) || (numItems <= 1)) {
+    for (INT i = 0; i < numItems; i++) {
+      item(ctx, i);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> run(hPool->runMutex);
+  {
+    std::lock_guard<std::mutex> lock(hPool->mutex);
+    hPool->item = item;
+    hPool->ctx = ctx;
+    hPool->numItems = numItems;
+    hPool->nextItem = 0;
+    hPool->busyThreads = hPool->numThreads;
+    hPool->generation++;
+  }
+  hPool->wake.notify_all();
+
+  FDKworkerPoolProcess(hPool);
+
+  std::unique_lock<std::mutex> lock(hPool->mutex);
+  hPool->done.wait(lock, [&] { return hPool->busyThreads == 0; });
+}
+
+#else
+
+HANDLE_FDK_WORKER_POOL FDKworkerPoolOpen(const INT) { return NULL; }
+
+void FDKworkerPoolClose(HANDLE_FDK_WORKER_POOL *phPool) {
+  if (phPool != NULL) {
+    *phPool = NULL;
+  }
+}
+
+void FDKworkerPoolRun(HANDLE_FDK_WORKER_POOL, FDK_WORKER_ITEM item, void *ctx,
+                      const INT numItems) {
+  for (INT i = 0; i < numItems; i++) {
+    item(ctx, i);
+  }
+}
+
+#endif /* FDK_WORKER_THREADS */
@@ -0,0 +1,163 @@
+/* -----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK AAC Codec Library for Android
+
+© Copyright  1995 - 2018 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+ 1.    INTRODUCTION
+The Fraunhofer FDK AAC Codec Library for Android ("FDK AAC Codec") is software
+that implements the MPEG Advanced Audio Coding ("AAC") encoding and decoding
+scheme for digital audio. This FDK AAC Codec software is intended to be used on
+a wide variety of Android devices.
+
+AAC's HE-AAC and HE-AAC v2 versions are regarded as today's most efficient
+general perceptual audio codecs. AAC-ELD is considered the best-performing
+full-bandwidth communications codec by independent studies and is widely
+deployed. AAC has been standardized by ISO and IEC as part of the MPEG
+specifications.
+
+Patent licenses for necessary patent claims for the FDK AAC Codec (including
+those of Fraunhofer) may be obtained through Via Licensing
+(www.vialicensing.com) or through the respective patent owners individually for
+the purpose of encoding or decoding bit streams in products that are compliant
+with the ISO/IEC MPEG audio standards. Please note that most manufacturers of
+Android devices already license these patent claims through Via Licensing or
+directly from the patent owners, and therefore FDK AAC Codec software may
+already be covered under those patent licenses when it is used for those
+licensed purposes only.
+
+Commercially-licensed AAC software libraries, including floating-point versions
+with enhanced sound quality, are also available from Fraunhofer. Users are
+encouraged to check the Fraunhofer website for additional applications
+information and documentation.
+
+2.    COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+You must retain the complete text of this software license in redistributions of
+the FDK AAC Codec or your modifications thereto in source code form.
+
+You must retain the complete text of this software license in the documentation
+and/or other materials provided with redistributions of the FDK AAC Codec or
+your modifications thereto in binary form. You must make available free of
+charge copies of the complete source code of the FDK AAC Codec and your
+modifications thereto to recipients of copies in binary form.
+
+The name of Fraunhofer may not be used to endorse or promote products derived
+from this library without prior written permission.
+
+You may not charge copyright license fees for anyone to use, copy or distribute
+the FDK AAC Codec software or your modifications thereto.
+
+Your modified versions of the FDK AAC Codec must carry prominent notices stating
+that you changed the software and the date of any change. For modified versions
+of the FDK AAC Codec, the term "Fraunhofer FDK AAC Codec Library for Android"
+must be replaced by the term "Third-Party Modified Version of the Fraunhofer FDK
+AAC Codec Library for Android."
+
+3.    NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software.
+
+You may use this FDK AAC Codec software or modifications thereto only for
+purposes that are authorized by appropriate patent licenses.
+
+4.    DISCLAIMER
+
+This FDK AAC Codec software is provided by Fraunhofer on behalf of the copyright
+holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES,
+including but not limited to the implied warranties of merchantability and
+fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary,
+or consequential damages, including but not limited to procurement of substitute
+goods or services; loss of use, data, or profits, or business interruption,
+however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of
+this software, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Audio and Multimedia Departments - FDK AAC LL
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+/************************* System integration library **************************
+
+   Author(s):   arduino-fdk-aac contributors
+
+   Description: Small pool of worker threads for data parallel work items
+
+*******************************************************************************/
+
+/** \file   FDK_workerPool.h
+    \brief  Worker threads which process the independent items of one call
+   (e.g. the channel elements of a frame) in parallel.
+ */
+
+#if !defined(FDK_WORKERPOOL_H)
+#define FDK_WORKERPOOL_H
+
+#include "libSYS/machine_type.h"
+
+/* Threads are available on desktop systems and on the ESP32 (pthreads). Define
+   FDK_WORKER_THREADS 0 to disable them. */
+#if !defined(FDK_WORKER_THREADS)
+#if !defined(ARDUINO) || defined(ESP32)
+#define FDK_WORKER_THREADS 1
+#else
+#define FDK_WORKER_THREADS 0
+#endif
+#endif
+
+typedef struct FDK_WORKER_POOL *HANDLE_FDK_WORKER_POOL;
+
+/**
+ *  Work item callback.
+ *
+ * \param ctx    Context which was passed to FDKworkerPoolRun().
+ * \param index  Index of the item: 0 <= index < numItems.
+ */
+typedef void (*FDK_WORKER_ITEM)(void *ctx, const INT index);
+
+/**
+ *  Start a worker pool.
+ *
+ * \param numThreads  Number of additional threads. The calling thread of
+ * FDKworkerPoolRun() always takes part in the processing.
+ * \return            Handle of the pool or NULL if threads are not supported or
+ * no memory is available.
+ */
+HANDLE_FDK_WORKER_POOL FDKworkerPoolOpen(const INT numThreads);
+
+/**
+ *  Stop all threads and release the pool.
+ *
+ * \param phPool  Pointer to the pool handle which is set to NULL.
+ */
+void FDKworkerPoolClose(HANDLE_FDK_WORKER_POOL *phPool);
+
+/**
+ *  Process the items 0..numItems-1 and return after all of them are done.
+ * Calls from different threads are serialized. A NULL pool processes all items
+ * in the calling thread.
+ *
+ * \param hPool     Pool handle or NULL.
+ * \param item      Callback which processes one item.
+ * \param ctx       Context for the callback.
+ * \param numItems  Number of items.
+ */
+void FDKworkerPoolRun(HANDLE_FDK_WORKER_POOL hPool, FDK_WORKER_ITEM item,
+                      void *ctx, const INT numItems);
+
+#endif /* FDK_WORKERPOOL_H */
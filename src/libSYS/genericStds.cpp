@@ -191,10 +191,25 @@ char *FDKstrncpy(char *dest, const char *src, UINT n) {
 /*************************************************************************
  * DYNAMIC MEMORY management (heap)
  *************************************************************************/
+/* Every block starts with a header which stores the allocator it was taken
+   from. 16 bytes keep the natural alignment of the system allocator. */
+#define FDK_ALLOC_HEADER 16
+
+/* Allocator which is active for the calling thread: NULL = system heap */
+static thread_local const FDK_ALLOCATOR *fdkAllocator = NULL;
+
+const FDK_ALLOCATOR *FDKsetAllocator(const FDK_ALLOCATOR *allocator) {
+  const FDK_ALLOCATOR *previous = fdkAllocator;
+  fdkAllocator = allocator;
+  return previous;
+}
+
+const FDK_ALLOCATOR *FDKgetAllocator(void) { return fdkAllocator; }
+
 #ifdef ESP32
 
   // allocate memory with an optional alignment information
-	void *FDKcallocExt(const UINT n, const UINT size, const UCHAR alignment) {
+	static void *FDKsysCallocExt(const UINT n, const UINT size, const UCHAR alignment) {
 		LOG_FDK(FDKDebug,"FDKcallocExt(%d,%d,%d)", n, size, alignment);
     UCHAR alignment_effective = alignment;
 	  void *ptr = nullptr;
@@ -216,18 +231,9 @@ char *FDKstrncpy(char *dest, const char *src, UINT n) {
 	  return ptr;
 	}
 
-	void *FDKcalloc(const UINT n, const UINT size) {
-    return FDKcallocExt(n, size, 1);
-  }
-
-
 #else
 
-	void *FDKcallocExt(const UINT n, const UINT size, const UCHAR) {
-    return FDKcalloc(n, size);
-  }
-
-	void *FDKcalloc(const UINT n, const UINT size) {
+	static void *FDKsysCallocExt(const UINT n, const UINT size, const UCHAR) {
 	  void *ptr;
 
 	  ptr = calloc(n, size);
@@ -241,6 +247,37 @@ char *FDKstrncpy(char *dest, const char *src, UINT n) {
 
 #endif
 
+/* Takes a block from the active allocator (fallback: system heap) and records
+   the allocator in the block header */
+static void *FDKallocBlock(const UINT size, const UCHAR alignment,
+                           const FDK_MEM_KIND kind) {
+  const FDK_ALLOCATOR *allocator = fdkAllocator;
+  UCHAR *block = NULL;
+
+  if (allocator != NULL) {
+    block = (UCHAR *)allocator->calloc(allocator->ctx, size + FDK_ALLOC_HEADER,
+                                       kind);
+  }
+  if (block == NULL) {
+    allocator = NULL;
+    block = (UCHAR *)FDKsysCallocExt(1, size + FDK_ALLOC_HEADER, alignment);
+  }
+  if (block == NULL) {
+    return NULL;
+  }
+  *((const FDK_ALLOCATOR **)block) = allocator;
+
+  return block + FDK_ALLOC_HEADER;
+}
+
+void *FDKcallocExt(const UINT n, const UINT size, const UCHAR alignment) {
+  return FDKallocBlock(n * size, alignment, FDK_MEM_PERSISTENT);
+}
+
+void *FDKcalloc(const UINT n, const UINT size) {
+  return FDKallocBlock(n * size, 1, FDK_MEM_PERSISTENT);
+}
+
 void *FDKaalloc(const UINT size, const UINT alignment) {
   void *addr, *result = NULL;
   addr = FDKcallocExt(1, size + alignment +(UINT)sizeof(void *), alignment); /* Malloc and clear memory. */
@@ -256,7 +293,7 @@ void *FDKaalloc(const UINT size, const UINT alignment) {
 
 void *FDKmalloc(const UINT size) {
 	LOG_FDK(FDKDebug,__FUNCTION__);
-  void *ptr = malloc(size);
+  void *ptr = FDKallocBlock(size, 1, FDK_MEM_PERSISTENT);
 	LOG_FDK(FDKInfo, "==> malloc(%d) -> %p", size, ptr);
 	if (ptr==nullptr) {
 	  LOG_FDK(FDKError, "Memory allocations error!!! malloc(%d) -> %p", size, ptr);
@@ -265,7 +302,112 @@ void *FDKmalloc(const UINT size) {
   return ptr;
 }
 
-void FDKfree(void *ptr) { free((INT *)ptr); }
+void FDKfree(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+  UCHAR *block = (UCHAR *)ptr - FDK_ALLOC_HEADER;
+  const FDK_ALLOCATOR *allocator = *((const FDK_ALLOCATOR **)block);
+  if (allocator != NULL) {
+    allocator->free(allocator->ctx, block);
+  } else {
+    free(block);
+  }
+}
+
+/*--------------------------------------------------------------------------*
+ * Bump pointer arena
+ *--------------------------------------------------------------------------*/
+static void *FDKarenaCalloc(void *ctx, const UINT size, const FDK_MEM_KIND) {
+  FDK_ARENA *arena = (FDK_ARENA *)ctx;
+  UINT aligned = (size + (FDK_ALLOC_HEADER - 1)) & ~(UINT)(FDK_ALLOC_HEADER - 1);
+
+  if (aligned > arena->size - arena->used) {
+    LOG_FDK(FDKWarning, "Arena exhausted: %d of %d bytes used, %d requested",
+            arena->used, arena->size, size);
+    arena->overflows++;
+    return NULL;
+  }
+  UCHAR *ptr = arena->base + arena->used;
+  arena->used += aligned;
+  arena->blocks++;
+  if (arena->used > arena->peak) {
+    arena->peak = arena->used;
+  }
+  /* the memory might have been used before */
+  memset(ptr, 0, size);
+
+  return ptr;
+}
+
+static void FDKarenaFree(void *ctx, void *) {
+  FDK_ARENA *arena = (FDK_ARENA *)ctx;
+  if (arena->blocks > 0 && --arena->blocks == 0) {
+    /* all blocks have been released: start from the beginning */
+    arena->used = 0;
+  }
+}
+
+const FDK_ALLOCATOR *FDKarenaInit(FDK_ARENA *arena, void *memory,
+                                  const UINT size) {
+  /* keep the alignment of the system allocator */
+  UCHAR *base = (UCHAR *)memory;
+  UINT offset = (UINT)((FDK_ALLOC_HEADER - ((size_t)base & (FDK_ALLOC_HEADER - 1))) &
+                       (FDK_ALLOC_HEADER - 1));
+
+  arena->base = base + offset;
+  arena->size = size > offset ? size - offset : 0;
+  arena->used = 0;
+  arena->peak = 0;
+  arena->blocks = 0;
+  arena->overflows = 0;
+  arena->allocator.calloc = FDKarenaCalloc;
+  arena->allocator.free = FDKarenaFree;
+  arena->allocator.ctx = arena;
+
+  return &arena->allocator;
+}
+
+/*--------------------------------------------------------------------------*
+ * Memory counter
+ *--------------------------------------------------------------------------*/
+static void *FDKmemCounterCalloc(void *ctx, const UINT size,
+                                 const FDK_MEM_KIND kind) {
+  FDK_MEM_COUNTER *counter = (FDK_MEM_COUNTER *)ctx;
+  /* same rounding as the arena */
+  UINT aligned = (size + (FDK_ALLOC_HEADER - 1)) & ~(UINT)(FDK_ALLOC_HEADER - 1);
+  /* the prefix remembers what needs to be subtracted again */
+  UCHAR *block = (UCHAR *)calloc(1, size + FDK_ALLOC_HEADER);
+  if (block == NULL) {
+    return NULL;
+  }
+  ((UINT *)block)[0] = aligned;
+  ((UINT *)block)[1] = (UINT)kind;
+
+  counter->used[kind] += aligned;
+  if (counter->used[kind] > counter->peak[kind]) {
+    counter->peak[kind] = counter->used[kind];
+  }
+
+  return block + FDK_ALLOC_HEADER;
+}
+
+static void FDKmemCounterFree(void *ctx, void *ptr) {
+  FDK_MEM_COUNTER *counter = (FDK_MEM_COUNTER *)ctx;
+  UCHAR *block = (UCHAR *)ptr - FDK_ALLOC_HEADER;
+
+  counter->used[((UINT *)block)[1]] -= ((UINT *)block)[0];
+  free(block);
+}
+
+const FDK_ALLOCATOR *FDKmemCounterInit(FDK_MEM_COUNTER *counter) {
+  FDKmemclear(counter, sizeof(FDK_MEM_COUNTER));
+  counter->allocator.calloc = FDKmemCounterCalloc;
+  counter->allocator.free = FDKmemCounterFree;
+  counter->allocator.ctx = counter;
+
+  return &counter->allocator;
+}
 
 
 void FDKafree(void *ptr) {
@@ -305,6 +447,118 @@ void *FDKaalloc_L(const UINT size, const UINT alignment, MEMORY_SECTION s) {
   return result; /* Return aligned address.          */
 }
 
+/*--------------------------------------------------------------------------*
+ * Shared scratch
+ *--------------------------------------------------------------------------*/
+/* Shared scratch which is active for the calling thread: NULL = private */
+static thread_local FDK_SHARED_SCRATCH *fdkSharedScratch = NULL;
+
+FDK_SHARED_SCRATCH *FDKsetSharedScratch(FDK_SHARED_SCRATCH *scratch) {
+  FDK_SHARED_SCRATCH *previous = fdkSharedScratch;
+  fdkSharedScratch = scratch;
+  return previous;
+}
+
+FDK_SHARED_SCRATCH *FDKgetSharedScratch(void) { return fdkSharedScratch; }
+
+/* Called by FDKfree() for the blocks of a shared scratch */
+static void FDKsharedScratchFree(void *ctx, void *block) {
+  FDK_SHARED_SCRATCH *scratch = (FDK_SHARED_SCRATCH *)ctx;
+
+  for (int i = 0; i < FDK_SHARED_SCRATCH_ENTRIES; i++) {
+    if (scratch->entries[i].block != block) continue;
+    if (--scratch->entries[i].refs == 0) {
+      if (scratch->backing != NULL) {
+        scratch->backing->free(scratch->backing->ctx, block);
+      } else {
+        free(block);
+      }
+      FDKmemclear(&scratch->entries[i], sizeof(scratch->entries[i]));
+    }
+    return;
+  }
+  FDK_ASSERT(0);
+}
+
+void FDKsharedScratchInit(FDK_SHARED_SCRATCH *scratch,
+                          const FDK_ALLOCATOR *backing) {
+  FDKmemclear(scratch, sizeof(FDK_SHARED_SCRATCH));
+  scratch->backing = backing;
+  scratch->allocator.calloc = NULL; /* blocks are only taken by name */
+  scratch->allocator.free = FDKsharedScratchFree;
+  scratch->allocator.ctx = scratch;
+}
+
+/* Provides the overlay with the indicated name. Returns NULL if the scratch
+   is full, so that the caller can fall back to a private overlay. */
+static void *FDKsharedScratchGet(FDK_SHARED_SCRATCH *scratch, const UINT size,
+                                 const UINT alignment, const char *name) {
+  int free_entry = -1;
+
+  for (int i = 0; i < FDK_SHARED_SCRATCH_ENTRIES; i++) {
+    if (scratch->entries[i].name == NULL) {
+      if (free_entry < 0) free_entry = i;
+    } else if ((strcmp(scratch->entries[i].name, name) == 0) &&
+               (scratch->entries[i].size >= size)) {
+      scratch->entries[i].refs++;
+      return scratch->entries[i].ptr;
+    }
+  }
+  if (free_entry < 0) {
+    LOG_FDK(FDKWarning, "Shared scratch full: %s is allocated per instance",
+            name);
+    return NULL;
+  }
+
+  UINT blockSize = FDK_ALLOC_HEADER + size + alignment + (UINT)sizeof(void *);
+  UCHAR *block = NULL;
+  if (scratch->backing != NULL) {
+    block = (UCHAR *)scratch->backing->calloc(scratch->backing->ctx, blockSize,
+                                              FDK_MEM_SCRATCH);
+  } else {
+    block = (UCHAR *)calloc(1, blockSize);
+  }
+  if (block == NULL) {
+    return NULL;
+  }
+  /* FDKafree_L() -> FDKfree() returns the block to FDKsharedScratchFree() */
+  *((const FDK_ALLOCATOR **)block) = &scratch->allocator;
+  void *addr = block + FDK_ALLOC_HEADER;
+  void *result = ALIGN_PTR((unsigned char *)addr + sizeof(void *));
+  *(((void **)result) - 1) = addr;
+
+  scratch->entries[free_entry].name = name;
+  scratch->entries[free_entry].size = size;
+  scratch->entries[free_entry].refs = 1;
+  scratch->entries[free_entry].block = block;
+  scratch->entries[free_entry].ptr = result;
+
+  return result;
+}
+
+void *FDKaalloc_Overlay(const UINT size, const UINT alignment,
+                        MEMORY_SECTION, const char *name) {
+  void *addr, *result = NULL;
+
+  if (fdkSharedScratch != NULL) {
+    result = FDKsharedScratchGet(fdkSharedScratch, size, alignment, name);
+    if (result != NULL) {
+      return result;
+    }
+  }
+  addr = FDKallocBlock(size + alignment + (UINT)sizeof(void *), alignment,
+                       FDK_MEM_SCRATCH); /* Malloc and clear memory.         */
+
+  if (addr != NULL) {
+    result = ALIGN_PTR((unsigned char *)addr +
+                       sizeof(void *)); /* Get aligned memory base address. */
+    *(((void **)result) - 1) = addr;    /* Save malloc'ed memory pointer.   */
+    C_ALLOC_ALIGNED_REGISTER(result, size);
+  }
+
+  return result; /* Return aligned address.          */
+}
+
 void FDKafree_L(void *ptr) {
   void *addr;
 
@@ -341,6 +595,10 @@ void FDKmemset(void *memPtr, const INT value, const UINT size) {
 
 void FDKmemclear(void *memPtr, const UINT size) { FDKmemset(memPtr, 0, size); }
 
+const void *FDKmemchr(const void *s, const INT value, const UINT size) {
+  return memchr(s, value, size);
+}
+
 UINT FDKstrlen(const char *s) { return (UINT)strlen(s); }
 
 /* Compare function wrappers */
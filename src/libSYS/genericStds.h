@@ -311,8 +311,24 @@ typedef enum {
   }
 
 /** See \ref SYSLIB_MEMORY_MACROS for description. */
-#define C_ALLOC_MEM_OVERLAY(name, type, num, sect, tag) \
-  C_AALLOC_MEM_L(name, type, num, sect)
+#define C_ALLOC_MEM_OVERLAY(name, type, num, sect, tag)                      \
+  type *Get##name(int n) {                                                   \
+    type *ap;                                                                \
+    FDK_ASSERT((n) == 0);                                                    \
+    ap = ((type *)FDKaalloc_Overlay((num) * sizeof(type), ALIGNMENT_DEFAULT, \
+                                    sect, #name));                           \
+    return ap;                                                               \
+  }                                                                          \
+  void Free##name(type **p) {                                                \
+    if (p != NULL) {                                                         \
+      FDKafree_L(*p);                                                        \
+      *p = NULL;                                                             \
+    }                                                                        \
+  }                                                                          \
+  UINT GetRequiredMem##name(void) {                                          \
+    return ALGN_SIZE_EXTRES((num) * sizeof(type) + ALIGNMENT_DEFAULT +       \
+                            sizeof(void *));                                 \
+  }
 
 /** See \ref SYSLIB_MEMORY_MACROS for description. */
 #define C_AALLOC_SCRATCH_START(name, type, n)                 \
@@ -454,6 +470,142 @@ void FDKfree_L(void *ptr);
  */
 void FDKafree_L(void *ptr);
 
+/**
+ *  Allocate an aligned overlay (work buffer) memory area. Overlays only hold
+ * data during one processing call. Use FDKafree_L() to free it.
+ */
+void *FDKaalloc_Overlay(const UINT size, const UINT alignment,
+                        MEMORY_SECTION s, const char *name);
+
+/**
+ *  Kind of memory requested from a FDK_ALLOCATOR.
+ */
+typedef enum {
+  FDK_MEM_PERSISTENT = 0, /*!< State which is kept between calls.        */
+  FDK_MEM_SCRATCH = 1     /*!< Overlay work buffers (C_ALLOC_MEM_OVERLAY). */
+} FDK_MEM_KIND;
+
+/**
+ *  Pluggable memory allocator. All memory requested with FDKcalloc(),
+ * FDKmalloc() and FDKaalloc() (and therefore all C_ALLOC_MEM macros) is taken
+ * from the allocator which is active for the calling thread. Every block
+ * remembers its allocator, so FDKfree() always returns it to the right place.
+ */
+typedef struct FDK_ALLOCATOR {
+  void *(*calloc)(void *ctx, const UINT size,
+                  const FDK_MEM_KIND kind); /*!< Returns cleared memory of size
+                                               bytes or NULL. */
+  void (*free)(void *ctx, void *ptr);       /*!< Releases a block.  */
+  void *ctx;                                /*!< User context.      */
+} FDK_ALLOCATOR;
+
+/**
+ *  Activate an allocator for the calling thread.
+ *
+ * \param allocator  Allocator to be used or NULL for the system heap.
+ * \return           The previously active allocator.
+ */
+const FDK_ALLOCATOR *FDKsetAllocator(const FDK_ALLOCATOR *allocator);
+
+/**
+ *  Get the allocator which is active for the calling thread.
+ *
+ * \return  Active allocator or NULL for the system heap.
+ */
+const FDK_ALLOCATOR *FDKgetAllocator(void);
+
+/**
+ *  Bump pointer arena which serves all allocations of one codec instance from
+ * a single pre-sized block. Freed memory is reclaimed when all blocks of the
+ * arena have been released. If the arena is exhausted the system heap is used.
+ */
+typedef struct FDK_ARENA {
+  UCHAR *base;        /*!< Start of the arena memory.                   */
+  UINT size;          /*!< Size of the arena memory in bytes.            */
+  UINT used;          /*!< Currently used bytes.                         */
+  UINT peak;          /*!< Max used bytes since FDKarenaInit().          */
+  UINT blocks;        /*!< Number of blocks which have not been freed.   */
+  UINT overflows;     /*!< Number of requests served by the system heap. */
+  FDK_ALLOCATOR allocator; /*!< Allocator to be passed to FDKsetAllocator(). */
+} FDK_ARENA;
+
+/**
+ *  Initialize an arena on caller provided memory.
+ *
+ * \param arena   Arena to be initialized.
+ * \param memory  Memory which is used by the arena.
+ * \param size    Size of the memory in bytes.
+ * \return        Allocator of the arena.
+ */
+const FDK_ALLOCATOR *FDKarenaInit(FDK_ARENA *arena, void *memory,
+                                  const UINT size);
+
+/**
+ *  Allocator which takes the memory from the system heap and keeps track of
+ * the number of bytes an FDK_ARENA would need for the same requests.
+ */
+typedef struct FDK_MEM_COUNTER {
+  UINT used[2]; /*!< Currently used bytes per FDK_MEM_KIND. */
+  UINT peak[2]; /*!< Max used bytes per FDK_MEM_KIND.       */
+  FDK_ALLOCATOR allocator; /*!< Allocator to be passed to FDKsetAllocator(). */
+} FDK_MEM_COUNTER;
+
+/**
+ *  Initialize a memory counter.
+ *
+ * \param counter  Counter to be initialized.
+ * \return         Allocator of the counter.
+ */
+const FDK_ALLOCATOR *FDKmemCounterInit(FDK_MEM_COUNTER *counter);
+
+#define FDK_SHARED_SCRATCH_ENTRIES \
+  16 /**< Max number of distinct overlays in a FDK_SHARED_SCRATCH. */
+
+/**
+ *  Overlay work buffers (C_ALLOC_MEM_OVERLAY) which are shared by all codec
+ * instances that are running on the same thread. Each overlay is allocated
+ * once and reference counted, so it is released when the last instance which
+ * is using it has been closed. The instances must not be used concurrently.
+ */
+typedef struct FDK_SHARED_SCRATCH {
+  struct {
+    const char *name; /*!< Name of the overlay, NULL = unused entry. */
+    UINT size;        /*!< Size of the overlay in bytes.              */
+    UINT refs;        /*!< Number of Get calls which have not been freed. */
+    void *block;      /*!< Allocated block.                            */
+    void *ptr;        /*!< Aligned overlay memory provided to the codec.  */
+  } entries[FDK_SHARED_SCRATCH_ENTRIES];
+  const FDK_ALLOCATOR *backing; /*!< Allocator of the overlay memory or NULL
+                                   for the system heap. */
+  FDK_ALLOCATOR allocator;      /*!< Releases the shared blocks.  */
+} FDK_SHARED_SCRATCH;
+
+/**
+ *  Initialize a shared scratch.
+ *
+ * \param scratch  Shared scratch to be initialized.
+ * \param backing  Allocator which provides the overlay memory or NULL for the
+ * system heap. It must outlive all instances which are using the scratch.
+ */
+void FDKsharedScratchInit(FDK_SHARED_SCRATCH *scratch,
+                          const FDK_ALLOCATOR *backing);
+
+/**
+ *  Activate a shared scratch for the overlays which are allocated by the
+ * calling thread.
+ *
+ * \param scratch  Shared scratch or NULL for private overlays per instance.
+ * \return         The previously active shared scratch.
+ */
+FDK_SHARED_SCRATCH *FDKsetSharedScratch(FDK_SHARED_SCRATCH *scratch);
+
+/**
+ *  Get the shared scratch which is active for the calling thread.
+ *
+ * \return  Active shared scratch or NULL.
+ */
+FDK_SHARED_SCRATCH *FDKgetSharedScratch(void);
+
 /**
  * Copy memory. Source and destination memory must not overlap.
  * Either use implementation from a Standard Library, or, if no Standard Library
@@ -491,6 +643,12 @@ void FDKmemclear(void *memPtr, const UINT size);
  */
 void FDKmemset(void *memPtr, const INT value, const UINT size);
 
+/**
+ * Find the first byte of a value in memory. The function arguments correspond
+ * to the standard memchr(), which is vectorized by most Standard Libraries.
+ */
+const void *FDKmemchr(const void *s, const INT value, const UINT size);
+
 /* Compare function wrappers */
 INT FDKmemcmp(const void *s1, const void *s2, const UINT size);
 INT FDKstrcmp(const char *s1, const char *s2);
@@ -581,6 +739,34 @@ void FDKprintDisclaimer(void);
 
 #ifdef __cplusplus
 }
+
+/**
+ *  Activates an allocator for the lifetime of the object and restores the
+ * previous one afterwards.
+ */
+class FDK_ALLOCATOR_SCOPE {
+ public:
+  FDK_ALLOCATOR_SCOPE(const FDK_ALLOCATOR *allocator)
+      : previous(FDKsetAllocator(allocator)) {}
+  ~FDK_ALLOCATOR_SCOPE() { FDKsetAllocator(previous); }
+
+ private:
+  const FDK_ALLOCATOR *previous;
+};
+
+/**
+ *  Activates a shared scratch for the lifetime of the object and restores the
+ * previous one afterwards.
+ */
+class FDK_SHARED_SCRATCH_SCOPE {
+ public:
+  FDK_SHARED_SCRATCH_SCOPE(FDK_SHARED_SCRATCH *scratch)
+      : previous(FDKsetSharedScratch(scratch)) {}
+  ~FDK_SHARED_SCRATCH_SCOPE() { FDKsetSharedScratch(previous); }
+
+ private:
+  FDK_SHARED_SCRATCH *previous;
+};
 #endif
 
 #endif /* GENERICSTDS_H */
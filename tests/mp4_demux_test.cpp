@@ -0,0 +1,283 @@
+/*
+ * mp4_demux_test: the MP4 demultiplexer on a generated file and on mutations
+ * of it. The intact file must return all samples, a mutated one may fail to
+ * parse but must not read outside of the file, which is caught when the test
+ * is built with -fsanitize=address.
+ *
+ * usage: mp4_demux_test [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "libMpegTPDec/tpdec_mp4.h"
+
+#define NUM_SAMPLES (200)
+#define SAMPLE_DURATION (1024)
+
+typedef std::vector<UCHAR> Bytes;
+
+static UINT rndState = 1;
+
+static UINT rnd(void) {
+  rndState = rndState * 1664525 + 1013904223;
+  return rndState >> 8;
+}
+
+static void put32(Bytes &b, const UINT v) {
+  b.push_back((UCHAR)(v >> 24));
+  b.push_back((UCHAR)(v >> 16));
+  b.push_back((UCHAR)(v >> 8));
+  b.push_back((UCHAR)v);
+}
+
+static void put16(Bytes &b, const UINT v) {
+  b.push_back((UCHAR)(v >> 8));
+  b.push_back((UCHAR)v);
+}
+
+static void set32(Bytes &b, const size_t pos, const UINT v) {
+  b[pos] = (UCHAR)(v >> 24);
+  b[pos + 1] = (UCHAR)(v >> 16);
+  b[pos + 2] = (UCHAR)(v >> 8);
+  b[pos + 3] = (UCHAR)v;
+}
+
+static Bytes box(const char *type, const Bytes &payload) {
+  Bytes b;
+  put32(b, (UINT)(8 + payload.size()));
+  b.insert(b.end(), type, type + 4);
+  b.insert(b.end(), payload.begin(), payload.end());
+  return b;
+}
+
+static Bytes fullBox(const char *type, const UINT versionFlags,
+                     const Bytes &payload) {
+  Bytes b;
+  put32(b, versionFlags);
+  b.insert(b.end(), payload.begin(), payload.end());
+  return box(type, b);
+}
+
+static Bytes cat(const std::vector<Bytes> &parts) {
+  Bytes b;
+  for (const Bytes &p : parts) b.insert(b.end(), p.begin(), p.end());
+  return b;
+}
+
+/* offsets of the tables in the file, for the targeted mutations */
+struct Layout {
+  size_t stss;  /* first stss entry */
+  size_t stsc;  /* first stsc entry */
+  size_t stco;  /* first stco entry */
+  size_t moov;
+  size_t moovEnd;
+};
+
+/*
+ * Progressive file with an AAC-LC track of NUM_SAMPLES samples: every 5th
+ * sample is a sync sample, chunks of 10 and then 7 samples.
+ */
+static Bytes makeFile(const std::vector<Bytes> &samples, Layout *pLayout) {
+  const UCHAR asc[2] = {0x11, 0x90};
+  Bytes esds, entry, stsd, stts, stss, stsz, stsc, stco, stbl, trak, moov;
+  std::vector<UINT> chunks; /* first sample of each chunk */
+  Bytes data;
+  UINT i;
+
+  for (i = 0; i < NUM_SAMPLES; i += (chunks.size() < 10) ? 10 : 7) {
+    chunks.push_back(i);
+  }
+
+  /* ES_Descriptor, DecoderConfigDescriptor, DecoderSpecificInfo */
+  esds = {0x03, 25, 0, 1, 0, 0x04, 17, 0x40, 0x15, 0, 0, 0,
+          0,    0,  0, 0, 0, 0,    0,  0,    0x05, 2};
+  esds.insert(esds.end(), asc, asc + 2);
+  esds.push_back(0x06);
+  esds.push_back(1);
+  esds.push_back(0x02);
+  esds = fullBox("esds", 0, esds);
+
+  entry.assign(6, 0);
+  put16(entry, 1); /* data_reference_index */
+  entry.resize(entry.size() + 8, 0);
+  put16(entry, 2);  /* channelcount */
+  put16(entry, 16); /* samplesize */
+  put32(entry, 0);
+  put32(entry, 48000u << 16);
+  entry = box("mp4a", cat({entry, esds}));
+  put32(stsd, 1);
+  stsd = fullBox("stsd", 0, cat({stsd, entry}));
+
+  put32(stts, 1);
+  put32(stts, NUM_SAMPLES);
+  put32(stts, SAMPLE_DURATION);
+  stts = fullBox("stts", 0, stts);
+
+  put32(stss, NUM_SAMPLES / 5);
+  for (i = 0; i < NUM_SAMPLES; i += 5) put32(stss, i + 1);
+  stss = fullBox("stss", 0, stss);
+
+  put32(stsz, 0);
+  put32(stsz, NUM_SAMPLES);
+  for (i = 0; i < NUM_SAMPLES; i++) put32(stsz, (UINT)samples[i].size());
+  stsz = fullBox("stsz", 0, stsz);
+
+  put32(stsc, 2);
+  put32(stsc, 1);
+  put32(stsc, 10);
+  put32(stsc, 1);
+  put32(stsc, 11);
+  put32(stsc, 7);
+  put32(stsc, 1);
+  stsc = fullBox("stsc", 0, stsc);
+
+  put32(stco, (UINT)chunks.size());
+  for (i = 0; i < chunks.size(); i++) put32(stco, 0); /* set below */
+  stco = fullBox("stco", 0, stco);
+
+  stbl = box("stbl", cat({stsd, stts, stss, stsz, stsc, stco}));
+  {
+    Bytes tkhd(4 + 8, 0), mdhd(4 + 8, 0), hdlr(4 + 4, 0);
+    put32(tkhd, 1); /* track_ID */
+    tkhd.resize(4 + 80, 0);
+    put32(mdhd, 48000);
+    put32(mdhd, NUM_SAMPLES * SAMPLE_DURATION);
+    put32(mdhd, 0);
+    hdlr.insert(hdlr.end(), {'s', 'o', 'u', 'n'});
+    hdlr.resize(hdlr.size() + 13, 0);
+    trak = box("trak",
+               cat({box("tkhd", tkhd),
+                    box("mdia", cat({box("mdhd", mdhd), box("hdlr", hdlr),
+                                     box("minf", stbl)}))}));
+  }
+  moov = box("moov", trak);
+
+  Bytes file = box("ftyp", {'M', '4', 'A', ' ', 0, 0, 0, 0});
+  pLayout->moov = file.size();
+  file.insert(file.end(), moov.begin(), moov.end());
+  pLayout->moovEnd = file.size();
+
+  /* offsets of the tables from the end of the moov backwards */
+  pLayout->stco = pLayout->moovEnd - 4 * chunks.size();
+  pLayout->stsc = pLayout->stco - 16 - 24;
+  pLayout->stss = pLayout->stsc - 16 - (8 + 4 * NUM_SAMPLES + 12) -
+                  (NUM_SAMPLES / 5) * 4;
+
+  for (i = 0; i < NUM_SAMPLES; i++) {
+    data.insert(data.end(), samples[i].begin(), samples[i].end());
+  }
+  {
+    size_t pos = file.size() + 8;
+    UINT c = 0;
+    for (i = 0; i < NUM_SAMPLES; i++) {
+      if ((c < chunks.size()) && (chunks[c] == i)) {
+        set32(file, pLayout->stco + 4 * c, (UINT)pos);
+        c++;
+      }
+      pos += samples[i].size();
+    }
+  }
+  Bytes mdat = box("mdat", data);
+  file.insert(file.end(), mdat.begin(), mdat.end());
+
+  return file;
+}
+
+/* Read, seek and read again. Returns the number of samples read first. */
+static UINT exercise(const Bytes &file, TRANSPORTDEC_ERROR *pErr) {
+  HANDLE_MP4_DEMUX hDemux = CMp4Demux_Open();
+  MP4_SAMPLE sample;
+  UINT n = 0, sum = 0;
+
+  if (hDemux == NULL) {
+    *pErr = TRANSPORTDEC_UNKOWN_ERROR;
+    return 0;
+  }
+  *pErr = CMp4Demux_SetInput(hDemux, file.data(), file.size());
+  if (*pErr == TRANSPORTDEC_OK) {
+    while (CMp4Demux_ReadSample(hDemux, &sample) == TRANSPORTDEC_OK) {
+      for (UINT i = 0; i < sample.size; i++) sum += sample.pData[i];
+      n++;
+    }
+    for (UINT k = 0; k < 8; k++) {
+      UINT64 time = (UINT64)(rnd() % (NUM_SAMPLES + 20)) * SAMPLE_DURATION;
+      if (CMp4Demux_Seek(hDemux, time, NULL) != TRANSPORTDEC_OK) continue;
+      for (UINT i = 0; i < 4; i++) {
+        if (CMp4Demux_ReadSample(hDemux, &sample) != TRANSPORTDEC_OK) break;
+        if (sample.size > 0) sum += sample.pData[sample.size - 1];
+      }
+    }
+  }
+  CMp4Demux_Close(&hDemux);
+
+  static volatile UINT sink;
+  sink += sum;
+  return n;
+}
+
+int main(int argc, char **argv) {
+  const INT iterations = (argc > 1) ? atoi(argv[1]) : 20000;
+  std::vector<Bytes> samples(NUM_SAMPLES);
+  TRANSPORTDEC_ERROR err;
+  Layout layout;
+  INT failures = 0;
+
+  for (Bytes &s : samples) {
+    s.resize(100 + rnd() % 400);
+    for (UCHAR &b : s) b = (UCHAR)rnd();
+  }
+  const Bytes file = makeFile(samples, &layout);
+
+  if ((exercise(file, &err) != NUM_SAMPLES) || (err != TRANSPORTDEC_OK)) {
+    printf("FAIL: intact file, error %d\n", err);
+    failures++;
+  }
+
+  /* Tables which point outside of stsz or stco must be rejected. */
+  struct {
+    const char *name;
+    size_t pos;
+    UINT value;
+  } broken[] = {
+      {"stss beyond the samples", layout.stss + 4 * (NUM_SAMPLES / 5 - 1),
+       NUM_SAMPLES + 1000},
+      {"stss not increasing", layout.stss + 4, 1},
+      {"stss zero", layout.stss, 0},
+      {"stsc huge samples per chunk", layout.stsc + 4, 0x7fffffff},
+      {"stsc chunk beyond stco", layout.stsc + 12, 0x10000},
+      {"stsc not increasing", layout.stsc + 12, 1},
+      {"stsc too few samples", layout.stsc + 16, 1},
+  };
+  for (const auto &b : broken) {
+    Bytes f = file;
+    set32(f, b.pos, b.value);
+    exercise(f, &err);
+    if (err != TRANSPORTDEC_PARSE_ERROR) {
+      printf("FAIL: %s, error %d\n", b.name, err);
+      failures++;
+    }
+  }
+
+  /* random mutations of the moov, the parser must stay within the file */
+  for (INT it = 0; it < iterations; it++) {
+    Bytes f = file;
+    UINT n = 1 + rnd() % 8;
+    for (UINT k = 0; k < n; k++) {
+      size_t pos = layout.moov + rnd() % (layout.moovEnd - layout.moov);
+      if (rnd() & 1) {
+        f[pos] = (UCHAR)rnd();
+      } else if (pos + 4 <= f.size()) {
+        set32(f, pos, (rnd() & 1) ? rnd() : rnd() % (NUM_SAMPLES + 4));
+      }
+    }
+    if (rnd() % 4 == 0) f.resize(rnd() % f.size());
+    exercise(f, &err);
+  }
+
+  printf("mp4_demux_test: %d mutations, %d failures\n", iterations, failures);
+  return (failures > 0) ? 1 : 0;
+}